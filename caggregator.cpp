@@ -0,0 +1,307 @@
+/*!
+ \file caggregator.cpp
+
+*/
+
+#include "caggregator.h"
+
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <limits>
+
+
+#define SEPARATOR	"\t"
+
+
+/*!
+ \brief Text getter of a group key made from the capture date.
+
+ \fn dateGroup
+ \param szFormat
+ \return cFilter::cTextGetter
+*/
+static cFilter::cTextGetter dateGroup(const QString& szFormat)
+{
+	cFilter::cNumberGetter	original	= cFilter::numberGetter("dateTimeOriginal");
+	cFilter::cNumberGetter	date		= cFilter::numberGetter("date");
+
+	return([original, date, szFormat](const cFilterRecord& record, QString& value) {
+		double	d;
+
+		if(!original(record, d) && !date(record, d))
+			return(false);
+		value	= QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(d)).toString(szFormat);
+		return(true);
+	});
+}
+
+cAggregateValue::cAggregateValue() :
+	m_iCount(0),
+	m_dSum(0),
+	m_dMin(std::numeric_limits<double>::max()),
+	m_dMax(std::numeric_limits<double>::lowest())
+{
+}
+
+cAggregateGroup::cAggregateGroup() :
+	m_iCount(0)
+{
+}
+
+cAggregator::cAggregator()
+{
+}
+
+bool cAggregator::compile(const QString& szGroupBy, const QString& szAggregates)
+{
+	QStringList	szGroupList		= szGroupBy.split(",");
+	QStringList	szAggregateList	= szAggregates.split(",");
+
+	// QString::SkipEmptyParts is deprecated since Qt 5.14, drop the empty parts by hand
+	szGroupList.removeAll(QString());
+	szAggregateList.removeAll(QString());
+
+	m_szGroupList.clear();
+	m_groupList.clear();
+	m_szAggregateList.clear();
+	m_szFunctionList.clear();
+	m_aggregateList.clear();
+	m_dateList.clear();
+	m_szError.clear();
+
+	for(int x = 0;x < szGroupList.count();x++)
+	{
+		QString					szGroup	= szGroupList[x].trimmed();
+		cFilter::cTextGetter	getter;
+
+		if(!szGroup.compare("year", Qt::CaseInsensitive))
+			getter	= dateGroup("yyyy");
+		else if(!szGroup.compare("month", Qt::CaseInsensitive))
+			getter	= dateGroup("yyyy-MM");
+		else if(!szGroup.compare("day", Qt::CaseInsensitive))
+			getter	= dateGroup("yyyy-MM-dd");
+		else
+			getter	= cFilter::textGetter(szGroup);
+
+		if(!getter)
+		{
+			m_szError	= QString("unknown group key '%1'").arg(szGroup);
+			return(false);
+		}
+
+		m_szGroupList.append(szGroup);
+		m_groupList.append(getter);
+	}
+
+	if(m_szGroupList.isEmpty())
+	{
+		m_szError	= "no group key";
+		return(false);
+	}
+
+	if(szAggregateList.isEmpty())
+	{
+		m_szError	= "no aggregate";
+		return(false);
+	}
+
+	QRegularExpression	function("^(min|max|sum|avg)\\((\\w+)\\)$");
+
+	for(int x = 0;x < szAggregateList.count();x++)
+	{
+		QString					szAggregate	= szAggregateList[x].trimmed();
+		QString					szFunction;
+		cFilter::cNumberGetter	getter;
+		QRegularExpressionMatch	match		= function.match(szAggregate.toLower());
+		bool					bDate		= false;
+
+		if(!szAggregate.compare("count", Qt::CaseInsensitive) || !szAggregate.compare("bytes", Qt::CaseInsensitive))
+		{
+			szFunction	= szAggregate.toLower();
+			if(szFunction == "bytes")
+				getter	= cFilter::numberGetter("size");
+		}
+		else if(match.hasMatch())
+		{
+			szFunction	= match.captured(1);
+			getter		= cFilter::numberGetter(match.captured(2));
+
+			if(!getter)
+			{
+				m_szError	= QString("'%1' is not a number or date field").arg(match.captured(2));
+				return(false);
+			}
+
+			// dates are aggregated as milliseconds but written as dates again
+			bDate		= cFilter::isDateField(match.captured(2));
+		}
+		else
+		{
+			m_szError	= QString("unknown aggregate '%1'").arg(szAggregate);
+			return(false);
+		}
+
+		m_szAggregateList.append(szAggregate);
+		m_szFunctionList.append(szFunction);
+		m_aggregateList.append(getter);
+		m_dateList.append(bDate);
+	}
+
+	return(true);
+}
+
+QString cAggregator::error()
+{
+	return(m_szError);
+}
+
+cAggregateTable* cAggregator::localTable()
+{
+	if(!m_local.hasLocalData())
+	{
+		QSharedPointer<cAggregateTable>	table(new cAggregateTable);
+
+		m_local.setLocalData(table);
+
+		// the list keeps the table alive after the thread is gone
+		QMutexLocker	locker(&m_tableMutex);
+		m_tableList.append(table);
+	}
+
+	return(m_local.localData().data());
+}
+
+void cAggregator::add(const cFilterRecord& record)
+{
+	QStringList	szKeyList;
+
+	for(int x = 0;x < m_groupList.count();x++)
+	{
+		QString	szValue;
+
+		if(!m_groupList[x](record, szValue))
+			szValue.clear();
+		szKeyList.append(szValue);
+	}
+
+	cAggregateTable*	lpTable	= localTable();
+	cAggregateGroup&	group	= (*lpTable)[szKeyList.join(SEPARATOR)];
+
+	if(group.m_valueList.isEmpty())
+	{
+		group.m_iCount	= 0;
+		group.m_valueList.resize(m_aggregateList.count());
+	}
+
+	group.m_iCount++;
+
+	for(int x = 0;x < m_aggregateList.count();x++)
+	{
+		double	d;
+
+		if(!m_aggregateList[x] || !m_aggregateList[x](record, d))
+			continue;
+
+		cAggregateValue&	value	= group.m_valueList[x];
+
+		value.m_iCount++;
+		value.m_dSum	+= d;
+		value.m_dMin	= qMin(value.m_dMin, d);
+		value.m_dMax	= qMax(value.m_dMax, d);
+	}
+}
+
+qint32 cAggregator::write(QTextStream& out)
+{
+	cAggregateTable	merged;
+
+	QMutexLocker	locker(&m_tableMutex);
+
+	for(int x = 0;x < m_tableList.count();x++)
+	{
+		cAggregateTable::const_iterator	i	= m_tableList[x]->constBegin();
+
+		for(;i != m_tableList[x]->constEnd();++i)
+		{
+			cAggregateGroup&	group	= merged[i.key()];
+
+			if(group.m_valueList.isEmpty())
+			{
+				group	= i.value();
+				continue;
+			}
+
+			group.m_iCount	+= i.value().m_iCount;
+
+			for(int y = 0;y < group.m_valueList.count();y++)
+			{
+				cAggregateValue&		value	= group.m_valueList[y];
+				const cAggregateValue&	other	= i.value().m_valueList.at(y);
+
+				value.m_iCount	+= other.m_iCount;
+				value.m_dSum	+= other.m_dSum;
+				value.m_dMin	= qMin(value.m_dMin, other.m_dMin);
+				value.m_dMax	= qMax(value.m_dMax, other.m_dMax);
+			}
+		}
+	}
+
+	locker.unlock();
+
+	out << m_szGroupList.join(SEPARATOR) << SEPARATOR << m_szAggregateList.join(SEPARATOR) << "\n";
+
+	QStringList	szKeys	= merged.keys();
+
+	std::sort(szKeys.begin(), szKeys.end());
+
+	for(int x = 0;x < szKeys.count();x++)
+	{
+		const cAggregateGroup&	group	= merged[szKeys[x]];
+
+		out << szKeys[x];
+
+		for(int y = 0;y < m_szFunctionList.count();y++)
+		{
+			const cAggregateValue&	value		= group.m_valueList.at(y);
+			const QString&			szFunction	= m_szFunctionList.at(y);
+			double					d			= 0;
+
+			out << SEPARATOR;
+
+			if(szFunction == "count")
+			{
+				out << group.m_iCount;
+				continue;
+			}
+			if(szFunction == "bytes")
+			{
+				out << static_cast<qint64>(value.m_dSum);
+				continue;
+			}
+
+			if(!value.m_iCount)
+				continue;
+
+			if(szFunction == "min")
+				d	= value.m_dMin;
+			else if(szFunction == "max")
+				d	= value.m_dMax;
+			else if(szFunction == "sum")
+				d	= value.m_dSum;
+			else
+				d	= value.m_dSum / value.m_iCount;
+
+			if(m_dateList.at(y) && szFunction != "sum")
+				out << QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(d)).toString("yyyy-MM-dd hh:mm:ss");
+			else
+				out << QString::number(d, 'g', 15);
+		}
+
+		out << "\n";
+	}
+
+	return(szKeys.count());
+}
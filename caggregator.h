@@ -0,0 +1,132 @@
+/*!
+ \file caggregator.h
+
+*/
+
+#ifndef CAGGREGATOR_H
+#define CAGGREGATOR_H
+
+
+#include "cfilter.h"
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QThreadStorage>
+#include <QTextStream>
+
+
+/*!
+ \brief Running values of one aggregate of one group.
+
+ \class cAggregateValue caggregator.h "caggregator.h"
+*/
+class cAggregateValue
+{
+public:
+	cAggregateValue();
+
+	qint64			m_iCount;					/*!< number of values */
+	double			m_dSum;						/*!< sum of the values */
+	double			m_dMin;						/*!< smallest value */
+	double			m_dMax;						/*!< largest value */
+};
+
+/*!
+ \brief Aggregates of one group.
+
+ \class cAggregateGroup caggregator.h "caggregator.h"
+*/
+class cAggregateGroup
+{
+public:
+	cAggregateGroup();
+
+	qint64						m_iCount;			/*!< pictures in the group */
+	QVector<cAggregateValue>	m_valueList;		/*!< one entry per aggregate */
+};
+
+/*!
+ \brief Groups of one thread.
+*/
+typedef QHash<QString, cAggregateGroup>	cAggregateTable;
+
+/*!
+ \brief Computes group-by statistics during the scan.
+
+ Every scanner thread adds its pictures to its own hash table, so add()
+ takes no lock. The tables are merged by write(). Memory depends on the
+ number of groups, not on the number of files.
+
+ Group keys are field names of cFilter plus year, month and day (of
+ dateTimeOriginal, or the image date if there is none). Aggregates
+ are count, bytes and min(field), max(field), sum(field) and avg(field)
+ over the number and date fields of cFilter.
+
+ \class cAggregator caggregator.h "caggregator.h"
+*/
+class cAggregator
+{
+public:
+	cAggregator();
+
+	/*!
+	 \brief
+
+	 \fn compile
+	 \param szGroupBy comma separated group keys
+	 \param szAggregates comma separated aggregates
+	 \return bool false on an error, see error()
+	*/
+	bool							compile(const QString& szGroupBy, const QString& szAggregates);
+	/*!
+	 \brief
+
+	 \fn error
+	 \return QString
+	*/
+	QString							error();
+
+	/*!
+	 \brief Adds a decoded picture. Thread safe.
+
+	 \fn add
+	 \param record
+	*/
+	void							add(const cFilterRecord& record);
+	/*!
+	 \brief Merges the per thread tables and writes one row per group, sorted by the group keys.
+
+	 \fn write
+	 \param out
+	 \return qint32 number of groups
+	*/
+	qint32							write(QTextStream& out);
+
+private:
+	QStringList						m_szGroupList;					/*!< names of the group keys */
+	QList<cFilter::cTextGetter>		m_groupList;					/*!< getters of the group keys */
+	QStringList						m_szAggregateList;				/*!< names of the aggregates */
+	QStringList						m_szFunctionList;				/*!< count, bytes, min, max, sum or avg per aggregate */
+	QList<cFilter::cNumberGetter>	m_aggregateList;				/*!< getters of the aggregated fields, empty for count */
+	QList<bool>						m_dateList;						/*!< aggregated field is a date */
+	QString							m_szError;						/*!< last error */
+
+	QThreadStorage<QSharedPointer<cAggregateTable> >	m_local;	/*!< table of the current thread */
+	QMutex							m_tableMutex;					/*!< guards m_tableList */
+	QList<QSharedPointer<cAggregateTable> >	m_tableList;			/*!< tables of all threads */
+
+	/*!
+	 \brief
+
+	 \fn localTable
+	 \return cAggregateTable
+	*/
+	cAggregateTable*				localTable();
+};
+
+#endif // CAGGREGATOR_H
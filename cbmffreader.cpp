@@ -0,0 +1,762 @@
+/*!
+ \file cbmffreader.cpp
+
+*/
+
+#include "cbmffreader.h"
+#include "cifdview.h"
+
+#include <QFileInfo>
+#include <QStringList>
+#include <QtEndian>
+
+#include <climits>
+#include <cstring>
+
+
+#define FOURCC(a, b, c, d)	((static_cast<quint32>(a) << 24) | (static_cast<quint32>(b) << 16) | (static_cast<quint32>(c) << 8) | static_cast<quint32>(d))
+
+#define MAX_BOXES			256
+#define MAX_META			(4 * 1024 * 1024)
+#define MAX_EXIF			(4 * 1024 * 1024)
+#define MAX_PREVIEW			(1024 * 1024)
+
+#define IFD_IFD0			1
+#define IFD_EXIF			5
+#define IFD_GPS				6
+
+
+/*!
+ \brief Canon's uuid of the metadata box in moov of CR3 files.
+*/
+static const uchar	canonUUID[16]	= { 0x85, 0xc0, 0xb6, 0x87, 0x82, 0x0f, 0x11, 0xe0, 0x81, 0x11, 0xf4, 0xce, 0x46, 0x2b, 0x6a, 0x48 };
+
+/*!
+ \brief uuid of the top level XMP box of CR3 files.
+*/
+static const uchar	xmpUUID[16]		= { 0xbe, 0x7a, 0xcf, 0xcb, 0x97, 0xa9, 0x42, 0xe8, 0x9c, 0x71, 0x99, 0x94, 0x91, 0xe3, 0xaf, 0xac };
+
+/*!
+ \brief Reads a big endian number of iBytes bytes (0, 1, 2, 4 or 8) at iPos and advances iPos.
+
+ \fn readValue
+ \param lpData
+ \param iSize
+ \param iPos
+ \param iBytes
+ \param iValue 0 if iBytes is 0
+ \return bool false if the number is outside of lpData
+*/
+static bool readValue(const uchar* lpData, qint64 iSize, qint64& iPos, qint32 iBytes, quint64& iValue)
+{
+	if(iPos + iBytes > iSize)
+		return(false);
+
+	switch(iBytes)
+	{
+	case 0:
+		iValue	= 0;
+		break;
+	case 1:
+		iValue	= lpData[iPos];
+		break;
+	case 2:
+		iValue	= qFromBigEndian<quint16>(lpData + iPos);
+		break;
+	case 4:
+		iValue	= qFromBigEndian<quint32>(lpData + iPos);
+		break;
+	case 8:
+		iValue	= qFromBigEndian<quint64>(lpData + iPos);
+		break;
+	default:
+		return(false);
+	}
+
+	iPos	+= iBytes;
+	return(true);
+}
+
+/*!
+ \brief One extent of an item in iloc.
+
+ \class cBMFFExtent
+*/
+class cBMFFExtent
+{
+public:
+	quint64		m_iOffset;					/*!< offset in the file, or in idat */
+	quint64		m_iLength;					/*!< 0 means up to the end of the file */
+};
+
+cBMFFReader::cBMFFReader() :
+	m_lpData(nullptr),
+	m_iDataSize(0),
+	m_bComplete(false),
+	m_iBytesRead(0),
+	m_iWidth(0),
+	m_iHeight(0),
+	m_iPreviewWidth(0),
+	m_iPreviewHeight(0)
+{
+}
+
+void cBMFFReader::clear()
+{
+	if(m_file.isOpen())
+		m_file.close();
+
+	m_szFileName.clear();
+	m_lpData			= nullptr;
+	m_iDataSize			= 0;
+	m_bComplete			= false;
+	m_iBytesRead		= 0;
+	m_exifList.clear();
+	m_iWidth			= 0;
+	m_iHeight			= 0;
+	m_previewData.clear();
+	m_iPreviewWidth		= 0;
+	m_iPreviewHeight	= 0;
+	m_xmpData.clear();
+}
+
+bool cBMFFReader::read(const QString& szFileName, const uchar* lpData, qint64 iSize, bool bComplete, bool bPreview, bool bXMP, bool bMakerNote)
+{
+	clear();
+
+	m_szFileName	= szFileName;
+	m_lpData		= lpData;
+	m_iDataSize		= lpData ? iSize : 0;
+	m_bComplete		= lpData && bComplete;
+
+	uchar	header[64];
+	qint64	iHeader	= sizeof(header);
+
+	// files shorter than the header buffer
+	if(m_bComplete)
+		iHeader	= qMin(iHeader, m_iDataSize);
+	else if(m_iDataSize < iHeader && fileSize() >= 0)
+		iHeader	= qMin(iHeader, fileSize());
+
+	if(iHeader < 16 || !readAt(0, iHeader, header) || !isBMFF(header, iHeader))
+	{
+		clear();
+		return(false);
+	}
+
+	qint64	iPos	= 0;
+	bool	bMOOV	= false;
+
+	for(int x = 0;x < MAX_BOXES;x++)
+	{
+		cBMFFBox	box;
+
+		if(!fileBox(iPos, -1, box))
+			break;
+
+		if(box.m_iType == FOURCC('m', 'e', 't', 'a'))
+		{
+			// HEIF: the item tables are small, the items themselves are read by their extents
+			if(box.m_iSize <= MAX_META && readAt(box.m_iOffset, box.m_iSize, m_buffer))
+				parseMeta(reinterpret_cast<const uchar*>(m_buffer.constData()), m_buffer.size(), bXMP);
+			break;
+		}
+
+		// CR3: the XMP box follows moov, the image data comes after it
+		if(bMOOV && box.m_iType == FOURCC('m', 'd', 'a', 't'))
+			break;
+
+		if(bMOOV && box.m_iType == FOURCC('u', 'u', 'i', 'd') && box.m_iSize > 16)
+		{
+			uchar	uuid[16];
+
+			if(readAt(box.m_iOffset, 16, uuid) && !memcmp(uuid, xmpUUID, 16))
+			{
+				if(box.m_iSize - 16 <= MAX_EXIF && !readAt(box.m_iOffset + 16, box.m_iSize - 16, m_xmpData))
+					m_xmpData.clear();
+				break;
+			}
+		}
+
+		if(box.m_iType == FOURCC('m', 'o', 'o', 'v'))
+		{
+			// CR3: only the Canon box is read, the track boxes are skipped
+			qint64	iEnd		= box.m_iOffset + box.m_iSize;
+			qint64	iChild		= box.m_iOffset;
+			uchar	uuid[16];
+
+			for(int y = 0;y < MAX_BOXES;y++)
+			{
+				cBMFFBox	child;
+
+				if(!fileBox(iChild, iEnd, child))
+					break;
+
+				if(child.m_iType == FOURCC('u', 'u', 'i', 'd') && child.m_iSize >= 16 && readAt(child.m_iOffset, 16, uuid) && !memcmp(uuid, canonUUID, 16))
+				{
+					child.m_iOffset	+= 16;
+					child.m_iSize	-= 16;
+					parseCanon(child, bPreview, bMakerNote);
+					break;
+				}
+				iChild	= child.m_iOffset + child.m_iSize;
+			}
+
+			if(!bXMP)
+				break;
+			bMOOV	= true;
+		}
+
+		// mdat and everything else is skipped
+		iPos	= box.m_iOffset + box.m_iSize;
+	}
+
+	if(m_file.isOpen())
+		m_file.close();
+
+	return(!m_exifList.isEmpty());
+}
+
+const QList<cBMFFExif>& cBMFFReader::exifList()
+{
+	return(m_exifList);
+}
+
+qint32 cBMFFReader::width()
+{
+	return(m_iWidth);
+}
+
+qint32 cBMFFReader::height()
+{
+	return(m_iHeight);
+}
+
+QByteArray cBMFFReader::previewData()
+{
+	return(m_previewData);
+}
+
+qint32 cBMFFReader::previewWidth()
+{
+	return(m_iPreviewWidth);
+}
+
+qint32 cBMFFReader::previewHeight()
+{
+	return(m_iPreviewHeight);
+}
+
+QByteArray cBMFFReader::xmpData()
+{
+	return(m_xmpData);
+}
+
+qint64 cBMFFReader::bytesRead()
+{
+	return(m_iBytesRead);
+}
+
+bool cBMFFReader::isBMFF(const uchar* lpData, qint64 iSize)
+{
+	if(!lpData || iSize < 16 || memcmp(lpData + 4, "ftyp", 4))
+		return(false);
+
+	static const char*	szBrandList[]	= { "heic", "heix", "heim", "heis", "hevc", "hevx", "mif1", "msf1", "avif", "avis", "crx ", nullptr };
+	qint64				iBoxSize		= qMin<qint64>(qFromBigEndian<quint32>(lpData), iSize);
+
+	// the major brand at 8, the compatible brands from 16 on
+	for(qint64 iPos = 8;iPos + 4 <= iBoxSize;iPos += (iPos == 8 ? 8 : 4))
+	{
+		for(int x = 0;szBrandList[x];x++)
+		{
+			if(!memcmp(lpData + iPos, szBrandList[x], 4))
+				return(true);
+		}
+	}
+	return(false);
+}
+
+bool cBMFFReader::isBMFFName(const QString& szFileName)
+{
+	static const QStringList	szSuffixList	= QStringList() << "heic" << "heif" << "hif" << "avif" << "cr3";
+
+	return(szSuffixList.contains(QFileInfo(szFileName).suffix().toLower()));
+}
+
+bool cBMFFReader::readAt(qint64 iOffset, qint64 iSize, uchar* lpDest)
+{
+	if(iOffset < 0 || iSize < 0)
+		return(false);
+
+	m_iBytesRead	+= iSize;
+
+	if(m_lpData && iOffset + iSize <= m_iDataSize)
+	{
+		memcpy(lpDest, m_lpData + iOffset, static_cast<size_t>(iSize));
+		return(true);
+	}
+
+	// beyond the end of a complete buffer is beyond the end of the file
+	if(m_bComplete || m_szFileName.isEmpty())
+		return(false);
+
+	if(!m_file.isOpen())
+	{
+		m_file.setFileName(m_szFileName);
+		if(!m_file.open(QIODevice::ReadOnly))
+			return(false);
+	}
+
+	if(!m_file.seek(iOffset))
+		return(false);
+	return(m_file.read(reinterpret_cast<char*>(lpDest), iSize) == iSize);
+}
+
+bool cBMFFReader::readAt(qint64 iOffset, qint64 iSize, QByteArray& data)
+{
+	if(iSize < 0 || iSize > INT_MAX)
+		return(false);
+
+	data.resize(static_cast<int>(iSize));
+	return(readAt(iOffset, iSize, reinterpret_cast<uchar*>(data.data())));
+}
+
+qint64 cBMFFReader::fileSize()
+{
+	if(m_bComplete)
+		return(m_iDataSize);
+
+	if(m_szFileName.isEmpty())
+		return(-1);
+
+	if(!m_file.isOpen())
+	{
+		m_file.setFileName(m_szFileName);
+		if(!m_file.open(QIODevice::ReadOnly))
+			return(-1);
+	}
+	return(m_file.size());
+}
+
+bool cBMFFReader::fileBox(qint64 iPos, qint64 iEnd, cBMFFBox& box)
+{
+	uchar	header[16];
+
+	if(iEnd >= 0 && iPos + 8 > iEnd)
+		return(false);
+
+	if(!readAt(iPos, 8, header))
+		return(false);
+
+	quint64	iBoxSize	= qFromBigEndian<quint32>(header);
+	qint64	iHeader		= 8;
+
+	box.m_iType	= qFromBigEndian<quint32>(header + 4);
+
+	if(iBoxSize == 1)
+	{
+		if(!readAt(iPos + 8, 8, header + 8))
+			return(false);
+		iBoxSize	= qFromBigEndian<quint64>(header + 8);
+		iHeader		= 16;
+	}
+	else if(iBoxSize == 0)
+	{
+		// the last box, up to the end of the parent or the file
+		qint64	iLast	= iEnd >= 0 ? iEnd : fileSize();
+
+		if(iLast < iPos + iHeader)
+			return(false);
+		iBoxSize	= static_cast<quint64>(iLast - iPos);
+	}
+
+	if(iBoxSize < static_cast<quint64>(iHeader) || iBoxSize > static_cast<quint64>(Q_INT64_C(0x7fffffffffffffff) - iPos))
+		return(false);
+	if(iEnd >= 0 && iPos + static_cast<qint64>(iBoxSize) > iEnd)
+		return(false);
+
+	box.m_iOffset	= iPos + iHeader;
+	box.m_iSize		= static_cast<qint64>(iBoxSize) - iHeader;
+	return(true);
+}
+
+bool cBMFFReader::memoryBox(const uchar* lpData, qint64 iSize, qint64 iPos, cBMFFBox& box)
+{
+	if(iPos + 8 > iSize)
+		return(false);
+
+	quint64	iBoxSize	= qFromBigEndian<quint32>(lpData + iPos);
+	qint64	iHeader		= 8;
+
+	box.m_iType	= qFromBigEndian<quint32>(lpData + iPos + 4);
+
+	if(iBoxSize == 1)
+	{
+		if(iPos + 16 > iSize)
+			return(false);
+		iBoxSize	= qFromBigEndian<quint64>(lpData + iPos + 8);
+		iHeader		= 16;
+	}
+	else if(iBoxSize == 0)
+		iBoxSize	= static_cast<quint64>(iSize - iPos);
+
+	if(iBoxSize < static_cast<quint64>(iHeader) || iBoxSize > static_cast<quint64>(iSize - iPos))
+		return(false);
+
+	box.m_iOffset	= iPos + iHeader;
+	box.m_iSize		= static_cast<qint64>(iBoxSize) - iHeader;
+	return(true);
+}
+
+bool cBMFFReader::parseMeta(const uchar* lpData, qint64 iSize, bool bXMP)
+{
+	cBMFFBox	iinf	= { 0, 0, -1 };
+	cBMFFBox	iloc	= { 0, 0, -1 };
+	cBMFFBox	iprp	= { 0, 0, -1 };
+	cBMFFBox	idat	= { 0, 0, -1 };
+	quint64		iPrimary	= 0;
+
+	// meta is a full box, version and flags come first
+	qint64		iPos	= 4;
+
+	for(int x = 0;x < MAX_BOXES;x++)
+	{
+		cBMFFBox	box;
+
+		if(!memoryBox(lpData, iSize, iPos, box))
+			break;
+
+		switch(box.m_iType)
+		{
+		case FOURCC('p', 'i', 't', 'm'):
+		{
+			qint64	iItem	= box.m_iOffset + 4;
+
+			if(box.m_iSize >= 4)
+				readValue(lpData, box.m_iOffset + box.m_iSize, iItem, lpData[box.m_iOffset] ? 4 : 2, iPrimary);
+			break;
+		}
+		case FOURCC('i', 'i', 'n', 'f'):
+			iinf	= box;
+			break;
+		case FOURCC('i', 'l', 'o', 'c'):
+			iloc	= box;
+			break;
+		case FOURCC('i', 'p', 'r', 'p'):
+			iprp	= box;
+			break;
+		case FOURCC('i', 'd', 'a', 't'):
+			idat	= box;
+			break;
+		default:
+			break;
+		}
+		iPos	= box.m_iOffset + box.m_iSize;
+	}
+
+	if(iinf.m_iSize < 4 || iloc.m_iSize < 4)
+		return(false);
+
+	// item ids of the Exif items and the XMP packets
+	QList<quint64>	exifItemList;
+	QList<quint64>	xmpItemList;
+	qint64			iEnd		= iinf.m_iOffset + iinf.m_iSize;
+	quint64			iEntries;
+
+	iPos	= iinf.m_iOffset + 4;
+	if(!readValue(lpData, iEnd, iPos, lpData[iinf.m_iOffset] ? 4 : 2, iEntries))
+		return(false);
+
+	for(quint64 x = 0;x < iEntries && x < MAX_BOXES;x++)
+	{
+		cBMFFBox	infe;
+
+		if(!memoryBox(lpData, iEnd, iPos, infe))
+			break;
+		iPos	= infe.m_iOffset + infe.m_iSize;
+
+		// only version 2 and 3 have an item type
+		qint64	iInfe		= infe.m_iOffset;
+		quint8	iVersion	= infe.m_iSize >= 4 ? lpData[iInfe] : 0;
+		quint64	iItem;
+		quint64	iProtection;
+		quint64	iType;
+
+		if(infe.m_iType != FOURCC('i', 'n', 'f', 'e') || iVersion < 2)
+			continue;
+
+		iInfe	+= 4;
+		if(!readValue(lpData, iPos, iInfe, iVersion == 2 ? 2 : 4, iItem) || !readValue(lpData, iPos, iInfe, 2, iProtection) || !readValue(lpData, iPos, iInfe, 4, iType))
+			continue;
+
+		if(iType == FOURCC('E', 'x', 'i', 'f'))
+			exifItemList.append(iItem);
+		else if(bXMP && iType == FOURCC('m', 'i', 'm', 'e'))
+		{
+			// item name and content type, both 0 terminated
+			const char*	lpName	= reinterpret_cast<const char*>(lpData + iInfe);
+			const char*	lpNameEnd	= static_cast<const char*>(memchr(lpName, 0, static_cast<size_t>(iPos - iInfe)));
+
+			if(lpNameEnd && reinterpret_cast<const uchar*>(lpNameEnd) + 21 <= lpData + iPos && !memcmp(lpNameEnd + 1, "application/rdf+xml", 20))
+				xmpItemList.append(iItem);
+		}
+	}
+
+	// extents of the Exif items
+	quint64	iVersion		= lpData[iloc.m_iOffset];
+	quint64	iSizes;
+	quint64	iIndexSizes;
+	quint64	iItems;
+
+	iEnd	= iloc.m_iOffset + iloc.m_iSize;
+	iPos	= iloc.m_iOffset + 4;
+
+	if(iVersion > 2 || !readValue(lpData, iEnd, iPos, 1, iSizes) || !readValue(lpData, iEnd, iPos, 1, iIndexSizes) || !readValue(lpData, iEnd, iPos, iVersion < 2 ? 2 : 4, iItems))
+		return(false);
+
+	qint32	iOffsetSize		= static_cast<qint32>(iSizes >> 4);
+	qint32	iLengthSize		= static_cast<qint32>(iSizes & 0x0f);
+	qint32	iBaseSize		= static_cast<qint32>(iIndexSizes >> 4);
+	qint32	iIndexSize		= (iVersion == 1 || iVersion == 2) ? static_cast<qint32>(iIndexSizes & 0x0f) : 0;
+
+	for(quint64 x = 0;x < iItems && (!exifItemList.isEmpty() || !xmpItemList.isEmpty());x++)
+	{
+		quint64				iItem;
+		quint64				iMethod		= 0;
+		quint64				iReference;
+		quint64				iBase;
+		quint64				iExtents;
+		QList<cBMFFExtent>	extentList;
+
+		if(!readValue(lpData, iEnd, iPos, iVersion < 2 ? 2 : 4, iItem))
+			return(false);
+		if((iVersion == 1 || iVersion == 2) && !readValue(lpData, iEnd, iPos, 2, iMethod))
+			return(false);
+		if(!readValue(lpData, iEnd, iPos, 2, iReference) || !readValue(lpData, iEnd, iPos, iBaseSize, iBase) || !readValue(lpData, iEnd, iPos, 2, iExtents))
+			return(false);
+
+		for(quint64 y = 0;y < iExtents;y++)
+		{
+			cBMFFExtent	extent;
+			quint64		iIndex;
+
+			if(!readValue(lpData, iEnd, iPos, iIndexSize, iIndex) || !readValue(lpData, iEnd, iPos, iOffsetSize, extent.m_iOffset) || !readValue(lpData, iEnd, iPos, iLengthSize, extent.m_iLength))
+				return(false);
+
+			extent.m_iOffset	+= iBase;
+			extentList.append(extent);
+		}
+
+		// items in other files or built from other items are not supported
+		iMethod	&= 0x0f;
+		if((!exifItemList.contains(iItem) && !xmpItemList.contains(iItem)) || iReference || iMethod > 1)
+			continue;
+
+		QByteArray	data;
+		QByteArray	extentData;
+		bool		bOK		= !extentList.isEmpty();
+
+		for(int y = 0;y < extentList.count() && bOK;y++)
+		{
+			const cBMFFExtent&	extent	= extentList.at(y);
+			quint64				iLength	= extent.m_iLength;
+
+			if(iMethod == 1)
+			{
+				// stored in idat of the meta box, which is already in memory
+				quint64	iIDATSize	= static_cast<quint64>(qMax<qint64>(idat.m_iSize, 0));
+
+				if(!iLength && extent.m_iOffset <= iIDATSize)
+					iLength	= iIDATSize - extent.m_iOffset;
+				if(extent.m_iOffset > iIDATSize || iLength > iIDATSize - extent.m_iOffset || data.size() + iLength > MAX_EXIF)
+					bOK	= false;
+				else
+					data.append(reinterpret_cast<const char*>(lpData + idat.m_iOffset + extent.m_iOffset), static_cast<int>(iLength));
+				continue;
+			}
+
+			if(!iLength && fileSize() >= 0 && extent.m_iOffset <= static_cast<quint64>(fileSize()))
+				iLength	= static_cast<quint64>(fileSize()) - extent.m_iOffset;
+			if(!iLength || iLength > MAX_EXIF || data.size() + iLength > MAX_EXIF || !readAt(static_cast<qint64>(extent.m_iOffset), static_cast<qint64>(iLength), extentData))
+				bOK	= false;
+			else
+				data.append(extentData);
+		}
+
+		if(!bOK)
+			continue;
+
+		if(exifItemList.removeOne(iItem))
+			addExifItem(data);
+		else if(xmpItemList.removeOne(iItem) && m_xmpData.isEmpty())
+			m_xmpData	= data;
+	}
+
+	if(iprp.m_iSize < 0 || !iPrimary)
+		return(true);
+
+	// size of the primary item: the ispe property associated with it in ipma
+	QList<cBMFFBox>	propertyList;
+	cBMFFBox		ipma	= { 0, 0, -1 };
+
+	iEnd	= iprp.m_iOffset + iprp.m_iSize;
+	iPos	= iprp.m_iOffset;
+
+	for(int x = 0;x < MAX_BOXES;x++)
+	{
+		cBMFFBox	box;
+
+		if(!memoryBox(lpData, iEnd, iPos, box))
+			break;
+		iPos	= box.m_iOffset + box.m_iSize;
+
+		if(box.m_iType == FOURCC('i', 'p', 'm', 'a'))
+			ipma	= box;
+		else if(box.m_iType == FOURCC('i', 'p', 'c', 'o'))
+		{
+			qint64	iProperty	= box.m_iOffset;
+			qint64	iPropertyEnd	= box.m_iOffset + box.m_iSize;
+
+			for(int y = 0;y < MAX_BOXES;y++)
+			{
+				cBMFFBox	property;
+
+				if(!memoryBox(lpData, iPropertyEnd, iProperty, property))
+					break;
+				propertyList.append(property);
+				iProperty	= property.m_iOffset + property.m_iSize;
+			}
+		}
+	}
+
+	if(ipma.m_iSize < 8)
+		return(true);
+
+	quint8	iIPMAVersion	= lpData[ipma.m_iOffset];
+	bool	bLargeIndex		= lpData[ipma.m_iOffset + 3] & 1;
+
+	iEnd	= ipma.m_iOffset + ipma.m_iSize;
+	iPos	= ipma.m_iOffset + 4;
+
+	if(!readValue(lpData, iEnd, iPos, 4, iEntries))
+		return(true);
+
+	for(quint64 x = 0;x < iEntries;x++)
+	{
+		quint64	iItem;
+		quint64	iAssociations;
+
+		if(!readValue(lpData, iEnd, iPos, iIPMAVersion < 1 ? 2 : 4, iItem) || !readValue(lpData, iEnd, iPos, 1, iAssociations))
+			break;
+
+		for(quint64 y = 0;y < iAssociations;y++)
+		{
+			quint64	iIndex;
+
+			if(!readValue(lpData, iEnd, iPos, bLargeIndex ? 2 : 1, iIndex))
+				return(true);
+
+			// the top bit marks essential properties, indexes start at 1
+			iIndex	&= bLargeIndex ? 0x7fff : 0x7f;
+
+			if(iItem != iPrimary || !iIndex || iIndex > static_cast<quint64>(propertyList.count()))
+				continue;
+
+			const cBMFFBox&	property	= propertyList.at(static_cast<int>(iIndex - 1));
+
+			if(property.m_iType == FOURCC('i', 's', 'p', 'e') && property.m_iSize >= 12)
+			{
+				m_iWidth	= static_cast<qint32>(qFromBigEndian<quint32>(lpData + property.m_iOffset + 4));
+				m_iHeight	= static_cast<qint32>(qFromBigEndian<quint32>(lpData + property.m_iOffset + 8));
+			}
+		}
+	}
+
+	return(true);
+}
+
+bool cBMFFReader::parseCanon(const cBMFFBox& box, bool bPreview, bool bMakerNote)
+{
+	qint64	iEnd	= box.m_iOffset + box.m_iSize;
+	qint64	iPos	= box.m_iOffset;
+
+	for(int x = 0;x < MAX_BOXES;x++)
+	{
+		cBMFFBox	child;
+		qint32		iIFD	= 0;
+
+		if(!fileBox(iPos, iEnd, child))
+			break;
+		iPos	= child.m_iOffset + child.m_iSize;
+
+		if(child.m_iType == FOURCC('C', 'M', 'T', '1'))
+			iIFD	= IFD_IFD0;
+		else if(child.m_iType == FOURCC('C', 'M', 'T', '2'))
+			iIFD	= IFD_EXIF;
+		else if(bMakerNote && child.m_iType == FOURCC('C', 'M', 'T', '3'))
+			iIFD	= IFD_MAKERNOTE_CANON;
+		else if(child.m_iType == FOURCC('C', 'M', 'T', '4'))
+			iIFD	= IFD_GPS;
+
+		if(iIFD && child.m_iSize <= MAX_EXIF)
+		{
+			cBMFFExif	exif;
+
+			exif.m_iIFD	= iIFD;
+			if(readAt(child.m_iOffset, child.m_iSize, exif.m_data))
+				m_exifList.append(exif);
+			continue;
+		}
+
+		// version and flags, width, height, size of the JPEG data, 4 unknown bytes, JPEG data
+		if(bPreview && child.m_iType == FOURCC('T', 'H', 'M', 'B') && child.m_iSize > 16)
+		{
+			uchar	header[16];
+
+			if(!readAt(child.m_iOffset, 16, header))
+				continue;
+
+			qint64	iJPEGSize	= qFromBigEndian<quint32>(header + 8);
+
+			if(iJPEGSize < 4 || iJPEGSize > child.m_iSize - 16 || iJPEGSize > MAX_PREVIEW || !readAt(child.m_iOffset + 16, iJPEGSize, m_previewData))
+			{
+				m_previewData.clear();
+				continue;
+			}
+
+			if(static_cast<uchar>(m_previewData.at(0)) != 0xff || static_cast<uchar>(m_previewData.at(1)) != 0xd8)
+			{
+				m_previewData.clear();
+				continue;
+			}
+			m_iPreviewWidth		= qFromBigEndian<quint16>(header + 4);
+			m_iPreviewHeight	= qFromBigEndian<quint16>(header + 6);
+		}
+	}
+
+	return(!m_exifList.isEmpty());
+}
+
+bool cBMFFReader::addExifItem(const QByteArray& data)
+{
+	if(data.size() < 4)
+		return(false);
+
+	const uchar*	lpData	= reinterpret_cast<const uchar*>(data.constData());
+	qint64			iTIFF	= 4 + static_cast<qint64>(qFromBigEndian<quint32>(lpData));
+
+	// some writers leave the offset at 0 and still start with the JPEG APP1 identifier
+	if(iTIFF + 6 <= data.size() && !memcmp(lpData + iTIFF, "Exif\0\0", 6))
+		iTIFF	+= 6;
+
+	if(iTIFF + 8 > data.size())
+		return(false);
+
+	cBMFFExif	exif;
+
+	exif.m_data	= data.mid(static_cast<int>(iTIFF));
+	exif.m_iIFD	= IFD_IFD0;
+	m_exifList.append(exif);
+	return(true);
+}
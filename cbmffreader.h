@@ -0,0 +1,255 @@
+/*!
+ \file cbmffreader.h
+
+*/
+
+#ifndef CBMFFREADER_H
+#define CBMFFREADER_H
+
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QFile>
+
+
+/*!
+ \brief One TIFF structure with EXIF tags found in a BMFF file.
+
+ \class cBMFFExif cbmffreader.h "cbmffreader.h"
+*/
+class cBMFFExif
+{
+public:
+	QByteArray	m_data;						/*!< starts with the TIFF header */
+	qint32		m_iIFD;						/*!< IFD id of the first IFD, numbered like Exiv2::IfdId, or IFD_MAKERNOTE_CANON */
+};
+
+/*!
+ \brief Position of a box in a BMFF file or buffer.
+
+ \class cBMFFBox cbmffreader.h "cbmffreader.h"
+*/
+class cBMFFBox
+{
+public:
+	quint32		m_iType;					/*!< four character code, big endian */
+	qint64		m_iOffset;					/*!< start of the payload */
+	qint64		m_iSize;					/*!< size of the payload */
+};
+
+/*!
+ \brief Reads the EXIF metadata of ISO base media files (HEIF, HEIC, AVIF and Canon CR3).
+
+ Only the boxes on the way to the metadata are read, everything else is
+ skipped by its size without touching its content:
+
+ HEIF and AVIF: meta/iinf names the Exif item, meta/iloc gives its extents
+ in the file and meta/iprp holds the size (ispe) of the primary item.
+
+ CR3: the Canon uuid box in moov holds complete TIFF structures for IFD0
+ (CMT1), the Exif IFD (CMT2), the maker note (CMT3) and the GPS IFD (CMT4)
+ and the thumbnail (THMB). The XMP packet is in a uuid box after moov.
+
+ The data comes from a buffer (e.g. the prefix read by cFileInput); parts
+ outside of the buffer are read from the file.
+
+ \class cBMFFReader cbmffreader.h "cbmffreader.h"
+*/
+class cBMFFReader
+{
+public:
+	cBMFFReader();
+
+	/*!
+	 \brief Reads the metadata of a file.
+
+	 \fn read
+	 \param szFileName file to read the parts outside of lpData from, may be empty if bComplete is true
+	 \param lpData first bytes of the file, or nullptr
+	 \param iSize size of lpData
+	 \param bComplete lpData holds the whole file
+	 \param bPreview also extract the embedded thumbnail
+	 \param bXMP also extract the XMP packet
+	 \param bMakerNote also extract the Canon maker note (CMT3)
+	 \return bool false if the file is not BMFF or contains no EXIF metadata
+	*/
+	bool					read(const QString& szFileName, const uchar* lpData, qint64 iSize, bool bComplete, bool bPreview, bool bXMP, bool bMakerNote);
+	/*!
+	 \brief
+
+	 \fn clear
+	*/
+	void					clear();
+
+	/*!
+	 \brief
+
+	 \fn exifList
+	 \return QList<cBMFFExif>
+	*/
+	const QList<cBMFFExif>&	exifList();
+	/*!
+	 \brief Width of the primary image, 0 if the file does not say.
+
+	 \fn width
+	 \return qint32
+	*/
+	qint32					width();
+	/*!
+	 \brief
+
+	 \fn height
+	 \return qint32
+	*/
+	qint32					height();
+	/*!
+	 \brief JPEG thumbnail if read() was asked for it, empty if there is none.
+
+	 \fn previewData
+	 \return QByteArray
+	*/
+	QByteArray				previewData();
+	/*!
+	 \brief
+
+	 \fn previewWidth
+	 \return qint32
+	*/
+	qint32					previewWidth();
+	/*!
+	 \brief
+
+	 \fn previewHeight
+	 \return qint32
+	*/
+	qint32					previewHeight();
+	/*!
+	 \brief XMP packet if read() was asked for it, empty if there is none.
+
+	 \fn xmpData
+	 \return QByteArray
+	*/
+	QByteArray				xmpData();
+	/*!
+	 \brief Number of bytes of the file looked at by the last read().
+
+	 \fn bytesRead
+	 \return qint64
+	*/
+	qint64					bytesRead();
+
+	/*!
+	 \brief Checks the ftyp box at the start of the data for a HEIF, AVIF or CR3 brand.
+
+	 \fn isBMFF
+	 \param lpData
+	 \param iSize
+	 \return bool
+	*/
+	static bool				isBMFF(const uchar* lpData, qint64 iSize);
+	/*!
+	 \brief Checks the extension of szFileName.
+
+	 \fn isBMFFName
+	 \param szFileName
+	 \return bool
+	*/
+	static bool				isBMFFName(const QString& szFileName);
+
+private:
+	QString					m_szFileName;					/*!< file of the data */
+	const uchar*			m_lpData;						/*!< first bytes of the file, or nullptr */
+	qint64					m_iDataSize;					/*!< size of m_lpData */
+	bool					m_bComplete;					/*!< m_lpData holds the whole file */
+	QFile					m_file;							/*!< opened when a box is outside of m_lpData */
+	qint64					m_iBytesRead;					/*!< bytes looked at */
+	QByteArray				m_buffer;						/*!< meta box, keeps its allocation for the next file */
+	QList<cBMFFExif>		m_exifList;						/*!< EXIF structures found */
+	qint32					m_iWidth;						/*!< width of the primary image */
+	qint32					m_iHeight;						/*!< height of the primary image */
+	QByteArray				m_previewData;					/*!< JPEG thumbnail */
+	qint32					m_iPreviewWidth;				/*!< width of the thumbnail */
+	qint32					m_iPreviewHeight;				/*!< height of the thumbnail */
+	QByteArray				m_xmpData;						/*!< XMP packet */
+
+	/*!
+	 \brief Copies iSize bytes at iOffset of the file into lpDest, from m_lpData if possible.
+
+	 \fn readAt
+	 \param iOffset
+	 \param iSize
+	 \param lpDest
+	 \return bool false if the range is outside of the file
+	*/
+	bool					readAt(qint64 iOffset, qint64 iSize, uchar* lpDest);
+	/*!
+	 \brief
+
+	 \fn readAt
+	 \param iOffset
+	 \param iSize
+	 \param data resized to iSize
+	 \return bool
+	*/
+	bool					readAt(qint64 iOffset, qint64 iSize, QByteArray& data);
+	/*!
+	 \brief Size of the whole file, -1 if it is not known.
+
+	 \fn fileSize
+	 \return qint64
+	*/
+	qint64					fileSize();
+	/*!
+	 \brief Reads the header of the box at iPos of the file.
+
+	 \fn fileBox
+	 \param iPos
+	 \param iEnd end of the parent box, -1 for the top level
+	 \param box
+	 \return bool false at the end of the parent or for a broken header
+	*/
+	bool					fileBox(qint64 iPos, qint64 iEnd, cBMFFBox& box);
+	/*!
+	 \brief Collects the Exif items, their extents and the size of the primary item from the payload of a meta box.
+
+	 \fn parseMeta
+	 \param lpData
+	 \param iSize
+	 \param bXMP also read the XMP item (a mime item of type application/rdf+xml)
+	 \return bool
+	*/
+	bool					parseMeta(const uchar* lpData, qint64 iSize, bool bXMP);
+	/*!
+	 \brief Reads the CMT boxes and the thumbnail of the Canon uuid box of a CR3 file.
+
+	 \fn parseCanon
+	 \param box payload without the uuid
+	 \param bPreview
+	 \param bMakerNote
+	 \return bool
+	*/
+	bool					parseCanon(const cBMFFBox& box, bool bPreview, bool bMakerNote);
+	/*!
+	 \brief Adds the content of an Exif item, which starts with the offset of the TIFF header.
+
+	 \fn addExifItem
+	 \param data
+	 \return bool
+	*/
+	bool					addExifItem(const QByteArray& data);
+
+	/*!
+	 \brief Reads the header of the box at iPos of lpData.
+
+	 \fn memoryBox
+	 \param lpData
+	 \param iSize end of the parent box
+	 \param iPos
+	 \param box m_iOffset is relative to lpData
+	 \return bool
+	*/
+	static bool				memoryBox(const uchar* lpData, qint64 iSize, qint64 iPos, cBMFFBox& box);
+};
+
+#endif // CBMFFREADER_H
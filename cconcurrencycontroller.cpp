@@ -0,0 +1,281 @@
+/*!
+ \file cconcurrencycontroller.cpp
+
+*/
+
+#include "cconcurrencycontroller.h"
+#include "cstatistics.h"
+
+#include <QFile>
+#include <QList>
+#include <QByteArray>
+#include <QMutexLocker>
+
+
+#define INTERVAL_NS			Q_INT64_C(500000000)
+#define MIN_FILES			8
+#define TOLERANCE			0.05
+#define HOLD_INTERVALS		6
+#define CPU_SATURATED		0.9
+#define IOWAIT_HIGH			0.1
+#define QUEUE_DEPTH_STEP	2
+
+
+cConcurrencyController::cConcurrencyController(qint32 iJobs, qint32 iMaxJobs, qint32 iQueueDepth, qint32 iMaxQueueDepth, cApply apply) :
+	m_apply(apply),
+	m_lpStatistics(nullptr),
+	m_iJobs(qMax(1, iJobs)),
+	m_iMaxJobs(qMax(m_iJobs, iMaxJobs)),
+	m_iQueueDepth(qMax(0, iQueueDepth)),
+	m_iMaxQueueDepth(qMax(m_iQueueDepth, iMaxQueueDepth)),
+	m_bRunning(false),
+	m_iActive(0),
+	m_iFiles(0),
+	m_bCPU(false),
+	m_knob(KnobJobs),
+	m_bProbe(false),
+	m_iDirection(1),
+	m_iPrevious(0),
+	m_dBaseline(0),
+	m_iHold(0)
+{
+	m_cpu.m_iBusy	= 0;
+	m_cpu.m_iIOWait	= 0;
+	m_cpu.m_iTotal	= 0;
+}
+
+void cConcurrencyController::setStatistics(cStatistics* lpStatistics)
+{
+	QMutexLocker	locker(&m_mutex);
+
+	m_lpStatistics	= lpStatistics;
+}
+
+void cConcurrencyController::start()
+{
+	QMutexLocker	locker(&m_mutex);
+
+	if(m_bRunning)
+		return;
+
+	m_bRunning	= true;
+	m_timer.start();
+
+	if(!m_bCPU)
+		m_bCPU	= readCPU(m_cpu);
+}
+
+void cConcurrencyController::stop()
+{
+	QMutexLocker	locker(&m_mutex);
+
+	if(!m_bRunning)
+		return;
+
+	m_iActive	+= m_timer.nsecsElapsed();
+	m_bRunning	= false;
+}
+
+void cConcurrencyController::fileDone()
+{
+	QMutexLocker	locker(&m_mutex);
+
+	m_iFiles++;
+
+	if(!m_bRunning)
+		return;
+
+	qint64	iActive	= m_iActive + m_timer.nsecsElapsed();
+
+	if(iActive < INTERVAL_NS || m_iFiles < MIN_FILES)
+		return;
+
+	cCPUTimes	cpu;
+	double		dCPU		= -1;
+	double		dIOWait		= -1;
+
+	if(readCPU(cpu))
+	{
+		if(m_bCPU && cpu.m_iTotal > m_cpu.m_iTotal)
+		{
+			double	dTotal	= static_cast<double>(cpu.m_iTotal - m_cpu.m_iTotal);
+
+			// the iowait counter of Linux may go backwards
+			dCPU	= qMax(0.0, static_cast<double>(cpu.m_iBusy) - static_cast<double>(m_cpu.m_iBusy)) / dTotal;
+			dIOWait	= qMax(0.0, static_cast<double>(cpu.m_iIOWait) - static_cast<double>(m_cpu.m_iIOWait)) / dTotal;
+		}
+		m_cpu	= cpu;
+		m_bCPU	= true;
+	}
+
+	double	dThroughput	= m_iFiles * 1000000000.0 / iActive;
+
+	m_iFiles	= 0;
+	m_iActive	= 0;
+	m_timer.restart();
+
+	decide(dThroughput, dCPU, dIOWait);
+}
+
+qint32 cConcurrencyController::jobs()
+{
+	QMutexLocker	locker(&m_mutex);
+
+	return(m_iJobs);
+}
+
+qint32 cConcurrencyController::maxJobs()
+{
+	QMutexLocker	locker(&m_mutex);
+
+	return(m_iMaxJobs);
+}
+
+qint32 cConcurrencyController::queueDepth()
+{
+	QMutexLocker	locker(&m_mutex);
+
+	return(m_iQueueDepth);
+}
+
+void cConcurrencyController::decide(double dThroughput, double dCPU, double dIOWait)
+{
+	m_szMeasurement	= QString("%1 files/s").arg(dThroughput, 0, 'f', 1);
+	if(dCPU >= 0)
+		m_szMeasurement	+= QString(", cpu %1%, iowait %2%").arg(qRound(dCPU * 100)).arg(qRound(dIOWait * 100));
+
+	if(m_lpStatistics)
+		m_lpStatistics->addCount("adaptive/intervals");
+
+	if(m_iHold > 0)
+	{
+		m_iHold--;
+		return;
+	}
+
+	if(m_bProbe)
+	{
+		bool	bBetter	= dThroughput > m_dBaseline * (1 + TOLERANCE);
+		bool	bWorse	= dThroughput < m_dBaseline * (1 - TOLERANCE);
+
+		m_bProbe	= false;
+
+		// the step helped, go on in the same direction
+		if(bBetter)
+		{
+			m_dBaseline	= dThroughput;
+			if(!step(m_iDirection))
+				hold(HOLD_INTERVALS);
+			return;
+		}
+
+		// a step up has to pay for itself, a step down only must not hurt
+		if(bWorse || m_iDirection > 0)
+		{
+			if(m_knob == KnobQueueDepth && m_iDirection > 0 && bWorse)
+				set(qMax(1, m_iPrevious / 2), "decrease");
+			else
+				set(m_iPrevious, "undo");
+		}
+		hold(HOLD_INTERVALS);
+		return;
+	}
+
+	qint32	iDirection	= 1;
+
+	// more workers only contend for saturated CPUs, more reads in flight only help while waiting for I/O
+	if(m_knob == KnobJobs)
+	{
+		if(dCPU >= CPU_SATURATED && dIOWait < IOWAIT_HIGH)
+			iDirection	= -1;
+	}
+	else if(dIOWait >= 0 && dIOWait < IOWAIT_HIGH)
+		iDirection	= -1;
+
+	m_dBaseline	= dThroughput;
+	if(!step(iDirection) && !step(-iDirection))
+		hold(1);
+}
+
+bool cConcurrencyController::step(qint32 iDirection)
+{
+	qint32	iValue	= (m_knob == KnobJobs) ? m_iJobs : m_iQueueDepth;
+	qint32	iMax	= (m_knob == KnobJobs) ? m_iMaxJobs : m_iMaxQueueDepth;
+	qint32	iStep	= (m_knob == KnobJobs) ? qMax(1, iValue / 4) : QUEUE_DEPTH_STEP;
+	qint32	iNew	= qBound(1, iValue + iDirection * iStep, iMax);
+
+	if(iNew == iValue)
+		return(false);
+
+	m_iPrevious		= iValue;
+	m_iDirection	= iDirection;
+	m_bProbe		= true;
+
+	set(iNew, iDirection > 0 ? "up" : "down");
+	return(true);
+}
+
+void cConcurrencyController::set(qint32 iValue, const QString& szReason)
+{
+	QString	szName;
+	qint32	iOld;
+
+	if(m_knob == KnobJobs)
+	{
+		szName	= "jobs";
+		iOld	= m_iJobs;
+		m_iJobs	= iValue;
+	}
+	else
+	{
+		szName			= "queue depth";
+		iOld			= m_iQueueDepth;
+		m_iQueueDepth	= iValue;
+	}
+
+	m_apply(m_iJobs, m_iQueueDepth);
+
+	if(m_lpStatistics)
+	{
+		m_lpStatistics->addCount("adaptive/" + szReason);
+		m_lpStatistics->log(QString("adaptive: %1: %2 %3 -> %4 (%5)").arg(m_szMeasurement).arg(szName).arg(iOld).arg(iValue).arg(szReason));
+	}
+}
+
+void cConcurrencyController::hold(qint32 iIntervals)
+{
+	m_iHold	= iIntervals;
+
+	if(m_iMaxQueueDepth > 0)
+		m_knob	= (m_knob == KnobJobs) ? KnobQueueDepth : KnobJobs;
+}
+
+bool cConcurrencyController::readCPU(cCPUTimes& times)
+{
+#if defined(Q_OS_LINUX)
+	QFile	file("/proc/stat");
+
+	if(!file.open(QFile::ReadOnly))
+		return(false);
+
+	// cpu user nice system idle iowait irq softirq steal ...
+	QList<QByteArray>	fieldList	= file.readLine().simplified().split(' ');
+
+	if(fieldList.count() < 8 || fieldList.at(0) != "cpu")
+		return(false);
+
+	quint64	iIdle	= fieldList.at(4).toULongLong();
+
+	times.m_iIOWait	= fieldList.at(5).toULongLong();
+	times.m_iTotal	= 0;
+
+	for(int x = 1;x < qMin(fieldList.count(), 9);x++)
+		times.m_iTotal	+= fieldList.at(x).toULongLong();
+
+	times.m_iBusy	= times.m_iTotal - iIdle - times.m_iIOWait;
+	return(true);
+#else
+	Q_UNUSED(times);
+	return(false);
+#endif
+}
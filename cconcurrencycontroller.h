@@ -0,0 +1,196 @@
+/*!
+ \file cconcurrencycontroller.h
+
+*/
+
+#ifndef CCONCURRENCYCONTROLLER_H
+#define CCONCURRENCYCONTROLLER_H
+
+
+#include <QString>
+#include <QMutex>
+#include <QElapsedTimer>
+
+#include <functional>
+
+
+class cStatistics;
+
+/*!
+ \brief CPU time counters of the whole system, from /proc/stat.
+
+ \class cCPUTimes cconcurrencycontroller.h "cconcurrencycontroller.h"
+*/
+class cCPUTimes
+{
+public:
+	quint64		m_iBusy;					/*!< ticks not idle and not waiting for I/O */
+	quint64		m_iIOWait;					/*!< ticks idle with I/O outstanding */
+	quint64		m_iTotal;					/*!< all ticks */
+};
+
+/*!
+ \brief Tunes the number of decode workers and the prefetch queue depth while the scanner runs.
+
+ The files completed are counted over intervals of at least half a second
+ of scanning. After every interval one knob is changed and the throughput
+ of the next interval decides whether the change is kept:
+
+ Workers (hill climbing): a step of a quarter of the current count is
+ tried, upwards unless the CPUs are saturated without I/O wait. A step up
+ that does not raise the throughput by 5% is undone, a step down is kept
+ unless the throughput falls by 5%.
+
+ Queue depth (AIMD): while the system waits for I/O the depth grows by 2,
+ otherwise it shrinks by 2. If the throughput falls after a step up, the
+ depth is halved.
+
+ After a step is undone both knobs are left alone for a few intervals and
+ the other knob is tried next. CPU utilization and I/O wait are those of
+ the whole system (Linux only, elsewhere only the throughput is used).
+ Every change is written to the log of the --stats report.
+
+ \class cConcurrencyController cconcurrencycontroller.h "cconcurrencycontroller.h"
+*/
+class cConcurrencyController
+{
+public:
+	/*!
+	 \brief Called with the new settings, on the thread calling fileDone().
+	*/
+	typedef std::function<void(qint32 iJobs, qint32 iQueueDepth)>	cApply;
+
+	/*!
+	 \brief
+
+	 \fn cConcurrencyController
+	 \param iJobs workers at the start
+	 \param iMaxJobs
+	 \param iQueueDepth queue depth at the start, 0 if there is no prefetcher
+	 \param iMaxQueueDepth
+	 \param apply
+	*/
+	cConcurrencyController(qint32 iJobs, qint32 iMaxJobs, qint32 iQueueDepth, qint32 iMaxQueueDepth, cApply apply);
+
+	/*!
+	 \brief
+
+	 \fn setStatistics
+	 \param lpStatistics
+	*/
+	void					setStatistics(cStatistics* lpStatistics);
+	/*!
+	 \brief Starts measuring, called when the files of a directory are handed to the workers.
+
+	 \fn start
+	*/
+	void					start();
+	/*!
+	 \brief Stops measuring until the next start(), e.g. while the rows of a directory are written.
+
+	 \fn stop
+	*/
+	void					stop();
+	/*!
+	 \brief Counts a completed file and decides at the end of an interval, may be called from any thread.
+
+	 \fn fileDone
+	*/
+	void					fileDone();
+	/*!
+	 \brief
+
+	 \fn jobs
+	 \return qint32
+	*/
+	qint32					jobs();
+	/*!
+	 \brief
+
+	 \fn maxJobs
+	 \return qint32
+	*/
+	qint32					maxJobs();
+	/*!
+	 \brief
+
+	 \fn queueDepth
+	 \return qint32
+	*/
+	qint32					queueDepth();
+
+	/*!
+	 \brief Reads the CPU counters of the system.
+
+	 \fn readCPU
+	 \param times
+	 \return bool false if they are not available
+	*/
+	static bool				readCPU(cCPUTimes& times);
+
+private:
+	/*!
+	 \brief The setting being tuned.
+	*/
+	enum Knob
+	{
+		KnobJobs		= 0,	/*!< number of decode workers */
+		KnobQueueDepth	= 1,	/*!< files prefetched at the same time */
+	};
+
+	QMutex					m_mutex;						/*!< guards all members */
+	cApply					m_apply;						/*!< applies the settings */
+	cStatistics*			m_lpStatistics;					/*!< receives the log, or nullptr */
+	qint32					m_iJobs;						/*!< current number of workers */
+	qint32					m_iMaxJobs;						/*!< upper bound of m_iJobs */
+	qint32					m_iQueueDepth;					/*!< current queue depth, 0 without prefetcher */
+	qint32					m_iMaxQueueDepth;				/*!< upper bound of m_iQueueDepth */
+	bool					m_bRunning;						/*!< between start() and stop() */
+	QElapsedTimer			m_timer;						/*!< time since start() */
+	qint64					m_iActive;						/*!< nanoseconds measured before the last start() */
+	qint64					m_iFiles;						/*!< files completed in the interval */
+	bool					m_bCPU;							/*!< m_cpu is valid */
+	cCPUTimes				m_cpu;							/*!< counters at the start of the interval */
+	Knob					m_knob;							/*!< setting changed by the next step */
+	bool					m_bProbe;						/*!< the last interval ran with a changed setting */
+	qint32					m_iDirection;					/*!< direction of the last step, 1 or -1 */
+	qint32					m_iPrevious;					/*!< setting before the last step */
+	double					m_dBaseline;					/*!< files per second before the last step */
+	qint32					m_iHold;						/*!< intervals left without a change */
+	QString					m_szMeasurement;				/*!< throughput and load of the last interval, for the log */
+
+	/*!
+	 \brief Decides on the next step after an interval.
+
+	 \fn decide
+	 \param dThroughput files per second
+	 \param dCPU busy fraction of all CPUs, -1 if not known
+	 \param dIOWait I/O wait fraction of all CPUs, -1 if not known
+	*/
+	void					decide(double dThroughput, double dCPU, double dIOWait);
+	/*!
+	 \brief Changes the current knob one step in iDirection.
+
+	 \fn step
+	 \param iDirection
+	 \return bool false if the knob is at its bound
+	*/
+	bool					step(qint32 iDirection);
+	/*!
+	 \brief Sets the current knob, applies the settings and logs the change.
+
+	 \fn set
+	 \param iValue
+	 \param szReason
+	*/
+	void					set(qint32 iValue, const QString& szReason);
+	/*!
+	 \brief Leaves the settings alone for iIntervals and tries the other knob next.
+
+	 \fn hold
+	 \param iIntervals
+	*/
+	void					hold(qint32 iIntervals);
+};
+
+#endif // CCONCURRENCYCONTROLLER_H
@@ -0,0 +1,71 @@
+/*!
+ \file ccontenthash.cpp
+
+*/
+
+#include "ccontenthash.h"
+
+#include <QFile>
+#include <QtGlobal>
+#include <QThreadStorage>
+
+#include <xxhash.h>
+
+
+#define HASH_BLOCK_SIZE		(4 * 1024 * 1024)
+#define HASH_ALIGNMENT		4096
+
+
+static QThreadStorage<cContentHash*>	g_contentHash;
+
+
+cContentHash::cContentHash() :
+	m_lpBuffer(static_cast<char*>(qMallocAligned(HASH_BLOCK_SIZE, HASH_ALIGNMENT))),
+	m_lpState(XXH3_createState())
+{
+}
+
+cContentHash::~cContentHash()
+{
+	qFreeAligned(m_lpBuffer);
+	XXH3_freeState(static_cast<XXH3_state_t*>(m_lpState));
+}
+
+QString cContentHash::hashFile(const QString& szFileName)
+{
+	if(!m_lpBuffer || !m_lpState)
+		return("");
+
+	QFile			file(szFileName);
+	XXH3_state_t*	lpState	= static_cast<XXH3_state_t*>(m_lpState);
+
+	if(!file.open(QFile::ReadOnly | QFile::Unbuffered))
+		return("");
+
+	if(XXH3_128bits_reset(lpState) == XXH_ERROR)
+		return("");
+
+	for(;;)
+	{
+		qint64	iRead	= file.read(m_lpBuffer, HASH_BLOCK_SIZE);
+
+		if(iRead < 0)
+			return("");
+		if(iRead == 0)
+			break;
+
+		XXH3_128bits_update(lpState, m_lpBuffer, static_cast<size_t>(iRead));
+	}
+
+	XXH128_hash_t	hash	= XXH3_128bits_digest(lpState);
+
+	return(QString("%1%2").arg(hash.high64, 16, 16, QChar('0')).arg(hash.low64, 16, 16, QChar('0')));
+}
+
+cContentHash* cContentHash::local()
+{
+	if(!g_contentHash.hasLocalData())
+		g_contentHash.setLocalData(new cContentHash);
+
+	return(g_contentHash.localData());
+}
@@ -0,0 +1,49 @@
+/*!
+ \file ccontenthash.h
+
+*/
+
+#ifndef CCONTENTHASH_H
+#define CCONTENTHASH_H
+
+
+#include <QString>
+
+
+/*!
+ \brief 128 bit XXH3 hash of a file's content.
+
+ The file is streamed unbuffered in large blocks into an aligned buffer,
+ xxHash picks the widest SIMD variant available at runtime.
+
+ \class cContentHash ccontenthash.h "ccontenthash.h"
+*/
+class cContentHash
+{
+public:
+	cContentHash();
+	~cContentHash();
+
+	/*!
+	 \brief Hashes the file and returns the hash as 32 hex digits, or an empty string on error.
+
+	 \fn hashFile
+	 \param szFileName
+	 \return QString
+	*/
+	QString				hashFile(const QString& szFileName);
+
+	/*!
+	 \brief Instance owned by the calling thread, so buffer and state are allocated once per thread.
+
+	 \fn local
+	 \return cContentHash
+	*/
+	static cContentHash*	local();
+
+private:
+	char*				m_lpBuffer;					/*!< aligned read buffer, reused for every file */
+	void*				m_lpState;					/*!< XXH3 streaming state, reused for every file */
+};
+
+#endif // CCONTENTHASH_H
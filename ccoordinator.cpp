@@ -0,0 +1,488 @@
+/*!
+ \file ccoordinator.cpp
+
+*/
+
+#include "ccoordinator.h"
+#include "cstatistics.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QProcess>
+
+#include <algorithm>
+
+
+#define TIMEOUT_CHECK_INTERVAL	5000
+#define SHARD_GRANULARITY		4
+
+
+cShard::cShard() :
+	m_iID(-1),
+	m_iEstimate(0),
+	m_iAttempts(0)
+{
+}
+
+cWorkerConnection::cWorkerConnection(QIODevice* lpSocket) :
+	m_lpSocket(lpSocket),
+	m_bAccepted(false),
+	m_iShard(-1),
+	m_lpSpool(nullptr),
+	m_iRows(0)
+{
+	m_lastActivity.start();
+}
+
+cWorkerConnection::~cWorkerConnection()
+{
+	delete m_lpSpool;
+}
+
+cCoordinator::cCoordinator(const QString& szHeader, QTextStream& out, QObject* parent) :
+	QObject(parent),
+	m_szHeader(szHeader),
+	m_out(out),
+	m_iFinished(0),
+	m_iWorkerTimeout(0),
+	m_lpStatistics(nullptr)
+{
+	connect(&m_timeoutTimer, &QTimer::timeout, this, &cCoordinator::onCheckTimeout);
+}
+
+cCoordinator::~cCoordinator()
+{
+	qDeleteAll(m_connectionList);
+	m_connectionList.clear();
+
+	for(int x = 0;x < m_localServerList.count();x++)
+		m_localServerList[x]->close();
+	for(int x = 0;x < m_tcpServerList.count();x++)
+		m_tcpServerList[x]->close();
+
+	for(int x = 0;x < m_processList.count();x++)
+	{
+		if(!m_processList[x]->waitForFinished(5000))
+			m_processList[x]->kill();
+	}
+}
+
+qint32 cCoordinator::plan(const QString& szRoot, qint32 iShards)
+{
+	QHash<QString, qint64>	countList;
+	qint64					iTotal	= countFiles(szRoot, countList);
+	QStringList				itemList;
+	QList<qint64>			estimateList;
+
+	m_shardList.clear();
+	m_pendingList.clear();
+	m_iFinished	= 0;
+
+	if(iShards < 1)
+		iShards	= 1;
+
+	if(!iTotal)
+		return(0);
+
+	// cut the tree finer than the number of shards so the greedy assignment can balance it
+	qint64	iTarget	= qMax(Q_INT64_C(1), iTotal / (iShards * SHARD_GRANULARITY));
+
+	if(iTotal <= iTarget)
+	{
+		itemList.append("r\t" + szRoot);
+		estimateList.append(iTotal);
+	}
+	else
+		splitDirectory(szRoot, iTarget, countList, itemList, estimateList);
+
+	QList<qint32>	orderList;
+
+	for(int x = 0;x < itemList.count();x++)
+		orderList.append(x);
+
+	std::sort(orderList.begin(), orderList.end(), [&estimateList](qint32 i1, qint32 i2) { return(estimateList.at(i1) > estimateList.at(i2)); });
+
+	iShards	= qMin(iShards, itemList.count());
+
+	for(int x = 0;x < iShards;x++)
+	{
+		cShard	shard;
+		shard.m_iID	= x;
+		m_shardList.append(shard);
+	}
+
+	// largest item first into the lightest shard
+	for(int x = 0;x < orderList.count();x++)
+	{
+		qint32	iLightest	= 0;
+
+		for(int y = 1;y < m_shardList.count();y++)
+		{
+			if(m_shardList.at(y).m_iEstimate < m_shardList.at(iLightest).m_iEstimate)
+				iLightest	= y;
+		}
+
+		m_shardList[iLightest].m_itemList.append(itemList.at(orderList.at(x)));
+		m_shardList[iLightest].m_iEstimate	+= estimateList.at(orderList.at(x));
+	}
+
+	for(int x = 0;x < m_shardList.count();x++)
+	{
+		m_pendingList.enqueue(x);
+
+		if(m_lpStatistics)
+			m_lpStatistics->log(QString("shard %1: %2 directories, %3 files estimated").arg(x).arg(m_shardList.at(x).m_itemList.count()).arg(m_shardList.at(x).m_iEstimate));
+	}
+
+	return(m_shardList.count());
+}
+
+bool cCoordinator::listen(const QString& szAddress)
+{
+	if(szAddress.startsWith("local:"))
+	{
+		QString			szName		= szAddress.mid(6);
+		QLocalServer*	lpServer	= new QLocalServer(this);
+
+		QLocalServer::removeServer(szName);
+
+		if(!lpServer->listen(szName))
+		{
+			delete lpServer;
+			return(false);
+		}
+
+		connect(lpServer, &QLocalServer::newConnection, this, &cCoordinator::onNewLocalConnection);
+		m_localServerList.append(lpServer);
+		return(true);
+	}
+
+	if(szAddress.startsWith("tcp:"))
+	{
+		QString		szHostPort	= szAddress.mid(4);
+		qint32		iColon		= szHostPort.lastIndexOf(':');
+
+		if(iColon < 0)
+			return(false);
+
+		QTcpServer*	lpServer	= new QTcpServer(this);
+
+		if(!lpServer->listen(QHostAddress(szHostPort.left(iColon)), static_cast<quint16>(szHostPort.mid(iColon + 1).toUInt())))
+		{
+			delete lpServer;
+			return(false);
+		}
+
+		connect(lpServer, &QTcpServer::newConnection, this, &cCoordinator::onNewTcpConnection);
+		m_tcpServerList.append(lpServer);
+		return(true);
+	}
+
+	return(false);
+}
+
+void cCoordinator::spawn(qint32 iCount, const QString& szAddress, const QStringList& szArguments)
+{
+	for(int x = 0;x < iCount;x++)
+	{
+		QProcess*	lpProcess	= new QProcess(this);
+
+		lpProcess->setStandardOutputFile(QProcess::nullDevice());
+		lpProcess->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+		lpProcess->start(QCoreApplication::applicationFilePath(), QStringList() << "--worker" << szAddress << szArguments);
+
+		m_processList.append(lpProcess);
+	}
+}
+
+void cCoordinator::setWorkerTimeout(qint32 iSeconds)
+{
+	m_iWorkerTimeout	= iSeconds;
+
+	if(m_iWorkerTimeout > 0)
+		m_timeoutTimer.start(TIMEOUT_CHECK_INTERVAL);
+	else
+		m_timeoutTimer.stop();
+}
+
+void cCoordinator::setStatistics(cStatistics* lpStatistics)
+{
+	m_lpStatistics	= lpStatistics;
+}
+
+bool cCoordinator::isFinished()
+{
+	return(m_iFinished >= m_shardList.count());
+}
+
+void cCoordinator::onNewLocalConnection()
+{
+	QLocalServer*	lpServer	= qobject_cast<QLocalServer*>(sender());
+
+	while(lpServer && lpServer->hasPendingConnections())
+	{
+		QLocalSocket*	lpSocket	= lpServer->nextPendingConnection();
+
+		connect(lpSocket, &QLocalSocket::readyRead, this, &cCoordinator::onReadyRead);
+		connect(lpSocket, &QLocalSocket::disconnected, this, &cCoordinator::onDisconnected);
+		addConnection(lpSocket);
+	}
+}
+
+void cCoordinator::onNewTcpConnection()
+{
+	QTcpServer*	lpServer	= qobject_cast<QTcpServer*>(sender());
+
+	while(lpServer && lpServer->hasPendingConnections())
+	{
+		QTcpSocket*	lpSocket	= lpServer->nextPendingConnection();
+
+		connect(lpSocket, &QTcpSocket::readyRead, this, &cCoordinator::onReadyRead);
+		connect(lpSocket, &QTcpSocket::disconnected, this, &cCoordinator::onDisconnected);
+		addConnection(lpSocket);
+	}
+}
+
+void cCoordinator::onReadyRead()
+{
+	QIODevice*			lpSocket		= qobject_cast<QIODevice*>(sender());
+	cWorkerConnection*	lpConnection	= m_connectionList.value(lpSocket, nullptr);
+
+	if(!lpConnection)
+		return;
+
+	while(lpSocket->canReadLine())
+	{
+		QString	szLine	= QString::fromUtf8(lpSocket->readLine());
+
+		szLine.chop(1);
+		lpConnection->m_lastActivity.restart();
+		handleLine(lpConnection, szLine);
+
+		// handleLine() may have dropped the connection
+		if(!m_connectionList.contains(lpSocket))
+			return;
+	}
+}
+
+void cCoordinator::onDisconnected()
+{
+	QIODevice*			lpSocket		= qobject_cast<QIODevice*>(sender());
+	cWorkerConnection*	lpConnection	= m_connectionList.take(lpSocket);
+
+	if(!lpConnection)
+		return;
+
+	releaseShard(lpConnection, "worker disconnected");
+
+	delete lpConnection;
+	lpSocket->deleteLater();
+}
+
+void cCoordinator::onCheckTimeout()
+{
+	QList<cWorkerConnection*>	connectionList	= m_connectionList.values();
+
+	for(int x = 0;x < connectionList.count();x++)
+	{
+		cWorkerConnection*	lpConnection	= connectionList[x];
+
+		if(lpConnection->m_iShard >= 0 && lpConnection->m_lastActivity.elapsed() > m_iWorkerTimeout * Q_INT64_C(1000))
+		{
+			releaseShard(lpConnection, "worker timed out");
+			lpConnection->m_lpSocket->close();
+		}
+	}
+}
+
+void cCoordinator::addConnection(QIODevice* lpSocket)
+{
+	m_connectionList.insert(lpSocket, new cWorkerConnection(lpSocket));
+
+	if(m_lpStatistics)
+		m_lpStatistics->addCount("coordinator/connections");
+}
+
+void cCoordinator::handleLine(cWorkerConnection* lpConnection, const QString& szLine)
+{
+	if(szLine.startsWith("ROW "))
+	{
+		qint32	iTab	= szLine.indexOf('\t', 4);
+
+		if(iTab < 0 || szLine.midRef(4, iTab - 4).toInt() != lpConnection->m_iShard || !lpConnection->m_lpSpool)
+			return;
+
+		lpConnection->m_lpSpool->write(szLine.midRef(iTab + 1).toUtf8());
+		lpConnection->m_lpSpool->write("\n");
+		lpConnection->m_iRows++;
+	}
+	else if(szLine == "CLAIM")
+		assignShard(lpConnection);
+	else if(szLine == "ALIVE")
+	{
+		// onReadyRead() has already reset the idle timeout
+	}
+	else if(szLine.startsWith("FINISHED "))
+	{
+		if(szLine.midRef(9).toInt() == lpConnection->m_iShard)
+			finishShard(lpConnection);
+	}
+	else if(szLine.startsWith("HELLO "))
+	{
+		qint32	iTab	= szLine.indexOf('\t');
+
+		lpConnection->m_szName		= szLine.mid(6, iTab < 0 ? -1 : iTab - 6);
+		lpConnection->m_bAccepted	= (iTab >= 0 && szLine.mid(iTab + 1) == m_szHeader);
+
+		if(!lpConnection->m_bAccepted)
+		{
+			send(lpConnection, "REJECT output columns differ from the coordinator");
+
+			if(m_lpStatistics)
+				m_lpStatistics->log(QString("rejected worker %1: different output columns").arg(lpConnection->m_szName));
+		}
+	}
+}
+
+void cCoordinator::assignShard(cWorkerConnection* lpConnection)
+{
+	if(lpConnection->m_iShard >= 0)
+		return;
+
+	if(!lpConnection->m_bAccepted)
+	{
+		send(lpConnection, "REJECT no valid HELLO received");
+		return;
+	}
+
+	if(m_pendingList.isEmpty())
+	{
+		// shards still running may come back if their worker dies
+		send(lpConnection, isFinished() ? "DONE" : "WAIT");
+		return;
+	}
+
+	qint32	iShard	= m_pendingList.dequeue();
+	cShard&	shard	= m_shardList[iShard];
+
+	lpConnection->m_lpSpool	= new QTemporaryFile(QDir::tempPath() + QDir::separator() + "qtEXIF2File-shard-XXXXXX.tsv");
+	if(!lpConnection->m_lpSpool->open())
+	{
+		delete lpConnection->m_lpSpool;
+		lpConnection->m_lpSpool	= nullptr;
+		m_pendingList.prepend(iShard);
+		send(lpConnection, "WAIT");
+		return;
+	}
+
+	lpConnection->m_iShard	= iShard;
+	lpConnection->m_iRows	= 0;
+	shard.m_iAttempts++;
+
+	send(lpConnection, QString("SHARD %1").arg(iShard));
+	for(int x = 0;x < shard.m_itemList.count();x++)
+		send(lpConnection, "ITEM " + shard.m_itemList.at(x));
+	send(lpConnection, "END");
+
+	if(m_lpStatistics && shard.m_iAttempts > 1)
+		m_lpStatistics->log(QString("shard %1 reassigned to %2 (attempt %3)").arg(iShard).arg(lpConnection->m_szName).arg(shard.m_iAttempts));
+}
+
+void cCoordinator::finishShard(cWorkerConnection* lpConnection)
+{
+	QTemporaryFile*	lpSpool	= lpConnection->m_lpSpool;
+
+	lpSpool->seek(0);
+	while(!lpSpool->atEnd())
+		m_out << QString::fromUtf8(lpSpool->readLine());
+
+	if(m_lpStatistics)
+	{
+		m_lpStatistics->addCount("coordinator/shards finished");
+		m_lpStatistics->addCount("coordinator/rows", lpConnection->m_iRows);
+	}
+
+	delete lpSpool;
+	lpConnection->m_lpSpool	= nullptr;
+	lpConnection->m_iShard	= -1;
+
+	m_iFinished++;
+
+	if(isFinished())
+	{
+		m_out.flush();
+		emit finished();
+	}
+}
+
+void cCoordinator::releaseShard(cWorkerConnection* lpConnection, const QString& szReason)
+{
+	if(lpConnection->m_iShard < 0)
+		return;
+
+	m_pendingList.prepend(lpConnection->m_iShard);
+
+	if(m_lpStatistics)
+	{
+		m_lpStatistics->addCount("coordinator/shards released");
+		m_lpStatistics->log(QString("shard %1 released from %2: %3").arg(lpConnection->m_iShard).arg(lpConnection->m_szName).arg(szReason));
+	}
+
+	delete lpConnection->m_lpSpool;
+	lpConnection->m_lpSpool	= nullptr;
+	lpConnection->m_iShard	= -1;
+}
+
+void cCoordinator::send(cWorkerConnection* lpConnection, const QString& szLine)
+{
+	lpConnection->m_lpSocket->write(szLine.toUtf8());
+	lpConnection->m_lpSocket->write("\n");
+}
+
+qint64 cCoordinator::countFiles(const QString& szPath, QHash<QString, qint64>& countList)
+{
+	QDir		dir(szPath);
+	QStringList	szDirs	= dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+	qint64		iCount	= dir.entryList(QDir::Files).count();
+
+	for(int x = 0;x < szDirs.count();x++)
+		iCount	+= countFiles(szPath + QDir::separator() + szDirs[x], countList);
+
+	countList.insert(szPath, iCount);
+	return(iCount);
+}
+
+void cCoordinator::splitDirectory(const QString& szPath, qint64 iTarget, const QHash<QString, qint64>& countList, QStringList& itemList, QList<qint64>& estimateList)
+{
+	QDir		dir(szPath);
+	QStringList	szDirs	= dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+	qint64		iFiles	= dir.entryList(QDir::Files).count();
+
+	if(iFiles)
+	{
+		itemList.append("n\t" + szPath);
+		estimateList.append(iFiles);
+	}
+
+	for(int x = 0;x < szDirs.count();x++)
+	{
+		QString	szSubPath	= szPath + QDir::separator() + szDirs[x];
+		qint64	iCount		= countList.value(szSubPath);
+
+		if(!iCount)
+			continue;
+
+		if(iCount > iTarget)
+			splitDirectory(szSubPath, iTarget, countList, itemList, estimateList);
+		else
+		{
+			itemList.append("r\t" + szSubPath);
+			estimateList.append(iCount);
+		}
+	}
+}
@@ -0,0 +1,242 @@
+/*!
+ \file ccoordinator.h
+
+*/
+
+#ifndef CCOORDINATOR_H
+#define CCOORDINATOR_H
+
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QMap>
+#include <QHash>
+#include <QQueue>
+#include <QTextStream>
+#include <QTemporaryFile>
+#include <QElapsedTimer>
+#include <QTimer>
+
+
+class QIODevice;
+class QLocalServer;
+class QTcpServer;
+class QProcess;
+class cStatistics;
+
+/*!
+ \brief A set of directories read by one worker.
+
+ Every item is "r\<tab\>path" (directory and all sub directories) or
+ "n\<tab\>path" (only the files of the directory).
+
+ \class cShard ccoordinator.h "ccoordinator.h"
+*/
+class cShard
+{
+public:
+	cShard();
+
+	qint32			m_iID;						/*!< shard number */
+	QStringList		m_itemList;					/*!< directories of the shard */
+	qint64			m_iEstimate;				/*!< estimated number of files */
+	qint32			m_iAttempts;				/*!< number of times the shard was handed out */
+};
+
+/*!
+ \brief State of one connected worker.
+
+ \class cWorkerConnection ccoordinator.h "ccoordinator.h"
+*/
+class cWorkerConnection
+{
+public:
+	cWorkerConnection(QIODevice* lpSocket);
+	~cWorkerConnection();
+
+	QIODevice*			m_lpSocket;				/*!< QLocalSocket or QTcpSocket */
+	QString				m_szName;				/*!< name sent by the worker */
+	bool				m_bAccepted;			/*!< the worker sent a matching header */
+	qint32				m_iShard;				/*!< shard being read, -1 if idle */
+	QTemporaryFile*		m_lpSpool;				/*!< rows of the current shard until it is finished */
+	qint64				m_iRows;				/*!< rows received for the current shard */
+	QElapsedTimer		m_lastActivity;			/*!< time since the last line was received */
+};
+
+/*!
+ \brief Splits a directory tree into shards and merges the rows of the workers.
+
+ Workers connect over a Unix domain socket (QLocalServer) or TCP, claim
+ shards and stream their rows back. Rows are spooled per shard and only
+ copied to the output when the worker reports the shard as finished, so a
+ shard of a worker that dies or times out is simply handed out again.
+
+ The protocol is line based UTF-8:
+ worker: HELLO name\<tab\>header, CLAIM, ROW id\<tab\>row, FINISHED id, ALIVE
+ coordinator: SHARD id, ITEM item, END, WAIT, DONE, REJECT reason
+
+ \class cCoordinator ccoordinator.h "ccoordinator.h"
+*/
+class cCoordinator : public QObject
+{
+	Q_OBJECT
+public:
+	/*!
+	 \brief
+
+	 \fn cCoordinator
+	 \param szHeader header line every worker has to produce
+	 \param out merged output
+	 \param parent
+	*/
+	cCoordinator(const QString& szHeader, QTextStream& out, QObject* parent = nullptr);
+	~cCoordinator();
+
+	/*!
+	 \brief Splits szRoot into iShards shards balanced by the estimated number of files.
+
+	 \fn plan
+	 \param szRoot
+	 \param iShards
+	 \return qint32 number of shards created
+	*/
+	qint32						plan(const QString& szRoot, qint32 iShards);
+	/*!
+	 \brief Listens on "local:name" or "tcp:host:port".
+
+	 \fn listen
+	 \param szAddress
+	 \return bool
+	*/
+	bool						listen(const QString& szAddress);
+	/*!
+	 \brief Starts iCount worker processes of this executable connected to szAddress.
+
+	 \fn spawn
+	 \param iCount
+	 \param szAddress
+	 \param szArguments extra arguments passed to the workers
+	*/
+	void						spawn(qint32 iCount, const QString& szAddress, const QStringList& szArguments);
+	/*!
+	 \brief Aborts a worker if its shard produced no data for iSeconds, 0 disables the timeout.
+
+	 \fn setWorkerTimeout
+	 \param iSeconds
+	*/
+	void						setWorkerTimeout(qint32 iSeconds);
+	/*!
+	 \brief
+
+	 \fn setStatistics
+	 \param lpStatistics
+	*/
+	void						setStatistics(cStatistics* lpStatistics);
+
+	/*!
+	 \brief
+
+	 \fn isFinished
+	 \return bool
+	*/
+	bool						isFinished();
+
+signals:
+	/*!
+	 \brief Emitted when all shards are merged into the output.
+
+	 \fn finished
+	*/
+	void						finished();
+
+private slots:
+	void						onNewLocalConnection();
+	void						onNewTcpConnection();
+	void						onReadyRead();
+	void						onDisconnected();
+	void						onCheckTimeout();
+
+private:
+	QString						m_szHeader;				/*!< expected header of the workers */
+	QTextStream&				m_out;					/*!< merged output */
+	QList<cShard>				m_shardList;			/*!< all shards */
+	QQueue<qint32>				m_pendingList;			/*!< shards not handed out yet */
+	qint32						m_iFinished;			/*!< shards merged into the output */
+	QList<QLocalServer*>		m_localServerList;		/*!< local listeners */
+	QList<QTcpServer*>			m_tcpServerList;		/*!< TCP listeners */
+	QList<QProcess*>			m_processList;			/*!< spawned workers */
+	QMap<QIODevice*, cWorkerConnection*>	m_connectionList;	/*!< connected workers */
+	qint32						m_iWorkerTimeout;		/*!< idle timeout in seconds, 0 = none */
+	QTimer						m_timeoutTimer;			/*!< checks the idle timeout */
+	cStatistics*				m_lpStatistics;			/*!< statistics, or nullptr */
+
+	/*!
+	 \brief
+
+	 \fn addConnection
+	 \param lpSocket
+	*/
+	void						addConnection(QIODevice* lpSocket);
+	/*!
+	 \brief
+
+	 \fn handleLine
+	 \param lpConnection
+	 \param szLine
+	*/
+	void						handleLine(cWorkerConnection* lpConnection, const QString& szLine);
+	/*!
+	 \brief
+
+	 \fn assignShard
+	 \param lpConnection
+	*/
+	void						assignShard(cWorkerConnection* lpConnection);
+	/*!
+	 \brief
+
+	 \fn finishShard
+	 \param lpConnection
+	*/
+	void						finishShard(cWorkerConnection* lpConnection);
+	/*!
+	 \brief Puts the shard of a lost worker back into the queue.
+
+	 \fn releaseShard
+	 \param lpConnection
+	 \param szReason
+	*/
+	void						releaseShard(cWorkerConnection* lpConnection, const QString& szReason);
+	/*!
+	 \brief
+
+	 \fn send
+	 \param lpConnection
+	 \param szLine
+	*/
+	void						send(cWorkerConnection* lpConnection, const QString& szLine);
+	/*!
+	 \brief
+
+	 \fn countFiles
+	 \param szPath
+	 \param countList
+	 \return qint64
+	*/
+	qint64						countFiles(const QString& szPath, QHash<QString, qint64>& countList);
+	/*!
+	 \brief
+
+	 \fn splitDirectory
+	 \param szPath
+	 \param iTarget
+	 \param countList
+	 \param itemList
+	 \param estimateList
+	*/
+	void						splitDirectory(const QString& szPath, qint64 iTarget, const QHash<QString, qint64>& countList, QStringList& itemList, QList<qint64>& estimateList);
+};
+
+#endif // CCOORDINATOR_H
@@ -0,0 +1,145 @@
+/*!
+ \file cdiskorder.cpp
+
+*/
+
+#include "cdiskorder.h"
+
+#include <QFile>
+#include <QVector>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(Q_OS_UNIX)
+#include <sys/stat.h>
+#endif
+
+#if defined(Q_OS_LINUX)
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <linux/fs.h>
+#include <linux/fiemap.h>
+#endif
+
+
+/*!
+ \brief Sort key of one file.
+
+ \class cDiskOrderKey cdiskorder.cpp
+*/
+class cDiskOrderKey
+{
+public:
+	quint64		m_iKey;						/*!< inode or physical offset, 0 if unknown */
+	qint32		m_iIndex;					/*!< index in the file list */
+
+	bool operator<(const cDiskOrderKey& other) const
+	{
+		if(m_iKey != other.m_iKey)
+			return(m_iKey < other.m_iKey);
+		return(m_iIndex < other.m_iIndex);
+	}
+};
+
+QList<qint32> cDiskOrder::order(const QFileInfoList& fileList, Order order)
+{
+	QList<qint32>			indexList;
+	QVector<cDiskOrderKey>	keyList(fileList.count());
+	bool					bKnown	= false;
+
+	for(int x = 0;x < fileList.count();x++)
+	{
+		quint64	iKey	= 0;
+
+		if(order == OrderExtent)
+			iKey	= physicalOffset(fileList[x].filePath());
+		else if(order == OrderInode)
+			iKey	= inode(fileList[x].filePath());
+
+		keyList[x].m_iKey	= iKey;
+		keyList[x].m_iIndex	= x;
+		bKnown				|= (iKey != 0);
+	}
+
+	// FIEMAP is not supported by the file system
+	if(!bKnown && order == OrderExtent)
+		return(cDiskOrder::order(fileList, OrderInode));
+
+	// files without a key stay in front in their original order
+	if(bKnown)
+		std::sort(keyList.begin(), keyList.end());
+
+	for(int x = 0;x < keyList.count();x++)
+		indexList.append(keyList[x].m_iIndex);
+
+	return(indexList);
+}
+
+QStringList cDiskOrder::orders()
+{
+	return(QStringList() << "name" << "inode" << "extent");
+}
+
+cDiskOrder::Order cDiskOrder::fromName(const QString& szName, bool* lpOK)
+{
+	qint32	iOrder	= orders().indexOf(szName);
+
+	if(lpOK)
+		*lpOK	= (iOrder >= 0);
+
+	return(iOrder >= 0 ? static_cast<Order>(iOrder) : OrderName);
+}
+
+quint64 cDiskOrder::inode(const QString& szFileName)
+{
+#if defined(Q_OS_UNIX)
+	struct stat	st;
+
+	if(::stat(QFile::encodeName(szFileName).constData(), &st) == 0)
+		return(static_cast<quint64>(st.st_ino));
+#else
+	Q_UNUSED(szFileName);
+#endif
+	return(0);
+}
+
+quint64 cDiskOrder::physicalOffset(const QString& szFileName)
+{
+#if defined(Q_OS_LINUX)
+	int		fd	= ::open(QFile::encodeName(szFileName).constData(), O_RDONLY | O_CLOEXEC);
+
+	if(fd < 0)
+		return(0);
+
+	// room for the header and exactly one extent
+	union
+	{
+		struct fiemap	header;
+		char			buffer[sizeof(struct fiemap) + sizeof(struct fiemap_extent)];
+	}		request;
+	quint64	iOffset	= 0;
+
+	memset(&request, 0, sizeof(request));
+	request.header.fm_start			= 0;
+	request.header.fm_length		= FIEMAP_MAX_OFFSET;
+	request.header.fm_flags			= 0;
+	request.header.fm_extent_count	= 1;
+
+	if(ioctl(fd, FS_IOC_FIEMAP, &request.header) == 0 && request.header.fm_mapped_extents > 0)
+	{
+		const struct fiemap_extent&	extent	= request.header.fm_extents[0];
+
+		// inline or not yet allocated data has no meaningful position
+		if(!(extent.fe_flags & (FIEMAP_EXTENT_UNKNOWN | FIEMAP_EXTENT_DATA_INLINE | FIEMAP_EXTENT_NOT_ALIGNED)))
+			iOffset	= extent.fe_physical;
+	}
+
+	::close(fd);
+	return(iOffset);
+#else
+	Q_UNUSED(szFileName);
+	return(0);
+#endif
+}
@@ -0,0 +1,89 @@
+/*!
+ \file cdiskorder.h
+
+*/
+
+#ifndef CDISKORDER_H
+#define CDISKORDER_H
+
+
+#include <QString>
+#include <QStringList>
+#include <QFileInfo>
+#include <QList>
+
+
+/*!
+ \brief Orders the files of a directory by their position on disk.
+
+ On rotating disks reading the files of a directory in name order causes a
+ seek for almost every file. Sorting by inode number (OrderInode) roughly
+ follows the allocation order of the file system, sorting by the physical
+ offset of the first extent (OrderExtent, FIEMAP on Linux) follows the
+ actual data. Where the information is not available the files keep their
+ position.
+
+ \class cDiskOrder cdiskorder.h "cdiskorder.h"
+*/
+class cDiskOrder
+{
+public:
+	/*!
+	 \brief
+
+	 \enum Order
+	*/
+	enum Order
+	{
+		OrderName	= 0,	/*!< keep the QDir order */
+		OrderInode	= 1,	/*!< sort by inode number */
+		OrderExtent	= 2,	/*!< sort by the physical offset of the first extent, by inode number if the file system has no FIEMAP */
+	};
+
+	/*!
+	 \brief Returns the indices of fileList in the order the files should be read.
+
+	 \fn order
+	 \param fileList
+	 \param order
+	 \return QList<qint32>
+	*/
+	static QList<qint32>	order(const QFileInfoList& fileList, Order order);
+
+	/*!
+	 \brief
+
+	 \fn orders
+	 \return QStringList
+	*/
+	static QStringList		orders();
+	/*!
+	 \brief
+
+	 \fn fromName
+	 \param szName one of orders()
+	 \param lpOK
+	 \return Order
+	*/
+	static Order			fromName(const QString& szName, bool* lpOK = nullptr);
+
+private:
+	/*!
+	 \brief
+
+	 \fn inode
+	 \param szFileName
+	 \return quint64 inode number, 0 if unknown
+	*/
+	static quint64			inode(const QString& szFileName);
+	/*!
+	 \brief
+
+	 \fn physicalOffset
+	 \param szFileName
+	 \return quint64 physical offset of the first extent, 0 if unknown
+	*/
+	static quint64			physicalOffset(const QString& szFileName);
+};
+
+#endif // CDISKORDER_H
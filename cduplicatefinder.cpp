@@ -0,0 +1,201 @@
+/*!
+ \file cduplicatefinder.cpp
+
+*/
+
+#include "cduplicatefinder.h"
+#include "ccontenthash.h"
+#include "cpicture.h"
+#include "cstatistics.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QElapsedTimer>
+
+#include <algorithm>
+
+
+/*!
+ \brief Hashes one candidate on a worker thread.
+
+ \class cHashTask cduplicatefinder.cpp
+*/
+class cHashTask : public QRunnable
+{
+public:
+	cHashTask(cDuplicateCandidate* lpCandidate, cStatistics* lpStatistics) :
+		m_lpCandidate(lpCandidate),
+		m_lpStatistics(lpStatistics)
+	{
+	}
+
+	void run()
+	{
+		QElapsedTimer	timer;
+
+		timer.start();
+		m_lpCandidate->m_szHash	= cContentHash::local()->hashFile(m_lpCandidate->m_szFileName);
+
+		if(m_lpStatistics)
+			m_lpStatistics->addTime("hash/duplicate candidate", timer.nsecsElapsed());
+	}
+
+	cDuplicateCandidate*	m_lpCandidate;			/*!< file to hash */
+	cStatistics*			m_lpStatistics;			/*!< timing statistics, or nullptr */
+};
+
+/*!
+ \brief Orders candidate indices by (size, DateTimeOriginal, camera model).
+
+ \class cCandidateLessThan cduplicatefinder.cpp
+*/
+class cCandidateLessThan
+{
+public:
+	cCandidateLessThan(const QVector<cDuplicateCandidate>& candidateList) :
+		m_candidateList(candidateList)
+	{
+	}
+
+	bool operator()(qint32 i1, qint32 i2) const
+	{
+		const cDuplicateCandidate&	c1	= m_candidateList.at(i1);
+		const cDuplicateCandidate&	c2	= m_candidateList.at(i2);
+
+		if(c1.m_iFileSize != c2.m_iFileSize)
+			return(c1.m_iFileSize < c2.m_iFileSize);
+		if(c1.m_iDateTimeOriginal != c2.m_iDateTimeOriginal)
+			return(c1.m_iDateTimeOriginal < c2.m_iDateTimeOriginal);
+		return(c1.m_szCameraModel < c2.m_szCameraModel);
+	}
+
+	const QVector<cDuplicateCandidate>&	m_candidateList;		/*!< the candidates the indices refer to */
+};
+
+cDuplicateFinder::cDuplicateFinder()
+{
+}
+
+void cDuplicateFinder::add(cPicture* lpPicture)
+{
+	cDuplicateCandidate	candidate;
+
+	candidate.m_szFileName			= lpPicture->filePath() + QDir::separator() + lpPicture->fileName();
+	candidate.m_iFileSize			= lpPicture->fileSize();
+	candidate.m_iDateTimeOriginal	= lpPicture->dateTimeOriginal().isValid() ? lpPicture->dateTimeOriginal().toMSecsSinceEpoch() : 0;
+	candidate.m_szCameraModel		= lpPicture->cameraModel();
+	candidate.m_szHash				= lpPicture->contentHash();
+
+	m_candidateList.append(candidate);
+}
+
+qint32 cDuplicateFinder::find(qint32 iJobs, cStatistics* lpStatistics)
+{
+	QVector<qint32>		indexList(m_candidateList.count());
+	cCandidateLessThan	lessThan(m_candidateList);
+	QList<QVector<qint32> >	collisionList;
+
+	m_groupList.clear();
+
+	for(int x = 0;x < indexList.count();x++)
+		indexList[x]	= x;
+
+	std::sort(indexList.begin(), indexList.end(), lessThan);
+
+	for(int x = 0;x < indexList.count();)
+	{
+		int	y	= x + 1;
+
+		while(y < indexList.count() && !lessThan(indexList[x], indexList[y]))
+			y++;
+
+		if(y - x > 1)
+			collisionList.append(indexList.mid(x, y - x));
+
+		x	= y;
+	}
+
+	QThreadPool	threadPool;
+	qint64		iHashed	= 0;
+
+	if(iJobs > 0)
+		threadPool.setMaxThreadCount(iJobs);
+
+	for(int x = 0;x < collisionList.count();x++)
+	{
+		const QVector<qint32>&	collision	= collisionList.at(x);
+
+		for(int y = 0;y < collision.count();y++)
+		{
+			cDuplicateCandidate*	lpCandidate	= &m_candidateList[collision.at(y)];
+
+			if(lpCandidate->m_szHash.isEmpty())
+			{
+				threadPool.start(new cHashTask(lpCandidate, lpStatistics));
+				iHashed++;
+			}
+		}
+	}
+
+	threadPool.waitForDone();
+
+	for(int x = 0;x < collisionList.count();x++)
+	{
+		QVector<qint32>	collision	= collisionList.at(x);
+
+		std::sort(collision.begin(), collision.end(), [this](qint32 i1, qint32 i2) { return(m_candidateList.at(i1).m_szHash < m_candidateList.at(i2).m_szHash); });
+
+		for(int y = 0;y < collision.count();)
+		{
+			const QString&	szHash	= m_candidateList.at(collision.at(y)).m_szHash;
+			int				z		= y + 1;
+
+			while(z < collision.count() && m_candidateList.at(collision.at(z)).m_szHash == szHash)
+				z++;
+
+			if(z - y > 1 && !szHash.isEmpty())
+				m_groupList.append(collision.mid(y, z - y));
+
+			y	= z;
+		}
+	}
+
+	if(lpStatistics)
+	{
+		lpStatistics->addCount("duplicates/candidates", m_candidateList.count());
+		lpStatistics->addCount("duplicates/hashed after prefilter", iHashed);
+		lpStatistics->addCount("duplicates/groups", m_groupList.count());
+	}
+
+	return(m_groupList.count());
+}
+
+bool cDuplicateFinder::writeReport(const QString& szFileName)
+{
+	QFile	file(szFileName);
+
+	if(!file.open(QFile::WriteOnly | QFile::Truncate))
+		return(false);
+
+	QTextStream	out(&file);
+
+	out << "group" << "\t" << "hash" << "\t" << "size" << "\t" << "file" << "\n";
+
+	for(int x = 0;x < m_groupList.count();x++)
+	{
+		const QVector<qint32>&	group	= m_groupList.at(x);
+
+		for(int y = 0;y < group.count();y++)
+		{
+			const cDuplicateCandidate&	candidate	= m_candidateList.at(group.at(y));
+
+			out << x + 1 << "\t" << candidate.m_szHash << "\t" << candidate.m_iFileSize << "\t" << candidate.m_szFileName << "\n";
+		}
+	}
+
+	file.close();
+	return(true);
+}
@@ -0,0 +1,77 @@
+/*!
+ \file cduplicatefinder.h
+
+*/
+
+#ifndef CDUPLICATEFINDER_H
+#define CDUPLICATEFINDER_H
+
+
+#include <QString>
+#include <QVector>
+#include <QList>
+
+
+class cPicture;
+class cStatistics;
+
+/*!
+ \brief A file that may have identical copies.
+
+ \class cDuplicateCandidate cduplicatefinder.h "cduplicatefinder.h"
+*/
+class cDuplicateCandidate
+{
+public:
+	QString		m_szFileName;				/*!< full path of the file */
+	qint64		m_iFileSize;				/*!< size of the file */
+	qint64		m_iDateTimeOriginal;		/*!< EXIF DateTimeOriginal in msecs since epoch, 0 if unknown */
+	QString		m_szCameraModel;			/*!< EXIF camera model */
+	QString		m_szHash;					/*!< content hash, empty until hashed */
+};
+
+/*!
+ \brief Groups identical files.
+
+ Files are first grouped by (size, DateTimeOriginal, camera model). Only
+ files sharing such a key with another file are hashed, identical hashes
+ within a key form a duplicate group.
+
+ \class cDuplicateFinder cduplicatefinder.h "cduplicatefinder.h"
+*/
+class cDuplicateFinder
+{
+public:
+	cDuplicateFinder();
+
+	/*!
+	 \brief Remembers a scanned picture. A content hash already computed by the scanner is reused.
+
+	 \fn add
+	 \param lpPicture
+	*/
+	void								add(cPicture* lpPicture);
+	/*!
+	 \brief Hashes the colliding candidates and builds the duplicate groups.
+
+	 \fn find
+	 \param iJobs
+	 \param lpStatistics
+	 \return qint32 number of duplicate groups
+	*/
+	qint32								find(qint32 iJobs, cStatistics* lpStatistics = nullptr);
+	/*!
+	 \brief
+
+	 \fn writeReport
+	 \param szFileName
+	 \return bool
+	*/
+	bool								writeReport(const QString& szFileName);
+
+private:
+	QVector<cDuplicateCandidate>		m_candidateList;			/*!< all scanned files */
+	QList<QVector<qint32> >				m_groupList;				/*!< indices into m_candidateList of identical files */
+};
+
+#endif // CDUPLICATEFINDER_H
@@ -4,69 +4,1145 @@
 */
 
 #include "cexif.h"
+#include "cstatistics.h"
 
 #include <QDebug>
 #include <QFileInfo>
+#include <QElapsedTimer>
+#include <QtEndian>
+
+#include <cmath>
+#include <cstring>
 
 #include <exiv2\exiv2.hpp>
+#include <libraw/libraw.h>
+
+
+// qmake CONFIG+=no_translation builds the tables from literals, without a QObject::tr() lookup per string
+#ifdef EXIF2FILE_NO_TRANSLATION
+#define EXIF_TR(x)	QStringLiteral(x)
+#else
+#define EXIF_TR(x)	QObject::tr(x)
+#endif
+
+
+/*!
+ \brief Tags known to cEXIF. Built on first use and only read afterwards, so all cEXIF objects and threads share it.
+
+ \fn tagList
+ \return cEXIFTagList
+*/
+static cEXIFTagList& tagList()
+{
+	static cEXIFTagList	list;
+
+	return(list);
+}
+
+/*!
+ \brief Names of the flash values, shared like tagList().
+
+ \fn flashList
+ \return cEXIFFlashList
+*/
+static cEXIFFlashList& flashList()
+{
+	static cEXIFFlashList	list;
+
+	return(list);
+}
+
+/*!
+ \brief Converts a file name for Exiv2 with a single copy.
+
+ \fn localFileName
+ \param szFileName
+ \return std::string
+*/
+static std::string localFileName(const QString& szFileName)
+{
+	QByteArray	name	= QFile::encodeName(szFileName);
+
+	return(std::string(name.constData(), static_cast<size_t>(name.size())));
+}
+
+/*!
+ \brief Creates the Exiv2 image class of format on io. Nothing is read yet.
+
+ \fn newImage
+ \param format
+ \param io
+ \return Exiv2::Image, nullptr if there is no image class for format in this Exiv2 build
+*/
+static Exiv2::Image::UniquePtr newImage(cEXIF::ImageFormat format, Exiv2::BasicIo::UniquePtr io)
+{
+	switch(format)
+	{
+	case cEXIF::ImageFormatJPEG:
+		return(Exiv2::Image::UniquePtr(new Exiv2::JpegImage(std::move(io), false)));
+	case cEXIF::ImageFormatTIFF:
+		return(Exiv2::Image::UniquePtr(new Exiv2::TiffImage(std::move(io), false)));
+	case cEXIF::ImageFormatCR2:
+		return(Exiv2::Image::UniquePtr(new Exiv2::Cr2Image(std::move(io), false)));
+	case cEXIF::ImageFormatCRW:
+		return(Exiv2::Image::UniquePtr(new Exiv2::CrwImage(std::move(io), false)));
+	case cEXIF::ImageFormatORF:
+		return(Exiv2::Image::UniquePtr(new Exiv2::OrfImage(std::move(io), false)));
+	case cEXIF::ImageFormatRW2:
+		return(Exiv2::Image::UniquePtr(new Exiv2::Rw2Image(std::move(io))));
+	case cEXIF::ImageFormatRAF:
+		return(Exiv2::Image::UniquePtr(new Exiv2::RafImage(std::move(io), false)));
+	case cEXIF::ImageFormatMRW:
+		return(Exiv2::Image::UniquePtr(new Exiv2::MrwImage(std::move(io), false)));
+#ifdef EXV_HAVE_LIBZ
+	case cEXIF::ImageFormatPNG:
+		return(Exiv2::Image::UniquePtr(new Exiv2::PngImage(std::move(io), false)));
+#endif
+	case cEXIF::ImageFormatWebP:
+		return(Exiv2::Image::UniquePtr(new Exiv2::WebPImage(std::move(io))));
+	default:
+		return(Exiv2::Image::UniquePtr());
+	}
+}
+
+/*!
+ \brief Converts a GPS coordinate (degrees, minutes, seconds as rationals) into signed decimal degrees.
+
+ \fn gpsDegrees
+ \param exifData
+ \param szKey
+ \param szRefKey
+ \param cNegative reference letter of the negative hemisphere
+ \param lpValue
+ \return bool
+*/
+static bool gpsDegrees(const Exiv2::ExifData& exifData, const char* szKey, const char* szRefKey, char cNegative, double* lpValue)
+{
+	Exiv2::ExifData::const_iterator	i	= exifData.findKey(Exiv2::ExifKey(szKey));
+
+	if(i == exifData.end() || i->count() != 3)
+		return(false);
+
+	double	dValue	= 0;
+	double	dScale	= 1;
+
+	for(int x = 0;x < 3;x++, dScale *= 60)
+	{
+		Exiv2::Rational	r	= i->toRational(x);
+
+		if(r.second == 0)
+		{
+			// 0/0 is used for unknown seconds
+			if(r.first == 0 && x > 0)
+				continue;
+			return(false);
+		}
+		dValue	+= static_cast<double>(r.first) / r.second / dScale;
+	}
+
+	Exiv2::ExifData::const_iterator	ref	= exifData.findKey(Exiv2::ExifKey(szRefKey));
+
+	if(ref != exifData.end())
+	{
+		std::string	szRef	= ref->toString();
+
+		if(!szRef.empty() && szRef[0] == cNegative)
+			dValue	= -dValue;
+	}
+
+	*lpValue	= dValue;
+	return(true);
+}
+
+/*!
+ \brief Altitude in meters, negative below sea level.
+
+ \fn gpsAltitude
+ \param exifData
+ \param lpValue
+ \return bool
+*/
+static bool gpsAltitude(const Exiv2::ExifData& exifData, double* lpValue)
+{
+	Exiv2::ExifData::const_iterator	i	= exifData.findKey(Exiv2::ExifKey("Exif.GPSInfo.GPSAltitude"));
+
+	if(i == exifData.end() || !i->count())
+		return(false);
+
+	Exiv2::Rational	r	= i->toRational(0);
+
+	if(r.second == 0)
+		return(false);
+
+	*lpValue	= static_cast<double>(r.first) / r.second;
+
+	Exiv2::ExifData::const_iterator	ref	= exifData.findKey(Exiv2::ExifKey("Exif.GPSInfo.GPSAltitudeRef"));
+
+	if(ref != exifData.end() && ref->count() && ref->toLong(0) == 1)
+		*lpValue	= -*lpValue;
+
+	return(true);
+}
+
+/*!
+ \brief IFD id of the maker note of an Exiv2 group, 0 for other groups.
+
+ \fn makerNoteIFD
+ \param szGroup
+ \return qint32
+*/
+static qint32 makerNoteIFD(const std::string& szGroup)
+{
+	if(szGroup == "Canon")
+		return(IFD_MAKERNOTE_CANON);
+	if(szGroup == "Nikon3")
+		return(IFD_MAKERNOTE_NIKON);
+	if(szGroup == "Sony1" || szGroup == "Sony2")
+		return(IFD_MAKERNOTE_SONY);
+	if(szGroup == "Fujifilm")
+		return(IFD_MAKERNOTE_FUJI);
+	return(0);
+}
+
+#define NSECS_PER_SECOND	Q_INT64_C(1000000000)
+
+
+/*!
+ \brief Days since 1970-01-01 of a date of the proleptic Gregorian calendar (H. Hinnant's days_from_civil).
+
+ \fn daysFromCivil
+ \param iYear
+ \param iMonth
+ \param iDay
+ \return qint64
+*/
+static qint64 daysFromCivil(qint32 iYear, qint32 iMonth, qint32 iDay)
+{
+	iYear	-= iMonth <= 2;
+
+	qint32	iEra	= (iYear >= 0 ? iYear : iYear - 399) / 400;
+	qint32	iYOE	= iYear - iEra * 400;
+	qint32	iDOY	= (153 * (iMonth + (iMonth > 2 ? -3 : 9)) + 2) / 5 + iDay - 1;
+	qint32	iDOE	= iYOE * 365 + iYOE / 4 - iYOE / 100 + iDOY;
+
+	return(static_cast<qint64>(iEra) * 146097 + iDOE - 719468);
+}
+
+/*!
+ \brief Reads iCount decimal digits, fails on anything else.
+
+ \fn parseDigits
+ \param lpData
+ \param iCount
+ \param iValue
+ \return bool
+*/
+static inline bool parseDigits(const QChar* lpData, qint32 iCount, qint32& iValue)
+{
+	iValue	= 0;
+
+	for(qint32 x = 0;x < iCount;x++)
+	{
+		ushort	iDigit	= lpData[x].unicode() - '0';
+
+		if(iDigit > 9)
+			return(false);
+		iValue	= iValue * 10 + iDigit;
+	}
+	return(true);
+}
+
+/*!
+ \brief Parses the fixed layout "YYYY:MM:DD" (iLength 10) or "YYYY:MM:DD HH:MM:SS" (iLength 19) into seconds since the epoch, ignoring any time zone.
+
+ The string is checked digit by digit against the layout, nothing is
+ allocated. Blank dates ("    :  :     :  :  ") and impossible dates fail.
+
+ \fn parseEXIFDate
+ \param szValue
+ \param iLength
+ \param iSeconds
+ \return bool
+*/
+static bool parseEXIFDate(const QString& szValue, qint32 iLength, qint64& iSeconds)
+{
+	static const qint32	iDaysInMonth[]	= { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+	if(szValue.size() < iLength)
+		return(false);
+
+	const QChar*	lpData	= szValue.constData();
+	qint32			iYear;
+	qint32			iMonth;
+	qint32			iDay;
+	qint32			iHour	= 0;
+	qint32			iMinute	= 0;
+	qint32			iSecond	= 0;
+
+	// some writers use ISO 8601 separators
+	if(!parseDigits(lpData, 4, iYear) || (lpData[4] != ':' && lpData[4] != '-') ||
+	   !parseDigits(lpData + 5, 2, iMonth) || lpData[7] != lpData[4] ||
+	   !parseDigits(lpData + 8, 2, iDay))
+		return(false);
+
+	if(iLength > 10)
+	{
+		if((lpData[10] != ' ' && lpData[10] != 'T') ||
+		   !parseDigits(lpData + 11, 2, iHour) || lpData[13] != ':' ||
+		   !parseDigits(lpData + 14, 2, iMinute) || lpData[16] != ':' ||
+		   !parseDigits(lpData + 17, 2, iSecond))
+			return(false);
+	}
+
+	if(iYear < 1 || iMonth < 1 || iMonth > 12 || iDay < 1 || iDay > iDaysInMonth[iMonth - 1] || iHour > 23 || iMinute > 59 || iSecond > 60)
+		return(false);
+
+	if(iMonth == 2 && iDay == 29 && (iYear % 4 || (!(iYear % 100) && iYear % 400)))
+		return(false);
+
+	iSeconds	= daysFromCivil(iYear, iMonth, iDay) * 86400 + iHour * 3600 + iMinute * 60 + iSecond;
+	return(true);
+}
+
+/*!
+ \brief Parses a SubSecTime value ("123", "5", ...) into nanoseconds. Digits after the ninth are ignored.
+
+ \fn parseSubSeconds
+ \param szValue
+ \return qint64
+*/
+static qint64 parseSubSeconds(const QString& szValue)
+{
+	const QChar*	lpData	= szValue.constData();
+	qint64			iValue	= 0;
+	qint32			iDigits	= 0;
+
+	for(qint32 x = 0;x < szValue.size() && iDigits < 9;x++, iDigits++)
+	{
+		ushort	iDigit	= lpData[x].unicode() - '0';
+
+		if(iDigit > 9)
+			break;
+		iValue	= iValue * 10 + iDigit;
+	}
+
+	for(;iDigits < 9;iDigits++)
+		iValue	*= 10;
+
+	return(iValue);
+}
+
+/*!
+ \brief Parses an OffsetTime value "+HH:MM" or "-HH:MM" into seconds east of UTC.
+
+ \fn parseOffset
+ \param szValue
+ \param iOffset
+ \return bool
+*/
+static bool parseOffset(const QString& szValue, qint32& iOffset)
+{
+	if(szValue.size() < 6)
+		return(false);
+
+	const QChar*	lpData	= szValue.constData();
+	qint32			iHour;
+	qint32			iMinute;
+
+	if((lpData[0] != '+' && lpData[0] != '-') || !parseDigits(lpData + 1, 2, iHour) || lpData[3] != ':' || !parseDigits(lpData + 4, 2, iMinute))
+		return(false);
+
+	if(iHour > 14 || iMinute > 59)
+		return(false);
+
+	iOffset	= (iHour * 3600 + iMinute * 60) * (lpData[0] == '-' ? -1 : 1);
+	return(true);
+}
+
+/*!
+ \brief Local (time zone naive) QDateTime of an EXIF date, without going through QDateTime::fromString().
+
+ \fn toDateTime
+ \param szValue
+ \return QDateTime
+*/
+static QDateTime toDateTime(const QString& szValue)
+{
+	qint64	iSeconds;
+
+	if(!parseEXIFDate(szValue, 19, iSeconds))
+		return(QDateTime());
+
+	qint64	iDays	= iSeconds / 86400;
+	qint32	iTime	= static_cast<qint32>(iSeconds % 86400);
+
+	// QDate counts Julian days, 2440588 is 1970-01-01
+	return(QDateTime(QDate::fromJulianDay(iDays + 2440588), QTime(iTime / 3600, (iTime / 60) % 60, qMin(iTime % 60, 59))));
+}
+
+cEXIF::cEXIF() :
+	m_iWidth(0),
+	m_iHeight(0),
+	m_szFileName(""),
+	m_bReadPreview(false),
+	m_iPreviewWidth(0),
+	m_iPreviewHeight(0),
+	m_bLibRaw(false),
+	m_lpStatistics(nullptr),
+	m_ioMode(cFileInput::IOModeRead),
+	m_iPrefixSize(256 * 1024),
+	m_bImageFactory(false),
+	m_bMakerNote(false),
+	m_bGPS(false),
+	m_dLatitude(0),
+	m_dLongitude(0),
+	m_bGPSAltitude(false),
+	m_dAltitude(0),
+	m_bTimestamp(false),
+	m_iTimestamp(0),
+	m_bUTCOffset(false),
+	m_iUTCOffset(0),
+	m_bGPSTimestamp(false),
+	m_iGPSTimestamp(0)
+{
+}
+
+cEXIF::~cEXIF()
+{
+	qDeleteAll(m_exifValueList);
+}
+
+bool cEXIF::fromFile(const QString& szFileName)
+{
+	if(!QFile::exists(szFileName))
+		return(false);
+
+	QElapsedTimer			timer;
+	bool					bInput	= false;
+
+	timer.start();
+
+	if(m_ioMode != cFileInput::IOModeRead)
+	{
+		bInput	= m_input.open(szFileName, m_ioMode, m_iPrefixSize);
+
+		if(m_lpStatistics)
+			m_lpStatistics->addTime("io/" + cFileInput::ioModeName(m_input.mode()), timer.nsecsElapsed());
+	}
+
+	bool	bOK	= read(szFileName, m_input, bInput, timer);
+
+	m_input.close();
+	return(bOK);
+}
+
+bool cEXIF::fromBuffer(const QString& szFileName, const QByteArray& buffer, qint64 iFileSize)
+{
+	QElapsedTimer			timer;
+
+	timer.start();
+	m_input.setBuffer(buffer, iFileSize);
+
+	bool	bOK	= read(szFileName, m_input, true, timer);
+
+	m_input.close();
+	return(bOK);
+}
+
+qint32 cEXIF::fromFiles(const QStringList& fileList, cBatchCallback callback)
+{
+	qint32	iOK	= 0;
+
+	for(int x = 0;x < fileList.count();x++)
+	{
+		bool	bOK	= fromFile(fileList[x]);
+
+		if(bOK)
+			iOK++;
+		callback(x, bOK, *this);
+	}
+
+	if(m_lpStatistics)
+		m_lpStatistics->addCount("batch/files", fileList.count());
+
+	return(iOK);
+}
+
+qint32 cEXIF::fromBuffers(const QStringList& fileList, const QList<QByteArray>& bufferList, const QList<qint64>& fileSizeList, cBatchCallback callback)
+{
+	qint32	iOK	= 0;
+
+	for(int x = 0;x < fileList.count();x++)
+	{
+		// the file is read directly if the caller could not read its prefix
+		bool	bOK	= bufferList.value(x).isEmpty() ? fromFile(fileList[x]) : fromBuffer(fileList[x], bufferList.value(x), fileSizeList.value(x, -1));
+
+		if(bOK)
+			iOK++;
+		callback(x, bOK, *this);
+	}
+
+	if(m_lpStatistics)
+		m_lpStatistics->addCount("batch/files", fileList.count());
+
+	return(iOK);
+}
+
+bool cEXIF::read(const QString& szFileName, cFileInput& input, bool bInput, QElapsedTimer& timer)
+{
+	qDeleteAll(m_exifValueList);
+	m_exifValueList.clear();
+	m_ifdView.clear();
+
+	m_szFileName	= "";
+	m_previewData.clear();
+	m_iPreviewWidth		= 0;
+	m_iPreviewHeight	= 0;
+	m_bGPS				= false;
+	m_bGPSAltitude		= false;
+	m_bTimestamp		= false;
+	m_bUTCOffset		= false;
+	m_bGPSTimestamp		= false;
+	m_xmpValueList.clear();
+	m_iptcValueList.clear();
+
+	// HEIF, AVIF and CR3: only the boxes leading to the metadata are read
+	if(bInput ? cBMFFReader::isBMFF(input.data(), input.size()) : cBMFFReader::isBMFFName(szFileName))
+	{
+		if(readBMFF(szFileName, input, bInput, timer))
+			return(true);
+
+		if(m_lpStatistics)
+			m_lpStatistics->addCount("bmff/fallback");
+		timer.restart();
+	}
+
+	Exiv2::Image::UniquePtr	image;
+
+	try
+	{
+		image	= openImage(szFileName, input, bInput);
+	}
+	catch (Exiv2::AnyError& e)
+	{
+		if(!bInput || input.isComplete())
+		{
+			qDebug() << e.what();
+//			std::cout << "Caught Exiv2 exception '" << e << "'\n";
+			return(false);
+		}
+		image.reset();
+	}
+
+	// only the entries are indexed here, the values are decoded when getTag() asks for them
+	bool				bView		= false;
+	qint64				iViewTime	= 0;
+	cIFDView::cWanted	wanted		= [this](qint32 iTag, qint32 iIFD) { return(tagList().find(iTag, iIFD) != nullptr); };
+
+	// only with the buffer at hand, reading the file again would cost more than converting what Exiv2 has decoded
+	if(bInput && input.size() && image.get() && !image->exifData().empty())
+	{
+		QElapsedTimer	viewTimer;
+
+		viewTimer.start();
+		bView		= m_ifdView.parse(input.data(), input.size(), wanted);
+		iViewTime	= viewTimer.nsecsElapsed();
+	}
+
+	// the metadata did not fit into the prefix, read the whole file
+	// Exiv2 only warns about IFDs and values past the prefix, the view finds them
+	if(bInput && !input.isComplete() && (!image.get() || image->exifData().empty() || !image->pixelWidth() || m_ifdView.isTruncated()))
+	{
+		if(m_lpStatistics)
+			m_lpStatistics->addCount("io/prefix-fallback");
+
+		image.reset();
+		input.close();
+		m_ifdView.clear();
+		bView	= false;
+
+		try
+		{
+			image	= openImage(szFileName, input, false);
+		}
+		catch (Exiv2::AnyError& e)
+		{
+			qDebug() << e.what();
+			return(false);
+		}
+	}
+
+	if(!image.get())
+		return(false);
+
+	if(m_lpStatistics)
+		m_lpStatistics->addTime("exiv2/" + QFileInfo(szFileName).suffix().toLower(), timer.nsecsElapsed() - iViewTime);
+
+	Exiv2::ExifData&				exifData	= image->exifData();
+
+	m_iWidth		= image->pixelWidth();
+	m_iHeight		= image->pixelHeight();
+	m_szFileName	= szFileName;
+
+	if(m_bLibRaw && isRAW(szFileName))
+		readLibRaw(szFileName);
+
+	if(!exifData.empty())
+	{
+		timer.restart();
+
+		qint32	iMakerNote	= 0;
+
+		// files read by Exiv2 itself and formats without a plain TIFF structure (PNG, HEIF, ...) are converted from the Exiv2 values
+		if(!bView)
+		{
+			Exiv2::ExifData::const_iterator	end			= exifData.end();
+			for(Exiv2::ExifData::const_iterator i = exifData.begin(); i != end; ++i)
+			{
+				cEXIFTag*	lpTag	= tagList().find(i->tag(), i->ifdId());
+
+				// Exiv2 has IFD ids of its own for the maker note groups
+				if(!lpTag && m_bMakerNote && i->ifdId() > 7)
+				{
+					qint32	iIFD	= makerNoteIFD(i->groupName());
+
+					if(iIFD)
+					{
+						iMakerNote	= iIFD;
+						lpTag		= tagList().find(i->tag(), iIFD);
+					}
+				}
+
+				if(lpTag)
+				{
+					cEXIFValue*	lpValue	= m_exifValueList.add(lpTag);
+					if(lpValue)
+						lpValue->setValue(i->value(), i->typeId());
+				}
+			}
+		}
+
+		if(m_lpStatistics)
+			m_lpStatistics->addTime(bView ? "exif/view" : "exif/values", bView ? iViewTime : timer.nsecsElapsed());
+
+		countMakerNote(bView ? m_ifdView.makerNote() : iMakerNote);
+	}
+
+	m_bGPS			= gpsDegrees(exifData, "Exif.GPSInfo.GPSLatitude", "Exif.GPSInfo.GPSLatitudeRef", 'S', &m_dLatitude) &&
+					  gpsDegrees(exifData, "Exif.GPSInfo.GPSLongitude", "Exif.GPSInfo.GPSLongitudeRef", 'W', &m_dLongitude);
+	m_bGPSAltitude	= gpsAltitude(exifData, &m_dAltitude);
+
+	readTimestamps();
+
+	if(m_xmpScanner.propertyCount())
+	{
+		std::string&	szPacket	= image->xmpPacket();
+
+		if(!szPacket.empty())
+			readXMP(szPacket.data(), static_cast<qint64>(szPacket.size()));
+		else if(!image->xmpData().empty())
+			readXMP(image->xmpData());
+	}
+
+	if(!m_iptcDatasetList.isEmpty() && !image->iptcData().empty())
+		readIPTC(image->iptcData());
+
+	if(m_bReadPreview)
+	{
+		try
+		{
+			Exiv2::PreviewManager				previewManager(*image);
+			Exiv2::PreviewPropertiesList		previewList	= previewManager.getPreviewProperties();
+
+			if(!previewList.empty())
+			{
+				// the list is sorted by size, the first entry is the embedded thumbnail
+				Exiv2::PreviewImage	preview	= previewManager.getPreviewImage(previewList.front());
+
+				m_previewData		= QByteArray(reinterpret_cast<const char*>(preview.pData()), static_cast<int>(preview.size()));
+				m_iPreviewWidth		= static_cast<qint32>(preview.width());
+				m_iPreviewHeight	= static_cast<qint32>(preview.height());
+			}
+		}
+		catch (Exiv2::AnyError& e)
+		{
+			qDebug() << e.what();
+		}
+	}
+
+	return(true);
+}
+
+std::unique_ptr<Exiv2::Image> cEXIF::openImage(const QString& szFileName, cFileInput& input, bool bInput)
+{
+	QElapsedTimer			timer;
+	ImageFormat				format	= bInput ? imageFormat(input.data(), input.size()) : imageFormat(szFileName);
+	Exiv2::Image::UniquePtr	image;
+
+	timer.start();
+
+	if(!m_bImageFactory && format != ImageFormatUnknown)
+	{
+		Exiv2::BasicIo::UniquePtr	io;
+
+		// MemIo only refers to the input, the buffer is not copied
+		if(bInput)
+			io.reset(new Exiv2::MemIo(input.data(), input.size()));
+		else
+			io.reset(new Exiv2::FileIo(localFileName(szFileName)));
+
+		image	= newImage(format, std::move(io));
+	}
+
+	if(image.get())
+	{
+		if(m_lpStatistics)
+			m_lpStatistics->addTime("exiv2-open/direct/" + imageFormatName(format), timer.nsecsElapsed());
+
+		// the signature of the input was checked, errors are real errors (or a prefix that is too short)
+		if(bInput)
+		{
+			image->readMetadata();
+			return(image);
+		}
+
+		try
+		{
+			image->readMetadata();
+			return(image);
+		}
+		catch (Exiv2::AnyError&)
+		{
+			// the extension did not match the content, let the factory find the format
+			if(m_lpStatistics)
+				m_lpStatistics->addCount("exiv2-open/mismatch");
+			image.reset();
+			timer.restart();
+		}
+	}
+
+	if(bInput)
+		image	= Exiv2::ImageFactory::open(input.data(), input.size());
+	else
+		image	= Exiv2::ImageFactory::open(localFileName(szFileName));
+
+	if(m_lpStatistics)
+		m_lpStatistics->addTime("exiv2-open/factory/" + imageFormatName(format), timer.nsecsElapsed());
+
+	if(image.get())
+		image->readMetadata();
+
+	return(image);
+}
+
+bool cEXIF::readBMFF(const QString& szFileName, cFileInput& input, bool bInput, QElapsedTimer& timer)
+{
+	bool	bOK;
+
+	bool	bXMP	= m_xmpScanner.propertyCount() > 0;
+
+	if(bInput)
+		bOK	= m_bmffReader.read(szFileName, input.data(), input.size(), input.isComplete(), m_bReadPreview, bXMP, m_bMakerNote);
+	else
+		bOK	= m_bmffReader.read(szFileName, nullptr, 0, false, m_bReadPreview, bXMP, m_bMakerNote);
+
+	if(!bOK)
+		return(false);
+
+	cIFDView::cWanted			wanted		= [](qint32 iTag, qint32 iIFD) { return(tagList().find(iTag, iIFD) != nullptr); };
+	const QList<cBMFFExif>&		exifList	= m_bmffReader.exifList();
+
+	m_ifdView.clear();
+	for(int x = 0;x < exifList.count();x++)
+	{
+		const cBMFFExif&	exif	= exifList.at(x);
+
+		if(!m_ifdView.append(reinterpret_cast<const uchar*>(exif.m_data.constData()), exif.m_data.size(), exif.m_iIFD, wanted))
+			qDebug() << szFileName << ": broken EXIF structure in IFD" << exif.m_iIFD;
+	}
+
+	m_szFileName	= szFileName;
+	m_iWidth		= m_bmffReader.width();
+	m_iHeight		= m_bmffReader.height();
+
+	// CR3 has no ispe box, the Exif IFD has the size of the image
+	if(!m_iWidth || !m_iHeight)
+	{
+		m_iWidth	= getTag(0xa002, 5).toInt();
+		m_iHeight	= getTag(0xa003, 5).toInt();
+	}
+
+	if(m_lpStatistics)
+	{
+		m_lpStatistics->addTime("bmff/" + QFileInfo(szFileName).suffix().toLower(), timer.nsecsElapsed());
+		m_lpStatistics->addCount("bmff/bytes", m_bmffReader.bytesRead());
+	}
+
+	countMakerNote(m_ifdView.makerNote());
+
+	if(m_bLibRaw && isRAW(szFileName))
+		readLibRaw(szFileName);
+
+	readGPS();
+	readTimestamps();
+
+	if(bXMP)
+	{
+		QByteArray	xmp	= m_bmffReader.xmpData();
+
+		if(!xmp.isEmpty())
+			readXMP(xmp.constData(), xmp.size());
+	}
+
+	if(m_bReadPreview)
+	{
+		m_previewData		= m_bmffReader.previewData();
+		m_iPreviewWidth		= m_bmffReader.previewWidth();
+		m_iPreviewHeight	= m_bmffReader.previewHeight();
+	}
+
+	return(true);
+}
+
+void cEXIF::readGPS()
+{
+	double	dValue[2];
+	qint32	iTag[2]		= { 0x0002, 0x0004 };
+	QChar	cNegative[2]	= { 'S', 'W' };
+
+	m_bGPS	= true;
+
+	for(int x = 0;x < 2 && m_bGPS;x++)
+	{
+		QList<QVariant>	valueList	= getTagList(iTag[x], 6);
+		double			dScale		= 1;
+
+		dValue[x]	= 0;
+
+		if(valueList.count() != 3)
+		{
+			m_bGPS	= false;
+			break;
+		}
+
+		for(int y = 0;y < 3;y++, dScale *= 60)
+		{
+			double	d	= valueList[y].toDouble();
+
+			// 0/0 is used for unknown seconds
+			if(std::isnan(d) && y > 0)
+				continue;
+			if(!std::isfinite(d))
+			{
+				m_bGPS	= false;
+				break;
+			}
+			dValue[x]	+= d / dScale;
+		}
+
+		// the reference tag follows the coordinate
+		if(getTag(iTag[x] - 1, 6).toString().startsWith(cNegative[x]))
+			dValue[x]	= -dValue[x];
+	}
+
+	if(m_bGPS)
+	{
+		m_dLatitude		= dValue[0];
+		m_dLongitude	= dValue[1];
+	}
+
+	QVariant	altitude	= getTag(0x0006, 6);
+
+	m_bGPSAltitude	= altitude.isValid() && std::isfinite(altitude.toDouble());
+	if(m_bGPSAltitude)
+	{
+		m_dAltitude	= altitude.toDouble();
+		if(getTag(0x0005, 6).toInt() == 1)
+			m_dAltitude	= -m_dAltitude;
+	}
+}
+
+void cEXIF::readXMP(const char* lpData, qint64 iSize)
+{
+	QElapsedTimer	timer;
+
+	timer.start();
+	m_xmpScanner.scan(lpData, iSize, m_xmpValueList);
+
+	if(m_lpStatistics)
+	{
+		m_lpStatistics->addTime("xmp/scan", timer.nsecsElapsed());
+		m_lpStatistics->addCount("xmp/bytes", iSize);
+	}
+}
+
+void cEXIF::readXMP(const Exiv2::XmpData& xmpData)
+{
+	QElapsedTimer					timer;
+	const QList<cXMPProperty>&		propertyList	= m_xmpScanner.propertyList();
+	Exiv2::XmpData::const_iterator	end				= xmpData.end();
+
+	timer.start();
+
+	m_xmpValueList.clear();
+	for(int x = 0;x < propertyList.count();x++)
+	{
+		QString	szValue;
+
+		try
+		{
+			Exiv2::XmpData::const_iterator	i	= xmpData.findKey(Exiv2::XmpKey(std::string("Xmp.") + propertyList[x].m_prefix.constData() + "." + propertyList[x].m_name.constData()));
+
+			if(i != end)
+			{
+				const Exiv2::Value&	value	= i->value();
+
+				// same conventions as cXMPScanner: x-default of language alternatives, array items joined with "; "
+				if(value.typeId() == Exiv2::langAlt)
+					szValue	= QString::fromStdString(static_cast<const Exiv2::LangAltValue&>(value).toString("x-default"));
+				else if(value.typeId() == Exiv2::xmpBag || value.typeId() == Exiv2::xmpSeq || value.typeId() == Exiv2::xmpAlt)
+				{
+					QStringList	itemList;
+
+					for(long y = 0;y < value.count();y++)
+						itemList.append(QString::fromStdString(value.toString(y)).simplified());
+					szValue	= itemList.join("; ");
+				}
+				else
+					szValue	= QString::fromStdString(value.toString());
+			}
+		}
+		catch (Exiv2::AnyError&)
+		{
+			// prefix not registered with Exiv2, the property can't be set
+		}
+		m_xmpValueList.append(szValue.simplified());
+	}
+
+	if(m_lpStatistics)
+		m_lpStatistics->addTime("xmp/decoded", timer.nsecsElapsed());
+}
+
+void cEXIF::readIPTC(const Exiv2::IptcData& iptcData)
+{
+	QElapsedTimer					timer;
+	QVector<QStringList>			valueList(m_iptcDatasetList.count());
+	bool							bUTF8	= false;
+	Exiv2::IptcData::const_iterator	end		= iptcData.end();
+
+	timer.start();
+
+	// IIM text is Latin-1 unless the envelope declares UTF-8 (ESC % G)
+	for(Exiv2::IptcData::const_iterator i = iptcData.begin(); i != end; ++i)
+	{
+		if(i->record() == Exiv2::IptcDataSets::envelope && i->tag() == Exiv2::IptcDataSets::CharacterSet)
+			bUTF8	= (i->toString() == "\x1b%G");
+	}
+
+	for(Exiv2::IptcData::const_iterator i = iptcData.begin(); i != end; ++i)
+	{
+		if(i->record() != Exiv2::IptcDataSets::application2)
+			continue;
+
+		qint32	iIndex	= m_iptcDatasetList.indexOf(i->tag());
+
+		if(iIndex < 0)
+			continue;
+
+		std::string	szValue	= i->toString();
+		QString		szText	= bUTF8 ? QString::fromUtf8(szValue.data(), static_cast<int>(szValue.size())) : QString::fromLatin1(szValue.data(), static_cast<int>(szValue.size()));
+
+		szText	= szText.simplified();
+		if(!szText.isEmpty())
+			valueList[iIndex].append(szText);
+	}
+
+	for(int x = 0;x < valueList.count();x++)
+		m_iptcValueList.append(valueList[x].join("; "));
+
+	if(m_lpStatistics)
+		m_lpStatistics->addTime("iptc/read", timer.nsecsElapsed());
+}
+
+void cEXIF::setReadPreview(bool bReadPreview)
+{
+	m_bReadPreview	= bReadPreview;
+}
+
+QByteArray cEXIF::previewData()
+{
+	return(m_previewData);
+}
+
+qint32 cEXIF::previewWidth()
+{
+	return(m_iPreviewWidth);
+}
+
+qint32 cEXIF::previewHeight()
+{
+	return(m_iPreviewHeight);
+}
 
+void cEXIF::setLibRaw(bool bLibRaw)
+{
+	m_bLibRaw	= bLibRaw;
+}
 
-cEXIF::cEXIF() :
-	m_iWidth(0),
-	m_iHeight(0),
-	m_szFileName("")
+void cEXIF::setStatistics(cStatistics* lpStatistics)
 {
+	m_lpStatistics	= lpStatistics;
 }
 
-bool cEXIF::fromFile(const QString& szFileName)
+void cEXIF::setIOMode(cFileInput::IOMode ioMode, qint64 iPrefixSize)
 {
-	if(!QFile::exists(szFileName))
-		return(false);
+	m_ioMode		= ioMode;
+	m_iPrefixSize	= iPrefixSize;
+}
 
-	m_exifValueList.clear();
+void cEXIF::setImageFactory(bool bImageFactory)
+{
+	m_bImageFactory	= bImageFactory;
+}
 
-	m_szFileName	= "";
+void cEXIF::setMakerNote(bool bMakerNote)
+{
+	m_bMakerNote	= bMakerNote;
+	m_ifdView.setMakerNotes(bMakerNote);
+}
 
-	Exiv2::Image::UniquePtr	image;
+bool cEXIF::setXMPProperties(const QStringList& szPropertyList)
+{
+	return(m_xmpScanner.setProperties(szPropertyList));
+}
+
+bool cEXIF::setIPTCDatasets(const QStringList& szDatasetList)
+{
+	m_iptcDatasetList.clear();
 
 	try
 	{
-		image	= Exiv2::ImageFactory::open(szFileName.toLocal8Bit().toStdString());
+		for(int x = 0;x < szDatasetList.count();x++)
+			m_iptcDatasetList.append(Exiv2::IptcDataSets::dataSet(szDatasetList[x].trimmed().toStdString(), Exiv2::IptcDataSets::application2));
 	}
 	catch (Exiv2::AnyError& e)
 	{
 		qDebug() << e.what();
-//		std::cout << "Caught Exiv2 exception '" << e << "'\n";
+		m_iptcDatasetList.clear();
 		return(false);
 	}
+	return(true);
+}
 
-	if(!image.get())
-		return(false);
+bool cEXIF::isRAW(const QString& szFileName)
+{
+	static const QStringList	szRAWList	= QStringList() << "3fr" << "arw" << "cr2" << "cr3" << "crw" << "dcr" << "dng" << "erf" << "iiq" << "k25" << "kdc" << "mef" << "mos" << "mrw" << "nef" << "nrw" << "orf" << "pef" << "raf" << "raw" << "rw2" << "rwl" << "sr2" << "srf" << "srw" << "x3f";
 
-	image->readMetadata();
+	return(szRAWList.contains(QFileInfo(szFileName).suffix().toLower()));
+}
 
-	Exiv2::ExifData&				exifData	= image->exifData();
+cEXIF::ImageFormat cEXIF::imageFormat(const uchar* lpData, qint64 iSize)
+{
+	if(!lpData || iSize < 16)
+		return(ImageFormatUnknown);
+
+	if(lpData[0] == 0xff && lpData[1] == 0xd8)
+		return(ImageFormatJPEG);
+	if(!memcmp(lpData, "\x89PNG\r\n\x1a\n", 8))
+		return(ImageFormatPNG);
+	if(!memcmp(lpData, "RIFF", 4) && !memcmp(lpData + 8, "WEBP", 4))
+		return(ImageFormatWebP);
+	if(!memcmp(lpData, "FUJIFILMCCD-RAW", 15))
+		return(ImageFormatRAF);
+	if(!memcmp(lpData, "\0MRM", 4))
+		return(ImageFormatMRW);
+	if(!memcmp(lpData, "II\x1a\0\0\0HEAPCCDR", 14))
+		return(ImageFormatCRW);
+	if(!memcmp(lpData, "IIU\0", 4))
+		return(ImageFormatRW2);
+	if(!memcmp(lpData, "IIRO", 4) || !memcmp(lpData, "IIRS", 4) || !memcmp(lpData, "MMOR", 4))
+		return(ImageFormatORF);
+	if(!memcmp(lpData, "II*\0", 4))
+		return(!memcmp(lpData + 8, "CR\x02", 3) ? ImageFormatCR2 : ImageFormatTIFF);
+	if(!memcmp(lpData, "MM\0*", 4))
+		return(ImageFormatTIFF);
+
+	return(ImageFormatUnknown);
+}
 
-	m_iWidth		= image->pixelWidth();
-	m_iHeight		= image->pixelHeight();
-	m_szFileName	= szFileName;
+cEXIF::ImageFormat cEXIF::imageFormat(const QString& szFileName)
+{
+	static const QHash<QString, ImageFormat>	formatList	= {
+		{"jpg", ImageFormatJPEG}, {"jpeg", ImageFormatJPEG}, {"jpe", ImageFormatJPEG},
+		{"tif", ImageFormatTIFF}, {"tiff", ImageFormatTIFF}, {"nef", ImageFormatTIFF}, {"nrw", ImageFormatTIFF},
+		{"arw", ImageFormatTIFF}, {"sr2", ImageFormatTIFF}, {"srf", ImageFormatTIFF}, {"dng", ImageFormatTIFF},
+		{"pef", ImageFormatTIFF}, {"3fr", ImageFormatTIFF}, {"erf", ImageFormatTIFF}, {"kdc", ImageFormatTIFF},
+		{"dcr", ImageFormatTIFF}, {"mos", ImageFormatTIFF}, {"mef", ImageFormatTIFF}, {"iiq", ImageFormatTIFF},
+		{"srw", ImageFormatTIFF},
+		{"cr2", ImageFormatCR2},
+		{"crw", ImageFormatCRW},
+		{"orf", ImageFormatORF},
+		{"rw2", ImageFormatRW2}, {"rwl", ImageFormatRW2},
+		{"raf", ImageFormatRAF},
+		{"mrw", ImageFormatMRW},
+		{"png", ImageFormatPNG},
+		{"webp", ImageFormatWebP},
+	};
+
+	return(formatList.value(QFileInfo(szFileName).suffix().toLower(), ImageFormatUnknown));
+}
 
-	if(!exifData.empty())
+QString cEXIF::imageFormatName(ImageFormat format)
+{
+	static const QStringList	szNameList	= QStringList() << "unknown" << "jpeg" << "tiff" << "cr2" << "crw" << "orf" << "rw2" << "raf" << "mrw" << "png" << "webp";
+
+	return(szNameList.value(format, "unknown"));
+}
+
+bool cEXIF::readLibRaw(const QString& szFileName)
+{
+	QElapsedTimer	timer;
+	QString			szSuffix	= QFileInfo(szFileName).suffix().toLower();
+
+	timer.start();
+
+	// LibRaw is large (several hundred KB), don't put it on the worker's stack
+	LibRaw*	lpRawProcessor	= new LibRaw;
+#ifdef Q_OS_WIN
+	int		iRet			= lpRawProcessor->open_file(reinterpret_cast<const wchar_t*>(szFileName.utf16()));
+#else
+	int		iRet			= lpRawProcessor->open_file(QFile::encodeName(szFileName).constData());
+#endif
+
+	if(iRet != LIBRAW_SUCCESS)
 	{
-		Exiv2::ExifData::const_iterator	end			= exifData.end();
-		for(Exiv2::ExifData::const_iterator i = exifData.begin(); i != end; ++i)
-		{
-			cEXIFTag*	lpTag	= m_exifTagList.find(i->tag(), i->ifdId());
+		delete lpRawProcessor;
 
-			if(lpTag)
-			{
-				cEXIFValue*	lpValue	= m_exifValueList.add(lpTag);
-				if(lpValue)
-					lpValue->setValue(QString::fromStdString(i->value().toString()), i->typeId(), i->count());
-			}
-		}
+		if(m_lpStatistics)
+			m_lpStatistics->addCount("libraw/" + szSuffix + " failed");
+		return(false);
 	}
 
+	qint32	iWidth	= lpRawProcessor->imgdata.sizes.width;
+	qint32	iHeight	= lpRawProcessor->imgdata.sizes.height;
+
+	lpRawProcessor->recycle();
+	delete lpRawProcessor;
+
+	if(m_lpStatistics)
+	{
+		m_lpStatistics->addTime("libraw/" + szSuffix, timer.nsecsElapsed());
+
+		if(iWidth != m_iWidth || iHeight != m_iHeight)
+			m_lpStatistics->addCount("libraw/" + szSuffix + " size differs from exiv2");
+	}
+
+	if(!iWidth || !iHeight)
+		return(false);
+
+	m_iWidth	= iWidth;
+	m_iHeight	= iHeight;
+
 	return(true);
 }
 
@@ -103,9 +1179,7 @@ QString cEXIF::cameraModel()
 
 QDateTime cEXIF::dateTime()
 {
-	QDateTime	dateTime	= QDateTime::fromString(getTag(0x0132, 1).value<QString>(), "yyyy:MM:dd hh:mm:ss");
-
-	return(dateTime);
+	return(toDateTime(getTag(0x0132, 1).value<QString>()));
 }
 
 QString cEXIF::fNumber()
@@ -120,7 +1194,7 @@ qint32 cEXIF::iso()
 
 QString cEXIF::flash()
 {
-	return(m_exifFlashList.flash(getTag(0x9209, 5).value<qint32>()));
+	return(flashList().flash(getTag(0x9209, 5).value<qint32>()));
 }
 
 qint32 cEXIF::flashID()
@@ -140,7 +1214,97 @@ QString cEXIF::lensMake()
 
 QString cEXIF::lensModel()
 {
-	return(getTag(0xa434, 5).value<QString>());
+	QString	szLens	= getTag(0xa434, 5).value<QString>();
+
+	if(m_bMakerNote && szLens.trimmed().isEmpty())
+		return(makerNoteLens());
+	return(szLens);
+}
+
+QString cEXIF::makerNoteLens()
+{
+	QString	szLens	= getTag(0x0095, IFD_MAKERNOTE_CANON).toString().trimmed();
+
+	if(!szLens.isEmpty())
+		return(szLens);
+
+	// minimum and maximum focal length, maximum aperture at both
+	QList<QVariant>	lensList	= getTagList(0x0084, IFD_MAKERNOTE_NIKON);
+
+	if(lensList.count() == 4)
+	{
+		double	dFocal[2]		= { lensList[0].toDouble(), lensList[1].toDouble() };
+		double	dAperture[2]	= { lensList[2].toDouble(), lensList[3].toDouble() };
+
+		// 0/0 for lenses the camera does not know
+		if(dFocal[0] > 0 && dFocal[1] >= dFocal[0])
+		{
+			szLens	= QString::number(dFocal[0]);
+			if(dFocal[1] > dFocal[0])
+				szLens	+= "-" + QString::number(dFocal[1]);
+			szLens	+= "mm";
+
+			if(dAperture[0] > 0)
+			{
+				szLens	+= " f/" + QString::number(dAperture[0]);
+				if(dAperture[1] > dAperture[0])
+					szLens	+= "-" + QString::number(dAperture[1]);
+			}
+			return(szLens);
+		}
+	}
+
+	// 65535 for E-mount lenses, which are only named in encrypted tags
+	QVariant	sonyLens	= getTag(0xb027, IFD_MAKERNOTE_SONY);
+
+	if(sonyLens.isValid() && sonyLens.toInt() != 65535)
+		return(QString("Sony lens %1").arg(sonyLens.toInt()));
+
+	return("");
+}
+
+qint32 cEXIF::shutterCount()
+{
+	if(!m_bMakerNote)
+		return(0);
+
+	QVariant	nikon	= getTag(0x00a7, IFD_MAKERNOTE_NIKON);
+
+	if(nikon.isValid())
+		return(nikon.toInt());
+
+	// the upper bit is a flag
+	QVariant	fuji	= getTag(0x1438, IFD_MAKERNOTE_FUJI);
+
+	if(fuji.isValid())
+		return(fuji.toInt() & 0x7fff);
+
+	return(0);
+}
+
+void cEXIF::countMakerNote(qint32 iIFD)
+{
+	if(!m_lpStatistics || !m_bMakerNote)
+		return;
+
+	switch(iIFD)
+	{
+	case IFD_MAKERNOTE_CANON:
+		m_lpStatistics->addCount("makernote/canon");
+		break;
+	case IFD_MAKERNOTE_NIKON:
+		m_lpStatistics->addCount("makernote/nikon");
+		break;
+	case IFD_MAKERNOTE_SONY:
+		m_lpStatistics->addCount("makernote/sony");
+		break;
+	case IFD_MAKERNOTE_FUJI:
+		m_lpStatistics->addCount("makernote/fuji");
+		break;
+	default:
+		m_lpStatistics->addCount("makernote/none");
+		break;
+	}
 }
 
 QString cEXIF::exposureTime()
@@ -168,12 +1332,12 @@ QString cEXIF::exifVersion()
 
 QDateTime cEXIF::dateTimeOriginal()
 {
-	return(QDateTime::fromString(getTag(0x9003, 5).value<QString>(), "yyyy:MM:dd hh:mm:ss"));
+	return(toDateTime(getTag(0x9003, 5).value<QString>()));
 }
 
 QDateTime cEXIF::dateTimeDigitized()
 {
-	return(QDateTime::fromString(getTag(0x9004, 5).value<QString>(), "yyyy:MM:dd hh:mm:ss"));
+	return(toDateTime(getTag(0x9004, 5).value<QString>()));
 }
 
 qint32 cEXIF::whiteBalance()
@@ -196,10 +1360,132 @@ QString cEXIF::gps()
 	if(eList.count() != 3)
 		return("");
 
-	QString szGPS	= QString("%1 %2° %3' %4\" %5 %6° %7' %8\"").arg(getTag(0x0001, 6).value<QString>()).arg(nList[0].value<QString>()).arg(nList[1].value<QString>()).arg(nList[2].value<QString>()).arg(getTag(0x0001, 6).value<QString>()).arg(eList[0].value<QString>()).arg(eList[1].value<QString>()).arg(eList[2].value<QString>());
+	QString szGPS	= QString("%1 %2° %3' %4\" %5 %6° %7' %8\"").arg(getTag(0x0001, 6).toString(), nList[0].toString(), nList[1].toString(), nList[2].toString(), getTag(0x0003, 6).toString(), eList[0].toString(), eList[1].toString(), eList[2].toString());
 	return(szGPS);
 }
 
+bool cEXIF::hasGPS()
+{
+	return(m_bGPS);
+}
+
+double cEXIF::gpsLatitude()
+{
+	return(m_dLatitude);
+}
+
+double cEXIF::gpsLongitude()
+{
+	return(m_dLongitude);
+}
+
+bool cEXIF::hasGPSAltitude()
+{
+	return(m_bGPSAltitude);
+}
+
+double cEXIF::gpsAltitude()
+{
+	return(m_dAltitude);
+}
+
+bool cEXIF::hasTimestamp()
+{
+	return(m_bTimestamp);
+}
+
+qint64 cEXIF::timestamp()
+{
+	return(m_iTimestamp);
+}
+
+bool cEXIF::hasUTCOffset()
+{
+	return(m_bUTCOffset);
+}
+
+qint32 cEXIF::utcOffset()
+{
+	return(m_iUTCOffset);
+}
+
+bool cEXIF::hasGPSTimestamp()
+{
+	return(m_bGPSTimestamp);
+}
+
+qint64 cEXIF::gpsTimestamp()
+{
+	return(m_iGPSTimestamp);
+}
+
+QStringList cEXIF::xmpValues()
+{
+	return(m_xmpValueList);
+}
+
+QStringList cEXIF::iptcValues()
+{
+	return(m_iptcValueList);
+}
+
+void cEXIF::readTimestamps()
+{
+	qint64	iSeconds;
+
+	if(parseEXIFDate(getTag(0x001d, 6).value<QString>(), 10, iSeconds))
+	{
+		QList<QVariant>	timeList	= getTagList(0x0007, 6);
+
+		if(timeList.count() == 3)
+		{
+			double	dTime	= timeList[0].value<double>() * 3600 + timeList[1].value<double>() * 60 + timeList[2].value<double>();
+
+			if(dTime >= 0 && dTime < 86401)
+			{
+				m_iGPSTimestamp	= iSeconds * NSECS_PER_SECOND + static_cast<qint64>(dTime * NSECS_PER_SECOND);
+				m_bGPSTimestamp	= true;
+			}
+		}
+	}
+
+	// the capture time, or the modification time if there is none
+	qint32	iDate		= 0x9003;
+	qint32	iSubSec		= 0x9291;
+	qint32	iOffset		= 0x9011;
+	qint32	iIFD		= 5;
+
+	if(!parseEXIFDate(getTag(iDate, iIFD).value<QString>(), 19, iSeconds))
+	{
+		iDate	= 0x0132;
+		iSubSec	= 0x9290;
+		iOffset	= 0x9010;
+		iIFD	= 1;
+
+		if(!parseEXIFDate(getTag(iDate, iIFD).value<QString>(), 19, iSeconds))
+			return;
+	}
+
+	qint64	iLocal	= iSeconds * NSECS_PER_SECOND + parseSubSeconds(getTag(iSubSec, 5).value<QString>());
+
+	m_bUTCOffset	= parseOffset(getTag(iOffset, 5).value<QString>(), m_iUTCOffset);
+
+	// without an offset tag the zone follows from the GPS clock, rounded to 15 minutes
+	if(!m_bUTCOffset && m_bGPSTimestamp)
+	{
+		qint64	iDifference	= (iLocal - m_iGPSTimestamp) / NSECS_PER_SECOND;
+
+		if(iDifference >= -14 * 3600 - 450 && iDifference <= 14 * 3600 + 450)
+		{
+			m_iUTCOffset	= static_cast<qint32>((iDifference + (iDifference < 0 ? -450 : 450)) / 900 * 900);
+			m_bUTCOffset	= true;
+		}
+	}
+
+	m_iTimestamp	= iLocal - (m_bUTCOffset ? m_iUTCOffset * NSECS_PER_SECOND : 0);
+	m_bTimestamp	= true;
+}
+
 QString cEXIF::fileName()
 {
 	return(m_szFileName);
@@ -207,12 +1493,7 @@ QString cEXIF::fileName()
 
 QVariant cEXIF::getTag(qint32 iTAGID, qint32 iIFDID)
 {
-	cEXIFTag*	lpTag	= m_exifTagList.find(iTAGID, iIFDID);
-
-	if(!lpTag)
-		return(QVariant());
-
-	cEXIFValue*	lpValue	= m_exifValueList.find(lpTag);
+	cEXIFValue*	lpValue	= findValue(iTAGID, iIFDID);
 
 	if(!lpValue)
 		return(QVariant());
@@ -222,17 +1503,34 @@ QVariant cEXIF::getTag(qint32 iTAGID, qint32 iIFDID)
 
 QList<QVariant> cEXIF::getTagList(qint32 iTAGID, qint32 iIFDID)
 {
-	cEXIFTag*	lpTag	= m_exifTagList.find(iTAGID, iIFDID);
+	cEXIFValue*	lpValue	= findValue(iTAGID, iIFDID);
 
-	if(!lpTag)
+	if(!lpValue)
 		return(QList<QVariant>());
 
+	return(lpValue->valueList());
+}
+
+cEXIFValue* cEXIF::findValue(qint32 iTAGID, qint32 iIFDID)
+{
+	cEXIFTag*	lpTag	= tagList().find(iTAGID, iIFDID);
+
+	if(!lpTag)
+		return(nullptr);
+
 	cEXIFValue*	lpValue	= m_exifValueList.find(lpTag);
 
-	if(!lpValue)
-		return(QList<QVariant>());
+	if(lpValue)
+		return(lpValue);
 
-	return(lpValue->valueList());
+	const cIFDEntry*	lpEntry	= m_ifdView.find(iTAGID, iIFDID);
+
+	if(!lpEntry)
+		return(nullptr);
+
+	lpValue	= m_exifValueList.add(lpTag);
+	lpValue->setValue(m_ifdView.data(*lpEntry), lpEntry->m_iType, lpEntry->m_iCount, m_ifdView.isBigEndian());
+	return(lpValue);
 }
 
 cEXIFCompression::cEXIFCompression(const qint32& iID, const QString& szCompression) :
@@ -243,55 +1541,55 @@ cEXIFCompression::cEXIFCompression(const qint32& iID, const QString& szCompressi
 
 cEXIFCompressionList::cEXIFCompressionList()
 {
-	add(0x0001, QObject::tr("Uncompressed"));
-	add(0x0002, QObject::tr("CCITT 1D"));
-	add(0x0003, QObject::tr("T4/Group 3 Fax"));
-	add(0x0004, QObject::tr("T6/Group 4 Fax"));
-	add(0x0005, QObject::tr("LZW"));
-	add(0x0006, QObject::tr("JPEG (old-style)"));
-	add(0x0007, QObject::tr("JPEG"));
-	add(0x0008, QObject::tr("Adobe Deflate"));
-	add(0x0009, QObject::tr("JBIG B&W"));
-	add(0x000A, QObject::tr("JBIG Color"));
-	add(0x0063, QObject::tr("JPEG"));
-	add(0x0106, QObject::tr("Kodak 262"));
-	add(0x7FFE, QObject::tr("Next"));
-	add(0x7FFF, QObject::tr("Sony ARW Compressed"));
-	add(0x8001, QObject::tr("Packed RAW"));
-	add(0x8002, QObject::tr("Samsung SRW Compressed"));
-	add(0x8003, QObject::tr("CCIRLEW"));
-	add(0x8004, QObject::tr("Samsung SRW Compressed 2"));
-	add(0x8005, QObject::tr("PackBits"));
-	add(0x8029, QObject::tr("Thunderscan"));
-	add(0x8063, QObject::tr("Kodak KDC Compressed"));
-	add(0x807F, QObject::tr("IT8CTPAD"));
-	add(0x8080, QObject::tr("IT8LW"));
-	add(0x8081, QObject::tr("IT8MP"));
-	add(0x8082, QObject::tr("IT8BL"));
-	add(0x808C, QObject::tr("PixarFilm"));
-	add(0x808D, QObject::tr("PixarLog"));
-	add(0x80B2, QObject::tr("Deflate"));
-	add(0x80B3, QObject::tr("DCS"));
-	add(0x80EB, QObject::tr("Aperio JPEG 2000 YCbCr"));
-	add(0x80ED, QObject::tr("Aperio JPEG 2000 RGB"));
-	add(0x8765, QObject::tr("JBIG"));
-	add(0x8774, QObject::tr("SGILog"));
-	add(0x8775, QObject::tr("SGILog24"));
-	add(0x8798, QObject::tr("JPEG 2000"));
-	add(0x8799, QObject::tr("Nikon NEF Compressed"));
-	add(0x879B, QObject::tr("JBIG2 TIFF FX"));
-	add(0x879E, QObject::tr("Microsoft Document Imaging (MDI) Binary Level Codec"));
-	add(0x879F, QObject::tr("Microsoft Document Imaging (MDI) Progressive Transform Codec"));
-	add(0x87A0, QObject::tr("Microsoft Document Imaging (MDI) Vector"));
-	add(0x8847, QObject::tr("ESRI Lerc"));
-	add(0x884C, QObject::tr("Lossy JPEG"));
-	add(0x886D, QObject::tr("LZMA2"));
-	add(0x886E, QObject::tr("Zstd"));
-	add(0x886F, QObject::tr("WebP"));
-	add(0x8875, QObject::tr("PNG"));
-	add(0x8876, QObject::tr("JPEG XR"));
-	add(0xFDE8, QObject::tr("Kodak DCR Compressed"));
-	add(0xFFFF, QObject::tr("Pentax PEF Compressed"));
+	add(0x0001, EXIF_TR("Uncompressed"));
+	add(0x0002, EXIF_TR("CCITT 1D"));
+	add(0x0003, EXIF_TR("T4/Group 3 Fax"));
+	add(0x0004, EXIF_TR("T6/Group 4 Fax"));
+	add(0x0005, EXIF_TR("LZW"));
+	add(0x0006, EXIF_TR("JPEG (old-style)"));
+	add(0x0007, EXIF_TR("JPEG"));
+	add(0x0008, EXIF_TR("Adobe Deflate"));
+	add(0x0009, EXIF_TR("JBIG B&W"));
+	add(0x000A, EXIF_TR("JBIG Color"));
+	add(0x0063, EXIF_TR("JPEG"));
+	add(0x0106, EXIF_TR("Kodak 262"));
+	add(0x7FFE, EXIF_TR("Next"));
+	add(0x7FFF, EXIF_TR("Sony ARW Compressed"));
+	add(0x8001, EXIF_TR("Packed RAW"));
+	add(0x8002, EXIF_TR("Samsung SRW Compressed"));
+	add(0x8003, EXIF_TR("CCIRLEW"));
+	add(0x8004, EXIF_TR("Samsung SRW Compressed 2"));
+	add(0x8005, EXIF_TR("PackBits"));
+	add(0x8029, EXIF_TR("Thunderscan"));
+	add(0x8063, EXIF_TR("Kodak KDC Compressed"));
+	add(0x807F, EXIF_TR("IT8CTPAD"));
+	add(0x8080, EXIF_TR("IT8LW"));
+	add(0x8081, EXIF_TR("IT8MP"));
+	add(0x8082, EXIF_TR("IT8BL"));
+	add(0x808C, EXIF_TR("PixarFilm"));
+	add(0x808D, EXIF_TR("PixarLog"));
+	add(0x80B2, EXIF_TR("Deflate"));
+	add(0x80B3, EXIF_TR("DCS"));
+	add(0x80EB, EXIF_TR("Aperio JPEG 2000 YCbCr"));
+	add(0x80ED, EXIF_TR("Aperio JPEG 2000 RGB"));
+	add(0x8765, EXIF_TR("JBIG"));
+	add(0x8774, EXIF_TR("SGILog"));
+	add(0x8775, EXIF_TR("SGILog24"));
+	add(0x8798, EXIF_TR("JPEG 2000"));
+	add(0x8799, EXIF_TR("Nikon NEF Compressed"));
+	add(0x879B, EXIF_TR("JBIG2 TIFF FX"));
+	add(0x879E, EXIF_TR("Microsoft Document Imaging (MDI) Binary Level Codec"));
+	add(0x879F, EXIF_TR("Microsoft Document Imaging (MDI) Progressive Transform Codec"));
+	add(0x87A0, EXIF_TR("Microsoft Document Imaging (MDI) Vector"));
+	add(0x8847, EXIF_TR("ESRI Lerc"));
+	add(0x884C, EXIF_TR("Lossy JPEG"));
+	add(0x886D, EXIF_TR("LZMA2"));
+	add(0x886E, EXIF_TR("Zstd"));
+	add(0x886F, EXIF_TR("WebP"));
+	add(0x8875, EXIF_TR("PNG"));
+	add(0x8876, EXIF_TR("JPEG XR"));
+	add(0xFDE8, EXIF_TR("Kodak DCR Compressed"));
+	add(0xFFFF, EXIF_TR("Pentax PEF Compressed"));
 }
 
 cEXIFCompression* cEXIFCompressionList::add(const qint32& iID, const QString& szCompression)
@@ -322,7 +1620,7 @@ QString cEXIFCompressionList::compression(const qint32& iID)
 {
 	cEXIFCompression* lpCompression	= find(iID);
 	if(!lpCompression)
-		return(QObject::tr("unknown"));
+		return(EXIF_TR("unknown"));
 	return(lpCompression->m_szCompression);
 }
 
@@ -334,27 +1632,27 @@ cEXIFLightSource::cEXIFLightSource(const qint32& iID, const QString& szLightSour
 
 cEXIFLightSourceList::cEXIFLightSourceList()
 {
-	add(0x0001, QObject::tr("Daylight"));
-	add(0x0002, QObject::tr("Fluorescent"));
-	add(0x0003, QObject::tr("Tungsten (Incandescent)"));
-	add(0x0004, QObject::tr("Flash"));
-	add(0x0009, QObject::tr("Fine Weather"));
-	add(0x000A, QObject::tr("Cloudy"));
-	add(0x000B, QObject::tr("Shade"));
-	add(0x000C, QObject::tr("Daylight Fluorescent"));
-	add(0x000D, QObject::tr("Day White Fluorescent"));
-	add(0x000E, QObject::tr("Cool White Fluorescent"));
-	add(0x000F, QObject::tr("White Fluorescent"));
-	add(0x0010, QObject::tr("Warm White Fluorescent"));
-	add(0x0011, QObject::tr("Standard Light A"));
-	add(0x0012, QObject::tr("Standard Light B"));
-	add(0x0013, QObject::tr("Standard Light C"));
-	add(0x0014, QObject::tr("D55"));
-	add(0x0015, QObject::tr("D65"));
-	add(0x0016, QObject::tr("D75"));
-	add(0x0017, QObject::tr("D50"));
-	add(0x0018, QObject::tr("ISO Studio Tungsten"));
-	add(0x00FF, QObject::tr("Other"));
+	add(0x0001, EXIF_TR("Daylight"));
+	add(0x0002, EXIF_TR("Fluorescent"));
+	add(0x0003, EXIF_TR("Tungsten (Incandescent)"));
+	add(0x0004, EXIF_TR("Flash"));
+	add(0x0009, EXIF_TR("Fine Weather"));
+	add(0x000A, EXIF_TR("Cloudy"));
+	add(0x000B, EXIF_TR("Shade"));
+	add(0x000C, EXIF_TR("Daylight Fluorescent"));
+	add(0x000D, EXIF_TR("Day White Fluorescent"));
+	add(0x000E, EXIF_TR("Cool White Fluorescent"));
+	add(0x000F, EXIF_TR("White Fluorescent"));
+	add(0x0010, EXIF_TR("Warm White Fluorescent"));
+	add(0x0011, EXIF_TR("Standard Light A"));
+	add(0x0012, EXIF_TR("Standard Light B"));
+	add(0x0013, EXIF_TR("Standard Light C"));
+	add(0x0014, EXIF_TR("D55"));
+	add(0x0015, EXIF_TR("D65"));
+	add(0x0016, EXIF_TR("D75"));
+	add(0x0017, EXIF_TR("D50"));
+	add(0x0018, EXIF_TR("ISO Studio Tungsten"));
+	add(0x00FF, EXIF_TR("Other"));
 }
 
 cEXIFLightSource* cEXIFLightSourceList::add(const qint32& iID, const QString& szLightSource)
@@ -385,7 +1683,7 @@ QString cEXIFLightSourceList::lightSource(const qint32& iID)
 {
 	cEXIFLightSource* lpLightSource	= find(iID);
 	if(!lpLightSource)
-		return(QObject::tr("unknown"));
+		return(EXIF_TR("unknown"));
 	return(lpLightSource->m_szLightSource);
 }
 
@@ -397,33 +1695,33 @@ cEXIFFlash::cEXIFFlash(const qint32& iID, const QString& szFlash) :
 
 cEXIFFlashList::cEXIFFlashList()
 {
-	add(0x00, QObject::tr("No Flash"));
-	add(0x01, QObject::tr("Fired"));
-	add(0x05, QObject::tr("Fired, Return not detected"));
-	add(0x07, QObject::tr("Fired, Return detected"));
-	add(0x08, QObject::tr("On, Did not fire"));
-	add(0x09, QObject::tr("On, Fired"));
-	add(0x0d, QObject::tr("On, Return not detected"));
-	add(0x0f, QObject::tr("On, Return detected"));
-	add(0x10, QObject::tr("Off, Did not fire"));
-	add(0x14, QObject::tr("Off, Did not fire, Return not detected"));
-	add(0x18, QObject::tr("Auto, Did not fire"));
-	add(0x19, QObject::tr("Auto, Fired"));
-	add(0x1d, QObject::tr("Auto, Fired, Return not detected"));
-	add(0x1f, QObject::tr("Auto, Fired, Return detected"));
-	add(0x20, QObject::tr("No Flash function"));
-	add(0x30, QObject::tr("Off, No flash function"));
-	add(0x41, QObject::tr("Fired, Red-eye reduction"));
-	add(0x45, QObject::tr("Fired, Red-eye reduction, Return not detected"));
-	add(0x47, QObject::tr("Fired, Red-eye reduction, Return detected"));
-	add(0x49, QObject::tr("On, Red-eye reduction"));
-	add(0x4d, QObject::tr("On, Red-eye reduction, Return not detected"));
-	add(0x4f, QObject::tr("On, Red-eye reduction, Return detected"));
-	add(0x50, QObject::tr("Off, Red-eye reduction"));
-	add(0x58, QObject::tr("Auto, Did not fire, Red-eye reduction"));
-	add(0x59, QObject::tr("Auto, Fired, Red-eye reduction"));
-	add(0x5d, QObject::tr("Auto, Fired, Red-eye reduction, Return not detected"));
-	add(0x5f, QObject::tr("Auto, Fired, Red-eye reduction, Return detected"));
+	add(0x00, EXIF_TR("No Flash"));
+	add(0x01, EXIF_TR("Fired"));
+	add(0x05, EXIF_TR("Fired, Return not detected"));
+	add(0x07, EXIF_TR("Fired, Return detected"));
+	add(0x08, EXIF_TR("On, Did not fire"));
+	add(0x09, EXIF_TR("On, Fired"));
+	add(0x0d, EXIF_TR("On, Return not detected"));
+	add(0x0f, EXIF_TR("On, Return detected"));
+	add(0x10, EXIF_TR("Off, Did not fire"));
+	add(0x14, EXIF_TR("Off, Did not fire, Return not detected"));
+	add(0x18, EXIF_TR("Auto, Did not fire"));
+	add(0x19, EXIF_TR("Auto, Fired"));
+	add(0x1d, EXIF_TR("Auto, Fired, Return not detected"));
+	add(0x1f, EXIF_TR("Auto, Fired, Return detected"));
+	add(0x20, EXIF_TR("No Flash function"));
+	add(0x30, EXIF_TR("Off, No flash function"));
+	add(0x41, EXIF_TR("Fired, Red-eye reduction"));
+	add(0x45, EXIF_TR("Fired, Red-eye reduction, Return not detected"));
+	add(0x47, EXIF_TR("Fired, Red-eye reduction, Return detected"));
+	add(0x49, EXIF_TR("On, Red-eye reduction"));
+	add(0x4d, EXIF_TR("On, Red-eye reduction, Return not detected"));
+	add(0x4f, EXIF_TR("On, Red-eye reduction, Return detected"));
+	add(0x50, EXIF_TR("Off, Red-eye reduction"));
+	add(0x58, EXIF_TR("Auto, Did not fire, Red-eye reduction"));
+	add(0x59, EXIF_TR("Auto, Fired, Red-eye reduction"));
+	add(0x5d, EXIF_TR("Auto, Fired, Red-eye reduction, Return not detected"));
+	add(0x5f, EXIF_TR("Auto, Fired, Red-eye reduction, Return detected"));
 }
 
 cEXIFFlash* cEXIFFlashList::add(const qint32& iID, const QString& szFlash)
@@ -454,7 +1752,7 @@ QString cEXIFFlashList::flash(const qint32& iID)
 {
 	cEXIFFlash* lpFlash	= find(iID);
 	if(!lpFlash)
-		return(QObject::tr("unknown"));
+		return(EXIF_TR("unknown"));
 	return(lpFlash->m_szFlash);
 }
 
@@ -469,321 +1767,330 @@ cEXIFTag::cEXIFTag(const qint32& iTAGID, const QString& szTAGName, const qint32&
 
 cEXIFTagList::cEXIFTagList()
 {
-	add(0x000b, QObject::tr("ProcessingSoftware"), 1, 2, QObject::tr("The name and version of the software used to post-process the picture."));
-	add(0x00fe, QObject::tr("NewSubfileType"), 1, 4, QObject::tr("A general indication of the kind of data contained in this subfile."));
-	add(0x00ff, QObject::tr("SubfileType"), 1, 3, QObject::tr("A general indication of the kind of data contained in this subfile. This field is deprecated. The NewSubfileType field should be used instead."));
-	add(0x0100, QObject::tr("ImageWidth"), 1, 4, QObject::tr("The number of columns of image data, equal to the number of pixels per row. In JPEG compressed data a JPEG marker is used instead of this tag."));
-	add(0x0101, QObject::tr("ImageHeight"), 1, 4, QObject::tr("The number of rows of image data. In JPEG compressed data a JPEG marker is used instead of this tag."));
-	add(0x0102, QObject::tr("BitsPerSample"), 1, 3, QObject::tr("The number of bits per image component. In this standard each component of the image is 8 bits, so the value for this tag is 8. See also <SamplesPerPixel>. In JPEG compressed data a JPEG marker is used instead of this tag."));
-	add(0x0103, QObject::tr("Compression"), 1, 3, QObject::tr("The compression scheme used for the image data. When a primary image is JPEG compressed, this designation is not necessary and is omitted. When thumbnails use JPEG compression, this tag value is set to 6."));
-	add(0x0106, QObject::tr("PhotometricInterpretation"), 1, 3, QObject::tr("The pixel composition. In JPEG compressed data a JPEG marker is used instead of this tag."));
-	add(0x0107, QObject::tr("Thresholding"), 1, 3, QObject::tr("For black and white TIFF files that represent shades of gray, the technique used to convert from gray to black and white pixels."));
-	add(0x0108, QObject::tr("CellWidth"), 1, 3, QObject::tr("The width of the dithering or halftoning matrix used to create a dithered or halftoned bilevel file."));
-	add(0x0109, QObject::tr("CellLength"), 1, 3, QObject::tr("The length of the dithering or halftoning matrix used to create a dithered or halftoned bilevel file."));
-	add(0x010a, QObject::tr("FillOrder"), 1, 3, QObject::tr("The logical order of bits within a byte"));
-	add(0x010d, QObject::tr("DocumentName"), 1, 2, QObject::tr("The name of the document from which this image was scanned"));
-	add(0x010e, QObject::tr("ImageDescription"), 1, 2, QObject::tr("A character string giving the title of the image. It may be a comment such as \"1988 company picnic\" or the like. Two-bytes character codes cannot be used. When a 2-bytes code is necessary, the Exif Private tag <UserComment> is to be used."));
-	add(0x010f, QObject::tr("Make"), 1, 2, QObject::tr("The manufacturer of the recording equipment. This is the manufacturer of the DSC, scanner, video digitizer or other equipment that generated the image. When the field is left blank, it is treated as unknown."));
-	add(0x0110, QObject::tr("Model"), 1, 2, QObject::tr("The model name or model number of the equipment. This is the model name or number of the DSC, scanner, video digitizer or other equipment that generated the image. When the field is left blank, it is treated as unknown."));
-	add(0x0111, QObject::tr("StripOffsets"), 1, 4, QObject::tr("For each strip, the byte offset of that strip. It is recommended that this be selected so the number of strip bytes does not exceed 64 Kbytes. With JPEG compressed data this designation is not needed and is omitted. See also <RowsPerStrip> and <StripByteCounts>."));
-	add(0x0112, QObject::tr("Orientation"), 1, 3, QObject::tr("The image orientation viewed in terms of rows and columns."));
-	add(0x0115, QObject::tr("SamplesPerPixel"), 1, 3, QObject::tr("The number of components per pixel. Since this standard applies to RGB and YCbCr images, the value set for this tag is 3. In JPEG compressed data a JPEG marker is used instead of this tag."));
-	add(0x0116, QObject::tr("RowsPerStrip"), 1, 4, QObject::tr("The number of rows per strip. This is the number of rows in the image of one strip when an image is divided into strips. With JPEG compressed data this designation is not needed and is omitted. See also <StripOffsets> and <StripByteCounts>."));
-	add(0x0117, QObject::tr("StripByteCounts"), 1, 4, QObject::tr("The total number of bytes in each strip. With JPEG compressed data this designation is not needed and is omitted."));
-	add(0x011a, QObject::tr("XResolution"), 1, 5, QObject::tr("The number of pixels per <ResolutionUnit> in the <ImageWidth> direction. When the image resolution is unknown, 72 [dpi] is designated."));
-	add(0x011b, QObject::tr("YResolution"), 1, 5, QObject::tr("The number of pixels per <ResolutionUnit> in the <ImageLength> direction. The same value as <XResolution> is designated."));
-	add(0x011c, QObject::tr("PlanarConfiguration"), 1, 3, QObject::tr("Indicates whether pixel components are recorded in a chunky or planar format. In JPEG compressed files a JPEG marker is used instead of this tag. If this field does not exist, the TIFF default of 1 (chunky) is assumed."));
-	add(0x0122, QObject::tr("GrayResponseUnit"), 1, 3, QObject::tr("The precision of the information contained in the GrayResponseCurve."));
-	add(0x0123, QObject::tr("GrayResponseCurve"), 1, 3, QObject::tr("For grayscale data, the optical density of each possible pixel value."));
-	add(0x0124, QObject::tr("T4Options"), 1, 4, QObject::tr("T.4-encoding options."));
-	add(0x0125, QObject::tr("T6Options"), 1, 4, QObject::tr("T.6-encoding options."));
-	add(0x0128, QObject::tr("ResolutionUnit"), 1, 3, QObject::tr("The unit for measuring <XResolution> and <YResolution>. The same unit is used for both <XResolution> and <YResolution>. If the image resolution is unknown, 2 (inches) is designated."));
-	add(0x0129, QObject::tr("PageNumber"), 1, 3, QObject::tr("The page number of the page from which this image was scanned."));
-	add(0x012d, QObject::tr("TransferFunction"), 1, 3, QObject::tr("A transfer function for the image, described in tabular style. Normally this tag is not necessary, since color space is specified in the color space information tag (<ColorSpace>)."));
-	add(0x0131, QObject::tr("Software"), 1, 2, QObject::tr("This tag records the name and version of the software or firmware of the camera or image input device used to generate the image. The detailed format is not specified, but it is recommended that the example shown below be followed. When the field is left blank, it is treated as unknown."));
-	add(0x0132, QObject::tr("DateTime"), 1, 2, QObject::tr("The date and time of image creation. In Exif standard, it is the date and time the file was changed."));
-	add(0x013b, QObject::tr("Artist"), 1, 2, QObject::tr("This tag records the name of the camera owner, photographer or image creator. The detailed format is not specified, but it is recommended that the information be written as in the example below for ease of Interoperability. When the field is left blank, it is treated as unknown. Ex.) \"Camera owner, John Smith; Photographer, Michael Brown; Image creator, Ken James\""));
-	add(0x013c, QObject::tr("HostComputer"), 1, 2, QObject::tr("This tag records information about the host computer used to generate the image."));
-	add(0x013d, QObject::tr("Predictor"), 1, 3, QObject::tr("A predictor is a mathematical operator that is applied to the image data before an encoding scheme is applied."));
-	add(0x013e, QObject::tr("WhitePoint"), 1, 5, QObject::tr("The chromaticity of the white point of the image. Normally this tag is not necessary, since color space is specified in the colorspace information tag (<ColorSpace>)."));
-	add(0x013f, QObject::tr("PrimaryChromaticities"), 1, 5, QObject::tr("The chromaticity of the three primary colors of the image. Normally this tag is not necessary, since colorspace is specified in the colorspace information tag (<ColorSpace>)."));
-	add(0x0140, QObject::tr("ColorMap"), 1, 3, QObject::tr("A color map for palette color images. This field defines a Red-Green-Blue color map (often called a lookup table) for palette-color images. In a palette-color image, a pixel value is used to index into an RGB lookup table."));
-	add(0x0141, QObject::tr("HalftoneHints"), 1, 3, QObject::tr("The purpose of the HalftoneHints field is to convey to the halftone function the range of gray levels within a colorimetrically-specified image that should retain tonal detail."));
-	add(0x0142, QObject::tr("TileWidth"), 1, 3, QObject::tr("The tile width in pixels. This is the number of columns in each tile."));
-	add(0x0143, QObject::tr("TileLength"), 1, 3, QObject::tr("The tile length (height) in pixels. This is the number of rows in each tile."));
-	add(0x0144, QObject::tr("TileOffsets"), 1, 3, QObject::tr("For each tile, the byte offset of that tile, as compressed and stored on disk. The offset is specified with respect to the beginning of the TIFF file. Note that this implies that each tile has a location independent of the locations of other tiles."));
-	add(0x0145, QObject::tr("TileByteCounts"), 1, 3, QObject::tr("For each tile, the number of (compressed) bytes in that tile. See TileOffsets for a description of how the byte counts are ordered."));
-	add(0x014a, QObject::tr("SubIFDs"), 1, 4, QObject::tr("Defined by Adobe Corporation to enable TIFF Trees within a TIFF file."));
-	add(0x014c, QObject::tr("InkSet"), 1, 3, QObject::tr("The set of inks used in a separated (PhotometricInterpretation=5) image."));
-	add(0x014d, QObject::tr("InkNames"), 1, 2, QObject::tr("The name of each ink used in a separated (PhotometricInterpretation=5) image."));
-	add(0x014e, QObject::tr("NumberOfInks"), 1, 3, QObject::tr("The number of inks. Usually equal to SamplesPerPixel, unless there are extra samples."));
-	add(0x0150, QObject::tr("DotRange"), 1, 1, QObject::tr("The component values that correspond to a 0% dot and 100% dot."));
-	add(0x0151, QObject::tr("TargetPrinter"), 1, 2, QObject::tr("A description of the printing environment for which this separation is intended."));
-	add(0x0152, QObject::tr("ExtraSamples"), 1, 3, QObject::tr("Specifies that each pixel has m extra components whose interpretation is defined by one of the values listed below."));
-	add(0x0153, QObject::tr("SampleFormat"), 1, 3, QObject::tr("This field specifies how to interpret each data sample in a pixel."));
-	add(0x0154, QObject::tr("SMinSampleValue"), 1, 3, QObject::tr("This field specifies the minimum sample value."));
-	add(0x0155, QObject::tr("SMaxSampleValue"), 1, 3, QObject::tr("This field specifies the maximum sample value."));
-	add(0x0156, QObject::tr("TransferRange"), 1, 3, QObject::tr("Expands the range of the TransferFunction"));
-	add(0x0157, QObject::tr("ClipPath"), 1, 1, QObject::tr("A TIFF ClipPath is intended to mirror the essentials of PostScript's path creation functionality."));
-	add(0x0158, QObject::tr("XClipPathUnits"), 1, 8, QObject::tr("The number of units that span the width of the image, in terms of integer ClipPath coordinates."));
-	add(0x0159, QObject::tr("YClipPathUnits"), 1, 8, QObject::tr("The number of units that span the height of the image, in terms of integer ClipPath coordinates."));
-	add(0x015a, QObject::tr("Indexed"), 1, 3, QObject::tr("Indexed images are images where the 'pixels' do not represent color values, but rather an index (usually 8-bit) into a separate color table, the ColorMap."));
-	add(0x015b, QObject::tr("JPEGTables"), 1, 7, QObject::tr("This optional tag may be used to encode the JPEG quantization and Huffman tables for subsequent use by the JPEG decompression process."));
-	add(0x015f, QObject::tr("OPIProxy"), 1, 3, QObject::tr("OPIProxy gives information concerning whether this image is a low-resolution proxy of a high-resolution image (Adobe OPI)."));
-	add(0x0200, QObject::tr("JPEGProc"), 1, 4, QObject::tr("This field indicates the process used to produce the compressed data"));
-	add(0x0201, QObject::tr("JPEGInterchangeFormat"), 1, 4, QObject::tr("The offset to the start byte (SOI) of JPEG compressed thumbnail data. This is not used for primary image JPEG data."));
-	add(0x0202, QObject::tr("JPEGInterchangeFormatLength"), 1, 4, QObject::tr("The number of bytes of JPEG compressed thumbnail data. This is not used for primary image JPEG data. JPEG thumbnails are not divided but are recorded as a continuous JPEG bitstream from SOI to EOI. Appn and COM markers should not be recorded. Compressed thumbnails must be recorded in no more than 64 Kbytes, including all other data to be recorded in APP1."));
-	add(0x0203, QObject::tr("JPEGRestartInterval"), 1, 3, QObject::tr("This Field indicates the length of the restart interval used in the compressed image data."));
-	add(0x0205, QObject::tr("JPEGLosslessPredictors"), 1, 3, QObject::tr("This Field points to a list of lossless predictor-selection values, one per component."));
-	add(0x0206, QObject::tr("JPEGPointTransforms"), 1, 3, QObject::tr("This Field points to a list of point transform values, one per component."));
-	add(0x0207, QObject::tr("JPEGQTables"), 1, 4, QObject::tr("This Field points to a list of offsets to the quantization tables, one per component."));
-	add(0x0208, QObject::tr("JPEGDCTables"), 1, 4, QObject::tr("This Field points to a list of offsets to the DC Huffman tables or the lossless Huffman tables, one per component."));
-	add(0x0209, QObject::tr("JPEGACTables"), 1, 4, QObject::tr("This Field points to a list of offsets to the Huffman AC tables, one per component."));
-	add(0x0211, QObject::tr("YCbCrCoefficients"), 1, 5, QObject::tr("The matrix coefficients for transformation from RGB to YCbCr image data. No default is given in TIFF; but here the value given in Appendix E, \"Color Space Guidelines\"), is used as the default. The color space is declared in a color space information tag, with the default being the value that gives the optimal image characteristics Interoperability this condition."));
-	add(0x0212, QObject::tr("YCbCrSubSampling"), 1, 3, QObject::tr("The sampling ratio of chrominance components in relation to the luminance component. In JPEG compressed data a JPEG marker is used instead of this tag."));
-	add(0x0213, QObject::tr("YCbCrPositioning"), 1, 3, QObject::tr("The position of chrominance components in relation to the luminance component. This field is designated only for JPEG compressed data or uncompressed YCbCr data. The TIFF default is 1 (centered); but when Y:Cb:Cr = 4:2:2 it is recommended in this standard that 2 (co-sited) be used to record data, in order to improve the image quality when viewed on TV systems. When this field does not exist, the reader shall assume the TIFF default. In the case of Y:Cb:Cr = 4:2:0, the TIFF default (centered) is recommended. If the reader does not have the capability of supporting both kinds of <YCbCrPositioning>, it shall follow the TIFF default regardless of the value in this field. It is preferable that readers be able to support both centered and co-sited positioning."));
-	add(0x0214, QObject::tr("ReferenceBlackWhite"), 1, 5, QObject::tr("The reference black point value and reference white point value. No defaults are given in TIFF, but the values below are given as defaults here. The color space is declared in a color space information tag, with the default being the value that gives the optimal image characteristics Interoperability these conditions."));
-	add(0x02bc, QObject::tr("XMLPacket"), 1, 1, QObject::tr("XMP Metadata (Adobe technote 9-14-02)"));
-	add(0x4746, QObject::tr("Rating"), 1, 3, QObject::tr("Rating tag used by Windows"));
-	add(0x4749, QObject::tr("RatingPercent"), 1, 3, QObject::tr("Rating tag used by Windows, value in percent"));
-	add(0x800d, QObject::tr("ImageID"), 1, 2, QObject::tr("ImageID is the full pathname of the original, high-resolution image, or any other identifying string that uniquely identifies the original image (Adobe OPI)."));
-	add(0x828d, QObject::tr("CFARepeatPatternDim"), 1, 3, QObject::tr("Contains two values representing the minimum rows and columns to define the repeating patterns of the color filter array"));
-	add(0x828e, QObject::tr("CFAPattern"), 1, 1, QObject::tr("Indicates the color filter array (CFA) geometric pattern of the image sensor when a one-chip color area sensor is used. It does not apply to all sensing methods"));
-	add(0x828f, QObject::tr("BatteryLevel"), 1, 5, QObject::tr("Contains a value of the battery level as a fraction or string"));
-	add(0x8298, QObject::tr("Copyright"), 1, 2, QObject::tr("Copyright information. In this standard the tag is used to indicate both the photographer and editor copyrights. It is the copyright notice of the person or organization claiming rights to the image. The Interoperability copyright statement including date and rights should be written in this field; e.g., \"Copyright, John Smith, 19xx. All rights reserved.\". In this standard the field records both the photographer and editor copyrights, with each recorded in a separate part of the statement. When there is a clear distinction between the photographer and editor copyrights, these are to be written in the order of photographer followed by editor copyright, separated by NULL (in this case since the statement also ends with a NULL, there are two NULL codes). When only the photographer copyright is given, it is terminated by one NULL code. When only the editor copyright is given, the photographer copyright part consists of one space followed by a terminating NULL code, then the editor copyright is given. When the field is left blank, it is treated as unknown."));
-	add(0x829a, QObject::tr("ExposureTime"), 1, 5, QObject::tr("Exposure time, given in seconds."));
-	add(0x829d, QObject::tr("FNumber"), 1, 5, QObject::tr("The F number."));
-	add(0x83bb, QObject::tr("IPTCNAA"), 1, 4, QObject::tr("Contains an IPTC/NAA record"));
-	add(0x8649, QObject::tr("ImageResources"), 1, 1, QObject::tr("Contains information embedded by the Adobe Photoshop application"));
-	add(0x8769, QObject::tr("ExifTag"), 1, 4, QObject::tr("A pointer to the Exif IFD. Interoperability, Exif IFD has the same structure as that of the IFD specified in TIFF. ordinarily, however, it does not contain image data as in the case of TIFF."));
-	add(0x8773, QObject::tr("InterColorProfile"), 1, 7, QObject::tr("Contains an InterColor Consortium (ICC) format color space characterization/profile"));
-	add(0x8822, QObject::tr("ExposureProgram"), 1, 3, QObject::tr("The class of the program used by the camera to set exposure when the picture is taken."));
-	add(0x8824, QObject::tr("SpectralSensitivity"), 1, 2, QObject::tr("Indicates the spectral sensitivity of each channel of the camera used."));
-	add(0x8825, QObject::tr("GPSTag"), 1, 4, QObject::tr("A pointer to the GPS Info IFD. The Interoperability structure of the GPS Info IFD, like that of Exif IFD, has no image data."));
-	add(0x8827, QObject::tr("ISOSpeedRatings"), 1, 3, QObject::tr("Indicates the ISO Speed and ISO Latitude of the camera or input device as specified in ISO 12232."));
-	add(0x8828, QObject::tr("OECF"), 1, 7, QObject::tr("Indicates the Opto-Electric Conversion Function (OECF) specified in ISO 14524."));
-	add(0x8829, QObject::tr("Interlace"), 1, 3, QObject::tr("Indicates the field number of multifield images."));
-	add(0x882a, QObject::tr("TimeZoneOffset"), 1, 8, QObject::tr("This optional tag encodes the time zone of the camera clock (relative to Greenwich Mean Time) used to create the DataTimeOriginal tag-value when the picture was taken. It may also contain the time zone offset of the clock used to create the DateTime tag-value when the image was modified."));
-	add(0x882b, QObject::tr("SelfTimerMode"), 1, 3, QObject::tr("Number of seconds image capture was delayed from button press."));
-	add(0x9003, QObject::tr("DateTimeOriginal"), 1, 2, QObject::tr("The date and time when the original image data was generated."));
-	add(0x9102, QObject::tr("CompressedBitsPerPixel"), 1, 5, QObject::tr("Specific to compressed data; states the compressed bits per pixel."));
-	add(0x9201, QObject::tr("ShutterSpeedValue"), 1, 10, QObject::tr("Shutter speed."));
-	add(0x9202, QObject::tr("ApertureValue"), 1, 5, QObject::tr("The lens aperture."));
-	add(0x9203, QObject::tr("BrightnessValue"), 1, 10, QObject::tr("The value of brightness."));
-	add(0x9204, QObject::tr("ExposureBiasValue"), 1, 10, QObject::tr("The exposure bias."));
-	add(0x9205, QObject::tr("MaxApertureValue"), 1, 5, QObject::tr("The smallest F number of the lens."));
-	add(0x9206, QObject::tr("SubjectDistance"), 1, 10, QObject::tr("The distance to the subject, given in meters."));
-	add(0x9207, QObject::tr("MeteringMode"), 1, 3, QObject::tr("The metering mode."));
-	add(0x9208, QObject::tr("LightSource"), 1, 3, QObject::tr("The kind of light source."));
-	add(0x9209, QObject::tr("Flash"), 1, 3, QObject::tr("Indicates the status of flash when the image was shot."));
-	add(0x920a, QObject::tr("FocalLength"), 1, 5, QObject::tr("The actual focal length of the lens, in mm."));
-	add(0x920b, QObject::tr("FlashEnergy"), 1, 5, QObject::tr("Amount of flash energy (BCPS)."));
-	add(0x920c, QObject::tr("SpatialFrequencyResponse"), 1, 7, QObject::tr("SFR of the camera."));
-	add(0x920d, QObject::tr("Noise"), 1, 7, QObject::tr("Noise measurement values."));
-	add(0x920e, QObject::tr("FocalPlaneXResolution"), 1, 5, QObject::tr("Number of pixels per FocalPlaneResolutionUnit (37392) in ImageWidth direction for main image."));
-	add(0x920f, QObject::tr("FocalPlaneYResolution"), 1, 5, QObject::tr("Number of pixels per FocalPlaneResolutionUnit (37392) in ImageLength direction for main image."));
-	add(0x9210, QObject::tr("FocalPlaneResolutionUnit"), 1, 3, QObject::tr("Unit of measurement for FocalPlaneXResolution(37390) and FocalPlaneYResolution(37391)."));
-	add(0x9211, QObject::tr("ImageNumber"), 1, 4, QObject::tr("Number assigned to an image, e.g., in a chained image burst."));
-	add(0x9212, QObject::tr("SecurityClassification"), 1, 2, QObject::tr("Security classification assigned to the image."));
-	add(0x9213, QObject::tr("ImageHistory"), 1, 2, QObject::tr("Record of what has been done to the image."));
-	add(0x9214, QObject::tr("SubjectLocation"), 1, 3, QObject::tr("Indicates the location and area of the main subject in the overall scene."));
-	add(0x9215, QObject::tr("ExposureIndex"), 1, 5, QObject::tr("Encodes the camera exposure index setting when image was captured."));
-	add(0x9216, QObject::tr("TIFFEPStandardID"), 1, 1, QObject::tr("Contains four ASCII characters representing the TIFF/EP standard version of a TIFF/EP file, eg '1', '0', '0', '0'"));
-	add(0x9217, QObject::tr("SensingMethod"), 1, 3, QObject::tr("Type of image sensor."));
-	add(0x9c9b, QObject::tr("XPTitle"), 1, 1, QObject::tr("Title tag used by Windows, encoded in UCS2"));
-	add(0x9c9c, QObject::tr("XPComment"), 1, 1, QObject::tr("Comment tag used by Windows, encoded in UCS2"));
-	add(0x9c9d, QObject::tr("XPAuthor"), 1, 1, QObject::tr("Author tag used by Windows, encoded in UCS2"));
-	add(0x9c9e, QObject::tr("XPKeywords"), 1, 1, QObject::tr("Keywords tag used by Windows, encoded in UCS2"));
-	add(0x9c9f, QObject::tr("XPSubject"), 1, 1, QObject::tr("Subject tag used by Windows, encoded in UCS2"));
-	add(0xc4a5, QObject::tr("PrintImageMatching"), 1, 7, QObject::tr("Print Image Matching, description needed."));
-	add(0xc612, QObject::tr("DNGVersion"), 1, 1, QObject::tr("This tag encodes the DNG four-tier version number. For files compliant with version 1.1.0.0 of the DNG specification, this tag should contain the bytes: 1, 1, 0, 0."));
-	add(0xc613, QObject::tr("DNGBackwardVersion"), 1, 1, QObject::tr("This tag specifies the oldest version of the Digital Negative specification for which a file is compatible. Readers shouldnot attempt to read a file if this tag specifies a version number that is higher than the version number of the specification the reader was based on. In addition to checking the version tags, readers should, for all tags, check the types, counts, and values, to verify it is able to correctly read the file."));
-	add(0xc614, QObject::tr("UniqueCameraModel"), 1, 2, QObject::tr("Defines a unique, non-localized name for the camera model that created the image in the raw file. This name should include the manufacturer's name to avoid conflicts, and should not be localized, even if the camera name itself is localized for different markets (see LocalizedCameraModel). This string may be used by reader software to index into per-model preferences and replacement profiles."));
-	add(0xc615, QObject::tr("LocalizedCameraModel"), 1, 1, QObject::tr("Similar to the UniqueCameraModel field, except the name can be localized for different markets to match the localization of the camera name."));
-	add(0xc616, QObject::tr("CFAPlaneColor"), 1, 1, QObject::tr("Provides a mapping between the values in the CFAPattern tag and the plane numbers in LinearRaw space. This is a required tag for non-RGB CFA images."));
-	add(0xc617, QObject::tr("CFALayout"), 1, 3, QObject::tr("Describes the spatial layout of the CFA."));
-	add(0xc618, QObject::tr("LinearizationTable"), 1, 3, QObject::tr("Describes a lookup table that maps stored values into linear values. This tag is typically used to increase compression ratios by storing the raw data in a non-linear, more visually uniform space with fewer total encoding levels. If SamplesPerPixel is not equal to one, this single table applies to all the samples for each pixel."));
-	add(0xc619, QObject::tr("BlackLevelRepeatDim"), 1, 3, QObject::tr("Specifies repeat pattern size for the BlackLevel tag."));
-	add(0xc61a, QObject::tr("BlackLevel"), 1, 5, QObject::tr("Specifies the zero light (a.k.a. thermal black or black current) encoding level, as a repeating pattern. The origin of this pattern is the top-left corner of the ActiveArea rectangle. The values are stored in row-column-sample scan order."));
-	add(0xc61b, QObject::tr("BlackLevelDeltaH"), 1, 10, QObject::tr("If the zero light encoding level is a function of the image column, BlackLevelDeltaH specifies the difference between the zero light encoding level for each column and the baseline zero light encoding level. If SamplesPerPixel is not equal to one, this single table applies to all the samples for each pixel."));
-	add(0xc61c, QObject::tr("BlackLevelDeltaV"), 1, 10, QObject::tr("If the zero light encoding level is a function of the image row, this tag specifies the difference between the zero light encoding level for each row and the baseline zero light encoding level. If SamplesPerPixel is not equal to one, this single table applies to all the samples for each pixel."));
-	add(0xc61d, QObject::tr("WhiteLevel"), 1, 3, QObject::tr("This tag specifies the fully saturated encoding level for the raw sample values. Saturation is caused either by the sensor itself becoming highly non-linear in response, or by the camera's analog to digital converter clipping."));
-	add(0xc61e, QObject::tr("DefaultScale"), 1, 5, QObject::tr("DefaultScale is required for cameras with non-square pixels. It specifies the default scale factors for each direction to convert the image to square pixels. Typically these factors are selected to approximately preserve total pixel count. For CFA images that use CFALayout equal to 2, 3, 4, or 5, such as the Fujifilm SuperCCD, these two values should usually differ by a factor of 2.0."));
-	add(0xc61f, QObject::tr("DefaultCropOrigin"), 1, 3, QObject::tr("Raw images often store extra pixels around the edges of the final image. These extra pixels help prevent interpolation artifacts near the edges of the final image. DefaultCropOrigin specifies the origin of the final image area, in raw image coordinates (i.e., before the DefaultScale has been applied), relative to the top-left corner of the ActiveArea rectangle."));
-	add(0xc620, QObject::tr("DefaultCropSize"), 1, 3, QObject::tr("Raw images often store extra pixels around the edges of the final image. These extra pixels help prevent interpolation artifacts near the edges of the final image. DefaultCropSize specifies the size of the final image area, in raw image coordinates (i.e., before the DefaultScale has been applied)."));
-	add(0xc621, QObject::tr("ColorMatrix1"), 1, 10, QObject::tr("ColorMatrix1 defines a transformation matrix that converts XYZ values to reference camera native color space values, under the first calibration illuminant. The matrix values are stored in row scan order. The ColorMatrix1 tag is required for all non-monochrome DNG files."));
-	add(0xc622, QObject::tr("ColorMatrix2"), 1, 10, QObject::tr("ColorMatrix2 defines a transformation matrix that converts XYZ values to reference camera native color space values, under the second calibration illuminant. The matrix values are stored in row scan order."));
-	add(0xc623, QObject::tr("CameraCalibration1"), 1, 10, QObject::tr("CameraCalibration1 defines a calibration matrix that transforms reference camera native space values to individual camera native space values under the first calibration illuminant. The matrix is stored in row scan order. This matrix is stored separately from the matrix specified by the ColorMatrix1 tag to allow raw converters to swap in replacement color matrices based on UniqueCameraModel tag, while still taking advantage of any per-individual camera calibration performed by the camera manufacturer."));
-	add(0xc624, QObject::tr("CameraCalibration2"), 1, 10, QObject::tr("CameraCalibration2 defines a calibration matrix that transforms reference camera native space values to individual camera native space values under the second calibration illuminant. The matrix is stored in row scan order. This matrix is stored separately from the matrix specified by the ColorMatrix2 tag to allow raw converters to swap in replacement color matrices based on UniqueCameraModel tag, while still taking advantage of any per-individual camera calibration performed by the camera manufacturer."));
-	add(0xc625, QObject::tr("ReductionMatrix1"), 1, 10, QObject::tr("ReductionMatrix1 defines a dimensionality reduction matrix for use as the first stage in converting color camera native space values to XYZ values, under the first calibration illuminant. This tag may only be used if ColorPlanes is greater than 3. The matrix is stored in row scan order."));
-	add(0xc626, QObject::tr("ReductionMatrix2"), 1, 10, QObject::tr("ReductionMatrix2 defines a dimensionality reduction matrix for use as the first stage in converting color camera native space values to XYZ values, under the second calibration illuminant. This tag may only be used if ColorPlanes is greater than 3. The matrix is stored in row scan order."));
-	add(0xc627, QObject::tr("AnalogBalance"), 1, 5, QObject::tr("Normally the stored raw values are not white balanced, since any digital white balancing will reduce the dynamic range of the final image if the user decides to later adjust the white balance; however, if camera hardware is capable of white balancing the color channels before the signal is digitized, it can improve the dynamic range of the final image. AnalogBalance defines the gain, either analog (recommended) or digital (not recommended) that has been applied the stored raw values."));
-	add(0xc628, QObject::tr("AsShotNeutral"), 1, 3, QObject::tr("Specifies the selected white balance at time of capture, encoded as the coordinates of a perfectly neutral color in linear reference space values. The inclusion of this tag precludes the inclusion of the AsShotWhiteXY tag."));
-	add(0xc629, QObject::tr("AsShotWhiteXY"), 1, 5, QObject::tr("Specifies the selected white balance at time of capture, encoded as x-y chromaticity coordinates. The inclusion of this tag precludes the inclusion of the AsShotNeutral tag."));
-	add(0xc62a, QObject::tr("BaselineExposure"), 1, 10, QObject::tr("Camera models vary in the trade-off they make between highlight headroom and shadow noise. Some leave a significant amount of highlight headroom during a normal exposure. This allows significant negative exposure compensation to be applied during raw conversion, but also means normal exposures will contain more shadow noise. Other models leave less headroom during normal exposures. This allows for less negative exposure compensation, but results in lower shadow noise for normal exposures. Because of these differences, a raw converter needs to vary the zero point of its exposure compensation control from model to model. BaselineExposure specifies by how much (in EV units) to move the zero point. Positive values result in brighter default results, while negative values result in darker default results."));
-	add(0xc62b, QObject::tr("BaselineNoise"), 1, 5, QObject::tr("Specifies the relative noise level of the camera model at a baseline ISO value of 100, compared to a reference camera model. Since noise levels tend to vary approximately with the square root of the ISO value, a raw converter can use this value, combined with the current ISO, to estimate the relative noise level of the current image."));
-	add(0xc62c, QObject::tr("BaselineSharpness"), 1, 5, QObject::tr("Specifies the relative amount of sharpening required for this camera model, compared to a reference camera model. Camera models vary in the strengths of their anti-aliasing filters. Cameras with weak or no filters require less sharpening than cameras with strong anti-aliasing filters."));
-	add(0xc62d, QObject::tr("BayerGreenSplit"), 1, 4, QObject::tr("Only applies to CFA images using a Bayer pattern filter array. This tag specifies, in arbitrary units, how closely the values of the green pixels in the blue/green rows track the values of the green pixels in the red/green rows. A value of zero means the two kinds of green pixels track closely, while a non-zero value means they sometimes diverge. The useful range for this tag is from 0 (no divergence) to about 5000 (quite large divergence)."));
-	add(0xc62e, QObject::tr("LinearResponseLimit"), 1, 5, QObject::tr("Some sensors have an unpredictable non-linearity in their response as they near the upper limit of their encoding range. This non-linearity results in color shifts in the highlight areas of the resulting image unless the raw converter compensates for this effect. LinearResponseLimit specifies the fraction of the encoding range above which the response may become significantly non-linear."));
-	add(0xc62f, QObject::tr("CameraSerialNumber"), 1, 2, QObject::tr("CameraSerialNumber contains the serial number of the camera or camera body that captured the image."));
-	add(0xc630, QObject::tr("LensInfo"), 1, 5, QObject::tr("Contains information about the lens that captured the image. If the minimum f-stops are unknown, they should be encoded as 0/0."));
-	add(0xc631, QObject::tr("ChromaBlurRadius"), 1, 5, QObject::tr("ChromaBlurRadius provides a hint to the DNG reader about how much chroma blur should be applied to the image. If this tag is omitted, the reader will use its default amount of chroma blurring. Normally this tag is only included for non-CFA images, since the amount of chroma blur required for mosaic images is highly dependent on the de-mosaic algorithm, in which case the DNG reader's default value is likely optimized for its particular de-mosaic algorithm."));
-	add(0xc632, QObject::tr("AntiAliasStrength"), 1, 5, QObject::tr("Provides a hint to the DNG reader about how strong the camera's anti-alias filter is. A value of 0.0 means no anti-alias filter (i.e., the camera is prone to aliasing artifacts with some subjects), while a value of 1.0 means a strong anti-alias filter (i.e., the camera almost never has aliasing artifacts)."));
-	add(0xc633, QObject::tr("ShadowScale"), 1, 10, QObject::tr("This tag is used by Adobe Camera Raw to control the sensitivity of its 'Shadows' slider."));
-	add(0xc634, QObject::tr("DNGPrivateData"), 1, 1, QObject::tr("Provides a way for camera manufacturers to store private data in the DNG file for use by their own raw converters, and to have that data preserved by programs that edit DNG files."));
-	add(0xc635, QObject::tr("MakerNoteSafety"), 1, 3, QObject::tr("MakerNoteSafety lets the DNG reader know whether the EXIF MakerNote tag is safe to preserve along with the rest of the EXIF data. File browsers and other image management software processing an image with a preserved MakerNote should be aware that any thumbnail image embedded in the MakerNote may be stale, and may not reflect the current state of the full size image."));
-	add(0xc65a, QObject::tr("CalibrationIlluminant1"), 1, 3, QObject::tr("The illuminant used for the first set of color calibration tags (ColorMatrix1, CameraCalibration1, ReductionMatrix1). The legal values for this tag are the same as the legal values for the LightSource EXIF tag."));
-	add(0xc65b, QObject::tr("CalibrationIlluminant2"), 1, 3, QObject::tr("The illuminant used for an optional second set of color calibration tags (ColorMatrix2, CameraCalibration2, ReductionMatrix2). The legal values for this tag are the same as the legal values for the CalibrationIlluminant1 tag; however, if both are included, neither is allowed to have a value of 0 (unknown)."));
-	add(0xc65c, QObject::tr("BestQualityScale"), 1, 5, QObject::tr("For some cameras, the best possible image quality is not achieved by preserving the total pixel count during conversion. For example, Fujifilm SuperCCD images have maximum detail when their total pixel count is doubled. This tag specifies the amount by which the values of the DefaultScale tag need to be multiplied to achieve the best quality image size."));
-	add(0xc65d, QObject::tr("RawDataUniqueID"), 1, 1, QObject::tr("This tag contains a 16-byte unique identifier for the raw image data in the DNG file. DNG readers can use this tag to recognize a particular raw image, even if the file's name or the metadata contained in the file has been changed. If a DNG writer creates such an identifier, it should do so using an algorithm that will ensure that it is very unlikely two different images will end up having the same identifier."));
-	add(0xc68b, QObject::tr("OriginalRawFileName"), 1, 1, QObject::tr("If the DNG file was converted from a non-DNG raw file, then this tag contains the file name of that original raw file."));
-	add(0xc68c, QObject::tr("OriginalRawFileData"), 1, 7, QObject::tr("If the DNG file was converted from a non-DNG raw file, then this tag contains the compressed contents of that original raw file. The contents of this tag always use the big-endian byte order. The tag contains a sequence of data blocks. Future versions of the DNG specification may define additional data blocks, so DNG readers should ignore extra bytes when parsing this tag. DNG readers should also detect the case where data blocks are missing from the end of the sequence, and should assume a default value for all the missing blocks. There are no padding or alignment bytes between data blocks."));
-	add(0xc68d, QObject::tr("ActiveArea"), 1, 3, QObject::tr("This rectangle defines the active (non-masked) pixels of the sensor. The order of the rectangle coordinates is: top, left, bottom, right."));
-	add(0xc68e, QObject::tr("MaskedAreas"), 1, 3, QObject::tr("This tag contains a list of non-overlapping rectangle coordinates of fully masked pixels, which can be optionally used by DNG readers to measure the black encoding level. The order of each rectangle's coordinates is: top, left, bottom, right. If the raw image data has already had its black encoding level subtracted, then this tag should not be used, since the masked pixels are no longer useful."));
-	add(0xc68f, QObject::tr("AsShotICCProfile"), 1, 7, QObject::tr("This tag contains an ICC profile that, in conjunction with the AsShotPreProfileMatrix tag, provides the camera manufacturer with a way to specify a default color rendering from camera color space coordinates (linear reference values) into the ICC profile connection space. The ICC profile connection space is an output referred colorimetric space, whereas the other color calibration tags in DNG specify a conversion into a scene referred colorimetric space. This means that the rendering in this profile should include any desired tone and gamut mapping needed to convert between scene referred values and output referred values."));
-	add(0xc690, QObject::tr("AsShotPreProfileMatrix"), 1, 10, QObject::tr("This tag is used in conjunction with the AsShotICCProfile tag. It specifies a matrix that should be applied to the camera color space coordinates before processing the values through the ICC profile specified in the AsShotICCProfile tag. The matrix is stored in the row scan order. If ColorPlanes is greater than three, then this matrix can (but is not required to) reduce the dimensionality of the color data down to three components, in which case the AsShotICCProfile should have three rather than ColorPlanes input components."));
-	add(0xc691, QObject::tr("CurrentICCProfile"), 1, 7, QObject::tr("This tag is used in conjunction with the CurrentPreProfileMatrix tag. The CurrentICCProfile and CurrentPreProfileMatrix tags have the same purpose and usage as the AsShotICCProfile and AsShotPreProfileMatrix tag pair, except they are for use by raw file editors rather than camera manufacturers."));
-	add(0xc692, QObject::tr("CurrentPreProfileMatrix"), 1, 10, QObject::tr("This tag is used in conjunction with the CurrentICCProfile tag. The CurrentICCProfile and CurrentPreProfileMatrix tags have the same purpose and usage as the AsShotICCProfile and AsShotPreProfileMatrix tag pair, except they are for use by raw file editors rather than camera manufacturers."));
-	add(0xc6bf, QObject::tr("ColorimetricReference"), 1, 3, QObject::tr("The DNG color model documents a transform between camera colors and CIE XYZ values. This tag describes the colorimetric reference for the CIE XYZ values. 0 = The XYZ values are scene-referred. 1 = The XYZ values are output-referred, using the ICC profile perceptual dynamic range. This tag allows output-referred data to be stored in DNG files and still processed correctly by DNG readers."));
-	add(0xc6f3, QObject::tr("CameraCalibrationSignature"), 1, 1, QObject::tr("A UTF-8 encoded string associated with the CameraCalibration1 and CameraCalibration2 tags. The CameraCalibration1 and CameraCalibration2 tags should only be used in the DNG color transform if the string stored in the CameraCalibrationSignature tag exactly matches the string stored in the ProfileCalibrationSignature tag for the selected camera profile."));
-	add(0xc6f4, QObject::tr("ProfileCalibrationSignature"), 1, 1, QObject::tr("A UTF-8 encoded string associated with the camera profile tags. The CameraCalibration1 and CameraCalibration2 tags should only be used in the DNG color transfer if the string stored in the CameraCalibrationSignature tag exactly matches the string stored in the ProfileCalibrationSignature tag for the selected camera profile."));
-	add(0xc6f6, QObject::tr("AsShotProfileName"), 1, 1, QObject::tr("A UTF-8 encoded string containing the name of the \"as shot\" camera profile, if any."));
-	add(0xc6f7, QObject::tr("NoiseReductionApplied"), 1, 5, QObject::tr("This tag indicates how much noise reduction has been applied to the raw data on a scale of 0.0 to 1.0. A 0.0 value indicates that no noise reduction has been applied. A 1.0 value indicates that the \"ideal\" amount of noise reduction has been applied, i.e. that the DNG reader should not apply additional noise reduction by default. A value of 0/0 indicates that this parameter is unknown."));
-	add(0xc6f8, QObject::tr("ProfileName"), 1, 1, QObject::tr("A UTF-8 encoded string containing the name of the camera profile. This tag is optional if there is only a single camera profile stored in the file but is required for all camera profiles if there is more than one camera profile stored in the file."));
-	add(0xc6f9, QObject::tr("ProfileHueSatMapDims"), 1, 4, QObject::tr("This tag specifies the number of input samples in each dimension of the hue/saturation/value mapping tables. The data for these tables are stored in ProfileHueSatMapData1 and ProfileHueSatMapData2 tags. The most common case has ValueDivisions equal to 1, so only hue and saturation are used as inputs to the mapping table."));
-	add(0xc6fa, QObject::tr("ProfileHueSatMapData1"), 1, 11, QObject::tr("This tag contains the data for the first hue/saturation/value mapping table. Each entry of the table contains three 32-bit IEEE floating-point values. The first entry is hue shift in degrees; the second entry is saturation scale factor; and the third entry is a value scale factor. The table entries are stored in the tag in nested loop order, with the value divisions in the outer loop, the hue divisions in the middle loop, and the saturation divisions in the inner loop. All zero input saturation entries are required to have a value scale factor of 1.0."));
-	add(0xc6fb, QObject::tr("ProfileHueSatMapData2"), 1, 11, QObject::tr("This tag contains the data for the second hue/saturation/value mapping table. Each entry of the table contains three 32-bit IEEE floating-point values. The first entry is hue shift in degrees; the second entry is a saturation scale factor; and the third entry is a value scale factor. The table entries are stored in the tag in nested loop order, with the value divisions in the outer loop, the hue divisions in the middle loop, and the saturation divisions in the inner loop. All zero input saturation entries are required to have a value scale factor of 1.0."));
-	add(0xc6fc, QObject::tr("ProfileToneCurve"), 1, 11, QObject::tr("This tag contains a default tone curve that can be applied while processing the image as a starting point for user adjustments. The curve is specified as a list of 32-bit IEEE floating-point value pairs in linear gamma. Each sample has an input value in the range of 0.0 to 1.0, and an output value in the range of 0.0 to 1.0. The first sample is required to be (0.0, 0.0), and the last sample is required to be (1.0, 1.0). Interpolated the curve using a cubic spline."));
-	add(0xc6fd, QObject::tr("ProfileEmbedPolicy"), 1, 4, QObject::tr("This tag contains information about the usage rules for the associated camera profile."));
-	add(0xc6fe, QObject::tr("ProfileCopyright"), 1, 1, QObject::tr("A UTF-8 encoded string containing the copyright information for the camera profile. This string always should be preserved along with the other camera profile tags."));
-	add(0xc714, QObject::tr("ForwardMatrix1"), 1, 10, QObject::tr("This tag defines a matrix that maps white balanced camera colors to XYZ D50 colors."));
-	add(0xc715, QObject::tr("ForwardMatrix2"), 1, 10, QObject::tr("This tag defines a matrix that maps white balanced camera colors to XYZ D50 colors."));
-	add(0xc716, QObject::tr("PreviewApplicationName"), 1, 1, QObject::tr("A UTF-8 encoded string containing the name of the application that created the preview stored in the IFD."));
-	add(0xc717, QObject::tr("PreviewApplicationVersion"), 1, 1, QObject::tr("A UTF-8 encoded string containing the version number of the application that created the preview stored in the IFD."));
-	add(0xc718, QObject::tr("PreviewSettingsName"), 1, 1, QObject::tr("A UTF-8 encoded string containing the name of the conversion settings (for example, snapshot name) used for the preview stored in the IFD."));
-	add(0xc719, QObject::tr("PreviewSettingsDigest"), 1, 1, QObject::tr("A unique ID of the conversion settings (for example, MD5 digest) used to render the preview stored in the IFD."));
-	add(0xc71a, QObject::tr("PreviewColorSpace"), 1, 4, QObject::tr("This tag specifies the color space in which the rendered preview in this IFD is stored. The default value for this tag is sRGB for color previews and Gray Gamma 2.2 for monochrome previews."));
-	add(0xc71b, QObject::tr("PreviewDateTime"), 1, 2, QObject::tr("This tag is an ASCII string containing the name of the date/time at which the preview stored in the IFD was rendered. The date/time is encoded using ISO 8601 format."));
-	add(0xc71c, QObject::tr("RawImageDigest"), 1, 7, QObject::tr("This tag is an MD5 digest of the raw image data. All pixels in the image are processed in row-scan order. Each pixel is zero padded to 16 or 32 bits deep (16-bit for data less than or equal to 16 bits deep, 32-bit otherwise). The data for each pixel is processed in little-endian byte order."));
-	add(0xc71d, QObject::tr("OriginalRawFileDigest"), 1, 7, QObject::tr("This tag is an MD5 digest of the data stored in the OriginalRawFileData tag."));
-	add(0xc71e, QObject::tr("SubTileBlockSize"), 1, 4, QObject::tr("Normally, the pixels within a tile are stored in simple row-scan order. This tag specifies that the pixels within a tile should be grouped first into rectangular blocks of the specified size. These blocks are stored in row-scan order. Within each block, the pixels are stored in row-scan order. The use of a non-default value for this tag requires setting the DNGBackwardVersion tag to at least 1.2.0.0."));
-	add(0xc71f, QObject::tr("RowInterleaveFactor"), 1, 4, QObject::tr("This tag specifies that rows of the image are stored in interleaved order. The value of the tag specifies the number of interleaved fields. The use of a non-default value for this tag requires setting the DNGBackwardVersion tag to at least 1.2.0.0."));
-	add(0xc725, QObject::tr("ProfileLookTableDims"), 1, 4, QObject::tr("This tag specifies the number of input samples in each dimension of a default \"look\" table. The data for this table is stored in the ProfileLookTableData tag."));
-	add(0xc726, QObject::tr("ProfileLookTableData"), 1, 11, QObject::tr("This tag contains a default \"look\" table that can be applied while processing the image as a starting point for user adjustment. This table uses the same format as the tables stored in the ProfileHueSatMapData1 and ProfileHueSatMapData2 tags, and is applied in the same color space. However, it should be applied later in the processing pipe, after any exposure compensation and/or fill light stages, but before any tone curve stage. Each entry of the table contains three 32-bit IEEE floating-point values. The first entry is hue shift in degrees, the second entry is a saturation scale factor, and the third entry is a value scale factor. The table entries are stored in the tag in nested loop order, with the value divisions in the outer loop, the hue divisions in the middle loop, and the saturation divisions in the inner loop. All zero input saturation entries are required to have a value scale factor of 1.0."));
-	add(0xc740, QObject::tr("OpcodeList1"), 1, 7, QObject::tr("Specifies the list of opcodes that should be applied to the raw image, as read directly from the file."));
-	add(0xc741, QObject::tr("OpcodeList2"), 1, 7, QObject::tr("Specifies the list of opcodes that should be applied to the raw image, just after it has been mapped to linear reference values."));
-	add(0xc74e, QObject::tr("OpcodeList3"), 1, 7, QObject::tr("Specifies the list of opcodes that should be applied to the raw image, just after it has been demosaiced."));
-	add(0xc761, QObject::tr("NoiseProfile"), 1, 11, QObject::tr("NoiseProfile describes the amount of noise in a raw image. Specifically, this tag models the amount of signal-dependent photon (shot) noise and signal-independent sensor readout noise, two common sources of noise in raw images. The model assumes that the noise is white and spatially independent, ignoring fixed pattern effects and other sources of noise (e.g., pixel response non-uniformity, spatially-dependent thermal effects, etc.)."));
-	add(0xc763, QObject::tr("TimeCodes"), 1, 1, QObject::tr("The optional TimeCodes tag shall contain an ordered array of time codes. All time codes shall be 8 bytes long and in binary format. The tag may contain from 1 to 10 time codes. When the tag contains more than one time code, the first one shall be the default time code. This specification does not prescribe how to use multiple time codes. Each time code shall be as defined for the 8-byte time code structure in SMPTE 331M-2004, Section 8.3. See also SMPTE 12-1-2008 and SMPTE 309-1999."));
-	add(0xc764, QObject::tr("FrameRate"), 1, 10, QObject::tr("The optional FrameRate tag shall specify the video frame rate in number of image frames per second, expressed as a signed rational number. The numerator shall be non-negative and the denominator shall be positive. This field value is identical to the sample rate field in SMPTE 377-1-2009."));
-	add(0xc772, QObject::tr("TStop"), 1, 10, QObject::tr("The optional TStop tag shall specify the T-stop of the actual lens, expressed as an unsigned rational number. T-stop is also known as T-number or the photometric aperture of the lens. (F-number is the geometric aperture of the lens.) When the exact value is known, the T-stop shall be specified using a single number. Alternately, two numbers shall be used to indicate a T-stop range, in which case the first number shall be the minimum T-stop and the second number shall be the maximum T-stop."));
-	add(0xc789, QObject::tr("ReelName"), 1, 2, QObject::tr("The optional ReelName tag shall specify a name for a sequence of images, where each image in the sequence has a unique image identifier (including but not limited to file name, frame number, date time, time code)."));
-	add(0xc7a1, QObject::tr("CameraLabel"), 1, 2, QObject::tr("The optional CameraLabel tag shall specify a text label for how the camera is used or assigned in this clip. This tag is similar to CameraLabel in XMP."));
-	add(0x829a, QObject::tr("ExposureTime"), 5, 5, QObject::tr("Exposure time, given in seconds (sec)."));
-	add(0x829d, QObject::tr("FNumber"), 5, 5, QObject::tr("The F number."));
-	add(0x8822, QObject::tr("ExposureProgram"), 5, 3, QObject::tr("The class of the program used by the camera to set exposure when the picture is taken."));
-	add(0x8824, QObject::tr("SpectralSensitivity"), 5, 2, QObject::tr("Indicates the spectral sensitivity of each channel of the camera used. The tag value is an ASCII string compatible with the standard developed by the ASTM Technical Committee."));
-	add(0x8827, QObject::tr("ISOSpeedRatings"), 5, 3, QObject::tr("Indicates the ISO Speed and ISO Latitude of the camera or input device as specified in ISO 12232."));
-	add(0x8828, QObject::tr("OECF"), 5, 7, QObject::tr("Indicates the Opto-Electoric Conversion Function (OECF) specified in ISO 14524. <OECF> is the relationship between the camera optical input and the image values."));
-	add(0x8830, QObject::tr("SensitivityType"), 5, 3, QObject::tr("The SensitivityType tag indicates which one of the parameters of ISO12232 is the PhotographicSensitivity tag. Although it is an optional tag, it should be recorded when a PhotographicSensitivity tag is recorded. Value = 4, 5, 6, or 7 may be used in case that the values of plural parameters are the same."));
-	add(0x8831, QObject::tr("StandardOutputSensitivity"), 5, 4, QObject::tr("This tag indicates the standard output sensitivity value of a camera or input device defined in ISO 12232. When recording this tag, the PhotographicSensitivity and SensitivityType tags shall also be recorded."));
-	add(0x8832, QObject::tr("RecommendedExposureIndex"), 5, 4, QObject::tr("This tag indicates the recommended exposure index value of a camera or input device defined in ISO 12232. When recording this tag, the PhotographicSensitivity and SensitivityType tags shall also be recorded."));
-	add(0x8833, QObject::tr("ISOSpeed"), 5, 4, QObject::tr("This tag indicates the ISO speed value of a camera or input device that is defined in ISO 12232. When recording this tag, the PhotographicSensitivity and SensitivityType tags shall also be recorded."));
-	add(0x8834, QObject::tr("ISOSpeedLatitudeyyy"), 5, 4, QObject::tr("This tag indicates the ISO speed latitude yyy value of a camera or input device that is defined in ISO 12232. However, this tag shall not be recorded without ISOSpeed and ISOSpeedLatitudezzz."));
-	add(0x8835, QObject::tr("ISOSpeedLatitudezzz"), 5, 4, QObject::tr("This tag indicates the ISO speed latitude zzz value of a camera or input device that is defined in ISO 12232. However, this tag shall not be recorded without ISOSpeed and ISOSpeedLatitudeyyy."));
-	add(0x9000, QObject::tr("ExifVersion"), 5, 7, QObject::tr("The version of this standard supported. Nonexistence of this field is taken to mean nonconformance to the standard."));
-	add(0x9003, QObject::tr("DateTimeOriginal"), 5, 2, QObject::tr("The date and time when the original image data was generated. For a digital still camera the date and time the picture was taken are recorded."));
-	add(0x9004, QObject::tr("DateTimeDigitized"), 5, 2, QObject::tr("The date and time when the image was stored as digital data."));
-	add(0x9101, QObject::tr("ComponentsConfiguration"), 5, 7, QObject::tr("Information specific to compressed data. The channels of each component are arranged in order from the 1st component to the 4th. For uncompressed data the data arrangement is given in the <PhotometricInterpretation> tag. However, since <PhotometricInterpretation> can only express the order of Y, Cb and Cr, this tag is provided for cases when compressed data uses components other than Y, Cb, and Cr and to enable support of other sequences."));
-	add(0x9102, QObject::tr("CompressedBitsPerPixel"), 5, 5, QObject::tr("Information specific to compressed data. The compression mode used for a compressed image is indicated in unit bits per pixel."));
-	add(0x9201, QObject::tr("ShutterSpeedValue"), 5, 10, QObject::tr("Shutter speed. The unit is the APEX (Additive System of Photographic Exposure) setting."));
-	add(0x9202, QObject::tr("ApertureValue"), 5, 5, QObject::tr("The lens aperture. The unit is the APEX value."));
-	add(0x9203, QObject::tr("BrightnessValue"), 5, 10, QObject::tr("The value of brightness. The unit is the APEX value. Ordinarily it is given in the range of -99.99 to 99.99."));
-	add(0x9204, QObject::tr("ExposureBiasValue"), 5, 10, QObject::tr("The exposure bias. The units is the APEX value. Ordinarily it is given in the range of -99.99 to 99.99."));
-	add(0x9205, QObject::tr("MaxApertureValue"), 5, 5, QObject::tr("The smallest F number of the lens. The unit is the APEX value. Ordinarily it is given in the range of 00.00 to 99.99, but it is not limited to this range."));
-	add(0x9206, QObject::tr("SubjectDistance"), 5, 5, QObject::tr("The distance to the subject, given in meters."));
-	add(0x9207, QObject::tr("MeteringMode"), 5, 3, QObject::tr("The metering mode."));
-	add(0x9208, QObject::tr("LightSource"), 5, 3, QObject::tr("The kind of light source."));
-	add(0x9209, QObject::tr("Flash"), 5, 3, QObject::tr("This tag is recorded when an image is taken using a strobe light (flash)."));
-	add(0x920a, QObject::tr("FocalLength"), 5, 5, QObject::tr("The actual focal length of the lens, in mm. Conversion is not made to the focal length of a 35 mm film camera."));
-	add(0x9214, QObject::tr("SubjectArea"), 5, 3, QObject::tr("This tag indicates the location and area of the main subject in the overall scene."));
-	add(0x927c, QObject::tr("MakerNote"), 5, 7, QObject::tr("A tag for manufacturers of Exif writers to record any desired information. The contents are up to the manufacturer."));
-	add(0x9286, QObject::tr("UserComment"), 5, 7, QObject::tr("A tag for Exif users to write keywords or comments on the image besides those in <ImageDescription>, and without the character code limitations of the <ImageDescription> tag."));
-	add(0x9290, QObject::tr("SubSecTime"), 5, 2, QObject::tr("A tag used to record fractions of seconds for the <DateTime> tag."));
-	add(0x9291, QObject::tr("SubSecTimeOriginal"), 5, 2, QObject::tr("A tag used to record fractions of seconds for the <DateTimeOriginal> tag."));
-	add(0x9292, QObject::tr("SubSecTimeDigitized"), 5, 2, QObject::tr("A tag used to record fractions of seconds for the <DateTimeDigitized> tag."));
-	add(0xa000, QObject::tr("FlashpixVersion"), 5, 7, QObject::tr("The FlashPix format version supported by a FPXR file."));
-	add(0xa001, QObject::tr("ColorSpace"), 5, 3, QObject::tr("The color space information tag is always recorded as the color space specifier. Normally sRGB is used to define the color space based on the PC monitor conditions and environment. If a color space other than sRGB is used, Uncalibrated is set. Image data recorded as Uncalibrated can be treated as sRGB when it is converted to FlashPix."));
-	add(0xa002, QObject::tr("PixelXDimension"), 5, 4, QObject::tr("Information specific to compressed data. When a compressed file is recorded, the valid width of the meaningful image must be recorded in this tag, whether or not there is padding data or a restart marker. This tag should not exist in an uncompressed file."));
-	add(0xa003, QObject::tr("PixelYDimension"), 5, 4, QObject::tr("Information specific to compressed data. When a compressed file is recorded, the valid height of the meaningful image must be recorded in this tag, whether or not there is padding data or a restart marker. This tag should not exist in an uncompressed file. Since data padding is unnecessary in the vertical direction, the number of lines recorded in this valid image height tag will in fact be the same as that recorded in the SOF."));
-	add(0xa004, QObject::tr("RelatedSoundFile"), 5, 2, QObject::tr("This tag is used to record the name of an audio file related to the image data. The only relational information recorded here is the Exif audio file name and extension (an ASCII string consisting of 8 characters + '.' + 3 characters). The path is not recorded."));
-	add(0xa005, QObject::tr("InteroperabilityTag"), 5, 4, QObject::tr("Interoperability IFD is composed of tags which stores the information to ensure the Interoperability and pointed by the following tag located in Exif IFD. The Interoperability structure of Interoperability IFD is the same as TIFF defined IFD structure but does not contain the image data characteristically compared with normal TIFF IFD."));
-	add(0xa20b, QObject::tr("FlashEnergy"), 5, 5, QObject::tr("Indicates the strobe energy at the time the image is captured, as measured in Beam Candle Power Seconds (BCPS)."));
-	add(0xa20c, QObject::tr("SpatialFrequencyResponse"), 5, 7, QObject::tr("This tag records the camera or input device spatial frequency table and SFR values in the direction of image width, image height, and diagonal direction, as specified in ISO 12233."));
-	add(0xa20e, QObject::tr("FocalPlaneXResolution"), 5, 5, QObject::tr("Indicates the number of pixels in the image width (X) direction per <FocalPlaneResolutionUnit> on the camera focal plane."));
-	add(0xa20f, QObject::tr("FocalPlaneYResolution"), 5, 5, QObject::tr("Indicates the number of pixels in the image height (V) direction per <FocalPlaneResolutionUnit> on the camera focal plane."));
-	add(0xa210, QObject::tr("FocalPlaneResolutionUnit"), 5, 3, QObject::tr("Indicates the unit for measuring <FocalPlaneXResolution> and <FocalPlaneYResolution>. This value is the same as the <ResolutionUnit>."));
-	add(0xa214, QObject::tr("SubjectLocation"), 5, 3, QObject::tr("Indicates the location of the main subject in the scene. The value of this tag represents the pixel at the center of the main subject relative to the left edge, prior to rotation processing as per the <Rotation> tag. The first value indicates the X column number and second indicates the Y row number."));
-	add(0xa215, QObject::tr("ExposureIndex"), 5, 5, QObject::tr("Indicates the exposure index selected on the camera or input device at the time the image is captured."));
-	add(0xa217, QObject::tr("SensingMethod"), 5, 3, QObject::tr("Indicates the image sensor type on the camera or input device."));
-	add(0xa300, QObject::tr("FileSource"), 5, 7, QObject::tr("Indicates the image source. If a DSC recorded the image, this tag value of this tag always be set to 3, indicating that the image was recorded on a DSC."));
-	add(0xa301, QObject::tr("SceneType"), 5, 7, QObject::tr("Indicates the type of scene. If a DSC recorded the image, this tag value must always be set to 1, indicating that the image was directly photographed."));
-	add(0xa302, QObject::tr("CFAPattern"), 5, 7, QObject::tr("Indicates the color filter array (CFA) geometric pattern of the image sensor when a one-chip color area sensor is used. It does not apply to all sensing methods."));
-	add(0xa401, QObject::tr("CustomRendered"), 5, 3, QObject::tr("This tag indicates the use of special processing on image data, such as rendering geared to output. When special processing is performed, the reader is expected to disable or minimize any further processing."));
-	add(0xa402, QObject::tr("ExposureMode"), 5, 3, QObject::tr("This tag indicates the exposure mode set when the image was shot. In auto-bracketing mode, the camera shoots a series of frames of the same scene at different exposure settings."));
-	add(0xa403, QObject::tr("WhiteBalance"), 5, 3, QObject::tr("This tag indicates the white balance mode set when the image was shot."));
-	add(0xa404, QObject::tr("DigitalZoomRatio"), 5, 5, QObject::tr("This tag indicates the digital zoom ratio when the image was shot. If the numerator of the recorded value is 0, this indicates that digital zoom was not used."));
-	add(0xa405, QObject::tr("FocalLengthIn35mmFilm"), 5, 3, QObject::tr("This tag indicates the equivalent focal length assuming a 35mm film camera, in mm. A value of 0 means the focal length is unknown. Note that this tag differs from the <FocalLength> tag."));
-	add(0xa406, QObject::tr("SceneCaptureType"), 5, 3, QObject::tr("This tag indicates the type of scene that was shot. It can also be used to record the mode in which the image was shot. Note that this differs from the <SceneType> tag."));
-	add(0xa407, QObject::tr("GainControl"), 5, 3, QObject::tr("This tag indicates the degree of overall image gain adjustment."));
-	add(0xa408, QObject::tr("Contrast"), 5, 3, QObject::tr("This tag indicates the direction of contrast processing applied by the camera when the image was shot."));
-	add(0xa409, QObject::tr("Saturation"), 5, 3, QObject::tr("This tag indicates the direction of saturation processing applied by the camera when the image was shot."));
-	add(0xa40a, QObject::tr("Sharpness"), 5, 3, QObject::tr("This tag indicates the direction of sharpness processing applied by the camera when the image was shot."));
-	add(0xa40b, QObject::tr("DeviceSettingDescription"), 5, 7, QObject::tr("This tag indicates information on the picture-taking conditions of a particular camera model. The tag is used only to indicate the picture-taking conditions in the reader."));
-	add(0xa40c, QObject::tr("SubjectDistanceRange"), 5, 3, QObject::tr("This tag indicates the distance to the subject."));
-	add(0xa420, QObject::tr("ImageUniqueID"), 5, 2, QObject::tr("This tag indicates an identifier assigned uniquely to each image. It is recorded as an ASCII string equivalent to hexadecimal notation and 128-bit fixed length."));
-	add(0xa430, QObject::tr("CameraOwnerName"), 5, 2, QObject::tr("This tag records the owner of a camera used in photography as an ASCII string."));
-	add(0xa431, QObject::tr("BodySerialNumber"), 5, 2, QObject::tr("This tag records the serial number of the body of the camera that was used in photography as an ASCII string."));
-	add(0xa432, QObject::tr("LensSpecification"), 5, 5, QObject::tr("This tag notes minimum focal length, maximum focal length, minimum F number in the minimum focal length, and minimum F number in the maximum focal length, which are specification information for the lens that was used in photography. When the minimum F number is unknown, the notation is 0/0"));
-	add(0xa433, QObject::tr("LensMake"), 5, 2, QObject::tr("This tag records the lens manufactor as an ASCII string."));
-	add(0xa434, QObject::tr("LensModel"), 5, 2, QObject::tr("This tag records the lens's model name and model number as an ASCII string."));
-	add(0xa435, QObject::tr("LensSerialNumber"), 5, 2, QObject::tr("This tag records the serial number of the interchangeable lens that was used in photography as an ASCII string."));
-	add(0x0001, QObject::tr("InteroperabilityIndex"), 7, 2, QObject::tr("Indicates the identification of the Interoperability rule. Use \"R98\" for stating ExifR98 Rules. Four bytes used including the termination code (NULL). see the separate volume of Recommended Exif Interoperability Rules (ExifR98) for other tags used for ExifR98."));
-	add(0x0002, QObject::tr("InteroperabilityVersion"), 7, 7, QObject::tr("Interoperability version"));
-	add(0x1000, QObject::tr("RelatedImageFileFormat"), 7, 2, QObject::tr("File format of image file"));
-	add(0x1001, QObject::tr("RelatedImageWidth"), 7, 4, QObject::tr("Image width"));
-	add(0x1002, QObject::tr("RelatedImageLength"), 7, 4, QObject::tr("Image height"));
-	add(0x0000, QObject::tr("GPSVersionID"), 6, 1, QObject::tr("Indicates the version of <GPSInfoIFD>. The version is given as 2.0.0.0. This tag is mandatory when <GPSInfo> tag is present. (Note: The <GPSVersionID> tag is given in bytes, unlike the <ExifVersion> tag. When the version is 2.0.0.0, the tag value is 02000000.H)."));
-	add(0x0001, QObject::tr("GPSLatitudeRef"), 6, 2, QObject::tr("Indicates whether the latitude is north or south latitude. The ASCII value 'N' indicates north latitude, and 'S' is south latitude."));
-	add(0x0002, QObject::tr("GPSLatitude"), 6, 5, QObject::tr("Indicates the latitude. The latitude is expressed as three RATIONAL values giving the degrees, minutes, and seconds, respectively. When degrees, minutes and seconds are expressed, the format is dd/1,mm/1,ss/1. When degrees and minutes are used and, for example, fractions of minutes are given up to two decimal places, the format is dd/1,mmmm/100,0/1."));
-	add(0x0003, QObject::tr("GPSLongitudeRef"), 6, 2, QObject::tr("Indicates whether the longitude is east or west longitude. ASCII 'E' indicates east longitude, and 'W' is west longitude."));
-	add(0x0004, QObject::tr("GPSLongitude"), 6, 5, QObject::tr("Indicates the longitude. The longitude is expressed as three RATIONAL values giving the degrees, minutes, and seconds, respectively. When degrees, minutes and seconds are expressed, the format is ddd/1,mm/1,ss/1. When degrees and minutes are used and, for example, fractions of minutes are given up to two decimal places, the format is ddd/1,mmmm/100,0/1."));
-	add(0x0005, QObject::tr("GPSAltitudeRef"), 6, 1, QObject::tr("Indicates the altitude used as the reference altitude. If the reference is sea level and the altitude is above sea level, 0 is given. If the altitude is below sea level, a value of 1 is given and the altitude is indicated as an absolute value in the GSPAltitude tag. The reference unit is meters. Note that this tag is BYTE type, unlike other reference tags."));
-	add(0x0006, QObject::tr("GPSAltitude"), 6, 5, QObject::tr("Indicates the altitude based on the reference in GPSAltitudeRef. Altitude is expressed as one RATIONAL value. The reference unit is meters."));
-	add(0x0007, QObject::tr("GPSTimeStamp"), 6, 5, QObject::tr("Indicates the time as UTC (Coordinated Universal Time). <TimeStamp> is expressed as three RATIONAL values giving the hour, minute, and second (atomic clock)."));
-	add(0x0008, QObject::tr("GPSSatellites"), 6, 2, QObject::tr("Indicates the GPS satellites used for measurements. This tag can be used to describe the number of satellites, their ID number, angle of elevation, azimuth, SNR and other information in ASCII notation. The format is not specified. If the GPS receiver is incapable of taking measurements, value of the tag is set to NULL."));
-	add(0x0009, QObject::tr("GPSStatus"), 6, 2, QObject::tr("Indicates the status of the GPS receiver when the image is recorded. \"A\" means measurement is in progress, and \"V\" means the measurement is Interoperability."));
-	add(0x000a, QObject::tr("GPSMeasureMode"), 6, 2, QObject::tr("Indicates the GPS measurement mode. \"2\" means two-dimensional measurement and \"3\" means three-dimensional measurement is in progress."));
-	add(0x000b, QObject::tr("GPSDOP"), 6, 5, QObject::tr("Indicates the GPS DOP (data degree of precision). An HDOP value is written during two-dimensional measurement, and PDOP during three-dimensional measurement."));
-	add(0x000c, QObject::tr("GPSSpeedRef"), 6, 2, QObject::tr("Indicates the unit used to express the GPS receiver speed of movement. \"K\" \"M\" and \"N\" represents kilometers per hour, miles per hour, and knots."));
-	add(0x000d, QObject::tr("GPSSpeed"), 6, 5, QObject::tr("Indicates the speed of GPS receiver movement."));
-	add(0x000e, QObject::tr("GPSTrackRef"), 6, 2, QObject::tr("Indicates the reference for giving the direction of GPS receiver movement. \"T\" denotes true direction and \"M\" is magnetic direction."));
-	add(0x000f, QObject::tr("GPSTrack"), 6, 5, QObject::tr("Indicates the direction of GPS receiver movement. The range of values is from 0.00 to 359.99."));
-	add(0x0010, QObject::tr("GPSImgDirectionRef"), 6, 2, QObject::tr("Indicates the reference for giving the direction of the image when it is captured. \"T\" denotes true direction and \"M\" is magnetic direction."));
-	add(0x0011, QObject::tr("GPSImgDirection"), 6, 5, QObject::tr("Indicates the direction of the image when it was captured. The range of values is from 0.00 to 359.99."));
-	add(0x0012, QObject::tr("GPSMapDatum"), 6, 2, QObject::tr("Indicates the geodetic survey data used by the GPS receiver. If the survey data is restricted to Japan, the value of this tag is \"TOKYO\" or \"WGS-84\"."));
-	add(0x0013, QObject::tr("GPSDestLatitudeRef"), 6, 2, QObject::tr("Indicates whether the latitude of the destination point is north or south latitude. The ASCII value \"N\" indicates north latitude, and \"S\" is south latitude."));
-	add(0x0014, QObject::tr("GPSDestLatitude"), 6, 5, QObject::tr("Indicates the latitude of the destination point. The latitude is expressed as three RATIONAL values giving the degrees, minutes, and seconds, respectively. If latitude is expressed as degrees, minutes and seconds, a typical format would be dd/1,mm/1,ss/1. When degrees and minutes are used and, for example, fractions of minutes are given up to two decimal places, the format would be dd/1,mmmm/100,0/1."));
-	add(0x0015, QObject::tr("GPSDestLongitudeRef"), 6, 2, QObject::tr("Indicates whether the longitude of the destination point is east or west longitude. ASCII \"E\" indicates east longitude, and \"W\" is west longitude."));
-	add(0x0016, QObject::tr("GPSDestLongitude"), 6, 5, QObject::tr("Indicates the longitude of the destination point. The longitude is expressed as three RATIONAL values giving the degrees, minutes, and seconds, respectively. If longitude is expressed as degrees, minutes and seconds, a typical format would be ddd/1,mm/1,ss/1. When degrees and minutes are used and, for example, fractions of minutes are given up to two decimal places, the format would be ddd/1,mmmm/100,0/1."));
-	add(0x0017, QObject::tr("GPSDestBearingRef"), 6, 2, QObject::tr("Indicates the reference used for giving the bearing to the destination point. \"T\" denotes true direction and \"M\" is magnetic direction."));
-	add(0x0018, QObject::tr("GPSDestBearing"), 6, 5, QObject::tr("Indicates the bearing to the destination point. The range of values is from 0.00 to 359.99."));
-	add(0x0019, QObject::tr("GPSDestDistanceRef"), 6, 2, QObject::tr("Indicates the unit used to express the distance to the destination point. \"K\"), \"M\" and \"N\" represent kilometers, miles and knots."));
-	add(0x001a, QObject::tr("GPSDestDistance"), 6, 5, QObject::tr("Indicates the distance to the destination point."));
-	add(0x001b, QObject::tr("GPSProcessingMethod"), 6, 7, QObject::tr("A character string recording the name of the method used for location finding. The first byte indicates the character code used, and this is followed by the name of the method."));
-	add(0x001c, QObject::tr("GPSAreaInformation"), 6, 7, QObject::tr("A character string recording the name of the GPS area. The first byte indicates the character code used, and this is followed by the name of the GPS area."));
-	add(0x001d, QObject::tr("GPSDateStamp"), 6, 2, QObject::tr("A character string recording date and time information relative to UTC (Coordinated Universal Time). The format is \"YYYY:MM:DD.\"."));
-	add(0x001e, QObject::tr("GPSDifferential"), 6, 3, QObject::tr("Indicates whether differential correction is applied to the GPS receiver."));
+	add(0x000b, EXIF_TR("ProcessingSoftware"), 1, 2, EXIF_TR("The name and version of the software used to post-process the picture."));
+	add(0x00fe, EXIF_TR("NewSubfileType"), 1, 4, EXIF_TR("A general indication of the kind of data contained in this subfile."));
+	add(0x00ff, EXIF_TR("SubfileType"), 1, 3, EXIF_TR("A general indication of the kind of data contained in this subfile. This field is deprecated. The NewSubfileType field should be used instead."));
+	add(0x0100, EXIF_TR("ImageWidth"), 1, 4, EXIF_TR("The number of columns of image data, equal to the number of pixels per row. In JPEG compressed data a JPEG marker is used instead of this tag."));
+	add(0x0101, EXIF_TR("ImageHeight"), 1, 4, EXIF_TR("The number of rows of image data. In JPEG compressed data a JPEG marker is used instead of this tag."));
+	add(0x0102, EXIF_TR("BitsPerSample"), 1, 3, EXIF_TR("The number of bits per image component. In this standard each component of the image is 8 bits, so the value for this tag is 8. See also <SamplesPerPixel>. In JPEG compressed data a JPEG marker is used instead of this tag."));
+	add(0x0103, EXIF_TR("Compression"), 1, 3, EXIF_TR("The compression scheme used for the image data. When a primary image is JPEG compressed, this designation is not necessary and is omitted. When thumbnails use JPEG compression, this tag value is set to 6."));
+	add(0x0106, EXIF_TR("PhotometricInterpretation"), 1, 3, EXIF_TR("The pixel composition. In JPEG compressed data a JPEG marker is used instead of this tag."));
+	add(0x0107, EXIF_TR("Thresholding"), 1, 3, EXIF_TR("For black and white TIFF files that represent shades of gray, the technique used to convert from gray to black and white pixels."));
+	add(0x0108, EXIF_TR("CellWidth"), 1, 3, EXIF_TR("The width of the dithering or halftoning matrix used to create a dithered or halftoned bilevel file."));
+	add(0x0109, EXIF_TR("CellLength"), 1, 3, EXIF_TR("The length of the dithering or halftoning matrix used to create a dithered or halftoned bilevel file."));
+	add(0x010a, EXIF_TR("FillOrder"), 1, 3, EXIF_TR("The logical order of bits within a byte"));
+	add(0x010d, EXIF_TR("DocumentName"), 1, 2, EXIF_TR("The name of the document from which this image was scanned"));
+	add(0x010e, EXIF_TR("ImageDescription"), 1, 2, EXIF_TR("A character string giving the title of the image. It may be a comment such as \"1988 company picnic\" or the like. Two-bytes character codes cannot be used. When a 2-bytes code is necessary, the Exif Private tag <UserComment> is to be used."));
+	add(0x010f, EXIF_TR("Make"), 1, 2, EXIF_TR("The manufacturer of the recording equipment. This is the manufacturer of the DSC, scanner, video digitizer or other equipment that generated the image. When the field is left blank, it is treated as unknown."));
+	add(0x0110, EXIF_TR("Model"), 1, 2, EXIF_TR("The model name or model number of the equipment. This is the model name or number of the DSC, scanner, video digitizer or other equipment that generated the image. When the field is left blank, it is treated as unknown."));
+	add(0x0111, EXIF_TR("StripOffsets"), 1, 4, EXIF_TR("For each strip, the byte offset of that strip. It is recommended that this be selected so the number of strip bytes does not exceed 64 Kbytes. With JPEG compressed data this designation is not needed and is omitted. See also <RowsPerStrip> and <StripByteCounts>."));
+	add(0x0112, EXIF_TR("Orientation"), 1, 3, EXIF_TR("The image orientation viewed in terms of rows and columns."));
+	add(0x0115, EXIF_TR("SamplesPerPixel"), 1, 3, EXIF_TR("The number of components per pixel. Since this standard applies to RGB and YCbCr images, the value set for this tag is 3. In JPEG compressed data a JPEG marker is used instead of this tag."));
+	add(0x0116, EXIF_TR("RowsPerStrip"), 1, 4, EXIF_TR("The number of rows per strip. This is the number of rows in the image of one strip when an image is divided into strips. With JPEG compressed data this designation is not needed and is omitted. See also <StripOffsets> and <StripByteCounts>."));
+	add(0x0117, EXIF_TR("StripByteCounts"), 1, 4, EXIF_TR("The total number of bytes in each strip. With JPEG compressed data this designation is not needed and is omitted."));
+	add(0x011a, EXIF_TR("XResolution"), 1, 5, EXIF_TR("The number of pixels per <ResolutionUnit> in the <ImageWidth> direction. When the image resolution is unknown, 72 [dpi] is designated."));
+	add(0x011b, EXIF_TR("YResolution"), 1, 5, EXIF_TR("The number of pixels per <ResolutionUnit> in the <ImageLength> direction. The same value as <XResolution> is designated."));
+	add(0x011c, EXIF_TR("PlanarConfiguration"), 1, 3, EXIF_TR("Indicates whether pixel components are recorded in a chunky or planar format. In JPEG compressed files a JPEG marker is used instead of this tag. If this field does not exist, the TIFF default of 1 (chunky) is assumed."));
+	add(0x0122, EXIF_TR("GrayResponseUnit"), 1, 3, EXIF_TR("The precision of the information contained in the GrayResponseCurve."));
+	add(0x0123, EXIF_TR("GrayResponseCurve"), 1, 3, EXIF_TR("For grayscale data, the optical density of each possible pixel value."));
+	add(0x0124, EXIF_TR("T4Options"), 1, 4, EXIF_TR("T.4-encoding options."));
+	add(0x0125, EXIF_TR("T6Options"), 1, 4, EXIF_TR("T.6-encoding options."));
+	add(0x0128, EXIF_TR("ResolutionUnit"), 1, 3, EXIF_TR("The unit for measuring <XResolution> and <YResolution>. The same unit is used for both <XResolution> and <YResolution>. If the image resolution is unknown, 2 (inches) is designated."));
+	add(0x0129, EXIF_TR("PageNumber"), 1, 3, EXIF_TR("The page number of the page from which this image was scanned."));
+	add(0x012d, EXIF_TR("TransferFunction"), 1, 3, EXIF_TR("A transfer function for the image, described in tabular style. Normally this tag is not necessary, since color space is specified in the color space information tag (<ColorSpace>)."));
+	add(0x0131, EXIF_TR("Software"), 1, 2, EXIF_TR("This tag records the name and version of the software or firmware of the camera or image input device used to generate the image. The detailed format is not specified, but it is recommended that the example shown below be followed. When the field is left blank, it is treated as unknown."));
+	add(0x0132, EXIF_TR("DateTime"), 1, 2, EXIF_TR("The date and time of image creation. In Exif standard, it is the date and time the file was changed."));
+	add(0x013b, EXIF_TR("Artist"), 1, 2, EXIF_TR("This tag records the name of the camera owner, photographer or image creator. The detailed format is not specified, but it is recommended that the information be written as in the example below for ease of Interoperability. When the field is left blank, it is treated as unknown. Ex.) \"Camera owner, John Smith; Photographer, Michael Brown; Image creator, Ken James\""));
+	add(0x013c, EXIF_TR("HostComputer"), 1, 2, EXIF_TR("This tag records information about the host computer used to generate the image."));
+	add(0x013d, EXIF_TR("Predictor"), 1, 3, EXIF_TR("A predictor is a mathematical operator that is applied to the image data before an encoding scheme is applied."));
+	add(0x013e, EXIF_TR("WhitePoint"), 1, 5, EXIF_TR("The chromaticity of the white point of the image. Normally this tag is not necessary, since color space is specified in the colorspace information tag (<ColorSpace>)."));
+	add(0x013f, EXIF_TR("PrimaryChromaticities"), 1, 5, EXIF_TR("The chromaticity of the three primary colors of the image. Normally this tag is not necessary, since colorspace is specified in the colorspace information tag (<ColorSpace>)."));
+	add(0x0140, EXIF_TR("ColorMap"), 1, 3, EXIF_TR("A color map for palette color images. This field defines a Red-Green-Blue color map (often called a lookup table) for palette-color images. In a palette-color image, a pixel value is used to index into an RGB lookup table."));
+	add(0x0141, EXIF_TR("HalftoneHints"), 1, 3, EXIF_TR("The purpose of the HalftoneHints field is to convey to the halftone function the range of gray levels within a colorimetrically-specified image that should retain tonal detail."));
+	add(0x0142, EXIF_TR("TileWidth"), 1, 3, EXIF_TR("The tile width in pixels. This is the number of columns in each tile."));
+	add(0x0143, EXIF_TR("TileLength"), 1, 3, EXIF_TR("The tile length (height) in pixels. This is the number of rows in each tile."));
+	add(0x0144, EXIF_TR("TileOffsets"), 1, 3, EXIF_TR("For each tile, the byte offset of that tile, as compressed and stored on disk. The offset is specified with respect to the beginning of the TIFF file. Note that this implies that each tile has a location independent of the locations of other tiles."));
+	add(0x0145, EXIF_TR("TileByteCounts"), 1, 3, EXIF_TR("For each tile, the number of (compressed) bytes in that tile. See TileOffsets for a description of how the byte counts are ordered."));
+	add(0x014a, EXIF_TR("SubIFDs"), 1, 4, EXIF_TR("Defined by Adobe Corporation to enable TIFF Trees within a TIFF file."));
+	add(0x014c, EXIF_TR("InkSet"), 1, 3, EXIF_TR("The set of inks used in a separated (PhotometricInterpretation=5) image."));
+	add(0x014d, EXIF_TR("InkNames"), 1, 2, EXIF_TR("The name of each ink used in a separated (PhotometricInterpretation=5) image."));
+	add(0x014e, EXIF_TR("NumberOfInks"), 1, 3, EXIF_TR("The number of inks. Usually equal to SamplesPerPixel, unless there are extra samples."));
+	add(0x0150, EXIF_TR("DotRange"), 1, 1, EXIF_TR("The component values that correspond to a 0% dot and 100% dot."));
+	add(0x0151, EXIF_TR("TargetPrinter"), 1, 2, EXIF_TR("A description of the printing environment for which this separation is intended."));
+	add(0x0152, EXIF_TR("ExtraSamples"), 1, 3, EXIF_TR("Specifies that each pixel has m extra components whose interpretation is defined by one of the values listed below."));
+	add(0x0153, EXIF_TR("SampleFormat"), 1, 3, EXIF_TR("This field specifies how to interpret each data sample in a pixel."));
+	add(0x0154, EXIF_TR("SMinSampleValue"), 1, 3, EXIF_TR("This field specifies the minimum sample value."));
+	add(0x0155, EXIF_TR("SMaxSampleValue"), 1, 3, EXIF_TR("This field specifies the maximum sample value."));
+	add(0x0156, EXIF_TR("TransferRange"), 1, 3, EXIF_TR("Expands the range of the TransferFunction"));
+	add(0x0157, EXIF_TR("ClipPath"), 1, 1, EXIF_TR("A TIFF ClipPath is intended to mirror the essentials of PostScript's path creation functionality."));
+	add(0x0158, EXIF_TR("XClipPathUnits"), 1, 8, EXIF_TR("The number of units that span the width of the image, in terms of integer ClipPath coordinates."));
+	add(0x0159, EXIF_TR("YClipPathUnits"), 1, 8, EXIF_TR("The number of units that span the height of the image, in terms of integer ClipPath coordinates."));
+	add(0x015a, EXIF_TR("Indexed"), 1, 3, EXIF_TR("Indexed images are images where the 'pixels' do not represent color values, but rather an index (usually 8-bit) into a separate color table, the ColorMap."));
+	add(0x015b, EXIF_TR("JPEGTables"), 1, 7, EXIF_TR("This optional tag may be used to encode the JPEG quantization and Huffman tables for subsequent use by the JPEG decompression process."));
+	add(0x015f, EXIF_TR("OPIProxy"), 1, 3, EXIF_TR("OPIProxy gives information concerning whether this image is a low-resolution proxy of a high-resolution image (Adobe OPI)."));
+	add(0x0200, EXIF_TR("JPEGProc"), 1, 4, EXIF_TR("This field indicates the process used to produce the compressed data"));
+	add(0x0201, EXIF_TR("JPEGInterchangeFormat"), 1, 4, EXIF_TR("The offset to the start byte (SOI) of JPEG compressed thumbnail data. This is not used for primary image JPEG data."));
+	add(0x0202, EXIF_TR("JPEGInterchangeFormatLength"), 1, 4, EXIF_TR("The number of bytes of JPEG compressed thumbnail data. This is not used for primary image JPEG data. JPEG thumbnails are not divided but are recorded as a continuous JPEG bitstream from SOI to EOI. Appn and COM markers should not be recorded. Compressed thumbnails must be recorded in no more than 64 Kbytes, including all other data to be recorded in APP1."));
+	add(0x0203, EXIF_TR("JPEGRestartInterval"), 1, 3, EXIF_TR("This Field indicates the length of the restart interval used in the compressed image data."));
+	add(0x0205, EXIF_TR("JPEGLosslessPredictors"), 1, 3, EXIF_TR("This Field points to a list of lossless predictor-selection values, one per component."));
+	add(0x0206, EXIF_TR("JPEGPointTransforms"), 1, 3, EXIF_TR("This Field points to a list of point transform values, one per component."));
+	add(0x0207, EXIF_TR("JPEGQTables"), 1, 4, EXIF_TR("This Field points to a list of offsets to the quantization tables, one per component."));
+	add(0x0208, EXIF_TR("JPEGDCTables"), 1, 4, EXIF_TR("This Field points to a list of offsets to the DC Huffman tables or the lossless Huffman tables, one per component."));
+	add(0x0209, EXIF_TR("JPEGACTables"), 1, 4, EXIF_TR("This Field points to a list of offsets to the Huffman AC tables, one per component."));
+	add(0x0211, EXIF_TR("YCbCrCoefficients"), 1, 5, EXIF_TR("The matrix coefficients for transformation from RGB to YCbCr image data. No default is given in TIFF; but here the value given in Appendix E, \"Color Space Guidelines\"), is used as the default. The color space is declared in a color space information tag, with the default being the value that gives the optimal image characteristics Interoperability this condition."));
+	add(0x0212, EXIF_TR("YCbCrSubSampling"), 1, 3, EXIF_TR("The sampling ratio of chrominance components in relation to the luminance component. In JPEG compressed data a JPEG marker is used instead of this tag."));
+	add(0x0213, EXIF_TR("YCbCrPositioning"), 1, 3, EXIF_TR("The position of chrominance components in relation to the luminance component. This field is designated only for JPEG compressed data or uncompressed YCbCr data. The TIFF default is 1 (centered); but when Y:Cb:Cr = 4:2:2 it is recommended in this standard that 2 (co-sited) be used to record data, in order to improve the image quality when viewed on TV systems. When this field does not exist, the reader shall assume the TIFF default. In the case of Y:Cb:Cr = 4:2:0, the TIFF default (centered) is recommended. If the reader does not have the capability of supporting both kinds of <YCbCrPositioning>, it shall follow the TIFF default regardless of the value in this field. It is preferable that readers be able to support both centered and co-sited positioning."));
+	add(0x0214, EXIF_TR("ReferenceBlackWhite"), 1, 5, EXIF_TR("The reference black point value and reference white point value. No defaults are given in TIFF, but the values below are given as defaults here. The color space is declared in a color space information tag, with the default being the value that gives the optimal image characteristics Interoperability these conditions."));
+	add(0x02bc, EXIF_TR("XMLPacket"), 1, 1, EXIF_TR("XMP Metadata (Adobe technote 9-14-02)"));
+	add(0x4746, EXIF_TR("Rating"), 1, 3, EXIF_TR("Rating tag used by Windows"));
+	add(0x4749, EXIF_TR("RatingPercent"), 1, 3, EXIF_TR("Rating tag used by Windows, value in percent"));
+	add(0x800d, EXIF_TR("ImageID"), 1, 2, EXIF_TR("ImageID is the full pathname of the original, high-resolution image, or any other identifying string that uniquely identifies the original image (Adobe OPI)."));
+	add(0x828d, EXIF_TR("CFARepeatPatternDim"), 1, 3, EXIF_TR("Contains two values representing the minimum rows and columns to define the repeating patterns of the color filter array"));
+	add(0x828e, EXIF_TR("CFAPattern"), 1, 1, EXIF_TR("Indicates the color filter array (CFA) geometric pattern of the image sensor when a one-chip color area sensor is used. It does not apply to all sensing methods"));
+	add(0x828f, EXIF_TR("BatteryLevel"), 1, 5, EXIF_TR("Contains a value of the battery level as a fraction or string"));
+	add(0x8298, EXIF_TR("Copyright"), 1, 2, EXIF_TR("Copyright information. In this standard the tag is used to indicate both the photographer and editor copyrights. It is the copyright notice of the person or organization claiming rights to the image. The Interoperability copyright statement including date and rights should be written in this field; e.g., \"Copyright, John Smith, 19xx. All rights reserved.\". In this standard the field records both the photographer and editor copyrights, with each recorded in a separate part of the statement. When there is a clear distinction between the photographer and editor copyrights, these are to be written in the order of photographer followed by editor copyright, separated by NULL (in this case since the statement also ends with a NULL, there are two NULL codes). When only the photographer copyright is given, it is terminated by one NULL code. When only the editor copyright is given, the photographer copyright part consists of one space followed by a terminating NULL code, then the editor copyright is given. When the field is left blank, it is treated as unknown."));
+	add(0x829a, EXIF_TR("ExposureTime"), 1, 5, EXIF_TR("Exposure time, given in seconds."));
+	add(0x829d, EXIF_TR("FNumber"), 1, 5, EXIF_TR("The F number."));
+	add(0x83bb, EXIF_TR("IPTCNAA"), 1, 4, EXIF_TR("Contains an IPTC/NAA record"));
+	add(0x8649, EXIF_TR("ImageResources"), 1, 1, EXIF_TR("Contains information embedded by the Adobe Photoshop application"));
+	add(0x8769, EXIF_TR("ExifTag"), 1, 4, EXIF_TR("A pointer to the Exif IFD. Interoperability, Exif IFD has the same structure as that of the IFD specified in TIFF. ordinarily, however, it does not contain image data as in the case of TIFF."));
+	add(0x8773, EXIF_TR("InterColorProfile"), 1, 7, EXIF_TR("Contains an InterColor Consortium (ICC) format color space characterization/profile"));
+	add(0x8822, EXIF_TR("ExposureProgram"), 1, 3, EXIF_TR("The class of the program used by the camera to set exposure when the picture is taken."));
+	add(0x8824, EXIF_TR("SpectralSensitivity"), 1, 2, EXIF_TR("Indicates the spectral sensitivity of each channel of the camera used."));
+	add(0x8825, EXIF_TR("GPSTag"), 1, 4, EXIF_TR("A pointer to the GPS Info IFD. The Interoperability structure of the GPS Info IFD, like that of Exif IFD, has no image data."));
+	add(0x8827, EXIF_TR("ISOSpeedRatings"), 1, 3, EXIF_TR("Indicates the ISO Speed and ISO Latitude of the camera or input device as specified in ISO 12232."));
+	add(0x8828, EXIF_TR("OECF"), 1, 7, EXIF_TR("Indicates the Opto-Electric Conversion Function (OECF) specified in ISO 14524."));
+	add(0x8829, EXIF_TR("Interlace"), 1, 3, EXIF_TR("Indicates the field number of multifield images."));
+	add(0x882a, EXIF_TR("TimeZoneOffset"), 1, 8, EXIF_TR("This optional tag encodes the time zone of the camera clock (relative to Greenwich Mean Time) used to create the DataTimeOriginal tag-value when the picture was taken. It may also contain the time zone offset of the clock used to create the DateTime tag-value when the image was modified."));
+	add(0x882b, EXIF_TR("SelfTimerMode"), 1, 3, EXIF_TR("Number of seconds image capture was delayed from button press."));
+	add(0x9003, EXIF_TR("DateTimeOriginal"), 1, 2, EXIF_TR("The date and time when the original image data was generated."));
+	add(0x9102, EXIF_TR("CompressedBitsPerPixel"), 1, 5, EXIF_TR("Specific to compressed data; states the compressed bits per pixel."));
+	add(0x9201, EXIF_TR("ShutterSpeedValue"), 1, 10, EXIF_TR("Shutter speed."));
+	add(0x9202, EXIF_TR("ApertureValue"), 1, 5, EXIF_TR("The lens aperture."));
+	add(0x9203, EXIF_TR("BrightnessValue"), 1, 10, EXIF_TR("The value of brightness."));
+	add(0x9204, EXIF_TR("ExposureBiasValue"), 1, 10, EXIF_TR("The exposure bias."));
+	add(0x9205, EXIF_TR("MaxApertureValue"), 1, 5, EXIF_TR("The smallest F number of the lens."));
+	add(0x9206, EXIF_TR("SubjectDistance"), 1, 10, EXIF_TR("The distance to the subject, given in meters."));
+	add(0x9207, EXIF_TR("MeteringMode"), 1, 3, EXIF_TR("The metering mode."));
+	add(0x9208, EXIF_TR("LightSource"), 1, 3, EXIF_TR("The kind of light source."));
+	add(0x9209, EXIF_TR("Flash"), 1, 3, EXIF_TR("Indicates the status of flash when the image was shot."));
+	add(0x920a, EXIF_TR("FocalLength"), 1, 5, EXIF_TR("The actual focal length of the lens, in mm."));
+	add(0x920b, EXIF_TR("FlashEnergy"), 1, 5, EXIF_TR("Amount of flash energy (BCPS)."));
+	add(0x920c, EXIF_TR("SpatialFrequencyResponse"), 1, 7, EXIF_TR("SFR of the camera."));
+	add(0x920d, EXIF_TR("Noise"), 1, 7, EXIF_TR("Noise measurement values."));
+	add(0x920e, EXIF_TR("FocalPlaneXResolution"), 1, 5, EXIF_TR("Number of pixels per FocalPlaneResolutionUnit (37392) in ImageWidth direction for main image."));
+	add(0x920f, EXIF_TR("FocalPlaneYResolution"), 1, 5, EXIF_TR("Number of pixels per FocalPlaneResolutionUnit (37392) in ImageLength direction for main image."));
+	add(0x9210, EXIF_TR("FocalPlaneResolutionUnit"), 1, 3, EXIF_TR("Unit of measurement for FocalPlaneXResolution(37390) and FocalPlaneYResolution(37391)."));
+	add(0x9211, EXIF_TR("ImageNumber"), 1, 4, EXIF_TR("Number assigned to an image, e.g., in a chained image burst."));
+	add(0x9212, EXIF_TR("SecurityClassification"), 1, 2, EXIF_TR("Security classification assigned to the image."));
+	add(0x9213, EXIF_TR("ImageHistory"), 1, 2, EXIF_TR("Record of what has been done to the image."));
+	add(0x9214, EXIF_TR("SubjectLocation"), 1, 3, EXIF_TR("Indicates the location and area of the main subject in the overall scene."));
+	add(0x9215, EXIF_TR("ExposureIndex"), 1, 5, EXIF_TR("Encodes the camera exposure index setting when image was captured."));
+	add(0x9216, EXIF_TR("TIFFEPStandardID"), 1, 1, EXIF_TR("Contains four ASCII characters representing the TIFF/EP standard version of a TIFF/EP file, eg '1', '0', '0', '0'"));
+	add(0x9217, EXIF_TR("SensingMethod"), 1, 3, EXIF_TR("Type of image sensor."));
+	add(0x9c9b, EXIF_TR("XPTitle"), 1, 1, EXIF_TR("Title tag used by Windows, encoded in UCS2"));
+	add(0x9c9c, EXIF_TR("XPComment"), 1, 1, EXIF_TR("Comment tag used by Windows, encoded in UCS2"));
+	add(0x9c9d, EXIF_TR("XPAuthor"), 1, 1, EXIF_TR("Author tag used by Windows, encoded in UCS2"));
+	add(0x9c9e, EXIF_TR("XPKeywords"), 1, 1, EXIF_TR("Keywords tag used by Windows, encoded in UCS2"));
+	add(0x9c9f, EXIF_TR("XPSubject"), 1, 1, EXIF_TR("Subject tag used by Windows, encoded in UCS2"));
+	add(0xc4a5, EXIF_TR("PrintImageMatching"), 1, 7, EXIF_TR("Print Image Matching, description needed."));
+	add(0xc612, EXIF_TR("DNGVersion"), 1, 1, EXIF_TR("This tag encodes the DNG four-tier version number. For files compliant with version 1.1.0.0 of the DNG specification, this tag should contain the bytes: 1, 1, 0, 0."));
+	add(0xc613, EXIF_TR("DNGBackwardVersion"), 1, 1, EXIF_TR("This tag specifies the oldest version of the Digital Negative specification for which a file is compatible. Readers shouldnot attempt to read a file if this tag specifies a version number that is higher than the version number of the specification the reader was based on. In addition to checking the version tags, readers should, for all tags, check the types, counts, and values, to verify it is able to correctly read the file."));
+	add(0xc614, EXIF_TR("UniqueCameraModel"), 1, 2, EXIF_TR("Defines a unique, non-localized name for the camera model that created the image in the raw file. This name should include the manufacturer's name to avoid conflicts, and should not be localized, even if the camera name itself is localized for different markets (see LocalizedCameraModel). This string may be used by reader software to index into per-model preferences and replacement profiles."));
+	add(0xc615, EXIF_TR("LocalizedCameraModel"), 1, 1, EXIF_TR("Similar to the UniqueCameraModel field, except the name can be localized for different markets to match the localization of the camera name."));
+	add(0xc616, EXIF_TR("CFAPlaneColor"), 1, 1, EXIF_TR("Provides a mapping between the values in the CFAPattern tag and the plane numbers in LinearRaw space. This is a required tag for non-RGB CFA images."));
+	add(0xc617, EXIF_TR("CFALayout"), 1, 3, EXIF_TR("Describes the spatial layout of the CFA."));
+	add(0xc618, EXIF_TR("LinearizationTable"), 1, 3, EXIF_TR("Describes a lookup table that maps stored values into linear values. This tag is typically used to increase compression ratios by storing the raw data in a non-linear, more visually uniform space with fewer total encoding levels. If SamplesPerPixel is not equal to one, this single table applies to all the samples for each pixel."));
+	add(0xc619, EXIF_TR("BlackLevelRepeatDim"), 1, 3, EXIF_TR("Specifies repeat pattern size for the BlackLevel tag."));
+	add(0xc61a, EXIF_TR("BlackLevel"), 1, 5, EXIF_TR("Specifies the zero light (a.k.a. thermal black or black current) encoding level, as a repeating pattern. The origin of this pattern is the top-left corner of the ActiveArea rectangle. The values are stored in row-column-sample scan order."));
+	add(0xc61b, EXIF_TR("BlackLevelDeltaH"), 1, 10, EXIF_TR("If the zero light encoding level is a function of the image column, BlackLevelDeltaH specifies the difference between the zero light encoding level for each column and the baseline zero light encoding level. If SamplesPerPixel is not equal to one, this single table applies to all the samples for each pixel."));
+	add(0xc61c, EXIF_TR("BlackLevelDeltaV"), 1, 10, EXIF_TR("If the zero light encoding level is a function of the image row, this tag specifies the difference between the zero light encoding level for each row and the baseline zero light encoding level. If SamplesPerPixel is not equal to one, this single table applies to all the samples for each pixel."));
+	add(0xc61d, EXIF_TR("WhiteLevel"), 1, 3, EXIF_TR("This tag specifies the fully saturated encoding level for the raw sample values. Saturation is caused either by the sensor itself becoming highly non-linear in response, or by the camera's analog to digital converter clipping."));
+	add(0xc61e, EXIF_TR("DefaultScale"), 1, 5, EXIF_TR("DefaultScale is required for cameras with non-square pixels. It specifies the default scale factors for each direction to convert the image to square pixels. Typically these factors are selected to approximately preserve total pixel count. For CFA images that use CFALayout equal to 2, 3, 4, or 5, such as the Fujifilm SuperCCD, these two values should usually differ by a factor of 2.0."));
+	add(0xc61f, EXIF_TR("DefaultCropOrigin"), 1, 3, EXIF_TR("Raw images often store extra pixels around the edges of the final image. These extra pixels help prevent interpolation artifacts near the edges of the final image. DefaultCropOrigin specifies the origin of the final image area, in raw image coordinates (i.e., before the DefaultScale has been applied), relative to the top-left corner of the ActiveArea rectangle."));
+	add(0xc620, EXIF_TR("DefaultCropSize"), 1, 3, EXIF_TR("Raw images often store extra pixels around the edges of the final image. These extra pixels help prevent interpolation artifacts near the edges of the final image. DefaultCropSize specifies the size of the final image area, in raw image coordinates (i.e., before the DefaultScale has been applied)."));
+	add(0xc621, EXIF_TR("ColorMatrix1"), 1, 10, EXIF_TR("ColorMatrix1 defines a transformation matrix that converts XYZ values to reference camera native color space values, under the first calibration illuminant. The matrix values are stored in row scan order. The ColorMatrix1 tag is required for all non-monochrome DNG files."));
+	add(0xc622, EXIF_TR("ColorMatrix2"), 1, 10, EXIF_TR("ColorMatrix2 defines a transformation matrix that converts XYZ values to reference camera native color space values, under the second calibration illuminant. The matrix values are stored in row scan order."));
+	add(0xc623, EXIF_TR("CameraCalibration1"), 1, 10, EXIF_TR("CameraCalibration1 defines a calibration matrix that transforms reference camera native space values to individual camera native space values under the first calibration illuminant. The matrix is stored in row scan order. This matrix is stored separately from the matrix specified by the ColorMatrix1 tag to allow raw converters to swap in replacement color matrices based on UniqueCameraModel tag, while still taking advantage of any per-individual camera calibration performed by the camera manufacturer."));
+	add(0xc624, EXIF_TR("CameraCalibration2"), 1, 10, EXIF_TR("CameraCalibration2 defines a calibration matrix that transforms reference camera native space values to individual camera native space values under the second calibration illuminant. The matrix is stored in row scan order. This matrix is stored separately from the matrix specified by the ColorMatrix2 tag to allow raw converters to swap in replacement color matrices based on UniqueCameraModel tag, while still taking advantage of any per-individual camera calibration performed by the camera manufacturer."));
+	add(0xc625, EXIF_TR("ReductionMatrix1"), 1, 10, EXIF_TR("ReductionMatrix1 defines a dimensionality reduction matrix for use as the first stage in converting color camera native space values to XYZ values, under the first calibration illuminant. This tag may only be used if ColorPlanes is greater than 3. The matrix is stored in row scan order."));
+	add(0xc626, EXIF_TR("ReductionMatrix2"), 1, 10, EXIF_TR("ReductionMatrix2 defines a dimensionality reduction matrix for use as the first stage in converting color camera native space values to XYZ values, under the second calibration illuminant. This tag may only be used if ColorPlanes is greater than 3. The matrix is stored in row scan order."));
+	add(0xc627, EXIF_TR("AnalogBalance"), 1, 5, EXIF_TR("Normally the stored raw values are not white balanced, since any digital white balancing will reduce the dynamic range of the final image if the user decides to later adjust the white balance; however, if camera hardware is capable of white balancing the color channels before the signal is digitized, it can improve the dynamic range of the final image. AnalogBalance defines the gain, either analog (recommended) or digital (not recommended) that has been applied the stored raw values."));
+	add(0xc628, EXIF_TR("AsShotNeutral"), 1, 3, EXIF_TR("Specifies the selected white balance at time of capture, encoded as the coordinates of a perfectly neutral color in linear reference space values. The inclusion of this tag precludes the inclusion of the AsShotWhiteXY tag."));
+	add(0xc629, EXIF_TR("AsShotWhiteXY"), 1, 5, EXIF_TR("Specifies the selected white balance at time of capture, encoded as x-y chromaticity coordinates. The inclusion of this tag precludes the inclusion of the AsShotNeutral tag."));
+	add(0xc62a, EXIF_TR("BaselineExposure"), 1, 10, EXIF_TR("Camera models vary in the trade-off they make between highlight headroom and shadow noise. Some leave a significant amount of highlight headroom during a normal exposure. This allows significant negative exposure compensation to be applied during raw conversion, but also means normal exposures will contain more shadow noise. Other models leave less headroom during normal exposures. This allows for less negative exposure compensation, but results in lower shadow noise for normal exposures. Because of these differences, a raw converter needs to vary the zero point of its exposure compensation control from model to model. BaselineExposure specifies by how much (in EV units) to move the zero point. Positive values result in brighter default results, while negative values result in darker default results."));
+	add(0xc62b, EXIF_TR("BaselineNoise"), 1, 5, EXIF_TR("Specifies the relative noise level of the camera model at a baseline ISO value of 100, compared to a reference camera model. Since noise levels tend to vary approximately with the square root of the ISO value, a raw converter can use this value, combined with the current ISO, to estimate the relative noise level of the current image."));
+	add(0xc62c, EXIF_TR("BaselineSharpness"), 1, 5, EXIF_TR("Specifies the relative amount of sharpening required for this camera model, compared to a reference camera model. Camera models vary in the strengths of their anti-aliasing filters. Cameras with weak or no filters require less sharpening than cameras with strong anti-aliasing filters."));
+	add(0xc62d, EXIF_TR("BayerGreenSplit"), 1, 4, EXIF_TR("Only applies to CFA images using a Bayer pattern filter array. This tag specifies, in arbitrary units, how closely the values of the green pixels in the blue/green rows track the values of the green pixels in the red/green rows. A value of zero means the two kinds of green pixels track closely, while a non-zero value means they sometimes diverge. The useful range for this tag is from 0 (no divergence) to about 5000 (quite large divergence)."));
+	add(0xc62e, EXIF_TR("LinearResponseLimit"), 1, 5, EXIF_TR("Some sensors have an unpredictable non-linearity in their response as they near the upper limit of their encoding range. This non-linearity results in color shifts in the highlight areas of the resulting image unless the raw converter compensates for this effect. LinearResponseLimit specifies the fraction of the encoding range above which the response may become significantly non-linear."));
+	add(0xc62f, EXIF_TR("CameraSerialNumber"), 1, 2, EXIF_TR("CameraSerialNumber contains the serial number of the camera or camera body that captured the image."));
+	add(0xc630, EXIF_TR("LensInfo"), 1, 5, EXIF_TR("Contains information about the lens that captured the image. If the minimum f-stops are unknown, they should be encoded as 0/0."));
+	add(0xc631, EXIF_TR("ChromaBlurRadius"), 1, 5, EXIF_TR("ChromaBlurRadius provides a hint to the DNG reader about how much chroma blur should be applied to the image. If this tag is omitted, the reader will use its default amount of chroma blurring. Normally this tag is only included for non-CFA images, since the amount of chroma blur required for mosaic images is highly dependent on the de-mosaic algorithm, in which case the DNG reader's default value is likely optimized for its particular de-mosaic algorithm."));
+	add(0xc632, EXIF_TR("AntiAliasStrength"), 1, 5, EXIF_TR("Provides a hint to the DNG reader about how strong the camera's anti-alias filter is. A value of 0.0 means no anti-alias filter (i.e., the camera is prone to aliasing artifacts with some subjects), while a value of 1.0 means a strong anti-alias filter (i.e., the camera almost never has aliasing artifacts)."));
+	add(0xc633, EXIF_TR("ShadowScale"), 1, 10, EXIF_TR("This tag is used by Adobe Camera Raw to control the sensitivity of its 'Shadows' slider."));
+	add(0xc634, EXIF_TR("DNGPrivateData"), 1, 1, EXIF_TR("Provides a way for camera manufacturers to store private data in the DNG file for use by their own raw converters, and to have that data preserved by programs that edit DNG files."));
+	add(0xc635, EXIF_TR("MakerNoteSafety"), 1, 3, EXIF_TR("MakerNoteSafety lets the DNG reader know whether the EXIF MakerNote tag is safe to preserve along with the rest of the EXIF data. File browsers and other image management software processing an image with a preserved MakerNote should be aware that any thumbnail image embedded in the MakerNote may be stale, and may not reflect the current state of the full size image."));
+	add(0xc65a, EXIF_TR("CalibrationIlluminant1"), 1, 3, EXIF_TR("The illuminant used for the first set of color calibration tags (ColorMatrix1, CameraCalibration1, ReductionMatrix1). The legal values for this tag are the same as the legal values for the LightSource EXIF tag."));
+	add(0xc65b, EXIF_TR("CalibrationIlluminant2"), 1, 3, EXIF_TR("The illuminant used for an optional second set of color calibration tags (ColorMatrix2, CameraCalibration2, ReductionMatrix2). The legal values for this tag are the same as the legal values for the CalibrationIlluminant1 tag; however, if both are included, neither is allowed to have a value of 0 (unknown)."));
+	add(0xc65c, EXIF_TR("BestQualityScale"), 1, 5, EXIF_TR("For some cameras, the best possible image quality is not achieved by preserving the total pixel count during conversion. For example, Fujifilm SuperCCD images have maximum detail when their total pixel count is doubled. This tag specifies the amount by which the values of the DefaultScale tag need to be multiplied to achieve the best quality image size."));
+	add(0xc65d, EXIF_TR("RawDataUniqueID"), 1, 1, EXIF_TR("This tag contains a 16-byte unique identifier for the raw image data in the DNG file. DNG readers can use this tag to recognize a particular raw image, even if the file's name or the metadata contained in the file has been changed. If a DNG writer creates such an identifier, it should do so using an algorithm that will ensure that it is very unlikely two different images will end up having the same identifier."));
+	add(0xc68b, EXIF_TR("OriginalRawFileName"), 1, 1, EXIF_TR("If the DNG file was converted from a non-DNG raw file, then this tag contains the file name of that original raw file."));
+	add(0xc68c, EXIF_TR("OriginalRawFileData"), 1, 7, EXIF_TR("If the DNG file was converted from a non-DNG raw file, then this tag contains the compressed contents of that original raw file. The contents of this tag always use the big-endian byte order. The tag contains a sequence of data blocks. Future versions of the DNG specification may define additional data blocks, so DNG readers should ignore extra bytes when parsing this tag. DNG readers should also detect the case where data blocks are missing from the end of the sequence, and should assume a default value for all the missing blocks. There are no padding or alignment bytes between data blocks."));
+	add(0xc68d, EXIF_TR("ActiveArea"), 1, 3, EXIF_TR("This rectangle defines the active (non-masked) pixels of the sensor. The order of the rectangle coordinates is: top, left, bottom, right."));
+	add(0xc68e, EXIF_TR("MaskedAreas"), 1, 3, EXIF_TR("This tag contains a list of non-overlapping rectangle coordinates of fully masked pixels, which can be optionally used by DNG readers to measure the black encoding level. The order of each rectangle's coordinates is: top, left, bottom, right. If the raw image data has already had its black encoding level subtracted, then this tag should not be used, since the masked pixels are no longer useful."));
+	add(0xc68f, EXIF_TR("AsShotICCProfile"), 1, 7, EXIF_TR("This tag contains an ICC profile that, in conjunction with the AsShotPreProfileMatrix tag, provides the camera manufacturer with a way to specify a default color rendering from camera color space coordinates (linear reference values) into the ICC profile connection space. The ICC profile connection space is an output referred colorimetric space, whereas the other color calibration tags in DNG specify a conversion into a scene referred colorimetric space. This means that the rendering in this profile should include any desired tone and gamut mapping needed to convert between scene referred values and output referred values."));
+	add(0xc690, EXIF_TR("AsShotPreProfileMatrix"), 1, 10, EXIF_TR("This tag is used in conjunction with the AsShotICCProfile tag. It specifies a matrix that should be applied to the camera color space coordinates before processing the values through the ICC profile specified in the AsShotICCProfile tag. The matrix is stored in the row scan order. If ColorPlanes is greater than three, then this matrix can (but is not required to) reduce the dimensionality of the color data down to three components, in which case the AsShotICCProfile should have three rather than ColorPlanes input components."));
+	add(0xc691, EXIF_TR("CurrentICCProfile"), 1, 7, EXIF_TR("This tag is used in conjunction with the CurrentPreProfileMatrix tag. The CurrentICCProfile and CurrentPreProfileMatrix tags have the same purpose and usage as the AsShotICCProfile and AsShotPreProfileMatrix tag pair, except they are for use by raw file editors rather than camera manufacturers."));
+	add(0xc692, EXIF_TR("CurrentPreProfileMatrix"), 1, 10, EXIF_TR("This tag is used in conjunction with the CurrentICCProfile tag. The CurrentICCProfile and CurrentPreProfileMatrix tags have the same purpose and usage as the AsShotICCProfile and AsShotPreProfileMatrix tag pair, except they are for use by raw file editors rather than camera manufacturers."));
+	add(0xc6bf, EXIF_TR("ColorimetricReference"), 1, 3, EXIF_TR("The DNG color model documents a transform between camera colors and CIE XYZ values. This tag describes the colorimetric reference for the CIE XYZ values. 0 = The XYZ values are scene-referred. 1 = The XYZ values are output-referred, using the ICC profile perceptual dynamic range. This tag allows output-referred data to be stored in DNG files and still processed correctly by DNG readers."));
+	add(0xc6f3, EXIF_TR("CameraCalibrationSignature"), 1, 1, EXIF_TR("A UTF-8 encoded string associated with the CameraCalibration1 and CameraCalibration2 tags. The CameraCalibration1 and CameraCalibration2 tags should only be used in the DNG color transform if the string stored in the CameraCalibrationSignature tag exactly matches the string stored in the ProfileCalibrationSignature tag for the selected camera profile."));
+	add(0xc6f4, EXIF_TR("ProfileCalibrationSignature"), 1, 1, EXIF_TR("A UTF-8 encoded string associated with the camera profile tags. The CameraCalibration1 and CameraCalibration2 tags should only be used in the DNG color transfer if the string stored in the CameraCalibrationSignature tag exactly matches the string stored in the ProfileCalibrationSignature tag for the selected camera profile."));
+	add(0xc6f6, EXIF_TR("AsShotProfileName"), 1, 1, EXIF_TR("A UTF-8 encoded string containing the name of the \"as shot\" camera profile, if any."));
+	add(0xc6f7, EXIF_TR("NoiseReductionApplied"), 1, 5, EXIF_TR("This tag indicates how much noise reduction has been applied to the raw data on a scale of 0.0 to 1.0. A 0.0 value indicates that no noise reduction has been applied. A 1.0 value indicates that the \"ideal\" amount of noise reduction has been applied, i.e. that the DNG reader should not apply additional noise reduction by default. A value of 0/0 indicates that this parameter is unknown."));
+	add(0xc6f8, EXIF_TR("ProfileName"), 1, 1, EXIF_TR("A UTF-8 encoded string containing the name of the camera profile. This tag is optional if there is only a single camera profile stored in the file but is required for all camera profiles if there is more than one camera profile stored in the file."));
+	add(0xc6f9, EXIF_TR("ProfileHueSatMapDims"), 1, 4, EXIF_TR("This tag specifies the number of input samples in each dimension of the hue/saturation/value mapping tables. The data for these tables are stored in ProfileHueSatMapData1 and ProfileHueSatMapData2 tags. The most common case has ValueDivisions equal to 1, so only hue and saturation are used as inputs to the mapping table."));
+	add(0xc6fa, EXIF_TR("ProfileHueSatMapData1"), 1, 11, EXIF_TR("This tag contains the data for the first hue/saturation/value mapping table. Each entry of the table contains three 32-bit IEEE floating-point values. The first entry is hue shift in degrees; the second entry is saturation scale factor; and the third entry is a value scale factor. The table entries are stored in the tag in nested loop order, with the value divisions in the outer loop, the hue divisions in the middle loop, and the saturation divisions in the inner loop. All zero input saturation entries are required to have a value scale factor of 1.0."));
+	add(0xc6fb, EXIF_TR("ProfileHueSatMapData2"), 1, 11, EXIF_TR("This tag contains the data for the second hue/saturation/value mapping table. Each entry of the table contains three 32-bit IEEE floating-point values. The first entry is hue shift in degrees; the second entry is a saturation scale factor; and the third entry is a value scale factor. The table entries are stored in the tag in nested loop order, with the value divisions in the outer loop, the hue divisions in the middle loop, and the saturation divisions in the inner loop. All zero input saturation entries are required to have a value scale factor of 1.0."));
+	add(0xc6fc, EXIF_TR("ProfileToneCurve"), 1, 11, EXIF_TR("This tag contains a default tone curve that can be applied while processing the image as a starting point for user adjustments. The curve is specified as a list of 32-bit IEEE floating-point value pairs in linear gamma. Each sample has an input value in the range of 0.0 to 1.0, and an output value in the range of 0.0 to 1.0. The first sample is required to be (0.0, 0.0), and the last sample is required to be (1.0, 1.0). Interpolated the curve using a cubic spline."));
+	add(0xc6fd, EXIF_TR("ProfileEmbedPolicy"), 1, 4, EXIF_TR("This tag contains information about the usage rules for the associated camera profile."));
+	add(0xc6fe, EXIF_TR("ProfileCopyright"), 1, 1, EXIF_TR("A UTF-8 encoded string containing the copyright information for the camera profile. This string always should be preserved along with the other camera profile tags."));
+	add(0xc714, EXIF_TR("ForwardMatrix1"), 1, 10, EXIF_TR("This tag defines a matrix that maps white balanced camera colors to XYZ D50 colors."));
+	add(0xc715, EXIF_TR("ForwardMatrix2"), 1, 10, EXIF_TR("This tag defines a matrix that maps white balanced camera colors to XYZ D50 colors."));
+	add(0xc716, EXIF_TR("PreviewApplicationName"), 1, 1, EXIF_TR("A UTF-8 encoded string containing the name of the application that created the preview stored in the IFD."));
+	add(0xc717, EXIF_TR("PreviewApplicationVersion"), 1, 1, EXIF_TR("A UTF-8 encoded string containing the version number of the application that created the preview stored in the IFD."));
+	add(0xc718, EXIF_TR("PreviewSettingsName"), 1, 1, EXIF_TR("A UTF-8 encoded string containing the name of the conversion settings (for example, snapshot name) used for the preview stored in the IFD."));
+	add(0xc719, EXIF_TR("PreviewSettingsDigest"), 1, 1, EXIF_TR("A unique ID of the conversion settings (for example, MD5 digest) used to render the preview stored in the IFD."));
+	add(0xc71a, EXIF_TR("PreviewColorSpace"), 1, 4, EXIF_TR("This tag specifies the color space in which the rendered preview in this IFD is stored. The default value for this tag is sRGB for color previews and Gray Gamma 2.2 for monochrome previews."));
+	add(0xc71b, EXIF_TR("PreviewDateTime"), 1, 2, EXIF_TR("This tag is an ASCII string containing the name of the date/time at which the preview stored in the IFD was rendered. The date/time is encoded using ISO 8601 format."));
+	add(0xc71c, EXIF_TR("RawImageDigest"), 1, 7, EXIF_TR("This tag is an MD5 digest of the raw image data. All pixels in the image are processed in row-scan order. Each pixel is zero padded to 16 or 32 bits deep (16-bit for data less than or equal to 16 bits deep, 32-bit otherwise). The data for each pixel is processed in little-endian byte order."));
+	add(0xc71d, EXIF_TR("OriginalRawFileDigest"), 1, 7, EXIF_TR("This tag is an MD5 digest of the data stored in the OriginalRawFileData tag."));
+	add(0xc71e, EXIF_TR("SubTileBlockSize"), 1, 4, EXIF_TR("Normally, the pixels within a tile are stored in simple row-scan order. This tag specifies that the pixels within a tile should be grouped first into rectangular blocks of the specified size. These blocks are stored in row-scan order. Within each block, the pixels are stored in row-scan order. The use of a non-default value for this tag requires setting the DNGBackwardVersion tag to at least 1.2.0.0."));
+	add(0xc71f, EXIF_TR("RowInterleaveFactor"), 1, 4, EXIF_TR("This tag specifies that rows of the image are stored in interleaved order. The value of the tag specifies the number of interleaved fields. The use of a non-default value for this tag requires setting the DNGBackwardVersion tag to at least 1.2.0.0."));
+	add(0xc725, EXIF_TR("ProfileLookTableDims"), 1, 4, EXIF_TR("This tag specifies the number of input samples in each dimension of a default \"look\" table. The data for this table is stored in the ProfileLookTableData tag."));
+	add(0xc726, EXIF_TR("ProfileLookTableData"), 1, 11, EXIF_TR("This tag contains a default \"look\" table that can be applied while processing the image as a starting point for user adjustment. This table uses the same format as the tables stored in the ProfileHueSatMapData1 and ProfileHueSatMapData2 tags, and is applied in the same color space. However, it should be applied later in the processing pipe, after any exposure compensation and/or fill light stages, but before any tone curve stage. Each entry of the table contains three 32-bit IEEE floating-point values. The first entry is hue shift in degrees, the second entry is a saturation scale factor, and the third entry is a value scale factor. The table entries are stored in the tag in nested loop order, with the value divisions in the outer loop, the hue divisions in the middle loop, and the saturation divisions in the inner loop. All zero input saturation entries are required to have a value scale factor of 1.0."));
+	add(0xc740, EXIF_TR("OpcodeList1"), 1, 7, EXIF_TR("Specifies the list of opcodes that should be applied to the raw image, as read directly from the file."));
+	add(0xc741, EXIF_TR("OpcodeList2"), 1, 7, EXIF_TR("Specifies the list of opcodes that should be applied to the raw image, just after it has been mapped to linear reference values."));
+	add(0xc74e, EXIF_TR("OpcodeList3"), 1, 7, EXIF_TR("Specifies the list of opcodes that should be applied to the raw image, just after it has been demosaiced."));
+	add(0xc761, EXIF_TR("NoiseProfile"), 1, 11, EXIF_TR("NoiseProfile describes the amount of noise in a raw image. Specifically, this tag models the amount of signal-dependent photon (shot) noise and signal-independent sensor readout noise, two common sources of noise in raw images. The model assumes that the noise is white and spatially independent, ignoring fixed pattern effects and other sources of noise (e.g., pixel response non-uniformity, spatially-dependent thermal effects, etc.)."));
+	add(0xc763, EXIF_TR("TimeCodes"), 1, 1, EXIF_TR("The optional TimeCodes tag shall contain an ordered array of time codes. All time codes shall be 8 bytes long and in binary format. The tag may contain from 1 to 10 time codes. When the tag contains more than one time code, the first one shall be the default time code. This specification does not prescribe how to use multiple time codes. Each time code shall be as defined for the 8-byte time code structure in SMPTE 331M-2004, Section 8.3. See also SMPTE 12-1-2008 and SMPTE 309-1999."));
+	add(0xc764, EXIF_TR("FrameRate"), 1, 10, EXIF_TR("The optional FrameRate tag shall specify the video frame rate in number of image frames per second, expressed as a signed rational number. The numerator shall be non-negative and the denominator shall be positive. This field value is identical to the sample rate field in SMPTE 377-1-2009."));
+	add(0xc772, EXIF_TR("TStop"), 1, 10, EXIF_TR("The optional TStop tag shall specify the T-stop of the actual lens, expressed as an unsigned rational number. T-stop is also known as T-number or the photometric aperture of the lens. (F-number is the geometric aperture of the lens.) When the exact value is known, the T-stop shall be specified using a single number. Alternately, two numbers shall be used to indicate a T-stop range, in which case the first number shall be the minimum T-stop and the second number shall be the maximum T-stop."));
+	add(0xc789, EXIF_TR("ReelName"), 1, 2, EXIF_TR("The optional ReelName tag shall specify a name for a sequence of images, where each image in the sequence has a unique image identifier (including but not limited to file name, frame number, date time, time code)."));
+	add(0xc7a1, EXIF_TR("CameraLabel"), 1, 2, EXIF_TR("The optional CameraLabel tag shall specify a text label for how the camera is used or assigned in this clip. This tag is similar to CameraLabel in XMP."));
+	add(0x829a, EXIF_TR("ExposureTime"), 5, 5, EXIF_TR("Exposure time, given in seconds (sec)."));
+	add(0x829d, EXIF_TR("FNumber"), 5, 5, EXIF_TR("The F number."));
+	add(0x8822, EXIF_TR("ExposureProgram"), 5, 3, EXIF_TR("The class of the program used by the camera to set exposure when the picture is taken."));
+	add(0x8824, EXIF_TR("SpectralSensitivity"), 5, 2, EXIF_TR("Indicates the spectral sensitivity of each channel of the camera used. The tag value is an ASCII string compatible with the standard developed by the ASTM Technical Committee."));
+	add(0x8827, EXIF_TR("ISOSpeedRatings"), 5, 3, EXIF_TR("Indicates the ISO Speed and ISO Latitude of the camera or input device as specified in ISO 12232."));
+	add(0x8828, EXIF_TR("OECF"), 5, 7, EXIF_TR("Indicates the Opto-Electoric Conversion Function (OECF) specified in ISO 14524. <OECF> is the relationship between the camera optical input and the image values."));
+	add(0x8830, EXIF_TR("SensitivityType"), 5, 3, EXIF_TR("The SensitivityType tag indicates which one of the parameters of ISO12232 is the PhotographicSensitivity tag. Although it is an optional tag, it should be recorded when a PhotographicSensitivity tag is recorded. Value = 4, 5, 6, or 7 may be used in case that the values of plural parameters are the same."));
+	add(0x8831, EXIF_TR("StandardOutputSensitivity"), 5, 4, EXIF_TR("This tag indicates the standard output sensitivity value of a camera or input device defined in ISO 12232. When recording this tag, the PhotographicSensitivity and SensitivityType tags shall also be recorded."));
+	add(0x8832, EXIF_TR("RecommendedExposureIndex"), 5, 4, EXIF_TR("This tag indicates the recommended exposure index value of a camera or input device defined in ISO 12232. When recording this tag, the PhotographicSensitivity and SensitivityType tags shall also be recorded."));
+	add(0x8833, EXIF_TR("ISOSpeed"), 5, 4, EXIF_TR("This tag indicates the ISO speed value of a camera or input device that is defined in ISO 12232. When recording this tag, the PhotographicSensitivity and SensitivityType tags shall also be recorded."));
+	add(0x8834, EXIF_TR("ISOSpeedLatitudeyyy"), 5, 4, EXIF_TR("This tag indicates the ISO speed latitude yyy value of a camera or input device that is defined in ISO 12232. However, this tag shall not be recorded without ISOSpeed and ISOSpeedLatitudezzz."));
+	add(0x8835, EXIF_TR("ISOSpeedLatitudezzz"), 5, 4, EXIF_TR("This tag indicates the ISO speed latitude zzz value of a camera or input device that is defined in ISO 12232. However, this tag shall not be recorded without ISOSpeed and ISOSpeedLatitudeyyy."));
+	add(0x9000, EXIF_TR("ExifVersion"), 5, 7, EXIF_TR("The version of this standard supported. Nonexistence of this field is taken to mean nonconformance to the standard."));
+	add(0x9003, EXIF_TR("DateTimeOriginal"), 5, 2, EXIF_TR("The date and time when the original image data was generated. For a digital still camera the date and time the picture was taken are recorded."));
+	add(0x9004, EXIF_TR("DateTimeDigitized"), 5, 2, EXIF_TR("The date and time when the image was stored as digital data."));
+	add(0x9010, EXIF_TR("OffsetTime"), 5, 2, EXIF_TR("A tag used to record the offset from UTC (the time difference from Universal Time Coordinated including daylight saving time) of the time of DateTime tag. The format when recording the offset is \"+|-HH:MM\"."));
+	add(0x9011, EXIF_TR("OffsetTimeOriginal"), 5, 2, EXIF_TR("A tag used to record the offset from UTC (the time difference from Universal Time Coordinated including daylight saving time) of the time of DateTimeOriginal tag. The format when recording the offset is \"+|-HH:MM\"."));
+	add(0x9012, EXIF_TR("OffsetTimeDigitized"), 5, 2, EXIF_TR("A tag used to record the offset from UTC (the time difference from Universal Time Coordinated including daylight saving time) of the time of DateTimeDigitized tag. The format when recording the offset is \"+|-HH:MM\"."));
+	add(0x9101, EXIF_TR("ComponentsConfiguration"), 5, 7, EXIF_TR("Information specific to compressed data. The channels of each component are arranged in order from the 1st component to the 4th. For uncompressed data the data arrangement is given in the <PhotometricInterpretation> tag. However, since <PhotometricInterpretation> can only express the order of Y, Cb and Cr, this tag is provided for cases when compressed data uses components other than Y, Cb, and Cr and to enable support of other sequences."));
+	add(0x9102, EXIF_TR("CompressedBitsPerPixel"), 5, 5, EXIF_TR("Information specific to compressed data. The compression mode used for a compressed image is indicated in unit bits per pixel."));
+	add(0x9201, EXIF_TR("ShutterSpeedValue"), 5, 10, EXIF_TR("Shutter speed. The unit is the APEX (Additive System of Photographic Exposure) setting."));
+	add(0x9202, EXIF_TR("ApertureValue"), 5, 5, EXIF_TR("The lens aperture. The unit is the APEX value."));
+	add(0x9203, EXIF_TR("BrightnessValue"), 5, 10, EXIF_TR("The value of brightness. The unit is the APEX value. Ordinarily it is given in the range of -99.99 to 99.99."));
+	add(0x9204, EXIF_TR("ExposureBiasValue"), 5, 10, EXIF_TR("The exposure bias. The units is the APEX value. Ordinarily it is given in the range of -99.99 to 99.99."));
+	add(0x9205, EXIF_TR("MaxApertureValue"), 5, 5, EXIF_TR("The smallest F number of the lens. The unit is the APEX value. Ordinarily it is given in the range of 00.00 to 99.99, but it is not limited to this range."));
+	add(0x9206, EXIF_TR("SubjectDistance"), 5, 5, EXIF_TR("The distance to the subject, given in meters."));
+	add(0x9207, EXIF_TR("MeteringMode"), 5, 3, EXIF_TR("The metering mode."));
+	add(0x9208, EXIF_TR("LightSource"), 5, 3, EXIF_TR("The kind of light source."));
+	add(0x9209, EXIF_TR("Flash"), 5, 3, EXIF_TR("This tag is recorded when an image is taken using a strobe light (flash)."));
+	add(0x920a, EXIF_TR("FocalLength"), 5, 5, EXIF_TR("The actual focal length of the lens, in mm. Conversion is not made to the focal length of a 35 mm film camera."));
+	add(0x9214, EXIF_TR("SubjectArea"), 5, 3, EXIF_TR("This tag indicates the location and area of the main subject in the overall scene."));
+	add(0x927c, EXIF_TR("MakerNote"), 5, 7, EXIF_TR("A tag for manufacturers of Exif writers to record any desired information. The contents are up to the manufacturer."));
+	add(0x9286, EXIF_TR("UserComment"), 5, 7, EXIF_TR("A tag for Exif users to write keywords or comments on the image besides those in <ImageDescription>, and without the character code limitations of the <ImageDescription> tag."));
+	add(0x9290, EXIF_TR("SubSecTime"), 5, 2, EXIF_TR("A tag used to record fractions of seconds for the <DateTime> tag."));
+	add(0x9291, EXIF_TR("SubSecTimeOriginal"), 5, 2, EXIF_TR("A tag used to record fractions of seconds for the <DateTimeOriginal> tag."));
+	add(0x9292, EXIF_TR("SubSecTimeDigitized"), 5, 2, EXIF_TR("A tag used to record fractions of seconds for the <DateTimeDigitized> tag."));
+	add(0xa000, EXIF_TR("FlashpixVersion"), 5, 7, EXIF_TR("The FlashPix format version supported by a FPXR file."));
+	add(0xa001, EXIF_TR("ColorSpace"), 5, 3, EXIF_TR("The color space information tag is always recorded as the color space specifier. Normally sRGB is used to define the color space based on the PC monitor conditions and environment. If a color space other than sRGB is used, Uncalibrated is set. Image data recorded as Uncalibrated can be treated as sRGB when it is converted to FlashPix."));
+	add(0xa002, EXIF_TR("PixelXDimension"), 5, 4, EXIF_TR("Information specific to compressed data. When a compressed file is recorded, the valid width of the meaningful image must be recorded in this tag, whether or not there is padding data or a restart marker. This tag should not exist in an uncompressed file."));
+	add(0xa003, EXIF_TR("PixelYDimension"), 5, 4, EXIF_TR("Information specific to compressed data. When a compressed file is recorded, the valid height of the meaningful image must be recorded in this tag, whether or not there is padding data or a restart marker. This tag should not exist in an uncompressed file. Since data padding is unnecessary in the vertical direction, the number of lines recorded in this valid image height tag will in fact be the same as that recorded in the SOF."));
+	add(0xa004, EXIF_TR("RelatedSoundFile"), 5, 2, EXIF_TR("This tag is used to record the name of an audio file related to the image data. The only relational information recorded here is the Exif audio file name and extension (an ASCII string consisting of 8 characters + '.' + 3 characters). The path is not recorded."));
+	add(0xa005, EXIF_TR("InteroperabilityTag"), 5, 4, EXIF_TR("Interoperability IFD is composed of tags which stores the information to ensure the Interoperability and pointed by the following tag located in Exif IFD. The Interoperability structure of Interoperability IFD is the same as TIFF defined IFD structure but does not contain the image data characteristically compared with normal TIFF IFD."));
+	add(0xa20b, EXIF_TR("FlashEnergy"), 5, 5, EXIF_TR("Indicates the strobe energy at the time the image is captured, as measured in Beam Candle Power Seconds (BCPS)."));
+	add(0xa20c, EXIF_TR("SpatialFrequencyResponse"), 5, 7, EXIF_TR("This tag records the camera or input device spatial frequency table and SFR values in the direction of image width, image height, and diagonal direction, as specified in ISO 12233."));
+	add(0xa20e, EXIF_TR("FocalPlaneXResolution"), 5, 5, EXIF_TR("Indicates the number of pixels in the image width (X) direction per <FocalPlaneResolutionUnit> on the camera focal plane."));
+	add(0xa20f, EXIF_TR("FocalPlaneYResolution"), 5, 5, EXIF_TR("Indicates the number of pixels in the image height (V) direction per <FocalPlaneResolutionUnit> on the camera focal plane."));
+	add(0xa210, EXIF_TR("FocalPlaneResolutionUnit"), 5, 3, EXIF_TR("Indicates the unit for measuring <FocalPlaneXResolution> and <FocalPlaneYResolution>. This value is the same as the <ResolutionUnit>."));
+	add(0xa214, EXIF_TR("SubjectLocation"), 5, 3, EXIF_TR("Indicates the location of the main subject in the scene. The value of this tag represents the pixel at the center of the main subject relative to the left edge, prior to rotation processing as per the <Rotation> tag. The first value indicates the X column number and second indicates the Y row number."));
+	add(0xa215, EXIF_TR("ExposureIndex"), 5, 5, EXIF_TR("Indicates the exposure index selected on the camera or input device at the time the image is captured."));
+	add(0xa217, EXIF_TR("SensingMethod"), 5, 3, EXIF_TR("Indicates the image sensor type on the camera or input device."));
+	add(0xa300, EXIF_TR("FileSource"), 5, 7, EXIF_TR("Indicates the image source. If a DSC recorded the image, this tag value of this tag always be set to 3, indicating that the image was recorded on a DSC."));
+	add(0xa301, EXIF_TR("SceneType"), 5, 7, EXIF_TR("Indicates the type of scene. If a DSC recorded the image, this tag value must always be set to 1, indicating that the image was directly photographed."));
+	add(0xa302, EXIF_TR("CFAPattern"), 5, 7, EXIF_TR("Indicates the color filter array (CFA) geometric pattern of the image sensor when a one-chip color area sensor is used. It does not apply to all sensing methods."));
+	add(0xa401, EXIF_TR("CustomRendered"), 5, 3, EXIF_TR("This tag indicates the use of special processing on image data, such as rendering geared to output. When special processing is performed, the reader is expected to disable or minimize any further processing."));
+	add(0xa402, EXIF_TR("ExposureMode"), 5, 3, EXIF_TR("This tag indicates the exposure mode set when the image was shot. In auto-bracketing mode, the camera shoots a series of frames of the same scene at different exposure settings."));
+	add(0xa403, EXIF_TR("WhiteBalance"), 5, 3, EXIF_TR("This tag indicates the white balance mode set when the image was shot."));
+	add(0xa404, EXIF_TR("DigitalZoomRatio"), 5, 5, EXIF_TR("This tag indicates the digital zoom ratio when the image was shot. If the numerator of the recorded value is 0, this indicates that digital zoom was not used."));
+	add(0xa405, EXIF_TR("FocalLengthIn35mmFilm"), 5, 3, EXIF_TR("This tag indicates the equivalent focal length assuming a 35mm film camera, in mm. A value of 0 means the focal length is unknown. Note that this tag differs from the <FocalLength> tag."));
+	add(0xa406, EXIF_TR("SceneCaptureType"), 5, 3, EXIF_TR("This tag indicates the type of scene that was shot. It can also be used to record the mode in which the image was shot. Note that this differs from the <SceneType> tag."));
+	add(0xa407, EXIF_TR("GainControl"), 5, 3, EXIF_TR("This tag indicates the degree of overall image gain adjustment."));
+	add(0xa408, EXIF_TR("Contrast"), 5, 3, EXIF_TR("This tag indicates the direction of contrast processing applied by the camera when the image was shot."));
+	add(0xa409, EXIF_TR("Saturation"), 5, 3, EXIF_TR("This tag indicates the direction of saturation processing applied by the camera when the image was shot."));
+	add(0xa40a, EXIF_TR("Sharpness"), 5, 3, EXIF_TR("This tag indicates the direction of sharpness processing applied by the camera when the image was shot."));
+	add(0xa40b, EXIF_TR("DeviceSettingDescription"), 5, 7, EXIF_TR("This tag indicates information on the picture-taking conditions of a particular camera model. The tag is used only to indicate the picture-taking conditions in the reader."));
+	add(0xa40c, EXIF_TR("SubjectDistanceRange"), 5, 3, EXIF_TR("This tag indicates the distance to the subject."));
+	add(0xa420, EXIF_TR("ImageUniqueID"), 5, 2, EXIF_TR("This tag indicates an identifier assigned uniquely to each image. It is recorded as an ASCII string equivalent to hexadecimal notation and 128-bit fixed length."));
+	add(0xa430, EXIF_TR("CameraOwnerName"), 5, 2, EXIF_TR("This tag records the owner of a camera used in photography as an ASCII string."));
+	add(0xa431, EXIF_TR("BodySerialNumber"), 5, 2, EXIF_TR("This tag records the serial number of the body of the camera that was used in photography as an ASCII string."));
+	add(0xa432, EXIF_TR("LensSpecification"), 5, 5, EXIF_TR("This tag notes minimum focal length, maximum focal length, minimum F number in the minimum focal length, and minimum F number in the maximum focal length, which are specification information for the lens that was used in photography. When the minimum F number is unknown, the notation is 0/0"));
+	add(0xa433, EXIF_TR("LensMake"), 5, 2, EXIF_TR("This tag records the lens manufactor as an ASCII string."));
+	add(0xa434, EXIF_TR("LensModel"), 5, 2, EXIF_TR("This tag records the lens's model name and model number as an ASCII string."));
+	add(0xa435, EXIF_TR("LensSerialNumber"), 5, 2, EXIF_TR("This tag records the serial number of the interchangeable lens that was used in photography as an ASCII string."));
+	add(0x0001, EXIF_TR("InteroperabilityIndex"), 7, 2, EXIF_TR("Indicates the identification of the Interoperability rule. Use \"R98\" for stating ExifR98 Rules. Four bytes used including the termination code (NULL). see the separate volume of Recommended Exif Interoperability Rules (ExifR98) for other tags used for ExifR98."));
+	add(0x0002, EXIF_TR("InteroperabilityVersion"), 7, 7, EXIF_TR("Interoperability version"));
+	add(0x1000, EXIF_TR("RelatedImageFileFormat"), 7, 2, EXIF_TR("File format of image file"));
+	add(0x1001, EXIF_TR("RelatedImageWidth"), 7, 4, EXIF_TR("Image width"));
+	add(0x1002, EXIF_TR("RelatedImageLength"), 7, 4, EXIF_TR("Image height"));
+	add(0x0000, EXIF_TR("GPSVersionID"), 6, 1, EXIF_TR("Indicates the version of <GPSInfoIFD>. The version is given as 2.0.0.0. This tag is mandatory when <GPSInfo> tag is present. (Note: The <GPSVersionID> tag is given in bytes, unlike the <ExifVersion> tag. When the version is 2.0.0.0, the tag value is 02000000.H)."));
+	add(0x0001, EXIF_TR("GPSLatitudeRef"), 6, 2, EXIF_TR("Indicates whether the latitude is north or south latitude. The ASCII value 'N' indicates north latitude, and 'S' is south latitude."));
+	add(0x0002, EXIF_TR("GPSLatitude"), 6, 5, EXIF_TR("Indicates the latitude. The latitude is expressed as three RATIONAL values giving the degrees, minutes, and seconds, respectively. When degrees, minutes and seconds are expressed, the format is dd/1,mm/1,ss/1. When degrees and minutes are used and, for example, fractions of minutes are given up to two decimal places, the format is dd/1,mmmm/100,0/1."));
+	add(0x0003, EXIF_TR("GPSLongitudeRef"), 6, 2, EXIF_TR("Indicates whether the longitude is east or west longitude. ASCII 'E' indicates east longitude, and 'W' is west longitude."));
+	add(0x0004, EXIF_TR("GPSLongitude"), 6, 5, EXIF_TR("Indicates the longitude. The longitude is expressed as three RATIONAL values giving the degrees, minutes, and seconds, respectively. When degrees, minutes and seconds are expressed, the format is ddd/1,mm/1,ss/1. When degrees and minutes are used and, for example, fractions of minutes are given up to two decimal places, the format is ddd/1,mmmm/100,0/1."));
+	add(0x0005, EXIF_TR("GPSAltitudeRef"), 6, 1, EXIF_TR("Indicates the altitude used as the reference altitude. If the reference is sea level and the altitude is above sea level, 0 is given. If the altitude is below sea level, a value of 1 is given and the altitude is indicated as an absolute value in the GSPAltitude tag. The reference unit is meters. Note that this tag is BYTE type, unlike other reference tags."));
+	add(0x0006, EXIF_TR("GPSAltitude"), 6, 5, EXIF_TR("Indicates the altitude based on the reference in GPSAltitudeRef. Altitude is expressed as one RATIONAL value. The reference unit is meters."));
+	add(0x0007, EXIF_TR("GPSTimeStamp"), 6, 5, EXIF_TR("Indicates the time as UTC (Coordinated Universal Time). <TimeStamp> is expressed as three RATIONAL values giving the hour, minute, and second (atomic clock)."));
+	add(0x0008, EXIF_TR("GPSSatellites"), 6, 2, EXIF_TR("Indicates the GPS satellites used for measurements. This tag can be used to describe the number of satellites, their ID number, angle of elevation, azimuth, SNR and other information in ASCII notation. The format is not specified. If the GPS receiver is incapable of taking measurements, value of the tag is set to NULL."));
+	add(0x0009, EXIF_TR("GPSStatus"), 6, 2, EXIF_TR("Indicates the status of the GPS receiver when the image is recorded. \"A\" means measurement is in progress, and \"V\" means the measurement is Interoperability."));
+	add(0x000a, EXIF_TR("GPSMeasureMode"), 6, 2, EXIF_TR("Indicates the GPS measurement mode. \"2\" means two-dimensional measurement and \"3\" means three-dimensional measurement is in progress."));
+	add(0x000b, EXIF_TR("GPSDOP"), 6, 5, EXIF_TR("Indicates the GPS DOP (data degree of precision). An HDOP value is written during two-dimensional measurement, and PDOP during three-dimensional measurement."));
+	add(0x000c, EXIF_TR("GPSSpeedRef"), 6, 2, EXIF_TR("Indicates the unit used to express the GPS receiver speed of movement. \"K\" \"M\" and \"N\" represents kilometers per hour, miles per hour, and knots."));
+	add(0x000d, EXIF_TR("GPSSpeed"), 6, 5, EXIF_TR("Indicates the speed of GPS receiver movement."));
+	add(0x000e, EXIF_TR("GPSTrackRef"), 6, 2, EXIF_TR("Indicates the reference for giving the direction of GPS receiver movement. \"T\" denotes true direction and \"M\" is magnetic direction."));
+	add(0x000f, EXIF_TR("GPSTrack"), 6, 5, EXIF_TR("Indicates the direction of GPS receiver movement. The range of values is from 0.00 to 359.99."));
+	add(0x0010, EXIF_TR("GPSImgDirectionRef"), 6, 2, EXIF_TR("Indicates the reference for giving the direction of the image when it is captured. \"T\" denotes true direction and \"M\" is magnetic direction."));
+	add(0x0011, EXIF_TR("GPSImgDirection"), 6, 5, EXIF_TR("Indicates the direction of the image when it was captured. The range of values is from 0.00 to 359.99."));
+	add(0x0012, EXIF_TR("GPSMapDatum"), 6, 2, EXIF_TR("Indicates the geodetic survey data used by the GPS receiver. If the survey data is restricted to Japan, the value of this tag is \"TOKYO\" or \"WGS-84\"."));
+	add(0x0013, EXIF_TR("GPSDestLatitudeRef"), 6, 2, EXIF_TR("Indicates whether the latitude of the destination point is north or south latitude. The ASCII value \"N\" indicates north latitude, and \"S\" is south latitude."));
+	add(0x0014, EXIF_TR("GPSDestLatitude"), 6, 5, EXIF_TR("Indicates the latitude of the destination point. The latitude is expressed as three RATIONAL values giving the degrees, minutes, and seconds, respectively. If latitude is expressed as degrees, minutes and seconds, a typical format would be dd/1,mm/1,ss/1. When degrees and minutes are used and, for example, fractions of minutes are given up to two decimal places, the format would be dd/1,mmmm/100,0/1."));
+	add(0x0015, EXIF_TR("GPSDestLongitudeRef"), 6, 2, EXIF_TR("Indicates whether the longitude of the destination point is east or west longitude. ASCII \"E\" indicates east longitude, and \"W\" is west longitude."));
+	add(0x0016, EXIF_TR("GPSDestLongitude"), 6, 5, EXIF_TR("Indicates the longitude of the destination point. The longitude is expressed as three RATIONAL values giving the degrees, minutes, and seconds, respectively. If longitude is expressed as degrees, minutes and seconds, a typical format would be ddd/1,mm/1,ss/1. When degrees and minutes are used and, for example, fractions of minutes are given up to two decimal places, the format would be ddd/1,mmmm/100,0/1."));
+	add(0x0017, EXIF_TR("GPSDestBearingRef"), 6, 2, EXIF_TR("Indicates the reference used for giving the bearing to the destination point. \"T\" denotes true direction and \"M\" is magnetic direction."));
+	add(0x0018, EXIF_TR("GPSDestBearing"), 6, 5, EXIF_TR("Indicates the bearing to the destination point. The range of values is from 0.00 to 359.99."));
+	add(0x0019, EXIF_TR("GPSDestDistanceRef"), 6, 2, EXIF_TR("Indicates the unit used to express the distance to the destination point. \"K\"), \"M\" and \"N\" represent kilometers, miles and knots."));
+	add(0x001a, EXIF_TR("GPSDestDistance"), 6, 5, EXIF_TR("Indicates the distance to the destination point."));
+	add(0x001b, EXIF_TR("GPSProcessingMethod"), 6, 7, EXIF_TR("A character string recording the name of the method used for location finding. The first byte indicates the character code used, and this is followed by the name of the method."));
+	add(0x001c, EXIF_TR("GPSAreaInformation"), 6, 7, EXIF_TR("A character string recording the name of the GPS area. The first byte indicates the character code used, and this is followed by the name of the GPS area."));
+	add(0x001d, EXIF_TR("GPSDateStamp"), 6, 2, EXIF_TR("A character string recording date and time information relative to UTC (Coordinated Universal Time). The format is \"YYYY:MM:DD.\"."));
+	add(0x001e, EXIF_TR("GPSDifferential"), 6, 3, EXIF_TR("Indicates whether differential correction is applied to the GPS receiver."));
+
+	add(0x0095, EXIF_TR("LensModel"), IFD_MAKERNOTE_CANON, 2, EXIF_TR("Canon maker note: model name of the lens."));
+	add(0x0084, EXIF_TR("Lens"), IFD_MAKERNOTE_NIKON, 5, EXIF_TR("Nikon maker note: minimum and maximum focal length and the maximum aperture at both."));
+	add(0x00a7, EXIF_TR("ShutterCount"), IFD_MAKERNOTE_NIKON, 4, EXIF_TR("Nikon maker note: number of shutter releases of the body."));
+	add(0xb027, EXIF_TR("LensType"), IFD_MAKERNOTE_SONY, 4, EXIF_TR("Sony maker note: id of the A-mount lens, 65535 for E-mount lenses."));
+	add(0x1438, EXIF_TR("ImageCount"), IFD_MAKERNOTE_FUJI, 3, EXIF_TR("Fujifilm maker note: number of images taken by the body, the upper bit is a flag."));
 }
 
 cEXIFTag* cEXIFTagList::add(const qint32& iTAGID, const QString& szTAGName, const qint32& iIFDID, const qint32& iTypeID, const QString& szDescription)
@@ -795,19 +2102,18 @@ cEXIFTag* cEXIFTagList::add(const qint32& iTAGID, const QString& szTAGName, cons
 
 	lpNew	= new cEXIFTag(iTAGID, szTAGName, iIFDID, iTypeID, szDescription);
 	append(lpNew);
+	m_tagHash.insert(key(iTAGID, iIFDID), lpNew);
 	return(lpNew);
 }
 
 cEXIFTag* cEXIFTagList::find(const qint32& iTAGID, const qint32& iIFDID)
 {
-	for(int x = 0;x < count();x++)
-	{
-		cEXIFTag*	lpTag	= at(x);
+	return(m_tagHash.value(key(iTAGID, iIFDID)));
+}
 
-		if(lpTag->m_iTAGID == iTAGID && lpTag->m_iIFDID == iIFDID)
-			return(lpTag);
-	}
-	return(nullptr);
+quint32 cEXIFTagList::key(qint32 iTAGID, qint32 iIFDID)
+{
+	return((static_cast<quint32>(iIFDID) << 16) | static_cast<quint16>(iTAGID));
 }
 
 cEXIFTag* cEXIFValue::exifTag()
@@ -816,67 +2122,210 @@ cEXIFTag* cEXIFValue::exifTag()
 }
 
 cEXIFValue::cEXIFValue(cEXIFTag* lpEXIFTag) :
-	m_lpEXIFTag(lpEXIFTag)
+	m_lpEXIFTag(lpEXIFTag),
+	m_valueType(ValueNone)
 {
 }
 
-QVariant cEXIFValue::convertValue(const QString& szValue, qint32 iTypeId)
+cEXIFValue::ValueType cEXIFValue::valueType(qint32 iTypeId)
 {
-	QVariant	variant;
-
 	switch(iTypeId)
 	{
 	case 1:	//byte
 	case 3: //short
 	case 4: //long
+	case 6: //signed byte
 	case 8: //signed short
-		variant = QVariant::fromValue(szValue.toLong());
-		break;
+	case 9: //signed long
+	case 13: //ifd
+		return(ValueInteger);
 	case 5: //rational
 	case 10: //signed rational
 	case 11: //float
-		if(szValue.contains("/"))
+	case 12: //double
+		return(ValueReal);
+	default:
+		return(ValueText);
+	}
+}
+
+void cEXIFValue::setValue(const Exiv2::Value& value, qint32 iTypeId)
+{
+	long	iCount	= value.count();
+
+	m_valueType	= valueType(iTypeId);
+
+	switch(m_valueType)
+	{
+	case ValueInteger:
+		m_integerList.resize(static_cast<int>(iCount));
+		for(long x = 0;x < iCount;x++)
+			m_integerList[static_cast<int>(x)]	= value.toLong(x);
+		break;
+	case ValueReal:
+		m_realList.resize(static_cast<int>(iCount));
+		for(long x = 0;x < iCount;x++)
 		{
-			QStringList	tmp	= szValue.split("/");
-			variant = QVariant::fromValue(tmp[0].toDouble()/tmp[1].toDouble());
+			if(iTypeId == 5 || iTypeId == 10)
+			{
+				Exiv2::Rational	r	= value.toRational(x);
+
+				m_realList[static_cast<int>(x)]	= static_cast<double>(r.first) / static_cast<double>(r.second);
+			}
+			else
+				m_realList[static_cast<int>(x)]	= static_cast<double>(value.toFloat(x));
 		}
-		else
-			variant	= QVariant::fromValue(szValue.toDouble());
 		break;
 	default:
-		variant	= szValue;
+		m_szText	= QString::fromStdString(value.toString());
+		break;
 	}
-	return(variant);
 }
 
-void cEXIFValue::setValue(const QString& szValue, qint32 iTypeId, qint32 iCount)
+void cEXIFValue::setValue(const uchar* lpData, qint32 iTypeId, quint32 iCount, bool bBigEndian)
 {
-	if(iCount == 1 || iTypeId == 2 || iTypeId == 7)
+	m_valueType	= valueType(iTypeId);
+
+	switch(iTypeId)
+	{
+	case 2: //ascii
 	{
-		m_valueList.append(convertValue(szValue, iTypeId));
+		quint32	iLength	= 0;
+
+		while(iLength < iCount && lpData[iLength])
+			iLength++;
+		m_szText	= QString::fromUtf8(reinterpret_cast<const char*>(lpData), static_cast<int>(iLength));
 		return;
 	}
+	case 1: //byte
+	case 6: //signed byte
+		m_integerList.resize(static_cast<int>(iCount));
+		for(quint32 x = 0;x < iCount;x++)
+			m_integerList[static_cast<int>(x)]	= (iTypeId == 6) ? static_cast<qint8>(lpData[x]) : lpData[x];
+		return;
+	case 3: //short
+	case 8: //signed short
+		m_integerList.resize(static_cast<int>(iCount));
+		for(quint32 x = 0;x < iCount;x++)
+		{
+			quint16	iValue	= bBigEndian ? qFromBigEndian<quint16>(lpData + x * 2) : qFromLittleEndian<quint16>(lpData + x * 2);
+
+			m_integerList[static_cast<int>(x)]	= (iTypeId == 8) ? static_cast<qint16>(iValue) : iValue;
+		}
+		return;
+	case 4: //long
+	case 9: //signed long
+	case 13: //ifd
+		m_integerList.resize(static_cast<int>(iCount));
+		for(quint32 x = 0;x < iCount;x++)
+		{
+			quint32	iValue	= bBigEndian ? qFromBigEndian<quint32>(lpData + x * 4) : qFromLittleEndian<quint32>(lpData + x * 4);
+
+			m_integerList[static_cast<int>(x)]	= (iTypeId == 9) ? static_cast<qint32>(iValue) : iValue;
+		}
+		return;
+	case 5: //rational
+	case 10: //signed rational
+		m_realList.resize(static_cast<int>(iCount));
+		for(quint32 x = 0;x < iCount;x++)
+		{
+			quint32	iNumerator		= bBigEndian ? qFromBigEndian<quint32>(lpData + x * 8) : qFromLittleEndian<quint32>(lpData + x * 8);
+			quint32	iDenominator	= bBigEndian ? qFromBigEndian<quint32>(lpData + x * 8 + 4) : qFromLittleEndian<quint32>(lpData + x * 8 + 4);
 
-	QStringList	valueList	= szValue.split(" ");
+			if(iTypeId == 10)
+				m_realList[static_cast<int>(x)]	= static_cast<double>(static_cast<qint32>(iNumerator)) / static_cast<double>(static_cast<qint32>(iDenominator));
+			else
+				m_realList[static_cast<int>(x)]	= static_cast<double>(iNumerator) / static_cast<double>(iDenominator);
+		}
+		return;
+	case 11: //float
+	case 12: //double
+		m_realList.resize(static_cast<int>(iCount));
+		for(quint32 x = 0;x < iCount;x++)
+		{
+			if(iTypeId == 11)
+			{
+				quint32	iBits	= bBigEndian ? qFromBigEndian<quint32>(lpData + x * 4) : qFromLittleEndian<quint32>(lpData + x * 4);
+				float	fValue;
+
+				memcpy(&fValue, &iBits, sizeof(fValue));
+				m_realList[static_cast<int>(x)]	= fValue;
+			}
+			else
+			{
+				quint64	iBits	= bBigEndian ? qFromBigEndian<quint64>(lpData + x * 8) : qFromLittleEndian<quint64>(lpData + x * 8);
+				double	dValue;
 
-	if(valueList.count() != iCount)
+				memcpy(&dValue, &iBits, sizeof(dValue));
+				m_realList[static_cast<int>(x)]	= dValue;
+			}
+		}
+		return;
+	default:
+	{
+		// same text as Exiv2 prints for undefined data: the bytes as decimal numbers
+		QString	szText;
+
+		szText.reserve(static_cast<int>(iCount) * 4);
+		for(quint32 x = 0;x < iCount;x++)
+		{
+			if(x)
+				szText.append(' ');
+			szText.append(QString::number(lpData[x]));
+		}
+		m_szText	= szText;
 		return;
+	}
+	}
+}
+
+qint32 cEXIFValue::count()
+{
+	switch(m_valueType)
+	{
+	case ValueInteger:
+		return(m_integerList.count());
+	case ValueReal:
+		return(m_realList.count());
+	case ValueText:
+		return(1);
+	default:
+		return(0);
+	}
+}
 
-	for(int x = 0;x < iCount;x++)
-		m_valueList.append(convertValue(valueList[x], iTypeId));
+QVariant cEXIFValue::variant(qint32 iIndex)
+{
+	switch(m_valueType)
+	{
+	case ValueInteger:
+		return(QVariant::fromValue(m_integerList.at(iIndex)));
+	case ValueReal:
+		return(QVariant::fromValue(m_realList.at(iIndex)));
+	default:
+		return(m_szText);
+	}
 }
 
 QVariant cEXIFValue::value()
 {
-	if(m_valueList.count())
-		return(m_valueList[0]);
+	if(count())
+		return(variant(0));
 
 	return(QVariant());
 }
 
 QList<QVariant> cEXIFValue::valueList()
 {
-	return(m_valueList);
+	QList<QVariant>	valueList;
+	qint32			iCount	= count();
+
+	valueList.reserve(iCount);
+
+	for(qint32 x = 0;x < iCount;x++)
+		valueList.append(variant(x));
+
+	return(valueList);
 }
 
 cEXIFValueList::cEXIFValueList()
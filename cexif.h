@@ -6,12 +6,36 @@
 #ifndef CEXIF_H
 #define CEXIF_H
 
+#include "cfileinput.h"
+#include "cifdview.h"
+#include "cbmffreader.h"
+#include "cxmpscanner.h"
+
 #include <QString>
 #include <QVariant>
 #include <QDateTime>
+#include <QByteArray>
+#include <QElapsedTimer>
 
 #include <QMetaType>
 #include <QList>
+#include <QVector>
+#include <QHash>
+#include <QStringList>
+
+#include <functional>
+#include <memory>
+
+
+class cStatistics;
+
+namespace Exiv2
+{
+	class Value;
+	class Image;
+	class IptcData;
+	class XmpData;
+}
 
 
 /*!
@@ -227,6 +251,19 @@ public:
 	 \return cEXIFTag
 	*/
 	cEXIFTag*		find(const qint32& iTAGID, const qint32& iIFDID);
+
+private:
+	QHash<quint32, cEXIFTag*>	m_tagHash;		/*!< index of find() */
+
+	/*!
+	 \brief
+
+	 \fn key
+	 \param iTAGID
+	 \param iIFDID
+	 \return quint32
+	*/
+	static quint32	key(qint32 iTAGID, qint32 iIFDID);
 };
 
 /*!
@@ -236,6 +273,19 @@ public:
 class cEXIFValue
 {
 public:
+	/*!
+	 \brief How the values are stored.
+
+	 \enum ValueType
+	*/
+	enum ValueType
+	{
+		ValueNone		= 0,	/*!< no value set */
+		ValueInteger	= 1,	/*!< BYTE, SHORT, LONG and signed variants in m_integerList */
+		ValueReal		= 2,	/*!< RATIONAL, FLOAT, DOUBLE and signed variants in m_realList */
+		ValueText		= 3,	/*!< ASCII, UNDEFINED and everything else in m_szText */
+	};
+
 	cEXIFValue(cEXIFTag* lpEXIFTag);
 
 	/*!
@@ -246,14 +296,30 @@ public:
 	*/
 	cEXIFTag*		exifTag();
 	/*!
-	 \brief
+	 \brief Copies the decoded values from Exiv2 without going through strings.
 
 	 \fn setValue
-	 \param szValue
+	 \param value
+	 \param iTypeId
+	*/
+	void			setValue(const Exiv2::Value& value, qint32 iTypeId);
+	/*!
+	 \brief Decodes raw TIFF value bytes, see cIFDView.
+
+	 \fn setValue
+	 \param lpData
 	 \param iTypeId
 	 \param iCount
+	 \param bBigEndian
+	*/
+	void			setValue(const uchar* lpData, qint32 iTypeId, quint32 iCount, bool bBigEndian);
+	/*!
+	 \brief
+
+	 \fn count
+	 \return qint32
 	*/
-	void			setValue(const QString& szValue, qint32 iTypeId, qint32 iCount = 1);
+	qint32			count();
 	/*!
 	 \brief
 
@@ -269,19 +335,30 @@ public:
 	*/
 	QList<QVariant>	valueList();
 
+	/*!
+	 \brief
+
+	 \fn valueType
+	 \param iTypeId TIFF type
+	 \return ValueType
+	*/
+	static ValueType	valueType(qint32 iTypeId);
+
 private:
 	cEXIFTag*		m_lpEXIFTag;				/*!< TODO: describe */
-	QList<QVariant>	m_valueList;				/*!< TODO: describe */
+	ValueType		m_valueType;				/*!< which of the lists holds the values */
+	QVector<qint64>	m_integerList;				/*!< values of integer types */
+	QVector<double>	m_realList;					/*!< values of rational and floating point types */
+	QString			m_szText;					/*!< value of text types */
 
 	/*!
 	 \brief
 
-	 \fn convertValue
-	 \param szValue
-	 \param iTypeId
+	 \fn variant
+	 \param iIndex
 	 \return QVariant
 	*/
-	QVariant		convertValue(const QString& szValue, qint32 iTypeId);
+	QVariant		variant(qint32 iIndex);
 };
 
 Q_DECLARE_METATYPE(cEXIFValue*)
@@ -322,7 +399,33 @@ public:
 class cEXIF
 {
 public:
+	/*!
+	 \brief Called by fromFiles() and fromBuffers() after every file. exif holds the tags of file iIndex until the callback returns.
+	*/
+	typedef std::function<void(qint32 iIndex, bool bOK, cEXIF& exif)>	cBatchCallback;
+
+	/*!
+	 \brief Container formats opened with their Exiv2 image class directly.
+
+	 \enum ImageFormat
+	*/
+	enum ImageFormat
+	{
+		ImageFormatUnknown	= 0,	/*!< opened by Exiv2::ImageFactory, which probes every format */
+		ImageFormatJPEG		= 1,	/*!< Exiv2::JpegImage */
+		ImageFormatTIFF		= 2,	/*!< Exiv2::TiffImage, also the TIFF based RAW formats (NEF, ARW, DNG, PEF, ...) */
+		ImageFormatCR2		= 3,	/*!< Exiv2::Cr2Image */
+		ImageFormatCRW		= 4,	/*!< Exiv2::CrwImage */
+		ImageFormatORF		= 5,	/*!< Exiv2::OrfImage */
+		ImageFormatRW2		= 6,	/*!< Exiv2::Rw2Image */
+		ImageFormatRAF		= 7,	/*!< Exiv2::RafImage */
+		ImageFormatMRW		= 8,	/*!< Exiv2::MrwImage */
+		ImageFormatPNG		= 9,	/*!< Exiv2::PngImage */
+		ImageFormatWebP		= 10,	/*!< Exiv2::WebPImage */
+	};
+
 	cEXIF();
+	~cEXIF();
 
 	/*!
 	 \brief
@@ -332,6 +435,40 @@ public:
 	 \return bool
 	*/
 	bool					fromFile(const QString& szFileName);
+	/*!
+	 \brief Parses a prefix of szFileName already read by the caller. The file is read completely if the metadata is not contained in the buffer.
+
+	 \fn fromBuffer
+	 \param szFileName
+	 \param buffer first bytes of the file
+	 \param iFileSize size of the whole file
+	 \return bool
+	*/
+	bool					fromBuffer(const QString& szFileName, const QByteArray& buffer, qint64 iFileSize);
+	/*!
+	 \brief Reads a batch of files with this object.
+
+	 The tag tables, the read buffer and the IFD view are built once and
+	 reused for every file of the batch, only the values are decoded per
+	 file.
+
+	 \fn fromFiles
+	 \param fileList
+	 \param callback
+	 \return qint32 number of files read
+	*/
+	qint32					fromFiles(const QStringList& fileList, cBatchCallback callback);
+	/*!
+	 \brief Batch version of fromBuffer(), bufferList and fileSizeList have one entry per file of fileList. Files with an empty buffer are read with fromFile().
+
+	 \fn fromBuffers
+	 \param fileList
+	 \param bufferList
+	 \param fileSizeList
+	 \param callback
+	 \return qint32 number of files read
+	*/
+	qint32					fromBuffers(const QStringList& fileList, const QList<QByteArray>& bufferList, const QList<qint64>& fileSizeList, cBatchCallback callback);
 
 	/*!
 	 \brief
@@ -418,12 +555,26 @@ public:
 	*/
 	QString					lensMake();
 	/*!
-	 \brief
+	 \brief LensModel of the Exif IFD, if it is empty and setMakerNote() is enabled the lens named by the maker note.
+
+	 Canon: LensModel (0x0095). Nikon: focal length and aperture range of
+	 the Lens tag (0x0084), e.g. "24-70mm f/2.8". Sony: "Sony lens <id>" of
+	 LensType (0xb027), the A-mount lens id.
 
 	 \fn lensModel
 	 \return QString
 	*/
 	QString					lensModel();
+	/*!
+	 \brief Number of shutter releases from the maker note, 0 if it is not known or setMakerNote() is not enabled.
+
+	 Nikon: ShutterCount (0x00a7). Fujifilm: ImageCount (0x1438). Canon and
+	 Sony do not store it unencrypted in the maker note.
+
+	 \fn shutterCount
+	 \return qint32
+	*/
+	qint32					shutterCount();
 	/*!
 	 \brief
 
@@ -480,6 +631,101 @@ public:
 	 \return QString
 	*/
 	QString					gps();
+	/*!
+	 \brief true if latitude and longitude were read.
+
+	 \fn hasGPS
+	 \return bool
+	*/
+	bool					hasGPS();
+	/*!
+	 \brief Latitude in decimal degrees, negative in the southern hemisphere.
+
+	 \fn gpsLatitude
+	 \return double
+	*/
+	double					gpsLatitude();
+	/*!
+	 \brief Longitude in decimal degrees, negative west of Greenwich.
+
+	 \fn gpsLongitude
+	 \return double
+	*/
+	double					gpsLongitude();
+	/*!
+	 \brief
+
+	 \fn hasGPSAltitude
+	 \return bool
+	*/
+	bool					hasGPSAltitude();
+	/*!
+	 \brief Altitude in meters, negative below sea level.
+
+	 \fn gpsAltitude
+	 \return double
+	*/
+	double					gpsAltitude();
+	/*!
+	 \brief true if DateTimeOriginal or DateTime could be parsed.
+
+	 \fn hasTimestamp
+	 \return bool
+	*/
+	bool					hasTimestamp();
+	/*!
+	 \brief Capture time (DateTimeOriginal, or DateTime if missing) including SubSecTime as UTC nanoseconds since the epoch.
+
+	 The offset comes from OffsetTimeOriginal/OffsetTime, or is derived
+	 from the GPS clock. If neither is known the local time is taken as UTC,
+	 see hasUTCOffset().
+
+	 \fn timestamp
+	 \return qint64
+	*/
+	qint64					timestamp();
+	/*!
+	 \brief
+
+	 \fn hasUTCOffset
+	 \return bool
+	*/
+	bool					hasUTCOffset();
+	/*!
+	 \brief Offset of the camera clock in seconds east of UTC.
+
+	 \fn utcOffset
+	 \return qint32
+	*/
+	qint32					utcOffset();
+	/*!
+	 \brief
+
+	 \fn hasGPSTimestamp
+	 \return bool
+	*/
+	bool					hasGPSTimestamp();
+	/*!
+	 \brief GPSDateStamp and GPSTimeStamp as UTC nanoseconds since the epoch.
+
+	 \fn gpsTimestamp
+	 \return qint64
+	*/
+	qint64					gpsTimestamp();
+	/*!
+	 \brief Values of the properties set with setXMPProperties(), in the same order.
+
+	 \fn xmpValues
+	 \return QStringList
+	*/
+	QStringList				xmpValues();
+	/*!
+	 \brief Values of the datasets set with setIPTCDatasets(), in the same order. Repeated datasets (Keywords) are joined with "; ".
+
+	 \fn iptcValues
+	 \return QStringList
+	*/
+	QStringList				iptcValues();
 	/*!
 	 \brief
 
@@ -502,16 +748,161 @@ public:
 	*/
 	QImage					thumbnail();
 
+	/*!
+	 \brief Makes fromFile() keep the smallest embedded preview image.
+
+	 \fn setReadPreview
+	 \param bReadPreview
+	*/
+	void					setReadPreview(bool bReadPreview);
+	/*!
+	 \brief Encoded bytes of the preview kept by fromFile(), empty if none.
+
+	 \fn previewData
+	 \return QByteArray
+	*/
+	QByteArray				previewData();
+	/*!
+	 \brief
+
+	 \fn previewWidth
+	 \return qint32
+	*/
+	qint32					previewWidth();
+	/*!
+	 \brief
+
+	 \fn previewHeight
+	 \return qint32
+	*/
+	qint32					previewHeight();
+
+	/*!
+	 \brief Reads the image size of RAW files with LibRaw instead of trusting Exiv2.
+
+	 LibRaw only opens the file and parses the metadata, the image data is not unpacked.
+
+	 \fn setLibRaw
+	 \param bLibRaw
+	*/
+	void					setLibRaw(bool bLibRaw);
+	/*!
+	 \brief Collects the time spent in Exiv2 and LibRaw per file extension.
+
+	 \fn setStatistics
+	 \param lpStatistics
+	*/
+	void					setStatistics(cStatistics* lpStatistics);
+	/*!
+	 \brief Selects how fromFile() reads the file. With IOModePrefix the whole file is read if the metadata is not complete within iPrefixSize bytes.
+
+	 \fn setIOMode
+	 \param ioMode
+	 \param iPrefixSize size of the metadata region in bytes
+	*/
+	void					setIOMode(cFileInput::IOMode ioMode, qint64 iPrefixSize);
+	/*!
+	 \brief Opens every file through Exiv2::ImageFactory instead of the image class of its format, for comparing the probe cost with --stats.
+
+	 \fn setImageFactory
+	 \param bImageFactory
+	*/
+	void					setImageFactory(bool bImageFactory);
+	/*!
+	 \brief Reads the lens and the shutter count from the Canon, Nikon, Sony and Fujifilm maker notes. Only the top level IFD of the maker note is walked and only these tags are kept.
+
+	 \fn setMakerNote
+	 \param bMakerNote
+	*/
+	void					setMakerNote(bool bMakerNote);
+	/*!
+	 \brief Extracts these XMP properties (prefix:name, e.g. xmp:Rating or dc:subject) with cXMPScanner.
+
+	 \fn setXMPProperties
+	 \param szPropertyList
+	 \return bool false if a property is not of the form prefix:name
+	*/
+	bool					setXMPProperties(const QStringList& szPropertyList);
+	/*!
+	 \brief Extracts these IPTC datasets of the application record (e.g. Caption, Keywords, Headline).
+
+	 \fn setIPTCDatasets
+	 \param szDatasetList
+	 \return bool false if Exiv2 does not know a dataset
+	*/
+	bool					setIPTCDatasets(const QStringList& szDatasetList);
+
+	/*!
+	 \brief
+
+	 \fn isRAW
+	 \param szFileName
+	 \return bool
+	*/
+	static bool				isRAW(const QString& szFileName);
+	/*!
+	 \brief Detects the format from the signature at the start of the file.
+
+	 \fn imageFormat
+	 \param lpData
+	 \param iSize
+	 \return ImageFormat, ImageFormatUnknown if the signature is not known
+	*/
+	static ImageFormat		imageFormat(const uchar* lpData, qint64 iSize);
+	/*!
+	 \brief Guesses the format from the extension of szFileName.
+
+	 \fn imageFormat
+	 \param szFileName
+	 \return ImageFormat
+	*/
+	static ImageFormat		imageFormat(const QString& szFileName);
+	/*!
+	 \brief Name of the format in the exiv2-open/ statistics.
+
+	 \fn imageFormatName
+	 \param format
+	 \return QString
+	*/
+	static QString			imageFormatName(ImageFormat format);
+
 private:
+	Q_DISABLE_COPY(cEXIF)
+
 	cEXIFValueList			m_exifValueList;				/*!< TODO: describe */
 	qint32					m_iWidth;						/*!< TODO: describe */
 	qint32					m_iHeight;						/*!< TODO: describe */
 	QString					m_szFileName;					/*!< TODO: describe */
 
-	cEXIFCompressionList	m_exifCompressionList;			/*!< TODO: describe */
-	cEXIFLightSourceList	m_exifLightSourceList;			/*!< TODO: describe */
-	cEXIFFlashList			m_exifFlashList;				/*!< TODO: describe */
-	cEXIFTagList			m_exifTagList;					/*!< TODO: describe */
+	bool					m_bReadPreview;					/*!< extract the smallest preview in fromFile() */
+	QByteArray				m_previewData;					/*!< encoded preview image */
+	qint32					m_iPreviewWidth;				/*!< width of the preview image */
+	qint32					m_iPreviewHeight;				/*!< height of the preview image */
+	bool					m_bLibRaw;						/*!< read the size of RAW files with LibRaw */
+	cStatistics*			m_lpStatistics;					/*!< timing statistics, or nullptr */
+	cFileInput::IOMode		m_ioMode;						/*!< how fromFile() reads the file */
+	qint64					m_iPrefixSize;					/*!< size of the metadata region */
+	bool					m_bImageFactory;				/*!< always open through Exiv2::ImageFactory */
+	bool					m_bMakerNote;					/*!< read the maker note tags */
+	bool					m_bGPS;							/*!< m_dLatitude and m_dLongitude are valid */
+	double					m_dLatitude;					/*!< latitude in decimal degrees */
+	double					m_dLongitude;					/*!< longitude in decimal degrees */
+	bool					m_bGPSAltitude;					/*!< m_dAltitude is valid */
+	double					m_dAltitude;					/*!< altitude in meters */
+	bool					m_bTimestamp;					/*!< m_iTimestamp is valid */
+	qint64					m_iTimestamp;					/*!< capture time in UTC nanoseconds */
+	bool					m_bUTCOffset;					/*!< m_iUTCOffset is valid */
+	qint32					m_iUTCOffset;					/*!< offset of the camera clock in seconds */
+	bool					m_bGPSTimestamp;				/*!< m_iGPSTimestamp is valid */
+	qint64					m_iGPSTimestamp;				/*!< GPS time in UTC nanoseconds */
+
+	cIFDView				m_ifdView;						/*!< undecoded tags, decoded by findValue() on first use */
+	cFileInput				m_input;						/*!< reused for every file */
+	cBMFFReader				m_bmffReader;					/*!< reads HEIF, AVIF and CR3 files, reused for every file */
+	cXMPScanner				m_xmpScanner;					/*!< extracts the configured XMP properties */
+	QStringList				m_xmpValueList;					/*!< values of the XMP properties */
+	QList<quint16>			m_iptcDatasetList;				/*!< datasets of the application record to extract */
+	QStringList				m_iptcValueList;				/*!< values of the IPTC datasets */
 
 	/*!
 	 \brief
@@ -531,6 +922,108 @@ private:
 	 \return QList<QVariant>
 	*/
 	QList<QVariant>			getTagList(qint32 iTAGID, qint32 iIFDID);
+	/*!
+	 \brief Returns the value of a tag, decoding it from m_ifdView the first time.
+
+	 \fn findValue
+	 \param iTAGID
+	 \param iIFDID
+	 \return cEXIFValue, nullptr if the tag is not set
+	*/
+	cEXIFValue*				findValue(qint32 iTAGID, qint32 iIFDID);
+	/*!
+	 \brief
+
+	 \fn readLibRaw
+	 \param szFileName
+	 \return bool
+	*/
+	bool					readLibRaw(const QString& szFileName);
+	/*!
+	 \brief Fills m_iTimestamp, m_iUTCOffset and m_iGPSTimestamp from the parsed tags.
+
+	 \fn readTimestamps
+	*/
+	void					readTimestamps();
+	/*!
+	 \brief Parses the file from input, or lets Exiv2 open it if bInput is false.
+
+	 \fn read
+	 \param szFileName
+	 \param input
+	 \param bInput
+	 \param timer started when reading the file began
+	 \return bool
+	*/
+	bool					read(const QString& szFileName, cFileInput& input, bool bInput, QElapsedTimer& timer);
+	/*!
+	 \brief Opens the file from input, or by name if bInput is false, and reads its metadata.
+
+	 The format is taken from the signature of the input or the extension of
+	 the file name and opened with its Exiv2 image class. Unknown formats,
+	 and files whose content does not match the guessed format, are opened
+	 through Exiv2::ImageFactory. Throws Exiv2::AnyError like Exiv2 does.
+
+	 \fn openImage
+	 \param szFileName
+	 \param input
+	 \param bInput
+	 \return Exiv2::Image, nullptr if Exiv2 does not know the format
+	*/
+	std::unique_ptr<Exiv2::Image>	openImage(const QString& szFileName, cFileInput& input, bool bInput);
+	/*!
+	 \brief Reads a HEIF, AVIF or CR3 file with cBMFFReader instead of Exiv2.
+
+	 \fn readBMFF
+	 \param szFileName
+	 \param input
+	 \param bInput
+	 \param timer started when reading the file began
+	 \return bool false if the file has to be read by Exiv2
+	*/
+	bool					readBMFF(const QString& szFileName, cFileInput& input, bool bInput, QElapsedTimer& timer);
+	/*!
+	 \brief Fills the GPS position from the parsed tags, for files not read by Exiv2.
+
+	 \fn readGPS
+	*/
+	void					readGPS();
+	/*!
+	 \brief Scans an XMP packet for the configured properties.
+
+	 \fn readXMP
+	 \param lpData
+	 \param iSize
+	*/
+	void					readXMP(const char* lpData, qint64 iSize);
+	/*!
+	 \brief Takes the configured properties from the XMP data decoded by Exiv2, for image classes which don't keep the packet.
+
+	 \fn readXMP
+	 \param xmpData
+	*/
+	void					readXMP(const Exiv2::XmpData& xmpData);
+	/*!
+	 \brief Collects the configured datasets from the IPTC data decoded by Exiv2.
+
+	 \fn readIPTC
+	 \param iptcData
+	*/
+	void					readIPTC(const Exiv2::IptcData& iptcData);
+	/*!
+	 \brief Lens named by the maker note, empty if there is none.
+
+	 \fn makerNoteLens
+	 \return QString
+	*/
+	QString					makerNoteLens();
+	/*!
+	 \brief Counts the maker notes found by the vendor in the makernote/ statistics.
+
+	 \fn countMakerNote
+	 \param iIFD IFD_MAKERNOTE_*, 0 if there was none
+	*/
+	void					countMakerNote(qint32 iIFD);
 };
 
 #endif // CEXIF_H
@@ -0,0 +1,353 @@
+/*!
+ \file cexternalsort.cpp
+
+*/
+
+#include "cexternalsort.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QAtomicInt>
+
+#include <algorithm>
+#include <queue>
+#include <vector>
+
+
+#define MAX_FANIN		256
+#define MIN_SLICE		4096
+#define RECORD_OVERHEAD	(static_cast<qint64>(sizeof(cSortRecord)) + 32)
+
+
+static bool recordLessThan(const cSortRecord& r1, const cSortRecord& r2)
+{
+	if(r1.m_iKey != r2.m_iKey)
+		return(r1.m_iKey < r2.m_iKey);
+	return(r1.m_iSequence < r2.m_iSequence);
+}
+
+/*!
+ \brief Sorts one slice of the buffer and optionally writes it as a run.
+
+ \class cSortTask cexternalsort.cpp
+*/
+class cSortTask : public QRunnable
+{
+public:
+	cSortTask(cSortRecord* lpBegin, cSortRecord* lpEnd, QTemporaryFile* lpRun, QAtomicInt* lpFailed) :
+		m_lpBegin(lpBegin),
+		m_lpEnd(lpEnd),
+		m_lpRun(lpRun),
+		m_lpFailed(lpFailed)
+	{
+	}
+
+	void run()
+	{
+		std::sort(m_lpBegin, m_lpEnd, recordLessThan);
+
+		if(!m_lpRun)
+			return;
+
+		QDataStream	stream(m_lpRun);
+
+		for(cSortRecord* lpRecord = m_lpBegin;lpRecord != m_lpEnd;lpRecord++)
+			stream << lpRecord->m_iKey << lpRecord->m_iSequence << lpRecord->m_szLine.toUtf8();
+
+		// e.g. the temp directory is full
+		if(!m_lpRun->flush() || stream.status() != QDataStream::Ok)
+			m_lpFailed->storeRelease(1);
+	}
+
+	cSortRecord*		m_lpBegin;				/*!< first record of the slice */
+	cSortRecord*		m_lpEnd;				/*!< end of the slice */
+	QTemporaryFile*		m_lpRun;				/*!< run file receiving the slice, or nullptr */
+	QAtomicInt*			m_lpFailed;				/*!< set to 1 if the run can't be written */
+};
+
+/*!
+ \brief Sequential reader of a run file used by the merge.
+
+ \class cSortRun cexternalsort.cpp
+*/
+class cSortRun
+{
+public:
+	cSortRun(QTemporaryFile* lpFile) :
+		m_stream(lpFile),
+		m_bValid(false),
+		m_bError(false)
+	{
+		lpFile->seek(0);
+		next();
+	}
+
+	bool next()
+	{
+		QByteArray	line;
+
+		if(m_stream.atEnd())
+		{
+			m_bValid	= false;
+			return(false);
+		}
+
+		m_stream >> m_record.m_iKey >> m_record.m_iSequence >> line;
+		m_record.m_szLine	= QString::fromUtf8(line);
+		m_bValid			= (m_stream.status() == QDataStream::Ok);
+		// a short or corrupt record is not the end of the run
+		m_bError			= !m_bValid;
+		return(m_bValid);
+	}
+
+	QDataStream		m_stream;				/*!< stream over the run file */
+	cSortRecord		m_record;				/*!< current record */
+	bool			m_bValid;				/*!< m_record holds a record */
+	bool			m_bError;				/*!< the run ended with an unreadable record */
+};
+
+cExternalSort::cExternalSort(qint64 iMemoryLimit, qint32 iJobs, const QString& szTempPath) :
+	m_iMemoryLimit(iMemoryLimit),
+	m_iJobs(iJobs > 0 ? iJobs : 1),
+	m_szTempPath(szTempPath.isEmpty() ? QDir::tempPath() : szTempPath),
+	m_iMemory(0),
+	m_iSequence(0),
+	m_iRunCount(0),
+	m_bFailed(false)
+{
+}
+
+cExternalSort::~cExternalSort()
+{
+	qDeleteAll(m_runList);
+}
+
+bool cExternalSort::add(qint64 iKey, const QString& szLine)
+{
+	// the output is incomplete anyway, don't buffer any more
+	if(m_bFailed)
+		return(false);
+
+	cSortRecord	record;
+
+	record.m_iKey		= iKey;
+	record.m_iSequence	= m_iSequence++;
+	record.m_szLine		= szLine;
+
+	m_recordList.append(record);
+	m_iMemory	+= RECORD_OVERHEAD + szLine.size() * static_cast<qint64>(sizeof(QChar));
+
+	if(m_iMemory >= m_iMemoryLimit)
+		return(spill());
+	return(true);
+}
+
+bool cExternalSort::finish(QTextStream& out)
+{
+	if(m_bFailed)
+		return(false);
+
+	if(m_runList.isEmpty())
+	{
+		// everything fits into memory: merge the sorted slices directly
+		QVector<qint32>	boundList	= sortSlices();
+		typedef std::pair<const cSortRecord*, qint32>	cHead;
+		auto			greater		= [](const cHead& h1, const cHead& h2) { return(recordLessThan(*h2.first, *h1.first)); };
+		std::priority_queue<cHead, std::vector<cHead>, decltype(greater)>	heap(greater);
+		QVector<qint32>	posList(boundList.mid(0, boundList.count() - 1));
+
+		for(int x = 0;x < posList.count();x++)
+		{
+			if(posList[x] < boundList[x + 1])
+				heap.push(cHead(&m_recordList[posList[x]], x));
+		}
+
+		while(!heap.empty())
+		{
+			cHead	head	= heap.top();
+
+			heap.pop();
+			out << head.first->m_szLine;
+
+			qint32	iSlice	= head.second;
+			if(++posList[iSlice] < boundList[iSlice + 1])
+				heap.push(cHead(&m_recordList[posList[iSlice]], iSlice));
+		}
+
+		m_recordList.clear();
+		m_iMemory	= 0;
+
+		out.flush();
+		return(out.status() == QTextStream::Ok);
+	}
+
+	if(!m_recordList.isEmpty() && !spill())
+		return(false);
+
+	while(m_runList.count() > MAX_FANIN)
+	{
+		QList<QTemporaryFile*>	groupList	= m_runList.mid(0, MAX_FANIN);
+		QTemporaryFile*			lpRun		= newRun();
+
+		if(!lpRun || !mergeRuns(groupList, lpRun, nullptr))
+			return(false);
+
+		for(int x = 0;x < groupList.count();x++)
+			m_runList.removeOne(groupList[x]);
+		qDeleteAll(groupList);
+
+		m_runList.append(lpRun);
+	}
+
+	bool	bOK	= mergeRuns(m_runList, nullptr, &out);
+
+	qDeleteAll(m_runList);
+	m_runList.clear();
+
+	return(bOK);
+}
+
+qint32 cExternalSort::runCount()
+{
+	return(m_iRunCount);
+}
+
+QVector<qint32> cExternalSort::sortSlices()
+{
+	qint32			iCount	= m_recordList.count();
+	qint32			iSlices	= qBound(1, iCount / MIN_SLICE, m_iJobs);
+	QVector<qint32>	boundList;
+	QThreadPool		threadPool;
+
+	threadPool.setMaxThreadCount(m_iJobs);
+
+	for(int x = 0;x <= iSlices;x++)
+		boundList.append(static_cast<qint32>(static_cast<qint64>(iCount) * x / iSlices));
+
+	for(int x = 0;x < iSlices;x++)
+		threadPool.start(new cSortTask(m_recordList.data() + boundList[x], m_recordList.data() + boundList[x + 1], nullptr, nullptr));
+
+	threadPool.waitForDone();
+	return(boundList);
+}
+
+bool cExternalSort::spill()
+{
+	qint32					iCount	= m_recordList.count();
+	qint32					iSlices	= qBound(1, iCount / MIN_SLICE, m_iJobs);
+	QList<QTemporaryFile*>	runList;
+	QThreadPool				threadPool;
+	QAtomicInt				failed(0);
+
+	threadPool.setMaxThreadCount(m_iJobs);
+
+	for(int x = 0;x < iSlices;x++)
+	{
+		QTemporaryFile*	lpRun	= newRun();
+
+		if(!lpRun)
+		{
+			qDeleteAll(runList);
+			m_bFailed	= true;
+			return(false);
+		}
+		runList.append(lpRun);
+	}
+
+	// every slice is sorted and written to its own run on a worker
+	for(int x = 0;x < iSlices;x++)
+	{
+		qint64	iBegin	= static_cast<qint64>(iCount) * x / iSlices;
+		qint64	iEnd	= static_cast<qint64>(iCount) * (x + 1) / iSlices;
+
+		threadPool.start(new cSortTask(m_recordList.data() + iBegin, m_recordList.data() + iEnd, runList[x], &failed));
+	}
+
+	threadPool.waitForDone();
+
+	if(failed.loadAcquire())
+	{
+		qDeleteAll(runList);
+		m_bFailed	= true;
+		return(false);
+	}
+
+	m_runList.append(runList);
+	m_recordList.clear();
+	m_recordList.squeeze();
+	m_iMemory	= 0;
+
+	return(true);
+}
+
+QTemporaryFile* cExternalSort::newRun()
+{
+	QTemporaryFile*	lpRun	= new QTemporaryFile(m_szTempPath + QDir::separator() + "qtEXIF2File-sort-XXXXXX.run");
+
+	if(!lpRun->open())
+	{
+		delete lpRun;
+		return(nullptr);
+	}
+
+	m_iRunCount++;
+	return(lpRun);
+}
+
+bool cExternalSort::mergeRuns(const QList<QTemporaryFile*>& runList, QTemporaryFile* lpRun, QTextStream* lpOut)
+{
+	QList<cSortRun*>	readerList;
+	auto				greater	= [&readerList](qint32 i1, qint32 i2) { return(recordLessThan(readerList.at(i2)->m_record, readerList.at(i1)->m_record)); };
+	std::priority_queue<qint32, std::vector<qint32>, decltype(greater)>	heap(greater);
+	QDataStream			stream;
+
+	if(lpRun)
+		stream.setDevice(lpRun);
+
+	for(int x = 0;x < runList.count();x++)
+	{
+		readerList.append(new cSortRun(runList[x]));
+
+		if(readerList.last()->m_bValid)
+			heap.push(x);
+	}
+
+	while(!heap.empty())
+	{
+		qint32			iRun	= heap.top();
+		cSortRun*		lpRead	= readerList.at(iRun);
+
+		heap.pop();
+
+		if(lpOut)
+			*lpOut << lpRead->m_record.m_szLine;
+		else
+			stream << lpRead->m_record.m_iKey << lpRead->m_record.m_iSequence << lpRead->m_record.m_szLine.toUtf8();
+
+		if(lpRead->next())
+			heap.push(iRun);
+	}
+
+	bool	bOK	= true;
+
+	for(int x = 0;x < readerList.count();x++)
+	{
+		if(readerList.at(x)->m_bError)
+			bOK	= false;
+	}
+	qDeleteAll(readerList);
+
+	if(lpRun && (!lpRun->flush() || stream.status() != QDataStream::Ok))
+		bOK	= false;
+
+	if(lpOut)
+	{
+		lpOut->flush();
+		if(lpOut->status() != QTextStream::Ok)
+			bOK	= false;
+	}
+
+	return(bOK);
+}
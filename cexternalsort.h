@@ -0,0 +1,125 @@
+/*!
+ \file cexternalsort.h
+
+*/
+
+#ifndef CEXTERNALSORT_H
+#define CEXTERNALSORT_H
+
+
+#include <QString>
+#include <QVector>
+#include <QList>
+#include <QTextStream>
+#include <QTemporaryFile>
+
+
+/*!
+ \brief One output row with its sort key.
+
+ \class cSortRecord cexternalsort.h "cexternalsort.h"
+*/
+class cSortRecord
+{
+public:
+	qint64		m_iKey;						/*!< sort key */
+	qint64		m_iSequence;				/*!< input position, keeps the sort stable */
+	QString		m_szLine;					/*!< the row including the line feed */
+};
+
+/*!
+ \brief Sorts output rows by a 64 bit key in bounded memory.
+
+ Rows are buffered until the memory limit is reached. The buffer is then cut
+ into one slice per job, the slices are sorted and written to temporary run
+ files in parallel. finish() k-way merges all runs (in several passes if
+ there are too many) into the output. If nothing was spilled, the sorted
+ slices are merged directly from memory.
+
+ \class cExternalSort cexternalsort.h "cexternalsort.h"
+*/
+class cExternalSort
+{
+public:
+	/*!
+	 \brief
+
+	 \fn cExternalSort
+	 \param iMemoryLimit bytes used for buffered rows
+	 \param iJobs number of slices sorted in parallel
+	 \param szTempPath directory for the run files, empty for the system default
+	*/
+	cExternalSort(qint64 iMemoryLimit, qint32 iJobs, const QString& szTempPath = QString());
+	~cExternalSort();
+
+	/*!
+	 \brief
+
+	 \fn add
+	 \param iKey
+	 \param szLine
+	 \return bool false if a run could not be written, finish() fails then too
+	*/
+	bool						add(qint64 iKey, const QString& szLine);
+	/*!
+	 \brief Writes all rows sorted by key to out.
+
+	 \fn finish
+	 \param out
+	 \return bool false if a run could not be written or read back, or out failed
+	*/
+	bool						finish(QTextStream& out);
+
+	/*!
+	 \brief
+
+	 \fn runCount
+	 \return qint32
+	*/
+	qint32						runCount();
+
+private:
+	qint64						m_iMemoryLimit;				/*!< maximum size of m_recordList in bytes */
+	qint32						m_iJobs;					/*!< number of parallel slices */
+	QString						m_szTempPath;				/*!< directory for the run files */
+	QVector<cSortRecord>		m_recordList;				/*!< current in-memory buffer */
+	qint64						m_iMemory;					/*!< estimated size of m_recordList */
+	qint64						m_iSequence;				/*!< next input position */
+	QList<QTemporaryFile*>		m_runList;					/*!< spilled, sorted runs */
+	qint32						m_iRunCount;				/*!< number of runs written, including merge passes */
+	bool						m_bFailed;					/*!< a run could not be written, the output would be incomplete */
+
+	/*!
+	 \brief Sorts the buffer in parallel slices, returns the slice bounds.
+
+	 \fn sortSlices
+	 \return QVector<qint32>
+	*/
+	QVector<qint32>				sortSlices();
+	/*!
+	 \brief
+
+	 \fn spill
+	 \return bool
+	*/
+	bool						spill();
+	/*!
+	 \brief
+
+	 \fn newRun
+	 \return QTemporaryFile
+	*/
+	QTemporaryFile*				newRun();
+	/*!
+	 \brief Merges run files into a new run, or into out if lpOut is set.
+
+	 \fn mergeRuns
+	 \param runList
+	 \param lpRun
+	 \param lpOut
+	 \return bool
+	*/
+	bool						mergeRuns(const QList<QTemporaryFile*>& runList, QTemporaryFile* lpRun, QTextStream* lpOut);
+};
+
+#endif // CEXTERNALSORT_H
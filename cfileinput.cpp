@@ -0,0 +1,220 @@
+/*!
+ \file cfileinput.cpp
+
+*/
+
+#include "cfileinput.h"
+
+#include <QStorageInfo>
+
+#if defined(Q_OS_UNIX)
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(Q_OS_LINUX)
+#include <sys/vfs.h>
+#endif
+
+
+#if defined(Q_OS_LINUX)
+// f_type values of statfs(), see statfs(2)
+#define NFS_MAGIC		0x00006969
+#define SMB_MAGIC		0x0000517b
+#define CIFS_MAGIC		0xff534d42
+#define SMB2_MAGIC		0xfe534d42
+#define AFS_MAGIC		0x5346414f
+#define CEPH_MAGIC		0x00c36400
+#define FUSE_MAGIC		0x65735546
+#define CODA_MAGIC		0x73757245
+#define NCP_MAGIC		0x0000564c
+#endif
+
+
+cFileInput::cFileInput() :
+	m_lpMap(nullptr),
+	m_bOwnBuffer(false),
+	m_iFileSize(0),
+	m_mode(IOModeRead)
+{
+}
+
+cFileInput::~cFileInput()
+{
+	close();
+}
+
+bool cFileInput::open(const QString& szFileName, IOMode mode, qint64 iPrefixSize)
+{
+	close();
+
+	m_file.setFileName(szFileName);
+	if(!m_file.open(QFile::ReadOnly))
+		return(false);
+
+	m_iFileSize	= m_file.size();
+	m_mode		= mode;
+
+	// a bounded prefix, if the metadata is not in it cEXIF lets Exiv2 read the file by name
+	if(m_mode == IOModeMMap && (m_iFileSize == 0 || isNetworkFileSystem(szFileName)))
+		m_mode	= IOModePrefix;
+
+	if(m_mode == IOModeMMap)
+	{
+		m_lpMap	= m_file.map(0, m_iFileSize);
+
+		if(m_lpMap)
+		{
+#if defined(Q_OS_UNIX)
+			// only the metadata region is needed soon, the image data is usually never touched
+			size_t	iAdvise	= static_cast<size_t>(qMin(m_iFileSize, iPrefixSize));
+
+			madvise(m_lpMap, static_cast<size_t>(m_iFileSize), MADV_RANDOM);
+			madvise(m_lpMap, iAdvise, MADV_SEQUENTIAL);
+			madvise(m_lpMap, iAdvise, MADV_WILLNEED);
+#endif
+			return(true);
+		}
+
+		m_mode	= IOModePrefix;
+	}
+
+	if(m_mode == IOModePrefix)
+	{
+		qint64	iSize	= qMin(m_iFileSize, iPrefixSize);
+
+		if(m_buffer.capacity() < iSize)
+			m_buffer.reserve(static_cast<int>(iSize));
+		m_buffer.resize(static_cast<int>(iSize));
+		m_buffer.resize(static_cast<int>(qMax(Q_INT64_C(0), m_file.read(m_buffer.data(), iSize))));
+		m_bOwnBuffer	= true;
+	}
+	else
+	{
+		m_mode			= IOModeRead;
+		m_buffer		= m_file.readAll();
+		m_bOwnBuffer	= false;
+	}
+
+	m_file.close();
+	return(m_buffer.size() > 0);
+}
+
+void cFileInput::setBuffer(const QByteArray& buffer, qint64 iFileSize)
+{
+	close();
+
+	m_buffer		= buffer;
+	m_bOwnBuffer	= false;
+	m_iFileSize		= iFileSize;
+	m_mode			= IOModePrefix;
+}
+
+void cFileInput::close()
+{
+	if(m_lpMap)
+	{
+		m_file.unmap(m_lpMap);
+		m_lpMap	= nullptr;
+	}
+
+	if(m_file.isOpen())
+		m_file.close();
+
+	// resize() keeps the reserved capacity, clear() would free it
+	if(m_bOwnBuffer)
+		m_buffer.resize(0);
+	else
+		m_buffer.clear();
+	m_iFileSize	= 0;
+}
+
+const uchar* cFileInput::data()
+{
+	if(m_lpMap)
+		return(m_lpMap);
+	return(reinterpret_cast<const uchar*>(m_buffer.constData()));
+}
+
+qint64 cFileInput::size()
+{
+	if(m_lpMap)
+		return(m_iFileSize);
+	return(m_buffer.size());
+}
+
+bool cFileInput::isComplete()
+{
+	return(size() == m_iFileSize);
+}
+
+cFileInput::IOMode cFileInput::mode()
+{
+	return(m_mode);
+}
+
+bool cFileInput::isNetworkFileSystem(const QString& szFileName)
+{
+#if defined(Q_OS_LINUX)
+	struct statfs	fs;
+
+	if(statfs(QFile::encodeName(szFileName).constData(), &fs) != 0)
+		return(true);
+
+	switch(static_cast<quint32>(fs.f_type))
+	{
+	case NFS_MAGIC:
+	case SMB_MAGIC:
+	case CIFS_MAGIC:
+	case SMB2_MAGIC:
+	case AFS_MAGIC:
+	case CEPH_MAGIC:
+	case FUSE_MAGIC:
+	case CODA_MAGIC:
+	case NCP_MAGIC:
+		return(true);
+	default:
+		return(false);
+	}
+#else
+	QByteArray	type	= QStorageInfo(szFileName).fileSystemType().toLower();
+
+	return(type.contains("nfs") || type.contains("smb") || type.contains("cifs") || type.contains("afp") || type.contains("webdav"));
+#endif
+}
+
+void cFileInput::dropCache(const QString& szFileName)
+{
+#if defined(Q_OS_LINUX)
+	int	fd	= ::open(QFile::encodeName(szFileName).constData(), O_RDONLY);
+
+	if(fd < 0)
+		return;
+
+	posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+	::close(fd);
+#else
+	Q_UNUSED(szFileName);
+#endif
+}
+
+QStringList cFileInput::ioModes()
+{
+	return(QStringList() << "read" << "mmap" << "prefix");
+}
+
+cFileInput::IOMode cFileInput::ioMode(const QString& szName, bool* lpOK)
+{
+	qint32	iMode	= ioModes().indexOf(szName);
+
+	if(lpOK)
+		*lpOK	= (iMode >= 0);
+
+	return(iMode >= 0 ? static_cast<IOMode>(iMode) : IOModeRead);
+}
+
+QString cFileInput::ioModeName(IOMode mode)
+{
+	return(ioModes().value(mode));
+}
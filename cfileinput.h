@@ -0,0 +1,147 @@
+/*!
+ \file cfileinput.h
+
+*/
+
+#ifndef CFILEINPUT_H
+#define CFILEINPUT_H
+
+
+#include <QString>
+#include <QStringList>
+#include <QFile>
+#include <QByteArray>
+
+
+/*!
+ \brief Gives the metadata parser direct access to the bytes of a file.
+
+ The file is either mapped read-only (IOModeMMap) or its first bytes are
+ read into a buffer (IOModePrefix). Files on network file systems are
+ never mapped, a server side truncation would kill the process with
+ SIGBUS; their prefix is read instead, as if a file can't be mapped.
+
+ \class cFileInput cfileinput.h "cfileinput.h"
+*/
+class cFileInput
+{
+public:
+	/*!
+	 \brief How cEXIF reads a file.
+
+	 \enum IOMode
+	*/
+	enum IOMode
+	{
+		IOModeRead		= 0,	/*!< Exiv2 reads the file itself */
+		IOModeMMap		= 1,	/*!< the file is mapped and parsed in place */
+		IOModePrefix	= 2,	/*!< only the first bytes are read */
+	};
+
+	cFileInput();
+	~cFileInput();
+
+	/*!
+	 \brief Opens szFileName. iPrefixSize is the size of the metadata region: the part read in IOModePrefix and the part madvise()d in IOModeMMap.
+
+	 \fn open
+	 \param szFileName
+	 \param mode
+	 \param iPrefixSize
+	 \return bool
+	*/
+	bool					open(const QString& szFileName, IOMode mode, qint64 iPrefixSize);
+	/*!
+	 \brief Takes over a prefix of a file read by somebody else, e.g. cPrefetcher.
+
+	 \fn setBuffer
+	 \param buffer
+	 \param iFileSize size of the whole file
+	*/
+	void					setBuffer(const QByteArray& buffer, qint64 iFileSize);
+	/*!
+	 \brief A buffer read by open() keeps its allocation, so an object reused for many files reads into the same memory.
+
+	 \fn close
+	*/
+	void					close();
+
+	/*!
+	 \brief
+
+	 \fn data
+	 \return const uchar
+	*/
+	const uchar*			data();
+	/*!
+	 \brief Number of bytes available at data().
+
+	 \fn size
+	 \return qint64
+	*/
+	qint64					size();
+	/*!
+	 \brief true if data() holds the whole file.
+
+	 \fn isComplete
+	 \return bool
+	*/
+	bool					isComplete();
+	/*!
+	 \brief Mode actually used, differs from the requested one after a fallback.
+
+	 \fn mode
+	 \return IOMode
+	*/
+	IOMode					mode();
+
+	/*!
+	 \brief
+
+	 \fn isNetworkFileSystem
+	 \param szFileName
+	 \return bool
+	*/
+	static bool				isNetworkFileSystem(const QString& szFileName);
+	/*!
+	 \brief Evicts the file from the page cache to measure cold cache reads. Only implemented on Linux.
+
+	 \fn dropCache
+	 \param szFileName
+	*/
+	static void				dropCache(const QString& szFileName);
+	/*!
+	 \brief
+
+	 \fn ioModes
+	 \return QStringList
+	*/
+	static QStringList		ioModes();
+	/*!
+	 \brief
+
+	 \fn ioMode
+	 \param szName one of ioModes()
+	 \param lpOK
+	 \return IOMode
+	*/
+	static IOMode			ioMode(const QString& szName, bool* lpOK = nullptr);
+	/*!
+	 \brief
+
+	 \fn ioModeName
+	 \param mode
+	 \return QString
+	*/
+	static QString			ioModeName(IOMode mode);
+
+private:
+	QFile					m_file;							/*!< the mapping lives as long as the file is open */
+	uchar*					m_lpMap;						/*!< mapped file, or nullptr */
+	QByteArray				m_buffer;						/*!< file content if it is not mapped */
+	bool					m_bOwnBuffer;					/*!< m_buffer was read by open() and keeps its capacity */
+	qint64					m_iFileSize;					/*!< size of the whole file */
+	IOMode					m_mode;							/*!< mode actually used */
+};
+
+#endif // CFILEINPUT_H
@@ -0,0 +1,603 @@
+/*!
+ \file cfilter.cpp
+
+*/
+
+#include "cfilter.h"
+#include "cpicture.h"
+
+#include <QDateTime>
+#include <QRegularExpression>
+#include <QList>
+
+
+#define QUOTED		QChar('"')
+
+
+/*!
+ \brief Value type of a field.
+
+ \enum FieldType
+*/
+enum FieldType
+{
+	FieldNumber	= 0,	/*!< compared as double */
+	FieldText	= 1,	/*!< compared as string, ignoring case */
+	FieldDate	= 2,	/*!< compared as milliseconds since the epoch */
+};
+
+/*!
+ \brief Comparison operator.
+
+ \enum CompareOp
+*/
+enum CompareOp
+{
+	OpEqual			= 0,
+	OpNotEqual		= 1,
+	OpLess			= 2,
+	OpLessEqual		= 3,
+	OpGreater		= 4,
+	OpGreaterEqual	= 5,
+	OpContains		= 6,
+};
+
+typedef cFilter::cNumberGetter	cNumberGetter;
+typedef cFilter::cTextGetter	cTextGetter;
+
+/*!
+ \brief One field usable in an expression.
+
+ \class cFilterField cfilter.cpp
+*/
+class cFilterField
+{
+public:
+	QString			m_szName;					/*!< name used in expressions */
+	FieldType		m_type;						/*!< value type */
+	bool			m_bPicture;					/*!< only known after decoding */
+	cNumberGetter	m_number;					/*!< getter of number and date fields */
+	cTextGetter		m_text;						/*!< getter of text fields */
+};
+
+static bool dateValue(const QDateTime& dateTime, double& value)
+{
+	if(!dateTime.isValid())
+		return(false);
+
+	value	= static_cast<double>(dateTime.toMSecsSinceEpoch());
+	return(true);
+}
+
+static bool textValue(const QString& szText, QString& value)
+{
+	value	= szText;
+	return(!value.isEmpty());
+}
+
+static QList<cFilterField>& fieldList()
+{
+	static QList<cFilterField>	list;
+
+	if(!list.isEmpty())
+		return(list);
+
+	auto	number	= [](const QString& szName, bool bPicture, cNumberGetter getter) { cFilterField f; f.m_szName = szName; f.m_type = FieldNumber; f.m_bPicture = bPicture; f.m_number = getter; list.append(f); };
+	auto	date	= [](const QString& szName, bool bPicture, cNumberGetter getter) { cFilterField f; f.m_szName = szName; f.m_type = FieldDate; f.m_bPicture = bPicture; f.m_number = getter; list.append(f); };
+	auto	text	= [](const QString& szName, bool bPicture, cTextGetter getter) { cFilterField f; f.m_szName = szName; f.m_type = FieldText; f.m_bPicture = bPicture; f.m_text = getter; list.append(f); };
+
+	// known from the directory listing
+	text("name", false, [](const cFilterRecord& r, QString& v) { return(textValue(r.m_fileInfo.fileName(), v)); });
+	text("path", false, [](const cFilterRecord& r, QString& v) { return(textValue(r.m_fileInfo.absolutePath(), v)); });
+	text("ext", false, [](const cFilterRecord& r, QString& v) { return(textValue(r.m_fileInfo.suffix(), v)); });
+	number("size", false, [](const cFilterRecord& r, double& v) { v = static_cast<double>(r.m_fileInfo.size()); return(true); });
+	date("modified", false, [](const cFilterRecord& r, double& v) { return(dateValue(r.m_fileInfo.lastModified(), v)); });
+
+	// only known after decoding
+	date("date", true, [](const cFilterRecord& r, double& v) { return(dateValue(r.m_lpPicture->dateTime(), v)); });
+	date("dateTimeOriginal", true, [](const cFilterRecord& r, double& v) { return(dateValue(r.m_lpPicture->dateTimeOriginal(), v)); });
+	date("dateTimeDigitized", true, [](const cFilterRecord& r, double& v) { return(dateValue(r.m_lpPicture->dateTimeDigitized(), v)); });
+	text("make", true, [](const cFilterRecord& r, QString& v) { return(textValue(r.m_lpPicture->cameraMake(), v)); });
+	text("camera", true, [](const cFilterRecord& r, QString& v) { return(textValue(r.m_lpPicture->cameraModel(), v)); });
+	text("lens", true, [](const cFilterRecord& r, QString& v) { return(textValue(r.m_lpPicture->lensModel(), v)); });
+	number("shutterCount", true, [](const cFilterRecord& r, double& v) { v = r.m_lpPicture->shutterCount(); return(v > 0); });
+	number("iso", true, [](const cFilterRecord& r, double& v) { v = r.m_lpPicture->iso(); return(v > 0); });
+	number("fnumber", true, [](const cFilterRecord& r, double& v) { bool bOK; v = r.m_lpPicture->fNumber().toDouble(&bOK); return(bOK && v > 0); });
+	number("focalLength", true, [](const cFilterRecord& r, double& v) { v = r.m_lpPicture->focalLength(); return(v > 0); });
+	number("focalLength35", true, [](const cFilterRecord& r, double& v) { v = r.m_lpPicture->focalLength35(); return(v > 0); });
+	number("width", true, [](const cFilterRecord& r, double& v) { v = r.m_lpPicture->imageWidth(); return(v > 0); });
+	number("height", true, [](const cFilterRecord& r, double& v) { v = r.m_lpPicture->imageHeight(); return(v > 0); });
+	number("latitude", true, [](const cFilterRecord& r, double& v) { v = r.m_lpPicture->latitude(); return(r.m_lpPicture->hasGPSPosition()); });
+	number("longitude", true, [](const cFilterRecord& r, double& v) { v = r.m_lpPicture->longitude(); return(r.m_lpPicture->hasGPSPosition()); });
+	number("altitude", true, [](const cFilterRecord& r, double& v) { v = r.m_lpPicture->altitude(); return(r.m_lpPicture->hasAltitude()); });
+
+	return(list);
+}
+
+template <typename T>
+static bool compare(const T& value, CompareOp op, const T& literal)
+{
+	switch(op)
+	{
+	case OpEqual:
+		return(value == literal);
+	case OpNotEqual:
+		return(!(value == literal));
+	case OpLess:
+		return(value < literal);
+	case OpLessEqual:
+		return(!(literal < value));
+	case OpGreater:
+		return(literal < value);
+	case OpGreaterEqual:
+		return(!(value < literal));
+	default:
+		return(false);
+	}
+}
+
+static bool parseNumber(const QString& szValue, double* lpValue)
+{
+	QString	szNumber	= szValue;
+	double	dFactor		= 1;
+	QChar	suffix		= szNumber.isEmpty() ? QChar() : szNumber.at(szNumber.length() - 1).toUpper();
+	bool	bOK;
+
+	if(suffix == 'K')
+		dFactor	= 1024.0;
+	else if(suffix == 'M')
+		dFactor	= 1024.0 * 1024.0;
+	else if(suffix == 'G')
+		dFactor	= 1024.0 * 1024.0 * 1024.0;
+
+	if(dFactor != 1)
+		szNumber.chop(1);
+
+	*lpValue	= szNumber.toDouble(&bOK) * dFactor;
+	return(bOK);
+}
+
+static bool parseDate(const QString& szValue, double* lpValue)
+{
+	static const char*	formatList[]	= { "yyyy-MM-dd hh:mm:ss", "yyyy-MM-ddThh:mm:ss", "yyyy-MM-dd hh:mm", "yyyy-MM-dd", "yyyy-MM", "yyyy:MM:dd hh:mm:ss", "yyyy" };
+
+	for(const char* szFormat : formatList)
+	{
+		QDateTime	dateTime	= QDateTime::fromString(szValue, szFormat);
+
+		if(dateTime.isValid())
+		{
+			*lpValue	= static_cast<double>(dateTime.toMSecsSinceEpoch());
+			return(true);
+		}
+	}
+	return(false);
+}
+
+cFilter::cFilter() :
+	m_bNeedsPicture(false),
+	m_iToken(0)
+{
+}
+
+bool cFilter::compile(const QString& szExpression)
+{
+	m_root			= cNode();
+	m_szError		= "";
+	m_bNeedsPicture	= false;
+
+	if(!tokenize(szExpression))
+		return(false);
+
+	m_iToken	= 0;
+
+	cNode	root	= parseOr();
+
+	if(!root)
+		return(false);
+
+	if(m_iToken < m_tokenList.count())
+	{
+		m_szError	= QString("unexpected \"%1\"").arg(m_tokenList[m_iToken]);
+		return(false);
+	}
+
+	m_root	= root;
+	m_tokenList.clear();
+	return(true);
+}
+
+QString cFilter::error()
+{
+	return(m_szError);
+}
+
+bool cFilter::needsPicture()
+{
+	return(m_bNeedsPicture);
+}
+
+cFilter::Result cFilter::evaluate(const cFilterRecord& record)
+{
+	if(!m_root)
+		return(ResultTrue);
+	return(m_root(record));
+}
+
+static const cFilterField* findField(const QString& szField)
+{
+	for(const cFilterField& field : fieldList())
+	{
+		if(!field.m_szName.compare(szField, Qt::CaseInsensitive))
+			return(&field);
+	}
+	return(nullptr);
+}
+
+cFilter::cNumberGetter cFilter::numberGetter(const QString& szField)
+{
+	const cFilterField*	lpField	= findField(szField);
+
+	if(!lpField || lpField->m_type == FieldText)
+		return(cNumberGetter());
+	return(lpField->m_number);
+}
+
+cFilter::cTextGetter cFilter::textGetter(const QString& szField)
+{
+	const cFilterField*	lpField	= findField(szField);
+
+	if(!lpField)
+		return(cTextGetter());
+
+	if(lpField->m_type == FieldText)
+		return(lpField->m_text);
+
+	cNumberGetter	getter	= lpField->m_number;
+
+	if(lpField->m_type == FieldDate)
+	{
+		return([getter](const cFilterRecord& record, QString& value) {
+			double	d;
+
+			if(!getter(record, d))
+				return(false);
+			value	= QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(d)).toString("yyyy-MM-dd hh:mm:ss");
+			return(true);
+		});
+	}
+
+	return([getter](const cFilterRecord& record, QString& value) {
+		double	d;
+
+		if(!getter(record, d))
+			return(false);
+		value	= QString::number(d);
+		return(true);
+	});
+}
+
+bool cFilter::isPictureField(const QString& szField)
+{
+	const cFilterField*	lpField	= findField(szField);
+
+	return(lpField && lpField->m_bPicture);
+}
+
+bool cFilter::isDateField(const QString& szField)
+{
+	const cFilterField*	lpField	= findField(szField);
+
+	return(lpField && lpField->m_type == FieldDate);
+}
+
+QStringList cFilter::fields()
+{
+	QStringList	szFields;
+
+	for(const cFilterField& field : fieldList())
+		szFields.append(field.m_szName);
+	return(szFields);
+}
+
+bool cFilter::tokenize(const QString& szExpression)
+{
+	static const QString	szOperatorChars	= "=!<>~&|";
+	qint32					iPos			= 0;
+
+	m_tokenList.clear();
+
+	while(iPos < szExpression.length())
+	{
+		QChar	c	= szExpression.at(iPos);
+
+		if(c.isSpace())
+		{
+			iPos++;
+			continue;
+		}
+
+		if(c == '(' || c == ')')
+		{
+			m_tokenList.append(c);
+			iPos++;
+			continue;
+		}
+
+		if(c == '"' || c == '\'')
+		{
+			qint32	iEnd	= szExpression.indexOf(c, iPos + 1);
+
+			if(iEnd < 0)
+			{
+				m_szError	= "unterminated string";
+				return(false);
+			}
+
+			// quoted values are marked, so "and" is never taken as keyword
+			m_tokenList.append(QUOTED + szExpression.mid(iPos + 1, iEnd - iPos - 1));
+			iPos	= iEnd + 1;
+			continue;
+		}
+
+		if(szOperatorChars.contains(c))
+		{
+			QString	szTwo	= szExpression.mid(iPos, 2);
+
+			if(szTwo == "<=" || szTwo == ">=" || szTwo == "!=" || szTwo == "&&" || szTwo == "||" || szTwo == "==")
+			{
+				m_tokenList.append(szTwo == "==" ? QString("=") : szTwo);
+				iPos	+= 2;
+			}
+			else
+			{
+				m_tokenList.append(c);
+				iPos++;
+			}
+			continue;
+		}
+
+		qint32	iStart	= iPos;
+
+		while(iPos < szExpression.length() && !szExpression.at(iPos).isSpace() && szExpression.at(iPos) != '(' && szExpression.at(iPos) != ')' && !szOperatorChars.contains(szExpression.at(iPos)))
+			iPos++;
+
+		m_tokenList.append(szExpression.mid(iStart, iPos - iStart));
+	}
+
+	if(m_tokenList.isEmpty())
+	{
+		m_szError	= "empty expression";
+		return(false);
+	}
+	return(true);
+}
+
+bool cFilter::isKeyword(const QString& szKeyword)
+{
+	if(m_iToken >= m_tokenList.count())
+		return(false);
+
+	const QString&	szToken	= m_tokenList[m_iToken];
+
+	if(szKeyword == "AND" && szToken == "&&")
+		return(true);
+	if(szKeyword == "OR" && szToken == "||")
+		return(true);
+	if(szKeyword == "NOT" && szToken == "!")
+		return(true);
+
+	return(!szToken.startsWith(QUOTED) && !szToken.compare(szKeyword, Qt::CaseInsensitive));
+}
+
+cFilter::cNode cFilter::parseOr()
+{
+	cNode	left	= parseAnd();
+
+	while(left && isKeyword("OR"))
+	{
+		m_iToken++;
+
+		cNode	right	= parseAnd();
+
+		if(!right)
+			return(cNode());
+
+		left	= [left, right](const cFilterRecord& record) {
+			Result	r1	= left(record);
+
+			if(r1 == ResultTrue)
+				return(ResultTrue);
+
+			Result	r2	= right(record);
+
+			if(r2 == ResultTrue)
+				return(ResultTrue);
+			return((r1 == ResultUnknown || r2 == ResultUnknown) ? ResultUnknown : ResultFalse);
+		};
+	}
+	return(left);
+}
+
+cFilter::cNode cFilter::parseAnd()
+{
+	cNode	left	= parseNot();
+
+	while(left && isKeyword("AND"))
+	{
+		m_iToken++;
+
+		cNode	right	= parseNot();
+
+		if(!right)
+			return(cNode());
+
+		left	= [left, right](const cFilterRecord& record) {
+			Result	r1	= left(record);
+
+			if(r1 == ResultFalse)
+				return(ResultFalse);
+
+			Result	r2	= right(record);
+
+			if(r2 == ResultFalse)
+				return(ResultFalse);
+			return((r1 == ResultUnknown || r2 == ResultUnknown) ? ResultUnknown : ResultTrue);
+		};
+	}
+	return(left);
+}
+
+cFilter::cNode cFilter::parseNot()
+{
+	if(isKeyword("NOT"))
+	{
+		m_iToken++;
+
+		cNode	node	= parseNot();
+
+		if(!node)
+			return(cNode());
+
+		return([node](const cFilterRecord& record) {
+			Result	r	= node(record);
+
+			if(r == ResultUnknown)
+				return(ResultUnknown);
+			return(r == ResultTrue ? ResultFalse : ResultTrue);
+		});
+	}
+
+	if(m_iToken < m_tokenList.count() && m_tokenList[m_iToken] == "(")
+	{
+		m_iToken++;
+
+		cNode	node	= parseOr();
+
+		if(!node)
+			return(cNode());
+
+		if(m_iToken >= m_tokenList.count() || m_tokenList[m_iToken] != ")")
+		{
+			m_szError	= "missing \")\"";
+			return(cNode());
+		}
+		m_iToken++;
+		return(node);
+	}
+
+	return(parseComparison());
+}
+
+cFilter::cNode cFilter::parseComparison()
+{
+	static const QStringList	szOperators	= QStringList() << "=" << "!=" << "<" << "<=" << ">" << ">=" << "~";
+
+	if(m_iToken + 3 > m_tokenList.count())
+	{
+		m_szError	= "incomplete comparison";
+		return(cNode());
+	}
+
+	QString	szField		= m_tokenList[m_iToken];
+	qint32	iOp			= szOperators.indexOf(m_tokenList[m_iToken + 1]);
+	QString	szValue		= m_tokenList[m_iToken + 2];
+
+	const cFilterField*	lpField	= findField(szField);
+
+	if(!lpField)
+	{
+		m_szError	= QString("unknown field \"%1\", known fields: %2").arg(szField, fields().join(", "));
+		return(cNode());
+	}
+
+	if(iOp < 0)
+	{
+		m_szError	= QString("unknown operator \"%1\"").arg(m_tokenList[m_iToken + 1]);
+		return(cNode());
+	}
+
+	if(szValue.startsWith(QUOTED))
+		szValue	= szValue.mid(1);
+
+	m_iToken		+= 3;
+	m_bNeedsPicture	|= lpField->m_bPicture;
+
+	CompareOp	op			= static_cast<CompareOp>(iOp);
+	bool		bPicture	= lpField->m_bPicture;
+
+	if(lpField->m_type == FieldText)
+	{
+		cTextGetter	getter	= lpField->m_text;
+
+		if(op == OpContains)
+		{
+			return([getter, bPicture, szValue](const cFilterRecord& record) {
+				QString	value;
+
+				if(bPicture && !record.m_lpPicture)
+					return(ResultUnknown);
+				if(!getter(record, value))
+					return(ResultFalse);
+				return(value.contains(szValue, Qt::CaseInsensitive) ? ResultTrue : ResultFalse);
+			});
+		}
+
+		if((op == OpEqual || op == OpNotEqual) && (szValue.contains('*') || szValue.contains('?')))
+		{
+			QString				szPattern	= QRegularExpression::escape(szValue).replace("\\*", ".*").replace("\\?", ".");
+			QRegularExpression	regExp("\\A" + szPattern + "\\z", QRegularExpression::CaseInsensitiveOption);
+			bool				bMatch		= (op == OpEqual);
+
+			regExp.optimize();
+
+			return([getter, bPicture, regExp, bMatch](const cFilterRecord& record) {
+				QString	value;
+
+				if(bPicture && !record.m_lpPicture)
+					return(ResultUnknown);
+				if(!getter(record, value))
+					return(bMatch ? ResultFalse : ResultTrue);
+				return(regExp.match(value).hasMatch() == bMatch ? ResultTrue : ResultFalse);
+			});
+		}
+
+		QString	szLiteral	= szValue.toLower();
+
+		return([getter, bPicture, op, szLiteral](const cFilterRecord& record) {
+			QString	value;
+
+			if(bPicture && !record.m_lpPicture)
+				return(ResultUnknown);
+			if(!getter(record, value))
+				return(op == OpNotEqual ? ResultTrue : ResultFalse);
+			return(compare(value.toLower(), op, szLiteral) ? ResultTrue : ResultFalse);
+		});
+	}
+
+	double	dLiteral;
+
+	if(op == OpContains)
+	{
+		m_szError	= QString("\"~\" can't be used with \"%1\"").arg(lpField->m_szName);
+		return(cNode());
+	}
+
+	if(lpField->m_type == FieldDate ? !parseDate(szValue, &dLiteral) : !parseNumber(szValue, &dLiteral))
+	{
+		m_szError	= QString("invalid value \"%1\" for \"%2\"").arg(szValue, lpField->m_szName);
+		return(cNode());
+	}
+
+	cNumberGetter	getter	= lpField->m_number;
+
+	return([getter, bPicture, op, dLiteral](const cFilterRecord& record) {
+		double	value;
+
+		if(bPicture && !record.m_lpPicture)
+			return(ResultUnknown);
+		if(!getter(record, value))
+			return(op == OpNotEqual ? ResultTrue : ResultFalse);
+		return(compare(value, op, dLiteral) ? ResultTrue : ResultFalse);
+	});
+}
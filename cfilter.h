@@ -0,0 +1,217 @@
+/*!
+ \file cfilter.h
+
+*/
+
+#ifndef CFILTER_H
+#define CFILTER_H
+
+
+#include <QString>
+#include <QStringList>
+#include <QFileInfo>
+
+#include <functional>
+
+
+class cPicture;
+
+/*!
+ \brief Everything a filter expression can look at.
+
+ Before the file is decoded m_lpPicture is nullptr and only the fields
+ known from the directory listing (name, path, extension, size, modified)
+ can be evaluated.
+
+ \class cFilterRecord cfilter.h "cfilter.h"
+*/
+class cFilterRecord
+{
+public:
+	cFilterRecord(const QFileInfo& fileInfo, cPicture* lpPicture = nullptr) :
+		m_fileInfo(fileInfo),
+		m_lpPicture(lpPicture)
+	{
+	}
+
+	const QFileInfo&	m_fileInfo;					/*!< file from the directory listing */
+	cPicture*			m_lpPicture;				/*!< decoded picture, or nullptr */
+};
+
+/*!
+ \brief A --where expression compiled into a tree of closures.
+
+ Syntax: comparisons "field op value" combined with AND, OR, NOT and
+ parentheses. Operators are = != < <= > >= and ~ (contains). String
+ comparisons ignore case, = and != accept the wildcards * and ?. Values
+ containing spaces have to be quoted, sizes accept the suffixes K, M and G,
+ dates are written as yyyy-MM-dd or "yyyy-MM-dd hh:mm:ss".
+
+ Example: camera ~ "EOS R5" AND date >= 2023-01-01 AND date < 2024-01-01 AND iso > 3200
+
+ Evaluation is three-valued: a comparison on a field that is not available
+ yet is Unknown, so the expression can be tested on the directory listing
+ alone and the file is skipped before decoding if the result is already
+ False.
+
+ \class cFilter cfilter.h "cfilter.h"
+*/
+class cFilter
+{
+public:
+	/*!
+	 \brief Result of evaluate().
+
+	 \enum Result
+	*/
+	enum Result
+	{
+		ResultFalse		= 0,	/*!< the record does not match */
+		ResultTrue		= 1,	/*!< the record matches */
+		ResultUnknown	= 2,	/*!< depends on fields that are not available yet */
+	};
+
+	/*!
+	 \brief Compiled node of the expression.
+	*/
+	typedef std::function<Result(const cFilterRecord& record)>	cNode;
+
+	cFilter();
+
+	/*!
+	 \brief Parses and compiles szExpression.
+
+	 \fn compile
+	 \param szExpression
+	 \return bool false on a syntax error, see error()
+	*/
+	bool					compile(const QString& szExpression);
+	/*!
+	 \brief
+
+	 \fn error
+	 \return QString
+	*/
+	QString					error();
+	/*!
+	 \brief true if the expression uses fields that are only known after decoding.
+
+	 \fn needsPicture
+	 \return bool
+	*/
+	bool					needsPicture();
+
+	/*!
+	 \brief
+
+	 \fn evaluate
+	 \param record
+	 \return Result
+	*/
+	Result					evaluate(const cFilterRecord& record);
+
+	/*!
+	 \brief Getter of a number or date field (dates as milliseconds since the epoch), empty if szField is unknown or a text field.
+	*/
+	typedef std::function<bool(const cFilterRecord& record, double& value)>		cNumberGetter;
+	/*!
+	 \brief Getter of a field as text, empty if szField is unknown.
+	*/
+	typedef std::function<bool(const cFilterRecord& record, QString& value)>	cTextGetter;
+
+	/*!
+	 \brief
+
+	 \fn numberGetter
+	 \param szField
+	 \return cNumberGetter
+	*/
+	static cNumberGetter	numberGetter(const QString& szField);
+	/*!
+	 \brief Number fields are formatted with QString::number(), dates as yyyy-MM-dd hh:mm:ss.
+
+	 \fn textGetter
+	 \param szField
+	 \return cTextGetter
+	*/
+	static cTextGetter		textGetter(const QString& szField);
+	/*!
+	 \brief true if the field is only known after decoding.
+
+	 \fn isPictureField
+	 \param szField
+	 \return bool
+	*/
+	static bool				isPictureField(const QString& szField);
+	/*!
+	 \brief
+
+	 \fn isDateField
+	 \param szField
+	 \return bool
+	*/
+	static bool				isDateField(const QString& szField);
+
+	/*!
+	 \brief Names of all fields.
+
+	 \fn fields
+	 \return QStringList
+	*/
+	static QStringList		fields();
+
+private:
+	cNode					m_root;							/*!< compiled expression */
+	QString					m_szError;						/*!< last syntax error */
+	bool					m_bNeedsPicture;				/*!< uses fields of the decoded picture */
+
+	QStringList				m_tokenList;					/*!< tokens while compiling */
+	qint32					m_iToken;						/*!< current token while compiling */
+
+	/*!
+	 \brief
+
+	 \fn tokenize
+	 \param szExpression
+	 \return bool
+	*/
+	bool					tokenize(const QString& szExpression);
+	/*!
+	 \brief
+
+	 \fn parseOr
+	 \return cNode
+	*/
+	cNode					parseOr();
+	/*!
+	 \brief
+
+	 \fn parseAnd
+	 \return cNode
+	*/
+	cNode					parseAnd();
+	/*!
+	 \brief
+
+	 \fn parseNot
+	 \return cNode
+	*/
+	cNode					parseNot();
+	/*!
+	 \brief
+
+	 \fn parseComparison
+	 \return cNode
+	*/
+	cNode					parseComparison();
+	/*!
+	 \brief
+
+	 \fn isKeyword
+	 \param szKeyword
+	 \return bool
+	*/
+	bool					isKeyword(const QString& szKeyword);
+};
+
+#endif // CFILTER_H
@@ -0,0 +1,330 @@
+/*!
+ \file cgeoindex.cpp
+
+*/
+
+#include "cgeoindex.h"
+
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+
+#define GEO_MAGIC		0x49474551	// "QEGI"
+#define GEO_VERSION		1
+#define GEO_HEADER_SIZE	24
+#define GEO_ENTRY_SIZE	32
+
+#define EVEN_BITS		Q_UINT64_C(0x5555555555555555)
+#define ODD_BITS		Q_UINT64_C(0xAAAAAAAAAAAAAAAA)
+
+
+static quint32 quantize(double dValue, double dMin, double dRange)
+{
+	double	d	= (dValue - dMin) / dRange;
+
+	if(d <= 0)
+		return(0);
+	if(d >= 1)
+		return(0xffffffff);
+	return(static_cast<quint32>(d * 4294967295.0));
+}
+
+/*!
+ \brief Moves the 32 bits of iValue to the even bit positions.
+
+ \fn spread
+ \param iValue
+ \return quint64
+*/
+static quint64 spread(quint32 iValue)
+{
+	quint64	x	= iValue;
+
+	x	= (x | (x << 16)) & Q_UINT64_C(0x0000FFFF0000FFFF);
+	x	= (x | (x << 8))  & Q_UINT64_C(0x00FF00FF00FF00FF);
+	x	= (x | (x << 4))  & Q_UINT64_C(0x0F0F0F0F0F0F0F0F);
+	x	= (x | (x << 2))  & Q_UINT64_C(0x3333333333333333);
+	x	= (x | (x << 1))  & EVEN_BITS;
+	return(x);
+}
+
+/*!
+ \brief Inverse of spread().
+
+ \fn compact
+ \param iValue
+ \return quint32
+*/
+static quint32 compact(quint64 iValue)
+{
+	quint64	x	= iValue & EVEN_BITS;
+
+	x	= (x | (x >> 1))  & Q_UINT64_C(0x3333333333333333);
+	x	= (x | (x >> 2))  & Q_UINT64_C(0x0F0F0F0F0F0F0F0F);
+	x	= (x | (x >> 4))  & Q_UINT64_C(0x00FF00FF00FF00FF);
+	x	= (x | (x >> 8))  & Q_UINT64_C(0x0000FFFF0000FFFF);
+	x	= (x | (x >> 16)) & Q_UINT64_C(0x00000000FFFFFFFF);
+	return(static_cast<quint32>(x));
+}
+
+/*!
+ \brief Bits of the same dimension as iBit below iBit.
+
+ \fn lowerBits
+ \param iBit
+ \return quint64
+*/
+static quint64 lowerBits(qint32 iBit)
+{
+	return(((iBit & 1) ? ODD_BITS : EVEN_BITS) & ((Q_UINT64_C(1) << iBit) - 1));
+}
+
+/*!
+ \brief Smallest key inside the box [iMin, iMax] that is greater than iKey (Tropf and Herzog).
+
+ iKey must be inside the key range but outside the box.
+
+ \fn bigMin
+ \param iKey
+ \param iMin
+ \param iMax
+ \return quint64
+*/
+static quint64 bigMin(quint64 iKey, quint64 iMin, quint64 iMax)
+{
+	quint64	iBigMin	= iMax;
+
+	for(qint32 iBit = 63;iBit >= 0;iBit--)
+	{
+		quint64	iMask	= Q_UINT64_C(1) << iBit;
+		bool	bKey	= (iKey & iMask) != 0;
+		bool	bMin	= (iMin & iMask) != 0;
+		bool	bMax	= (iMax & iMask) != 0;
+
+		if(!bKey && !bMin && bMax)
+		{
+			iBigMin	= (iMin | iMask) & ~lowerBits(iBit);
+			iMax	= (iMax & ~iMask) | lowerBits(iBit);
+		}
+		else if(!bKey && bMin && bMax)
+			return(iMin);
+		else if(bKey && !bMin && !bMax)
+			return(iBigMin);
+		else if(bKey && !bMin && bMax)
+			iMin	= (iMin | iMask) & ~lowerBits(iBit);
+	}
+	return(iBigMin);
+}
+
+static bool entryLessThan(const cGeoIndexEntry& e1, const cGeoIndexEntry& e2)
+{
+	return(e1.m_iKey < e2.m_iKey);
+}
+
+cGeoIndex::cGeoIndex()
+{
+}
+
+void cGeoIndex::add(double dLatitude, double dLongitude, const QString& szFileName)
+{
+	cGeoIndexEntry	entry;
+
+	entry.m_iKey		= key(dLatitude, dLongitude);
+	entry.m_dLatitude	= dLatitude;
+	entry.m_dLongitude	= dLongitude;
+	entry.m_szFileName	= szFileName;
+
+	m_entryList.append(entry);
+}
+
+qint64 cGeoIndex::count()
+{
+	return(m_entryList.count());
+}
+
+bool cGeoIndex::write(const QString& szFileName)
+{
+	std::stable_sort(m_entryList.begin(), m_entryList.end(), entryLessThan);
+
+	QFile		file(szFileName);
+	QByteArray	strings;
+
+	if(!file.open(QFile::WriteOnly | QFile::Truncate))
+		return(false);
+
+	QByteArray	buffer(GEO_HEADER_SIZE + m_entryList.count() * GEO_ENTRY_SIZE, 0);
+	uchar*		lpData	= reinterpret_cast<uchar*>(buffer.data());
+
+	qToLittleEndian<quint32>(GEO_MAGIC, lpData);
+	qToLittleEndian<quint32>(GEO_VERSION, lpData + 4);
+	qToLittleEndian<quint64>(static_cast<quint64>(m_entryList.count()), lpData + 8);
+	qToLittleEndian<quint64>(static_cast<quint64>(buffer.size()), lpData + 16);
+
+	lpData	+= GEO_HEADER_SIZE;
+
+	for(int x = 0;x < m_entryList.count();x++, lpData += GEO_ENTRY_SIZE)
+	{
+		const cGeoIndexEntry&	entry	= m_entryList.at(x);
+		QByteArray				path	= entry.m_szFileName.toUtf8();
+		quint64					iLatitude;
+		quint64					iLongitude;
+
+		memcpy(&iLatitude, &entry.m_dLatitude, sizeof(iLatitude));
+		memcpy(&iLongitude, &entry.m_dLongitude, sizeof(iLongitude));
+
+		qToLittleEndian<quint64>(entry.m_iKey, lpData);
+		qToLittleEndian<quint64>(iLatitude, lpData + 8);
+		qToLittleEndian<quint64>(iLongitude, lpData + 16);
+		qToLittleEndian<quint32>(static_cast<quint32>(strings.size()), lpData + 24);
+		qToLittleEndian<quint32>(static_cast<quint32>(path.size()), lpData + 28);
+
+		strings.append(path);
+	}
+
+	bool	bOK	= (file.write(buffer) == buffer.size()) && (file.write(strings) == strings.size());
+
+	file.close();
+	return(bOK);
+}
+
+quint64 cGeoIndex::key(double dLatitude, double dLongitude)
+{
+	return((spread(quantize(dLongitude, -180, 360)) << 1) | spread(quantize(dLatitude, -90, 180)));
+}
+
+cGeoIndexReader::cGeoIndexReader(const QString& szFileName) :
+	m_file(szFileName),
+	m_lpData(nullptr),
+	m_iSize(0),
+	m_iCount(0),
+	m_iStrings(0)
+{
+}
+
+cGeoIndexReader::~cGeoIndexReader()
+{
+	m_file.close();
+}
+
+bool cGeoIndexReader::open()
+{
+	if(!m_file.open(QFile::ReadOnly))
+		return(false);
+
+	m_iSize	= m_file.size();
+	if(m_iSize < GEO_HEADER_SIZE)
+		return(false);
+
+	m_lpData	= m_file.map(0, m_iSize);
+	if(!m_lpData)
+		return(false);
+
+	if(qFromLittleEndian<quint32>(m_lpData) != GEO_MAGIC || qFromLittleEndian<quint32>(m_lpData + 4) != GEO_VERSION)
+		return(false);
+
+	m_iCount	= static_cast<qint64>(qFromLittleEndian<quint64>(m_lpData + 8));
+	m_iStrings	= static_cast<qint64>(qFromLittleEndian<quint64>(m_lpData + 16));
+
+	return(m_iStrings == GEO_HEADER_SIZE + m_iCount * GEO_ENTRY_SIZE && m_iStrings <= m_iSize);
+}
+
+qint64 cGeoIndexReader::count()
+{
+	return(m_iCount);
+}
+
+QList<cGeoIndexEntry> cGeoIndexReader::query(double dMinLatitude, double dMinLongitude, double dMaxLatitude, double dMaxLongitude)
+{
+	QList<cGeoIndexEntry>	resultList;
+
+	if(!m_lpData || dMinLatitude > dMaxLatitude)
+		return(resultList);
+
+	if(dMinLongitude > dMaxLongitude)
+	{
+		queryRange(dMinLatitude, dMinLongitude, dMaxLatitude, 180, resultList);
+		queryRange(dMinLatitude, -180, dMaxLatitude, dMaxLongitude, resultList);
+	}
+	else
+		queryRange(dMinLatitude, dMinLongitude, dMaxLatitude, dMaxLongitude, resultList);
+
+	return(resultList);
+}
+
+void cGeoIndexReader::queryRange(double dMinLatitude, double dMinLongitude, double dMaxLatitude, double dMaxLongitude, QList<cGeoIndexEntry>& resultList)
+{
+	quint64	iMin	= cGeoIndex::key(dMinLatitude, dMinLongitude);
+	quint64	iMax	= cGeoIndex::key(dMaxLatitude, dMaxLongitude);
+	quint32	iMinLat	= compact(iMin);
+	quint32	iMaxLat	= compact(iMax);
+	quint32	iMinLon	= compact(iMin >> 1);
+	quint32	iMaxLon	= compact(iMax >> 1);
+	qint64	iPos	= lowerBound(0, iMin);
+
+	while(iPos < m_iCount)
+	{
+		quint64	iKey	= keyAt(iPos);
+
+		if(iKey > iMax)
+			break;
+
+		quint32	iLat	= compact(iKey);
+		quint32	iLon	= compact(iKey >> 1);
+
+		if(iLat < iMinLat || iLat > iMaxLat || iLon < iMinLon || iLon > iMaxLon)
+		{
+			// skip the part of the curve running outside the box
+			iPos	= lowerBound(iPos, bigMin(iKey, iMin, iMax));
+			continue;
+		}
+
+		cGeoIndexEntry	result	= entry(iPos);
+
+		if(result.m_dLatitude >= dMinLatitude && result.m_dLatitude <= dMaxLatitude && result.m_dLongitude >= dMinLongitude && result.m_dLongitude <= dMaxLongitude)
+			resultList.append(result);
+		iPos++;
+	}
+}
+
+cGeoIndexEntry cGeoIndexReader::entry(qint64 iIndex)
+{
+	const uchar*	lpEntry	= m_lpData + GEO_HEADER_SIZE + iIndex * GEO_ENTRY_SIZE;
+	cGeoIndexEntry	result;
+	quint64			iLatitude	= qFromLittleEndian<quint64>(lpEntry + 8);
+	quint64			iLongitude	= qFromLittleEndian<quint64>(lpEntry + 16);
+	qint64			iOffset		= m_iStrings + qFromLittleEndian<quint32>(lpEntry + 24);
+	qint64			iLength		= qFromLittleEndian<quint32>(lpEntry + 28);
+
+	result.m_iKey	= qFromLittleEndian<quint64>(lpEntry);
+	memcpy(&result.m_dLatitude, &iLatitude, sizeof(iLatitude));
+	memcpy(&result.m_dLongitude, &iLongitude, sizeof(iLongitude));
+
+	if(iOffset + iLength <= m_iSize)
+		result.m_szFileName	= QString::fromUtf8(reinterpret_cast<const char*>(m_lpData + iOffset), static_cast<int>(iLength));
+
+	return(result);
+}
+
+quint64 cGeoIndexReader::keyAt(qint64 iIndex)
+{
+	return(qFromLittleEndian<quint64>(m_lpData + GEO_HEADER_SIZE + iIndex * GEO_ENTRY_SIZE));
+}
+
+qint64 cGeoIndexReader::lowerBound(qint64 iFrom, quint64 iKey)
+{
+	qint64	iLow	= iFrom;
+	qint64	iHigh	= m_iCount;
+
+	while(iLow < iHigh)
+	{
+		qint64	iMid	= iLow + (iHigh - iLow) / 2;
+
+		if(keyAt(iMid) < iKey)
+			iLow	= iMid + 1;
+		else
+			iHigh	= iMid;
+	}
+	return(iLow);
+}
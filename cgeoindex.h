@@ -0,0 +1,177 @@
+/*!
+ \file cgeoindex.h
+
+*/
+
+#ifndef CGEOINDEX_H
+#define CGEOINDEX_H
+
+
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QList>
+#include <QFile>
+
+
+/*!
+ \brief One picture of the spatial index.
+
+ On disk every entry has 32 bytes (little endian): the Z-order key, latitude
+ and longitude as IEEE doubles, offset and length of the UTF-8 path in the
+ string table.
+
+ \class cGeoIndexEntry cgeoindex.h "cgeoindex.h"
+*/
+class cGeoIndexEntry
+{
+public:
+	quint64		m_iKey;						/*!< Z-order (Morton) key, see cGeoIndex::key() */
+	double		m_dLatitude;				/*!< latitude in decimal degrees */
+	double		m_dLongitude;				/*!< longitude in decimal degrees */
+	QString		m_szFileName;				/*!< full path of the picture */
+};
+
+/*!
+ \brief Collects the positions of the pictures and writes them sorted by Z-order.
+
+ Latitude and longitude are quantized to 32 bits each and interleaved
+ (longitude first), which is the bit order of a geohash. Sorting by this
+ key keeps nearby pictures close together in the file, so
+ cGeoIndexReader::query() only has to look at a few runs of entries.
+
+ \class cGeoIndex cgeoindex.h "cgeoindex.h"
+*/
+class cGeoIndex
+{
+public:
+	cGeoIndex();
+
+	/*!
+	 \brief
+
+	 \fn add
+	 \param dLatitude
+	 \param dLongitude
+	 \param szFileName
+	*/
+	void							add(double dLatitude, double dLongitude, const QString& szFileName);
+	/*!
+	 \brief
+
+	 \fn count
+	 \return qint64
+	*/
+	qint64							count();
+	/*!
+	 \brief Sorts the entries and writes the index.
+
+	 \fn write
+	 \param szFileName
+	 \return bool
+	*/
+	bool							write(const QString& szFileName);
+
+	/*!
+	 \brief Z-order key of a position.
+
+	 \fn key
+	 \param dLatitude
+	 \param dLongitude
+	 \return quint64
+	*/
+	static quint64					key(double dLatitude, double dLongitude);
+
+private:
+	QVector<cGeoIndexEntry>			m_entryList;					/*!< collected entries */
+};
+
+/*!
+ \brief Bounding box queries on an index written by cGeoIndex.
+
+ \class cGeoIndexReader cgeoindex.h "cgeoindex.h"
+*/
+class cGeoIndexReader
+{
+public:
+	/*!
+	 \brief
+
+	 \fn cGeoIndexReader
+	 \param szFileName
+	*/
+	cGeoIndexReader(const QString& szFileName);
+	~cGeoIndexReader();
+
+	/*!
+	 \brief
+
+	 \fn open
+	 \return bool
+	*/
+	bool							open();
+	/*!
+	 \brief
+
+	 \fn count
+	 \return qint64
+	*/
+	qint64							count();
+	/*!
+	 \brief Returns all pictures inside the box. dMinLongitude > dMaxLongitude selects a box crossing the antimeridian.
+
+	 \fn query
+	 \param dMinLatitude
+	 \param dMinLongitude
+	 \param dMaxLatitude
+	 \param dMaxLongitude
+	 \return QList<cGeoIndexEntry>
+	*/
+	QList<cGeoIndexEntry>			query(double dMinLatitude, double dMinLongitude, double dMaxLatitude, double dMaxLongitude);
+
+private:
+	QFile							m_file;							/*!< index file */
+	const uchar*					m_lpData;						/*!< mapped index */
+	qint64							m_iSize;						/*!< size of the mapping */
+	qint64							m_iCount;						/*!< number of entries */
+	qint64							m_iStrings;						/*!< offset of the string table */
+
+	/*!
+	 \brief
+
+	 \fn entry
+	 \param iIndex
+	 \return cGeoIndexEntry
+	*/
+	cGeoIndexEntry					entry(qint64 iIndex);
+	/*!
+	 \brief
+
+	 \fn keyAt
+	 \param iIndex
+	 \return quint64
+	*/
+	quint64							keyAt(qint64 iIndex);
+	/*!
+	 \brief First entry at or after iFrom with a key >= iKey.
+
+	 \fn lowerBound
+	 \param iFrom
+	 \param iKey
+	 \return qint64
+	*/
+	qint64							lowerBound(qint64 iFrom, quint64 iKey);
+	/*!
+	 \brief
+
+	 \fn queryRange
+	 \param dMinLatitude
+	 \param dMinLongitude
+	 \param dMaxLatitude
+	 \param dMaxLongitude
+	 \param resultList
+	*/
+	void							queryRange(double dMinLatitude, double dMinLongitude, double dMaxLatitude, double dMaxLongitude, QList<cGeoIndexEntry>& resultList);
+};
+
+#endif // CGEOINDEX_H
@@ -0,0 +1,466 @@
+/*!
+ \file cguard.cpp
+
+*/
+
+#include "cguard.h"
+#include "cpicture.h"
+#include "cscanner.h"
+#include "cstatistics.h"
+
+#include <QCoreApplication>
+#include <QProcess>
+#include <QDataStream>
+#include <QThreadStorage>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QtEndian>
+
+#include <QDebug>
+
+#include <new>
+#include <exception>
+#include <cstdio>
+
+#if defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+
+#define START_TIMEOUT		30000
+#define STOP_TIMEOUT		1000
+#define MAX_FRAME_SIZE		(256 * 1024 * 1024)
+
+
+/*!
+ \brief Child process of one thread, see cGuard::read().
+
+ \class cGuardChild cguard.cpp
+*/
+class cGuardChild
+{
+public:
+	cGuardChild() :
+		m_lpProcess(nullptr)
+	{
+	}
+
+	~cGuardChild()
+	{
+		stop();
+	}
+
+	/*!
+	 \brief Ends the child, a child that is still busy is killed.
+	*/
+	void stop()
+	{
+		if(!m_lpProcess)
+			return;
+
+		m_lpProcess->closeWriteChannel();
+		if(!m_lpProcess->waitForFinished(STOP_TIMEOUT))
+		{
+			m_lpProcess->kill();
+			m_lpProcess->waitForFinished(STOP_TIMEOUT);
+		}
+
+		delete m_lpProcess;
+		m_lpProcess	= nullptr;
+		m_buffer.clear();
+	}
+
+	QProcess*		m_lpProcess;				/*!< started by the first read() of the thread, or nullptr */
+	QByteArray		m_buffer;					/*!< data received but not parsed yet */
+};
+
+static QThreadStorage<cGuardChild*>	g_guardChild;
+
+
+/*!
+ \brief Prefixes payload with its size.
+
+ \fn frame
+ \param payload
+ \return QByteArray
+*/
+static QByteArray frame(const QByteArray& payload)
+{
+	quint32		iSize	= qToBigEndian(static_cast<quint32>(payload.size()));
+
+	return(QByteArray(reinterpret_cast<const char*>(&iSize), sizeof(iSize)) + payload);
+}
+
+/*!
+ \brief Removes the first complete frame from buffer.
+
+ \fn takeFrame
+ \param buffer
+ \param payload
+ \return bool false if the frame is incomplete
+*/
+static bool takeFrame(QByteArray& buffer, QByteArray& payload)
+{
+	if(buffer.size() < static_cast<int>(sizeof(quint32)))
+		return(false);
+
+	quint32	iSize	= qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(buffer.constData()));
+
+	if(buffer.size() - static_cast<int>(sizeof(quint32)) < static_cast<qint64>(iSize))
+		return(false);
+
+	payload	= buffer.mid(sizeof(quint32), static_cast<int>(iSize));
+	buffer.remove(0, static_cast<int>(sizeof(quint32) + iSize));
+	return(true);
+}
+
+/*!
+ \brief Reads exactly iSize bytes, blocking.
+
+ \fn readFully
+ \param file
+ \param lpData
+ \param iSize
+ \return bool false at the end of the input
+*/
+static bool readFully(QFile& file, char* lpData, qint64 iSize)
+{
+	while(iSize > 0)
+	{
+		qint64	iRead	= file.read(lpData, iSize);
+
+		if(iRead <= 0)
+			return(false);
+
+		lpData	+= iRead;
+		iSize	-= iRead;
+	}
+	return(true);
+}
+
+cGuard::cGuard(const QStringList& szArguments) :
+	m_szArguments(szArguments),
+	m_iTimeout(30),
+	m_iMemoryLimit(0),
+	m_lpStatistics(nullptr)
+{
+}
+
+cGuard::~cGuard()
+{
+	m_quarantineFile.close();
+	m_reportFile.close();
+}
+
+void cGuard::setTimeout(qint32 iSeconds)
+{
+	m_iTimeout	= qMax(0, iSeconds);
+}
+
+void cGuard::setMemoryLimit(qint32 iMB)
+{
+	m_iMemoryLimit	= qMax(0, iMB);
+}
+
+void cGuard::setStatistics(cStatistics* lpStatistics)
+{
+	m_lpStatistics	= lpStatistics;
+}
+
+bool cGuard::setQuarantine(const QString& szFileName)
+{
+	m_quarantineFile.setFileName(szFileName);
+
+	if(m_quarantineFile.open(QFile::ReadOnly))
+	{
+		while(!m_quarantineFile.atEnd())
+		{
+			QString	szLine	= QString::fromUtf8(m_quarantineFile.readLine()).trimmed();
+
+			if(!szLine.isEmpty())
+				m_quarantineList.insert(szLine);
+		}
+		m_quarantineFile.close();
+	}
+
+	if(m_lpStatistics)
+		m_lpStatistics->addCount("guard/quarantine loaded", m_quarantineList.count());
+
+	return(m_quarantineFile.open(QFile::WriteOnly | QFile::Append));
+}
+
+bool cGuard::setErrorReport(const QString& szFileName)
+{
+	m_reportFile.setFileName(szFileName);
+
+	if(!m_reportFile.open(QFile::WriteOnly | QFile::Truncate))
+		return(false);
+
+	m_reportFile.write("file\tresult\tdetail\tms\n");
+	m_reportFile.flush();
+	return(true);
+}
+
+bool cGuard::isQuarantined(const QString& szFileName)
+{
+	QMutexLocker	locker(&m_mutex);
+
+	return(m_quarantineList.contains(szFileName));
+}
+
+cGuard::Result cGuard::read(const QString& szFileName, cPicture* lpPicture)
+{
+	if(!g_guardChild.hasLocalData())
+		g_guardChild.setLocalData(new cGuardChild);
+
+	cGuardChild*	lpChild	= g_guardChild.localData();
+	QElapsedTimer	timer;
+	QString			szDetail;
+	Result			result;
+
+	timer.start();
+
+	if(!lpChild->m_lpProcess && !start(lpChild))
+	{
+		// nothing is known about the file, it is not quarantined
+		report(szFileName, ResultFailed, "can't start a child process", timer.elapsed());
+		return(ResultFailed);
+	}
+
+	QByteArray		request;
+	QDataStream		stream(&request, QIODevice::WriteOnly);
+
+	stream << szFileName;
+	lpChild->m_lpProcess->write(frame(request));
+
+	result	= receive(lpChild, lpPicture, szDetail);
+
+	if(result != ResultOK)
+		report(szFileName, result, szDetail, timer.elapsed());
+
+	return(result);
+}
+
+bool cGuard::start(cGuardChild* lpChild)
+{
+	lpChild->m_lpProcess	= new QProcess;
+
+	// stdout carries the frames, the messages of Exiv2 go to our stderr
+	lpChild->m_lpProcess->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+	lpChild->m_lpProcess->start(QCoreApplication::applicationFilePath(), QStringList() << "--guard-child" << QString::number(m_iMemoryLimit) << m_szArguments);
+
+	if(!lpChild->m_lpProcess->waitForStarted(START_TIMEOUT))
+	{
+		qDebug() << "can't start child process:" << lpChild->m_lpProcess->errorString();
+		lpChild->stop();
+		return(false);
+	}
+
+	if(m_lpStatistics)
+		m_lpStatistics->addCount("guard/children started");
+
+	return(true);
+}
+
+cGuard::Result cGuard::receive(cGuardChild* lpChild, cPicture* lpPicture, QString& szDetail)
+{
+	QProcess*		lpProcess	= lpChild->m_lpProcess;
+	QElapsedTimer	timer;
+	QByteArray		payload;
+
+	timer.start();
+
+	for(;;)
+	{
+		if(takeFrame(lpChild->m_buffer, payload))
+			break;
+
+		if(lpChild->m_buffer.size() > MAX_FRAME_SIZE)
+		{
+			szDetail	= "invalid answer of the child process";
+			lpChild->stop();
+			return(ResultCrashed);
+		}
+
+		if(lpProcess->state() == QProcess::NotRunning)
+		{
+			if(lpProcess->exitStatus() == QProcess::CrashExit)
+				szDetail	= "child process crashed";
+			else
+				szDetail	= QString("child process exited with code %1").arg(lpProcess->exitCode());
+			lpChild->stop();
+			return(ResultCrashed);
+		}
+
+		qint64	iLeft	= -1;
+
+		if(m_iTimeout > 0)
+		{
+			iLeft	= m_iTimeout * Q_INT64_C(1000) - timer.elapsed();
+
+			if(iLeft <= 0)
+			{
+				szDetail	= QString("no answer after %1 s").arg(m_iTimeout);
+				lpProcess->kill();
+				lpChild->stop();
+				return(ResultTimeout);
+			}
+		}
+
+		// returns early when the child ends, the next pass finds out
+		lpProcess->waitForReadyRead(static_cast<int>(iLeft));
+		lpChild->m_buffer.append(lpProcess->readAllStandardOutput());
+	}
+
+	QDataStream	stream(payload);
+	quint8		iResult;
+
+	stream >> iResult >> szDetail;
+
+	Result	result	= static_cast<Result>(iResult);
+
+	if(result == ResultOK && !lpPicture->load(stream))
+	{
+		szDetail	= "invalid answer of the child process";
+		result		= ResultCrashed;
+	}
+
+	// the child ends itself after it ran out of memory
+	if(result == ResultMemory || result == ResultCrashed)
+		lpChild->stop();
+
+	return(result);
+}
+
+void cGuard::report(const QString& szFileName, Result result, const QString& szDetail, qint64 iMilliSeconds)
+{
+	QString			szName		= resultName(result);
+	bool			bHarmful	= (result == ResultTimeout || result == ResultCrashed || result == ResultMemory);
+	QString			szLine		= szFileName + "\t" + szName + "\t" + QString(szDetail).replace('\t', ' ').replace('\n', ' ') + "\t" + QString::number(iMilliSeconds) + "\n";
+	QMutexLocker	locker(&m_mutex);
+
+	if(m_reportFile.isOpen())
+	{
+		m_reportFile.write(szLine.toUtf8());
+		m_reportFile.flush();
+	}
+
+	if(bHarmful && !m_quarantineList.contains(szFileName))
+	{
+		m_quarantineList.insert(szFileName);
+
+		if(m_quarantineFile.isOpen())
+		{
+			m_quarantineFile.write(szFileName.toUtf8() + "\n");
+			m_quarantineFile.flush();
+		}
+	}
+
+	locker.unlock();
+
+	if(m_lpStatistics)
+	{
+		m_lpStatistics->addCount("guard/" + szName);
+		if(bHarmful)
+			m_lpStatistics->log(QString("guard: %1 quarantined: %2").arg(szFileName, szDetail));
+	}
+}
+
+int cGuard::runChild(cScanner* lpScanner, qint32 iMemoryLimit)
+{
+#if defined(Q_OS_UNIX)
+	if(iMemoryLimit > 0)
+	{
+		struct rlimit	limit;
+
+		limit.rlim_cur	= static_cast<rlim_t>(iMemoryLimit) * 1024 * 1024;
+		limit.rlim_max	= limit.rlim_cur;
+
+		if(setrlimit(RLIMIT_AS, &limit) != 0)
+			qDebug() << "can't limit the address space of the child process to" << iMemoryLimit << "MB";
+	}
+#else
+	Q_UNUSED(iMemoryLimit);
+#endif
+
+	QFile	in;
+	QFile	out;
+
+	if(!in.open(stdin, QFile::ReadOnly | QFile::Unbuffered) || !out.open(stdout, QFile::WriteOnly))
+		return(1);
+
+	for(;;)
+	{
+		quint32		iSize;
+
+		if(!readFully(in, reinterpret_cast<char*>(&iSize), sizeof(iSize)))
+			return(0);
+
+		iSize	= qFromBigEndian(iSize);
+		if(iSize > MAX_FRAME_SIZE)
+			return(1);
+
+		QByteArray	request(static_cast<int>(iSize), '\0');
+
+		if(!readFully(in, request.data(), iSize))
+			return(1);
+
+		QString		szFileName;
+		QDataStream	requestStream(request);
+
+		requestStream >> szFileName;
+
+		cPicture	picture;
+		Result		result	= ResultFailed;
+		QString		szDetail;
+
+		try
+		{
+			if(lpScanner->decodePicture(szFileName, &picture))
+				result	= ResultOK;
+			else
+				szDetail	= "no metadata could be read";
+		}
+		catch(std::bad_alloc&)
+		{
+			result		= ResultMemory;
+			szDetail	= QString("address space limit of %1 MB exceeded").arg(iMemoryLimit);
+		}
+		catch(std::exception& e)
+		{
+			szDetail	= QString::fromLocal8Bit(e.what());
+		}
+
+		QByteArray	response;
+		QDataStream	responseStream(&response, QIODevice::WriteOnly);
+
+		responseStream << static_cast<quint8>(result) << szDetail;
+		if(result == ResultOK)
+			picture.save(responseStream);
+
+		out.write(frame(response));
+		out.flush();
+
+		// the heap may be in any state after an allocation failed, the parent starts a new child
+		if(result == ResultMemory)
+			return(2);
+	}
+}
+
+QString cGuard::resultName(Result result)
+{
+	switch(result)
+	{
+	case ResultOK:
+		return("ok");
+	case ResultFailed:
+		return("failed");
+	case ResultTimeout:
+		return("timeout");
+	case ResultCrashed:
+		return("crashed");
+	case ResultMemory:
+		return("memory");
+	}
+	return("");
+}
@@ -0,0 +1,178 @@
+/*!
+ \file cguard.h
+
+*/
+
+#ifndef CGUARD_H
+#define CGUARD_H
+
+
+#include <QString>
+#include <QStringList>
+#include <QSet>
+#include <QFile>
+#include <QMutex>
+
+
+class cPicture;
+class cScanner;
+class cStatistics;
+class cGuardChild;
+
+/*!
+ \brief Reads files in child processes so a file that hangs or crashes Exiv2 only costs that file.
+
+ Every thread calling read() owns one child process of this executable
+ started with --guard-child. The child reads one file at a time and sends
+ the picture back, it limits its own address space (RLIMIT_AS, Unix only).
+ A child that needs longer than the timeout is killed, a child that dies or
+ runs out of memory is replaced by a new one for the next file.
+
+ Files that timed out, crashed or ran out of memory are added to the
+ quarantine file and skipped by later scans using the same file. Every
+ file that could not be read is written to the error report.
+
+ Parent and child exchange frames of a 32 bit big endian size and a
+ QDataStream payload: the file name to the child, the result, a detail
+ message and the picture (see cPicture::save()) back.
+
+ \class cGuard cguard.h "cguard.h"
+*/
+class cGuard
+{
+public:
+	/*!
+	 \brief Outcome of read().
+	*/
+	enum Result
+	{
+		ResultOK		= 0,	/*!< the picture was read */
+		ResultFailed	= 1,	/*!< the file has no readable metadata */
+		ResultTimeout	= 2,	/*!< the child was killed after the timeout */
+		ResultCrashed	= 3,	/*!< the child died */
+		ResultMemory	= 4,	/*!< the child ran out of its address space */
+	};
+
+	/*!
+	 \brief
+
+	 \fn cGuard
+	 \param szArguments arguments of the child processes after --guard-child, i.e. the options of the decoder
+	*/
+	cGuard(const QStringList& szArguments);
+	~cGuard();
+
+	/*!
+	 \brief Time a child may spend on one file, 0 waits forever.
+
+	 \fn setTimeout
+	 \param iSeconds
+	*/
+	void					setTimeout(qint32 iSeconds);
+	/*!
+	 \brief Address space limit of the child processes, 0 for none.
+
+	 \fn setMemoryLimit
+	 \param iMB
+	*/
+	void					setMemoryLimit(qint32 iMB);
+	/*!
+	 \brief
+
+	 \fn setStatistics
+	 \param lpStatistics
+	*/
+	void					setStatistics(cStatistics* lpStatistics);
+	/*!
+	 \brief Reads the files quarantined by earlier scans from szFileName and appends new ones to it.
+
+	 \fn setQuarantine
+	 \param szFileName
+	 \return bool false if the file can't be opened
+	*/
+	bool					setQuarantine(const QString& szFileName);
+	/*!
+	 \brief Writes one line per file that could not be read to szFileName.
+
+	 \fn setErrorReport
+	 \param szFileName
+	 \return bool false if the file can't be created
+	*/
+	bool					setErrorReport(const QString& szFileName);
+	/*!
+	 \brief Thread safe.
+
+	 \fn isQuarantined
+	 \param szFileName absolute path
+	 \return bool
+	*/
+	bool					isQuarantined(const QString& szFileName);
+	/*!
+	 \brief Reads a file in the child process of the calling thread. Thread safe.
+
+	 \fn read
+	 \param szFileName
+	 \param lpPicture
+	 \return Result
+	*/
+	Result					read(const QString& szFileName, cPicture* lpPicture);
+
+	/*!
+	 \brief Main loop of a child process: reads the files the parent sends on stdin and answers on stdout until stdin is closed.
+
+	 \fn runChild
+	 \param lpScanner decodes the files, see cScanner::decodePicture()
+	 \param iMemoryLimit address space limit in MB, 0 for none
+	 \return int exit code
+	*/
+	static int				runChild(cScanner* lpScanner, qint32 iMemoryLimit);
+	/*!
+	 \brief
+
+	 \fn resultName
+	 \param result
+	 \return QString
+	*/
+	static QString			resultName(Result result);
+
+private:
+	QStringList				m_szArguments;					/*!< options passed to the children */
+	qint32					m_iTimeout;						/*!< seconds per file, 0 = none */
+	qint32					m_iMemoryLimit;					/*!< MB per child, 0 = none */
+	cStatistics*			m_lpStatistics;					/*!< statistics, or nullptr */
+	QMutex					m_mutex;						/*!< guards the quarantine and the report */
+	QSet<QString>			m_quarantineList;				/*!< files skipped */
+	QFile					m_quarantineFile;				/*!< receives newly quarantined files */
+	QFile					m_reportFile;					/*!< error report */
+
+	/*!
+	 \brief Starts the child process of the calling thread.
+
+	 \fn start
+	 \param lpChild
+	 \return bool
+	*/
+	bool					start(cGuardChild* lpChild);
+	/*!
+	 \brief Waits for the answer of the child until the timeout.
+
+	 \fn receive
+	 \param lpChild
+	 \param lpPicture
+	 \param szDetail
+	 \return Result
+	*/
+	Result					receive(cGuardChild* lpChild, cPicture* lpPicture, QString& szDetail);
+	/*!
+	 \brief Writes a file that could not be read to the report and quarantines it if it harmed the child.
+
+	 \fn report
+	 \param szFileName
+	 \param result
+	 \param szDetail
+	 \param iMilliSeconds
+	*/
+	void					report(const QString& szFileName, Result result, const QString& szDetail, qint64 iMilliSeconds);
+};
+
+#endif // CGUARD_H
@@ -0,0 +1,484 @@
+/*!
+ \file cifdview.cpp
+
+*/
+
+#include "cifdview.h"
+
+#include <QtEndian>
+#include <QList>
+#include <QPair>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+
+#define IFD_IFD0		1
+#define IFD_IFD3		4
+#define IFD_EXIF		5
+#define IFD_GPS			6
+#define IFD_INTEROP		7
+
+#define MAX_IFDS		16
+#define MAX_ENTRIES		1000
+
+
+static quint16 read16(const uchar* lpData, bool bBigEndian)
+{
+	return(bBigEndian ? qFromBigEndian<quint16>(lpData) : qFromLittleEndian<quint16>(lpData));
+}
+
+static quint32 read32(const uchar* lpData, bool bBigEndian)
+{
+	return(bBigEndian ? qFromBigEndian<quint32>(lpData) : qFromLittleEndian<quint32>(lpData));
+}
+
+static void swapValues(uchar* lpData, qint32 iType, quint32 iCount)
+{
+	qint32	iSize	= cIFDView::typeSize(iType);
+
+	// rationals are two longs
+	if(iType == 5 || iType == 10)
+	{
+		iSize	= 4;
+		iCount	*= 2;
+	}
+
+	for(quint32 x = 0;x < iCount;x++, lpData += iSize)
+		std::reverse(lpData, lpData + iSize);
+}
+
+cIFDView::cIFDView() :
+	m_bBigEndian(false),
+	m_bMakerNotes(false),
+	m_iMakerNote(0),
+	m_bTruncated(false)
+{
+}
+
+void cIFDView::clear()
+{
+	// both keep their allocation for the next file
+	m_metadata.resize(0);
+	m_entryList.clear();
+	m_bBigEndian	= false;
+	m_iMakerNote	= 0;
+	m_bTruncated	= false;
+}
+
+void cIFDView::setMakerNotes(bool bMakerNotes)
+{
+	m_bMakerNotes	= bMakerNotes;
+}
+
+bool cIFDView::parse(const uchar* lpData, qint64 iSize, cWanted wanted)
+{
+	clear();
+
+	qint64			iTIFFSize;
+	const uchar*	lpTIFF	= findTIFF(lpData, iSize, iTIFFSize);
+
+	if(!lpTIFF)
+		return(false);
+
+	m_bBigEndian	= (lpTIFF[0] == 'M');
+
+	bool	bOK	= parseTIFF(lpTIFF, iTIFFSize, IFD_IFD0, wanted);
+
+	// past the end of an APP1 segment inside the data the file is broken, not cut off
+	bool	bTruncated	= m_bTruncated && lpTIFF + iTIFFSize == lpData + iSize;
+
+	if(!bOK)
+		clear();
+	m_bTruncated	= bTruncated;
+	return(bOK);
+}
+
+bool cIFDView::append(const uchar* lpData, qint64 iSize, qint32 iIFD, cWanted wanted)
+{
+	qint64			iTIFFSize;
+	const uchar*	lpTIFF	= findTIFF(lpData, iSize, iTIFFSize);
+
+	if(!lpTIFF)
+		return(false);
+
+	// all entries are decoded with the byte order of the view
+	if(m_entryList.isEmpty())
+		m_bBigEndian	= (lpTIFF[0] == 'M');
+	else if(m_bBigEndian != (lpTIFF[0] == 'M'))
+		return(false);
+
+	qint32	iEntries	= m_entryList.count();
+	qint32	iMetadata	= m_metadata.size();
+
+	if(!parseTIFF(lpTIFF, iTIFFSize, iIFD, wanted))
+	{
+		m_entryList.resize(iEntries);
+		m_metadata.resize(iMetadata);
+		return(false);
+	}
+
+	// e.g. CMT3 of CR3 files, the maker note as a TIFF structure of its own
+	if(iIFD >= IFD_MAKERNOTE_CANON)
+		m_iMakerNote	= iIFD;
+	return(true);
+}
+
+bool cIFDView::parseTIFF(const uchar* lpTIFF, qint64 iTIFFSize, qint32 iIFD, cWanted wanted)
+{
+	if(m_metadata.capacity() < 4096)
+		m_metadata.reserve(4096);
+
+	QList<QPair<quint32, qint32> >	ifdList;
+	QList<quint32>					visitedList;
+	QByteArray						make;
+	quint32							iMakerNote		= 0;
+	quint32							iMakerNoteSize	= 0;
+
+	ifdList.append(qMakePair(read32(lpTIFF + 4, m_bBigEndian), iIFD));
+
+	while(!ifdList.isEmpty())
+	{
+		QPair<quint32, qint32>	ifd		= ifdList.takeFirst();
+		quint32					iOffset	= ifd.first;
+
+		// loops and runaway chains in broken files
+		if(visitedList.contains(iOffset) || visitedList.count() >= MAX_IFDS)
+			continue;
+		visitedList.append(iOffset);
+
+		if(static_cast<qint64>(iOffset) + 2 > iTIFFSize)
+		{
+			m_bTruncated	= true;
+			return(false);
+		}
+
+		quint16	iEntries	= read16(lpTIFF + iOffset, m_bBigEndian);
+
+		if(iEntries > MAX_ENTRIES)
+			return(false);
+		if(static_cast<qint64>(iOffset) + 2 + iEntries * 12 > iTIFFSize)
+		{
+			m_bTruncated	= true;
+			return(false);
+		}
+
+		for(quint16 x = 0;x < iEntries;x++)
+		{
+			const uchar*	lpEntry	= lpTIFF + iOffset + 2 + x * 12;
+			quint16			iTag	= read16(lpEntry, m_bBigEndian);
+			quint16			iType	= read16(lpEntry + 2, m_bBigEndian);
+			quint32			iCount	= read32(lpEntry + 4, m_bBigEndian);
+			quint64			iBytes	= static_cast<quint64>(typeSize(iType)) * iCount;
+
+			if(ifd.second == IFD_IFD0 && iTag == 0x8769)
+				ifdList.append(qMakePair(read32(lpEntry + 8, m_bBigEndian), IFD_EXIF));
+			else if(ifd.second == IFD_IFD0 && iTag == 0x8825)
+				ifdList.append(qMakePair(read32(lpEntry + 8, m_bBigEndian), IFD_GPS));
+			else if(ifd.second == IFD_EXIF && iTag == 0xa005)
+				ifdList.append(qMakePair(read32(lpEntry + 8, m_bBigEndian), IFD_INTEROP));
+			else if(m_bMakerNotes && ifd.second == IFD_EXIF && iTag == 0x927c && iBytes > 4)
+			{
+				iMakerNote		= read32(lpEntry + 8, m_bBigEndian);
+				iMakerNoteSize	= static_cast<quint32>(qMin(iBytes, static_cast<quint64>(UINT_MAX)));
+			}
+			else if(m_bMakerNotes && ifd.second == IFD_IFD0 && iTag == 0x010f && iType == 2)
+			{
+				// Canon and some Sony maker notes have no header, the make tells them apart
+				quint32	iMakeOffset	= iBytes > 4 ? read32(lpEntry + 8, m_bBigEndian) : static_cast<quint32>(lpEntry + 8 - lpTIFF);
+
+				if(iMakeOffset + iBytes <= static_cast<quint64>(iTIFFSize))
+					make	= QByteArray::fromRawData(reinterpret_cast<const char*>(lpTIFF + iMakeOffset), static_cast<int>(iBytes));
+			}
+
+			// values of up to four bytes are stored in the entry itself
+			const uchar*	lpValue	= lpEntry + 8;
+
+			// also for entries which are not wanted, Exiv2 skips them as well when the data is cut off
+			if(iBytes > 4)
+			{
+				quint32	iValueOffset	= read32(lpEntry + 8, m_bBigEndian);
+
+				if(iValueOffset + iBytes > static_cast<quint64>(iTIFFSize))
+				{
+					m_bTruncated	= true;
+					if(wanted(iTag, ifd.second))
+						return(false);
+					continue;
+				}
+				lpValue	= lpTIFF + iValueOffset;
+			}
+
+			if(!iBytes || !wanted(iTag, ifd.second))
+				continue;
+
+			cIFDEntry	entry;
+
+			entry.m_iTag	= iTag;
+			entry.m_iType	= iType;
+			entry.m_iIFD	= ifd.second;
+			entry.m_iCount	= iCount;
+			entry.m_iOffset	= static_cast<quint32>(m_metadata.size());
+
+			m_metadata.append(reinterpret_cast<const char*>(lpValue), static_cast<int>(iBytes));
+			m_entryList.append(entry);
+		}
+
+		// IFD0 links to IFD1 (thumbnail) and in RAW files to further image IFDs
+		if(ifd.second >= IFD_IFD0 && ifd.second < IFD_IFD3)
+		{
+			if(static_cast<qint64>(iOffset) + 2 + iEntries * 12 + 4 > iTIFFSize)
+				m_bTruncated	= true;
+			else
+			{
+				quint32	iNext	= read32(lpTIFF + iOffset + 2 + iEntries * 12, m_bBigEndian);
+
+				if(iNext)
+					ifdList.append(qMakePair(iNext, ifd.second + 1));
+			}
+		}
+	}
+
+	// a broken maker note does not invalidate the rest of the view
+	if(iMakerNoteSize && static_cast<quint64>(iMakerNote) + iMakerNoteSize > static_cast<quint64>(iTIFFSize))
+		m_bTruncated	= true;
+	else if(iMakerNoteSize)
+		parseMakerNote(lpTIFF, iTIFFSize, iMakerNote, iMakerNoteSize, make, wanted);
+
+	return(true);
+}
+
+bool cIFDView::parseMakerNote(const uchar* lpTIFF, qint64 iTIFFSize, quint32 iOffset, quint32 iSize, const QByteArray& make, cWanted wanted)
+{
+	const uchar*	lpMakerNote	= lpTIFF + iOffset;
+	bool			bOK			= true;
+	qint32			iIFD		= 0;
+
+	if(iSize >= 18 && !memcmp(lpMakerNote, "Nikon\0\2", 7))
+	{
+		// type 3 has a TIFF header of its own, offsets are relative to it
+		const uchar*	lpNikon		= lpMakerNote + 10;
+		bool			bBigEndian	= (lpNikon[0] == 'M');
+
+		if(read16(lpNikon + 2, bBigEndian) != 42)
+			return(false);
+
+		iIFD	= IFD_MAKERNOTE_NIKON;
+		bOK		= parseIFD(lpNikon, iSize - 10, read32(lpNikon + 4, bBigEndian), bBigEndian, iIFD, wanted);
+	}
+	else if(iSize >= 12 && !memcmp(lpMakerNote, "FUJIFILM", 8))
+	{
+		// always little endian, offsets are relative to the maker note
+		iIFD	= IFD_MAKERNOTE_FUJI;
+		bOK		= parseIFD(lpMakerNote, iSize, qFromLittleEndian<quint32>(lpMakerNote + 8), false, iIFD, wanted);
+	}
+	else if(iSize >= 14 && (!memcmp(lpMakerNote, "SONY DSC \0\0\0", 12) || !memcmp(lpMakerNote, "SONY CAM \0\0\0", 12)))
+	{
+		iIFD	= IFD_MAKERNOTE_SONY;
+		bOK		= parseIFD(lpTIFF, iTIFFSize, iOffset + 12, m_bBigEndian, iIFD, wanted);
+	}
+	else if(make.startsWith("SONY") && memcmp(lpMakerNote, "SONY", 4) && memcmp(lpMakerNote, "PREMI", 5))
+	{
+		iIFD	= IFD_MAKERNOTE_SONY;
+		bOK		= parseIFD(lpTIFF, iTIFFSize, iOffset, m_bBigEndian, iIFD, wanted);
+	}
+	else if(make.startsWith("Canon"))
+	{
+		iIFD	= IFD_MAKERNOTE_CANON;
+		bOK		= parseIFD(lpTIFF, iTIFFSize, iOffset, m_bBigEndian, iIFD, wanted);
+	}
+
+	if(bOK)
+		m_iMakerNote	= iIFD;
+	return(bOK);
+}
+
+bool cIFDView::parseIFD(const uchar* lpBase, qint64 iBaseSize, quint32 iOffset, bool bBigEndian, qint32 iIFD, cWanted wanted)
+{
+	if(static_cast<qint64>(iOffset) + 2 > iBaseSize)
+	{
+		m_bTruncated	= true;
+		return(false);
+	}
+
+	quint16	iEntries	= read16(lpBase + iOffset, bBigEndian);
+
+	if(iEntries > MAX_ENTRIES)
+		return(false);
+	if(static_cast<qint64>(iOffset) + 2 + iEntries * 12 > iBaseSize)
+	{
+		m_bTruncated	= true;
+		return(false);
+	}
+
+	qint32	iEntryCount	= m_entryList.count();
+	qint32	iMetadata	= m_metadata.size();
+
+	for(quint16 x = 0;x < iEntries;x++)
+	{
+		const uchar*	lpEntry	= lpBase + iOffset + 2 + x * 12;
+		quint16			iTag	= read16(lpEntry, bBigEndian);
+		quint16			iType	= read16(lpEntry + 2, bBigEndian);
+		quint32			iCount	= read32(lpEntry + 4, bBigEndian);
+		quint64			iBytes	= static_cast<quint64>(typeSize(iType)) * iCount;
+
+		const uchar*	lpValue	= lpEntry + 8;
+
+		if(iBytes > 4)
+		{
+			quint32	iValueOffset	= read32(lpEntry + 8, bBigEndian);
+
+			if(iValueOffset + iBytes > static_cast<quint64>(iBaseSize))
+			{
+				m_bTruncated	= true;
+				if(!wanted(iTag, iIFD))
+					continue;
+
+				m_entryList.resize(iEntryCount);
+				m_metadata.resize(iMetadata);
+				return(false);
+			}
+			lpValue	= lpBase + iValueOffset;
+		}
+
+		if(!iBytes || !wanted(iTag, iIFD))
+			continue;
+
+		cIFDEntry	entry;
+
+		entry.m_iTag	= iTag;
+		entry.m_iType	= iType;
+		entry.m_iIFD	= iIFD;
+		entry.m_iCount	= iCount;
+		entry.m_iOffset	= static_cast<quint32>(m_metadata.size());
+
+		m_metadata.append(reinterpret_cast<const char*>(lpValue), static_cast<int>(iBytes));
+		m_entryList.append(entry);
+
+		// cEXIFValue decodes everything in the byte order of the view
+		if(bBigEndian != m_bBigEndian)
+			swapValues(reinterpret_cast<uchar*>(m_metadata.data()) + entry.m_iOffset, iType, iCount);
+	}
+
+	return(true);
+}
+
+bool cIFDView::isTruncated()
+{
+	return(m_bTruncated);
+}
+
+const cIFDEntry* cIFDView::find(qint32 iTag, qint32 iIFD)
+{
+	for(int x = 0;x < m_entryList.count();x++)
+	{
+		const cIFDEntry&	entry	= m_entryList.at(x);
+
+		if(entry.m_iTag == iTag && entry.m_iIFD == iIFD)
+			return(&entry);
+	}
+	return(nullptr);
+}
+
+const uchar* cIFDView::data(const cIFDEntry& entry)
+{
+	return(reinterpret_cast<const uchar*>(m_metadata.constData()) + entry.m_iOffset);
+}
+
+bool cIFDView::isBigEndian()
+{
+	return(m_bBigEndian);
+}
+
+qint32 cIFDView::makerNote()
+{
+	return(m_iMakerNote);
+}
+
+qint32 cIFDView::typeSize(qint32 iType)
+{
+	switch(iType)
+	{
+	case 1: //byte
+	case 2: //ascii
+	case 6: //signed byte
+	case 7: //undefined
+		return(1);
+	case 3: //short
+	case 8: //signed short
+		return(2);
+	case 4: //long
+	case 9: //signed long
+	case 11: //float
+	case 13: //ifd
+		return(4);
+	case 5: //rational
+	case 10: //signed rational
+	case 12: //double
+		return(8);
+	default:
+		return(0);
+	}
+}
+
+const uchar* cIFDView::findTIFF(const uchar* lpData, qint64 iSize, qint64& iTIFFSize)
+{
+	if(!lpData || iSize < 8)
+		return(nullptr);
+
+	if((!memcmp(lpData, "II", 2) && qFromLittleEndian<quint16>(lpData + 2) == 42) || (!memcmp(lpData, "MM", 2) && qFromBigEndian<quint16>(lpData + 2) == 42))
+	{
+		iTIFFSize	= iSize;
+		return(lpData);
+	}
+
+	if(lpData[0] != 0xff || lpData[1] != 0xd8)
+		return(nullptr);
+
+	qint64	iPos	= 2;
+
+	while(iPos + 4 <= iSize)
+	{
+		if(lpData[iPos] != 0xff)
+			return(nullptr);
+
+		uchar	iMarker	= lpData[iPos + 1];
+
+		// fill bytes and markers without a length
+		if(iMarker == 0xff)
+		{
+			iPos++;
+			continue;
+		}
+		if(iMarker == 0x01 || (iMarker >= 0xd0 && iMarker <= 0xd8))
+		{
+			iPos	+= 2;
+			continue;
+		}
+
+		// the metadata ends where the image data starts
+		if(iMarker == 0xda || iMarker == 0xd9)
+			return(nullptr);
+
+		qint64	iLength	= qFromBigEndian<quint16>(lpData + iPos + 2);
+
+		if(iMarker == 0xe1 && iLength >= 2 + 6 + 8 && iPos + 2 + 2 + 6 + 8 <= iSize && !memcmp(lpData + iPos + 4, "Exif\0\0", 6))
+		{
+			const uchar*	lpTIFF	= lpData + iPos + 10;
+
+			// a segment cut off by the end of the data ends the structure there, see isTruncated()
+			iTIFFSize	= qMin(iLength - 8, iSize - iPos - 10);
+			if((!memcmp(lpTIFF, "II", 2) && qFromLittleEndian<quint16>(lpTIFF + 2) == 42) || (!memcmp(lpTIFF, "MM", 2) && qFromBigEndian<quint16>(lpTIFF + 2) == 42))
+				return(lpTIFF);
+			return(nullptr);
+		}
+
+		if(iPos + 2 + iLength > iSize)
+			return(nullptr);
+
+		iPos	+= 2 + iLength;
+	}
+
+	return(nullptr);
+}
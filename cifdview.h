@@ -0,0 +1,207 @@
+/*!
+ \file cifdview.h
+
+*/
+
+#ifndef CIFDVIEW_H
+#define CIFDVIEW_H
+
+
+#include <QByteArray>
+#include <QVector>
+
+#include <functional>
+
+
+// IFD ids of the vendor maker notes, above the range of Exiv2::IfdId
+#define IFD_MAKERNOTE_CANON		1001
+#define IFD_MAKERNOTE_NIKON		1002
+#define IFD_MAKERNOTE_SONY		1003
+#define IFD_MAKERNOTE_FUJI		1004
+
+
+/*!
+ \brief One raw IFD entry.
+
+ \class cIFDEntry cifdview.h "cifdview.h"
+*/
+class cIFDEntry
+{
+public:
+	quint16		m_iTag;						/*!< tag id */
+	quint16		m_iType;					/*!< TIFF type */
+	qint32		m_iIFD;						/*!< IFD id, numbered like Exiv2::IfdId */
+	quint32		m_iCount;					/*!< number of values */
+	quint32		m_iOffset;					/*!< offset of the value bytes in the copied metadata */
+};
+
+/*!
+ \brief Undecoded view of the TIFF structure of the EXIF metadata.
+
+ parse() walks IFD0 and its chain, the Exif, GPS and interoperability
+ IFDs of a TIFF file or of the APP1 segment of a JPEG file and copies the
+ value bytes of the wanted entries into one buffer. Nothing is converted,
+ cEXIFValue decodes an entry when it is first asked for.
+
+ This saves the conversion into cEXIFValue, not the decoding of Exiv2:
+ cEXIF still runs Exiv2's readMetadata(), which decodes every tag, for
+ the image size and the other metadata. The view is only built when cEXIF
+ already holds the file or its prefix in a cFileInput buffer.
+
+ If enabled with setMakerNotes(), the top level IFD of the Canon, Nikon
+ (type 3), Sony and Fujifilm maker notes is walked as well and its wanted
+ entries are added with the IFD ids IFD_MAKERNOTE_*. Sub-IFDs and encrypted
+ maker note data are not followed.
+
+ \class cIFDView cifdview.h "cifdview.h"
+*/
+class cIFDView
+{
+public:
+	/*!
+	 \brief Decides which entries are kept.
+	*/
+	typedef std::function<bool(qint32 iTag, qint32 iIFD)>	cWanted;
+
+	cIFDView();
+
+	/*!
+	 \brief
+
+	 \fn clear
+	*/
+	void					clear();
+	/*!
+	 \brief Also walks the maker note of the Exif IFD.
+
+	 \fn setMakerNotes
+	 \param bMakerNotes
+	*/
+	void					setMakerNotes(bool bMakerNotes);
+	/*!
+	 \brief Builds the view. Fails if the data is neither TIFF nor JPEG with EXIF, or if an offset of a wanted entry points outside of lpData, see isTruncated().
+
+	 \fn parse
+	 \param lpData
+	 \param iSize
+	 \param wanted
+	 \return bool
+	*/
+	bool					parse(const uchar* lpData, qint64 iSize, cWanted wanted);
+	/*!
+	 \brief Adds a separate TIFF structure whose first IFD is iIFD, e.g. the CMT boxes of CR3 files. Fails without changing the view if the byte order differs from the entries already in it.
+
+	 \fn append
+	 \param lpData
+	 \param iSize
+	 \param iIFD IFD id of the first IFD, numbered like Exiv2::IfdId
+	 \param wanted
+	 \return bool
+	*/
+	bool					append(const uchar* lpData, qint64 iSize, qint32 iIFD, cWanted wanted);
+	/*!
+	 \brief True if the last parse() met an IFD or value offset past the end of its data, i.e. the data was only the start of the file.
+
+	 \fn isTruncated
+	 \return bool
+	*/
+	bool					isTruncated();
+	/*!
+	 \brief
+
+	 \fn find
+	 \param iTag
+	 \param iIFD
+	 \return const cIFDEntry, nullptr if the entry is not in the view
+	*/
+	const cIFDEntry*		find(qint32 iTag, qint32 iIFD);
+	/*!
+	 \brief Value bytes of an entry, in the byte order of the file.
+
+	 \fn data
+	 \param entry
+	 \return const uchar
+	*/
+	const uchar*			data(const cIFDEntry& entry);
+	/*!
+	 \brief
+
+	 \fn isBigEndian
+	 \return bool
+	*/
+	bool					isBigEndian();
+	/*!
+	 \brief IFD id of the maker note added to the view, 0 if there is none.
+
+	 \fn makerNote
+	 \return qint32
+	*/
+	qint32					makerNote();
+
+	/*!
+	 \brief Size of one value of a TIFF type in bytes, 0 for unknown types.
+
+	 \fn typeSize
+	 \param iType
+	 \return qint32
+	*/
+	static qint32			typeSize(qint32 iType);
+
+private:
+	QByteArray				m_metadata;						/*!< value bytes of all entries */
+	QVector<cIFDEntry>		m_entryList;					/*!< entries of the view */
+	bool					m_bBigEndian;					/*!< byte order of the file */
+	bool					m_bMakerNotes;					/*!< walk the maker note */
+	qint32					m_iMakerNote;					/*!< IFD id of the maker note in the view */
+	bool					m_bTruncated;					/*!< an offset pointed past the end of the data */
+
+	/*!
+	 \brief Returns the TIFF header inside lpData, nullptr if there is none.
+
+	 \fn findTIFF
+	 \param lpData
+	 \param iSize
+	 \param iTIFFSize bytes from the header to the end of the TIFF structure
+	 \return const uchar
+	*/
+	static const uchar*		findTIFF(const uchar* lpData, qint64 iSize, qint64& iTIFFSize);
+	/*!
+	 \brief Walks the IFDs of one TIFF structure starting with iIFD and adds the wanted entries.
+
+	 \fn parseTIFF
+	 \param lpTIFF TIFF header
+	 \param iTIFFSize
+	 \param iIFD
+	 \param wanted
+	 \return bool false if an offset points outside of the structure
+	*/
+	bool					parseTIFF(const uchar* lpTIFF, qint64 iTIFFSize, qint32 iIFD, cWanted wanted);
+	/*!
+	 \brief Finds the vendor of a maker note by its header or by the camera make and adds the wanted entries of its IFD.
+
+	 \fn parseMakerNote
+	 \param lpTIFF TIFF header of the structure holding the maker note
+	 \param iTIFFSize
+	 \param iOffset offset of the maker note
+	 \param iSize size of the maker note
+	 \param make value of the Make tag, may be empty
+	 \param wanted
+	 \return bool false if the maker note is broken
+	*/
+	bool					parseMakerNote(const uchar* lpTIFF, qint64 iTIFFSize, quint32 iOffset, quint32 iSize, const QByteArray& make, cWanted wanted);
+	/*!
+	 \brief Adds the wanted entries of one IFD without following any links. Values in the other byte order are swapped to the one of the view.
+
+	 \fn parseIFD
+	 \param lpBase start of the offsets
+	 \param iBaseSize
+	 \param iOffset offset of the IFD
+	 \param bBigEndian byte order of the IFD
+	 \param iIFD
+	 \param wanted
+	 \return bool false without changing the view if an offset points outside of lpBase
+	*/
+	bool					parseIFD(const uchar* lpBase, qint64 iBaseSize, quint32 iOffset, bool bBigEndian, qint32 iIFD, cWanted wanted);
+};
+
+#endif // CIFDVIEW_H
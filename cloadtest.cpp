@@ -0,0 +1,287 @@
+/*!
+ \file cloadtest.cpp
+
+*/
+
+#include "cloadtest.h"
+
+#include <QFile>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <QDebug>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <cstring>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+
+#define READ_SIZE		(64 * 1024)
+
+
+/*!
+ \brief Sends all of lpData, with iFD attached if it is not -1.
+
+ \fn sendAll
+ \param iSocket
+ \param lpData
+ \param iSize
+ \param iFD
+ \return bool
+*/
+static bool sendAll(int iSocket, const char* lpData, size_t iSize, int iFD)
+{
+	while(iSize)
+	{
+		struct iovec	iov;
+		struct msghdr	message;
+		char			control[CMSG_SPACE(sizeof(int))];
+
+		iov.iov_base		= const_cast<char*>(lpData);
+		iov.iov_len			= iSize;
+		memset(&message, 0, sizeof(message));
+		message.msg_iov		= &iov;
+		message.msg_iovlen	= 1;
+
+		// the descriptor goes with the first byte of the request
+		if(iFD >= 0)
+		{
+			memset(control, 0, sizeof(control));
+			message.msg_control		= control;
+			message.msg_controllen	= sizeof(control);
+
+			struct cmsghdr*	lpHeader	= CMSG_FIRSTHDR(&message);
+
+			lpHeader->cmsg_level	= SOL_SOCKET;
+			lpHeader->cmsg_type		= SCM_RIGHTS;
+			lpHeader->cmsg_len		= CMSG_LEN(sizeof(int));
+			memcpy(CMSG_DATA(lpHeader), &iFD, sizeof(int));
+		}
+
+		ssize_t	iSent	= sendmsg(iSocket, &message, 0);
+
+		if(iSent < 0)
+		{
+			if(errno == EINTR)
+				continue;
+			return(false);
+		}
+
+		lpData	+= iSent;
+		iSize	-= static_cast<size_t>(iSent);
+		iFD		= -1;
+	}
+
+	return(true);
+}
+
+cLoadTest::cLoadTest() :
+	m_iConnections(1),
+	m_iRequests(10000),
+	m_iPipeline(16),
+	m_bPassFDs(false)
+{
+}
+
+void cLoadTest::setConnections(qint32 iConnections)
+{
+	m_iConnections	= qMax(1, iConnections);
+}
+
+void cLoadTest::setRequests(qint32 iRequests)
+{
+	m_iRequests	= qMax(1, iRequests);
+}
+
+void cLoadTest::setPipeline(qint32 iPipeline)
+{
+	m_iPipeline	= qMax(1, iPipeline);
+}
+
+void cLoadTest::setPassFDs(bool bPassFDs)
+{
+	m_bPassFDs	= bPassFDs;
+}
+
+bool cLoadTest::run(const QString& szSocket, const QStringList& fileList, QTextStream& out)
+{
+	if(fileList.isEmpty())
+		return(false);
+
+	// written by the connection threads, one element each
+	std::vector<QVector<qint64> >	latencyLists(static_cast<size_t>(m_iConnections));
+	std::vector<qint32>			errorList(static_cast<size_t>(m_iConnections), 0);
+	std::vector<qint32>			okList(static_cast<size_t>(m_iConnections), 0);
+	std::vector<std::thread>	threadList;
+	QElapsedTimer				timer;
+	qint32						iFirst	= 0;
+
+	timer.start();
+
+	for(int x = 0;x < m_iConnections;x++)
+	{
+		// the remainder goes to the first connections
+		qint32	iRequests	= m_iRequests / m_iConnections + (x < m_iRequests % m_iConnections ? 1 : 0);
+
+		threadList.push_back(std::thread([this, x, iFirst, iRequests, &szSocket, &fileList, &latencyLists, &errorList, &okList]() {
+			okList[static_cast<size_t>(x)]	= runConnection(szSocket, fileList, iFirst, iRequests, latencyLists[static_cast<size_t>(x)], errorList[static_cast<size_t>(x)]);
+		}));
+		iFirst	+= iRequests;
+	}
+
+	for(size_t x = 0;x < threadList.size();x++)
+		threadList[x].join();
+
+	qint64			iElapsed	= timer.nsecsElapsed();
+	QVector<qint64>	latencyList;
+	qint32			iErrors		= 0;
+	bool			bOK			= true;
+
+	for(size_t x = 0;x < latencyLists.size();x++)
+	{
+		latencyList	+= latencyLists[x];
+		iErrors		+= errorList[x];
+		bOK			= bOK && okList[x];
+	}
+
+	std::sort(latencyList.begin(), latencyList.end());
+
+	auto	percentile	= [&latencyList](double dPercent) {
+		if(latencyList.isEmpty())
+			return(QString("-"));
+
+		qint32	iIndex	= qMin(latencyList.count() - 1, static_cast<qint32>(latencyList.count() * dPercent / 100.0));
+
+		return(QString::number(latencyList.at(iIndex) / 1000000.0, 'f', 3));
+	};
+
+	out << "connections" << "\t" << m_iConnections << "\n";
+	out << "pipeline" << "\t" << m_iPipeline << "\n";
+	out << "requests" << "\t" << latencyList.count() << "\n";
+	out << "errors" << "\t" << iErrors << "\n";
+	out << "seconds" << "\t" << QString::number(iElapsed / 1000000000.0, 'f', 3) << "\n";
+	out << "requests/s" << "\t" << QString::number(latencyList.count() / (iElapsed / 1000000000.0), 'f', 1) << "\n";
+	out << "p50 ms" << "\t" << percentile(50) << "\n";
+	out << "p90 ms" << "\t" << percentile(90) << "\n";
+	out << "p99 ms" << "\t" << percentile(99) << "\n";
+	out << "max ms" << "\t" << percentile(100) << "\n";
+
+	return(bOK);
+}
+
+bool cLoadTest::runConnection(const QString& szSocket, const QStringList& fileList, qint32 iFirst, qint32 iRequests, QVector<qint64>& latencyList, qint32& iErrors)
+{
+	QByteArray			path	= QFile::encodeName(szSocket);
+	struct sockaddr_un	address;
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family	= AF_UNIX;
+
+	if(path.size() >= static_cast<int>(sizeof(address.sun_path)))
+		return(false);
+	memcpy(address.sun_path, path.constData(), static_cast<size_t>(path.size()));
+
+	int	iSocket	= socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if(iSocket < 0 || ::connect(iSocket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0)
+	{
+		qDebug() << "can't connect to" << szSocket << strerror(errno);
+		if(iSocket >= 0)
+			::close(iSocket);
+		return(false);
+	}
+
+	QElapsedTimer		timer;
+	QVector<qint64>		sentList(iRequests, 0);
+	QByteArray			input;
+	char				buffer[READ_SIZE];
+	qint32				iSent		= 0;
+	qint32				iReceived	= 0;
+	bool				bOK			= true;
+
+	timer.start();
+	latencyList.reserve(iRequests);
+
+	while(iReceived < iRequests)
+	{
+		// keep the pipeline full
+		while(iSent < iRequests && iSent - iReceived < m_iPipeline)
+		{
+			QString		szFileName	= fileList.at((iFirst + iSent) % fileList.count());
+			QJsonObject	request;
+			int			iFD			= -1;
+
+			request.insert("id", iSent);
+
+			if(m_bPassFDs)
+			{
+				iFD	= ::open(QFile::encodeName(szFileName).constData(), O_RDONLY);
+				request.insert("fd", true);
+			}
+			else
+				request.insert("path", szFileName);
+
+			QByteArray	line	= QJsonDocument(request).toJson(QJsonDocument::Compact) + "\n";
+
+			sentList[iSent]	= timer.nsecsElapsed();
+
+			// a file that can't be opened is sent without a descriptor, the server answers with an error
+			bool	bSent	= sendAll(iSocket, line.constData(), static_cast<size_t>(line.size()), iFD);
+
+			if(iFD >= 0)
+				::close(iFD);
+
+			if(!bSent)
+			{
+				bOK	= false;
+				break;
+			}
+			iSent++;
+		}
+
+		if(!bOK)
+			break;
+
+		ssize_t	iRead	= recv(iSocket, buffer, sizeof(buffer), 0);
+
+		if(iRead < 0 && errno == EINTR)
+			continue;
+		if(iRead <= 0)
+		{
+			bOK	= false;
+			break;
+		}
+
+		input.append(buffer, static_cast<int>(iRead));
+
+		qint32	iStart	= 0;
+		qint32	iEnd;
+
+		while((iEnd = input.indexOf('\n', iStart)) >= 0)
+		{
+			QJsonObject	response	= QJsonDocument::fromJson(input.mid(iStart, iEnd - iStart)).object();
+			qint32		iID			= response.value("id").toInt(-1);
+
+			iStart	= iEnd + 1;
+			iReceived++;
+
+			if(!response.value("ok").toBool())
+				iErrors++;
+
+			if(iID >= 0 && iID < iRequests)
+				latencyList.append(timer.nsecsElapsed() - sentList.at(iID));
+		}
+		input.remove(0, iStart);
+	}
+
+	::close(iSocket);
+	return(bOK);
+}
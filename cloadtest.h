@@ -0,0 +1,91 @@
+/*!
+ \file cloadtest.h
+
+*/
+
+#ifndef CLOADTEST_H
+#define CLOADTEST_H
+
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QTextStream>
+
+
+/*!
+ \brief Load test client of cServer.
+
+ Opens several connections to the server, pipelines requests for the
+ given files on every connection and reports the throughput and the
+ latency percentiles of the responses.
+
+ \class cLoadTest cloadtest.h "cloadtest.h"
+*/
+class cLoadTest
+{
+public:
+	cLoadTest();
+
+	/*!
+	 \brief Number of parallel connections.
+
+	 \fn setConnections
+	 \param iConnections
+	*/
+	void				setConnections(qint32 iConnections);
+	/*!
+	 \brief Total number of requests, the files are requested round robin.
+
+	 \fn setRequests
+	 \param iRequests
+	*/
+	void				setRequests(qint32 iRequests);
+	/*!
+	 \brief Requests in flight per connection.
+
+	 \fn setPipeline
+	 \param iPipeline
+	*/
+	void				setPipeline(qint32 iPipeline);
+	/*!
+	 \brief Sends open descriptors with SCM_RIGHTS instead of paths.
+
+	 \fn setPassFDs
+	 \param bPassFDs
+	*/
+	void				setPassFDs(bool bPassFDs);
+
+	/*!
+	 \brief
+
+	 \fn run
+	 \param szSocket socket file of the server
+	 \param fileList
+	 \param out receives the report
+	 \return bool false if a connection failed
+	*/
+	bool				run(const QString& szSocket, const QStringList& fileList, QTextStream& out);
+
+private:
+	qint32				m_iConnections;				/*!< parallel connections */
+	qint32				m_iRequests;				/*!< total number of requests */
+	qint32				m_iPipeline;				/*!< requests in flight per connection */
+	bool				m_bPassFDs;					/*!< send descriptors instead of paths */
+
+	/*!
+	 \brief Runs the requests of one connection. Called on its own thread.
+
+	 \fn runConnection
+	 \param szSocket
+	 \param fileList
+	 \param iFirst index of the first request
+	 \param iRequests number of requests of the connection
+	 \param latencyList receives the latency of every answered request in nanoseconds
+	 \param iErrors receives the number of error responses
+	 \return bool
+	*/
+	bool				runConnection(const QString& szSocket, const QStringList& fileList, qint32 iFirst, qint32 iRequests, QVector<qint64>& latencyList, qint32& iErrors);
+};
+
+#endif // CLOADTEST_H
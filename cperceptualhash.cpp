@@ -0,0 +1,429 @@
+/*!
+ \file cperceptualhash.cpp
+
+*/
+
+#include "cperceptualhash.h"
+
+#include <QFile>
+#include <QDebug>
+#include <QDir>
+#include <QBitArray>
+#include <QHash>
+#include <QScopedPointer>
+#include <QTextStream>
+#include <QtAlgorithms>
+
+#include <algorithm>
+
+#include <cstdio>
+#include <cstdlib>
+#include <csetjmp>
+#include <jpeglib.h>
+
+
+#define HASH_WIDTH		9
+#define HASH_HEIGHT		8
+#define CHUNK_COUNT		4
+#define CHUNK_BITS		16
+
+
+/*!
+ \brief libjpeg error manager returning to dHash() instead of calling exit().
+
+ \class cJPEGError cperceptualhash.cpp
+*/
+class cJPEGError
+{
+public:
+	jpeg_error_mgr		m_error;				/*!< libjpeg error manager, must be the first member */
+	jmp_buf				m_jump;					/*!< return point on errors */
+};
+
+static void jpegErrorExit(j_common_ptr lpInfo)
+{
+	longjmp(reinterpret_cast<cJPEGError*>(lpInfo->err)->m_jump, 1);
+}
+
+static void jpegOutputMessage(j_common_ptr)
+{
+}
+
+static qint32 findRoot(QVector<qint32>& parentList, qint32 i)
+{
+	while(parentList[i] != i)
+	{
+		parentList[i]	= parentList[parentList[i]];
+		i				= parentList[i];
+	}
+	return(i);
+}
+
+static inline quint32 chunk(quint64 iHash, qint32 iChunk)
+{
+	return(static_cast<quint32>((iHash >> (iChunk * CHUNK_BITS)) & 0xFFFF));
+}
+
+/*!
+ \brief Decodes a JPEG to grayscale, downscaled by the IDCT but to no less than 9x8 pixels.
+
+ Only trivially destructible objects live between setjmp() and longjmp()
+ here, the pixel buffer is volatile so the error path sees its address.
+
+ \fn decodeGray
+ \param jpeg
+ \param lpWidth receives the width
+ \param lpHeight receives the height
+ \return uchar* pixels, to be released with free(), nullptr on errors
+*/
+static uchar* decodeGray(const QByteArray& jpeg, qint32* lpWidth, qint32* lpHeight)
+{
+	jpeg_decompress_struct	info;
+	cJPEGError				error;
+	uchar* volatile			lpPixel	= nullptr;
+
+	info.err						= jpeg_std_error(&error.m_error);
+	error.m_error.error_exit		= jpegErrorExit;
+	error.m_error.output_message	= jpegOutputMessage;
+
+	if(setjmp(error.m_jump))
+	{
+		jpeg_destroy_decompress(&info);
+		free(lpPixel);
+		return(nullptr);
+	}
+
+	jpeg_create_decompress(&info);
+	jpeg_mem_src(&info, reinterpret_cast<unsigned char*>(const_cast<char*>(jpeg.constData())), static_cast<unsigned long>(jpeg.size()));
+	jpeg_read_header(&info, TRUE);
+
+	// let the IDCT do the downscaling, but keep at least 9x8 pixels
+	info.out_color_space		= JCS_GRAYSCALE;
+	info.scale_num				= 1;
+	info.scale_denom			= 8;
+	info.dct_method				= JDCT_IFAST;
+	info.do_fancy_upsampling	= FALSE;
+	info.do_block_smoothing		= FALSE;
+
+	while(info.scale_denom > 1 && ((info.image_width + info.scale_denom - 1) / info.scale_denom < HASH_WIDTH || (info.image_height + info.scale_denom - 1) / info.scale_denom < HASH_HEIGHT))
+		info.scale_denom	/= 2;
+
+	jpeg_start_decompress(&info);
+
+	lpPixel	= static_cast<uchar*>(malloc(static_cast<size_t>(info.output_width) * info.output_height));
+	if(!lpPixel)
+	{
+		jpeg_destroy_decompress(&info);
+		return(nullptr);
+	}
+
+	while(info.output_scanline < info.output_height)
+	{
+		JSAMPROW	lpRow	= lpPixel + static_cast<size_t>(info.output_scanline) * info.output_width;
+		jpeg_read_scanlines(&info, &lpRow, 1);
+	}
+
+	*lpWidth	= static_cast<qint32>(info.output_width);
+	*lpHeight	= static_cast<qint32>(info.output_height);
+
+	jpeg_finish_decompress(&info);
+	jpeg_destroy_decompress(&info);
+
+	return(lpPixel);
+}
+
+quint64 cPerceptualHash::dHash(const QByteArray& jpeg, bool* lpOK)
+{
+	if(lpOK)
+		*lpOK	= false;
+
+	if(jpeg.size() < 4 || static_cast<uchar>(jpeg.at(0)) != 0xFF || static_cast<uchar>(jpeg.at(1)) != 0xD8)
+		return(0);
+
+	qint32											iWidth	= 0;
+	qint32											iHeight	= 0;
+	QScopedPointer<uchar, QScopedPointerPodDeleter>	pixelList(decodeGray(jpeg, &iWidth, &iHeight));
+
+	if(!pixelList)
+		return(0);
+
+	if(iWidth < HASH_WIDTH || iHeight < HASH_HEIGHT)
+		return(0);
+
+	// area average down to 9x8: sum the rows of a cell row first (contiguous, vectorizes), then the columns
+	QVector<quint32>	columnSum(iWidth);
+	quint32				cell[HASH_HEIGHT][HASH_WIDTH];
+
+	for(int cy = 0;cy < HASH_HEIGHT;cy++)
+	{
+		qint32	y0	= cy * iHeight / HASH_HEIGHT;
+		qint32	y1	= (cy + 1) * iHeight / HASH_HEIGHT;
+
+		columnSum.fill(0);
+
+		for(int y = y0;y < y1;y++)
+		{
+			const uchar*	lpRow	= pixelList.data() + y * iWidth;
+			quint32*		lpSum	= columnSum.data();
+
+			for(int x = 0;x < iWidth;x++)
+				lpSum[x]	+= lpRow[x];
+		}
+
+		for(int cx = 0;cx < HASH_WIDTH;cx++)
+		{
+			qint32	x0		= cx * iWidth / HASH_WIDTH;
+			qint32	x1		= (cx + 1) * iWidth / HASH_WIDTH;
+			quint32	iSum	= 0;
+
+			for(int x = x0;x < x1;x++)
+				iSum	+= columnSum[x];
+
+			// fixed point average, cells differ in size by one pixel at most
+			cell[cy][cx]	= (iSum << 8) / static_cast<quint32>((x1 - x0) * (y1 - y0));
+		}
+	}
+
+	quint64	iHash	= 0;
+
+	for(int y = 0;y < HASH_HEIGHT;y++)
+	{
+		for(int x = 0;x < HASH_WIDTH - 1;x++)
+		{
+			iHash	<<= 1;
+			if(cell[y][x] > cell[y][x + 1])
+				iHash	|= 1;
+		}
+	}
+
+	if(lpOK)
+		*lpOK	= true;
+
+	return(iHash);
+}
+
+qint32 cPerceptualHash::distance(quint64 iHash1, quint64 iHash2)
+{
+	return(static_cast<qint32>(qPopulationCount(iHash1 ^ iHash2)));
+}
+
+cSimilarityIndex::cSimilarityIndex(const QString& szTempPath) :
+	m_szTempPath(szTempPath.isEmpty() ? QDir::tempPath() : szTempPath),
+	m_lpFileList(nullptr),
+	m_bFailed(false)
+{
+}
+
+cSimilarityIndex::~cSimilarityIndex()
+{
+	delete m_lpFileList;
+}
+
+void cSimilarityIndex::add(quint64 iHash, const QString& szFileName)
+{
+	if(m_bFailed)
+		return;
+
+	if(!m_lpFileList)
+	{
+		m_lpFileList	= new QTemporaryFile(m_szTempPath + QDir::separator() + "qtEXIF2File-similar-XXXXXX.lst");
+
+		if(!m_lpFileList->open())
+		{
+			qDebug() << "can't create the similarity file list in" << m_szTempPath;
+			m_bFailed	= true;
+			return;
+		}
+		m_fileStream.setDevice(m_lpFileList);
+	}
+
+	// UTF-8 with a length prefix, a name may contain line breaks
+	m_fileStream << szFileName.toUtf8();
+	if(m_fileStream.status() != QDataStream::Ok)
+	{
+		qDebug() << "can't write the similarity file list" << m_lpFileList->fileName();
+		m_bFailed	= true;
+		return;
+	}
+
+	m_hashList.append(iHash);
+}
+
+qint32 cSimilarityIndex::cluster(qint32 iMaxDistance)
+{
+	m_clusterList.clear();
+
+	// merge identical hashes, only the distinct ones go into the index
+	QVector<qint32>		orderList(m_hashList.count());
+
+	for(int x = 0;x < orderList.count();x++)
+		orderList[x]	= x;
+
+	std::sort(orderList.begin(), orderList.end(), [this](qint32 i1, qint32 i2) { return(m_hashList.at(i1) < m_hashList.at(i2)); });
+
+	QVector<quint64>	distinctList;
+	QVector<qint32>		fileDistinctList(m_hashList.count());
+
+	for(int x = 0;x < orderList.count();x++)
+	{
+		quint64	iHash	= m_hashList.at(orderList.at(x));
+
+		if(distinctList.isEmpty() || distinctList.last() != iHash)
+			distinctList.append(iHash);
+		fileDistinctList[orderList.at(x)]	= distinctList.count() - 1;
+	}
+	orderList.clear();
+
+	qint32				iDistinct	= distinctList.count();
+	QVector<qint32>		parentList(iDistinct);
+
+	for(int x = 0;x < iDistinct;x++)
+		parentList[x]	= x;
+
+	// all chunk variants within the per chunk radius
+	qint32				iChunkRadius	= iMaxDistance / CHUNK_COUNT;
+	QVector<quint32>	maskList;
+
+	for(quint32 iMask = 0;iMask < (1u << CHUNK_BITS);iMask++)
+	{
+		if(static_cast<qint32>(qPopulationCount(iMask)) <= iChunkRadius)
+			maskList.append(iMask);
+	}
+
+	for(int iChunk = 0;iChunk < CHUNK_COUNT && iMaxDistance > 0;iChunk++)
+	{
+		QVector<qint32>	offsetList((1 << CHUNK_BITS) + 1, 0);
+		QVector<qint32>	idList(iDistinct);
+
+		for(int x = 0;x < iDistinct;x++)
+			offsetList[chunk(distinctList.at(x), iChunk) + 1]++;
+		for(int x = 1;x < offsetList.count();x++)
+			offsetList[x]	+= offsetList[x - 1];
+
+		QVector<qint32>	cursorList(offsetList);
+
+		for(int x = 0;x < iDistinct;x++)
+			idList[cursorList[chunk(distinctList.at(x), iChunk)]++]	= x;
+		cursorList.clear();
+
+		for(int x = 0;x < iDistinct;x++)
+		{
+			quint64	iHash	= distinctList.at(x);
+			quint32	iValue	= chunk(iHash, iChunk);
+
+			for(int m = 0;m < maskList.count();m++)
+			{
+				quint32	iBucket	= iValue ^ maskList.at(m);
+
+				for(int k = offsetList.at(iBucket);k < offsetList.at(iBucket + 1);k++)
+				{
+					qint32	y	= idList.at(k);
+
+					if(y <= x)
+						continue;
+
+					if(cPerceptualHash::distance(iHash, distinctList.at(y)) <= iMaxDistance)
+					{
+						qint32	iRoot1	= findRoot(parentList, x);
+						qint32	iRoot2	= findRoot(parentList, y);
+
+						if(iRoot1 != iRoot2)
+							parentList[iRoot2]	= iRoot1;
+					}
+				}
+			}
+		}
+	}
+
+	// singletons are the common case, only build lists for roots with more than one file
+	QVector<qint32>	rootCountList(iDistinct, 0);
+	QVector<qint32>	clusterIndexList(iDistinct, -1);
+
+	for(int x = 0;x < m_hashList.count();x++)
+	{
+		fileDistinctList[x]	= findRoot(parentList, fileDistinctList.at(x));
+		rootCountList[fileDistinctList.at(x)]++;
+	}
+
+	for(int x = 0;x < m_hashList.count();x++)
+	{
+		qint32	iRoot	= fileDistinctList.at(x);
+
+		if(rootCountList.at(iRoot) < 2)
+			continue;
+
+		if(clusterIndexList.at(iRoot) < 0)
+		{
+			clusterIndexList[iRoot]	= m_clusterList.count();
+			m_clusterList.append(QVector<qint32>());
+		}
+		m_clusterList[clusterIndexList.at(iRoot)].append(x);
+	}
+
+	return(m_clusterList.count());
+}
+
+bool cSimilarityIndex::writeReport(const QString& szFileName)
+{
+	if(m_bFailed)
+		return(false);
+
+	// only the names of the files in a cluster are read back
+	QBitArray				wantedList(m_hashList.count());
+	QHash<qint32, QString>	fileList;
+
+	for(int x = 0;x < m_clusterList.count();x++)
+	{
+		const QVector<qint32>&	cluster	= m_clusterList.at(x);
+
+		for(int y = 0;y < cluster.count();y++)
+			wantedList.setBit(cluster.at(y));
+	}
+
+	if(m_lpFileList && !m_clusterList.isEmpty())
+	{
+		if(!m_lpFileList->flush() || !m_lpFileList->seek(0))
+			return(false);
+
+		QDataStream	in(m_lpFileList);
+		QByteArray	name;
+
+		for(int x = 0;x < m_hashList.count();x++)
+		{
+			in >> name;
+			if(in.status() != QDataStream::Ok)
+			{
+				qDebug() << "can't read the similarity file list" << m_lpFileList->fileName();
+				return(false);
+			}
+
+			if(wantedList.testBit(x))
+				fileList.insert(x, QString::fromUtf8(name));
+		}
+	}
+
+	QFile	file(szFileName);
+
+	if(!file.open(QFile::WriteOnly | QFile::Truncate))
+		return(false);
+
+	QTextStream	out(&file);
+
+	out << "cluster" << "\t" << "phash" << "\t" << "distance" << "\t" << "file" << "\n";
+
+	for(int x = 0;x < m_clusterList.count();x++)
+	{
+		const QVector<qint32>&	cluster	= m_clusterList.at(x);
+		quint64					iFirst	= m_hashList.at(cluster.first());
+
+		for(int y = 0;y < cluster.count();y++)
+		{
+			quint64	iHash	= m_hashList.at(cluster.at(y));
+
+			out << x + 1 << "\t" << QString("%1").arg(iHash, 16, 16, QChar('0')) << "\t" << cPerceptualHash::distance(iFirst, iHash) << "\t" << fileList.value(cluster.at(y)) << "\n";
+		}
+	}
+
+	file.close();
+	return(true);
+}
@@ -0,0 +1,112 @@
+/*!
+ \file cperceptualhash.h
+
+*/
+
+#ifndef CPERCEPTUALHASH_H
+#define CPERCEPTUALHASH_H
+
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QList>
+#include <QTemporaryFile>
+#include <QDataStream>
+
+
+/*!
+ \brief 64 bit difference hash (dHash) of an embedded JPEG preview.
+
+ The preview is decoded to grayscale with libjpeg's DCT domain scaling, so
+ only 1/8 (or less) of the pixels are ever reconstructed, then reduced to
+ 9x8 by area averaging. Each bit tells whether a pixel is brighter than its
+ right neighbour.
+
+ \class cPerceptualHash cperceptualhash.h "cperceptualhash.h"
+*/
+class cPerceptualHash
+{
+public:
+	/*!
+	 \brief
+
+	 \fn dHash
+	 \param jpeg
+	 \param lpOK
+	 \return quint64
+	*/
+	static quint64		dHash(const QByteArray& jpeg, bool* lpOK = nullptr);
+	/*!
+	 \brief
+
+	 \fn distance
+	 \param iHash1
+	 \param iHash2
+	 \return qint32
+	*/
+	static qint32		distance(quint64 iHash1, quint64 iHash2);
+};
+
+/*!
+ \brief Clusters perceptual hashes within a hamming distance.
+
+ Uses multi-index hashing: the hash is split into four 16 bit chunks and
+ every chunk gets a bucket table (a counting sorted id array plus 65537
+ offsets). Two hashes within distance d agree up to d/4 bits in at least one
+ chunk, so only those buckets are probed. Identical hashes are merged before
+ indexing. Memory is about 30 bytes per distinct hash.
+
+ The file names are not kept in memory: add() spills them to a temporary
+ file in the order of the hashes, so the row of a hash is its id, and
+ writeReport() reads back only the names of files in a cluster.
+
+ \class cSimilarityIndex cperceptualhash.h "cperceptualhash.h"
+*/
+class cSimilarityIndex
+{
+public:
+	/*!
+	 \brief
+
+	 \fn cSimilarityIndex
+	 \param szTempPath directory for the file name list, the system temp directory if empty
+	*/
+	cSimilarityIndex(const QString& szTempPath = QString());
+	~cSimilarityIndex();
+
+	/*!
+	 \brief
+
+	 \fn add
+	 \param iHash
+	 \param szFileName
+	*/
+	void						add(quint64 iHash, const QString& szFileName);
+	/*!
+	 \brief Builds the clusters of files with at most iMaxDistance differing bits.
+
+	 \fn cluster
+	 \param iMaxDistance
+	 \return qint32 number of clusters with more than one file
+	*/
+	qint32						cluster(qint32 iMaxDistance);
+	/*!
+	 \brief
+
+	 \fn writeReport
+	 \param szFileName
+	 \return bool false if the report can't be written or the file name list could not be spilled or read back
+	*/
+	bool						writeReport(const QString& szFileName);
+
+private:
+	QString						m_szTempPath;				/*!< directory for the file name list */
+	QVector<quint64>			m_hashList;					/*!< hash per file, the index is the row in m_lpFileList */
+	QTemporaryFile*				m_lpFileList;				/*!< file names in the order of m_hashList, created by the first add() */
+	QDataStream					m_fileStream;				/*!< writes m_lpFileList */
+	bool						m_bFailed;					/*!< the file name list could not be written */
+	QList<QVector<qint32> >		m_clusterList;				/*!< indices into m_hashList per cluster */
+};
+
+#endif // CPERCEPTUALHASH_H
@@ -7,6 +7,7 @@
 #include "cpicture.h"
 
 #include <QFileInfo>
+#include <QDataStream>
 
 
 cPicture::cPicture(QObject *parent) :
@@ -25,23 +26,89 @@ cPicture::cPicture(QObject *parent) :
 	m_focalLength(0.0),
 	m_lensMake(""),
 	m_lensModel(""),
+	m_shutterCount(0),
 	m_exposureTime(""),
 	m_exposureBias(0),
 	m_exifVersion(""),
 	m_whiteBalance(0),
 	m_focalLength35(0.0),
-	m_gps("")
+	m_gps(""),
+	m_bGPSPosition(false),
+	m_latitude(0),
+	m_longitude(0),
+	m_bAltitude(false),
+	m_altitude(0),
+	m_bTimestamp(false),
+	m_timestamp(0),
+	m_bUTCOffset(false),
+	m_utcOffset(0),
+	m_bGPSTimestamp(false),
+	m_gpsTimestamp(0),
+	m_bReadPreview(false),
+	m_previewWidth(0),
+	m_previewHeight(0),
+	m_thumbnailID(0),
+	m_perceptualHash(0),
+	m_bPerceptualHash(false)
 {
 }
 
 bool cPicture::fromFile(const QString& szFileName)
 {
 	cEXIF		exif;
-	QFileInfo	fileInfo(szFileName);
 
+	exif.setReadPreview(m_bReadPreview);
+
+	return(fromFile(szFileName, exif));
+}
+
+bool cPicture::fromFile(const QString& szFileName, cEXIF& exif)
+{
 	if(!exif.fromFile(szFileName))
 		return(false);
 
+	setEXIF(szFileName, exif);
+	return(true);
+}
+
+bool cPicture::fromBuffer(const QString& szFileName, const QByteArray& buffer, qint64 iFileSize, cEXIF& exif)
+{
+	if(!exif.fromBuffer(szFileName, buffer, iFileSize))
+		return(false);
+
+	setEXIF(szFileName, exif);
+	return(true);
+}
+
+void cPicture::fromEXIF(const QString& szFileName, cEXIF& exif)
+{
+	setEXIF(szFileName, exif);
+}
+
+QList<cPicture*> cPicture::fromFiles(const QStringList& fileList, cEXIF& exif)
+{
+	QList<cPicture*>	pictureList;
+
+	for(int x = 0;x < fileList.count();x++)
+		pictureList.append(nullptr);
+
+	exif.fromFiles(fileList, [&pictureList, &fileList](qint32 iIndex, bool bOK, cEXIF& exif) {
+		if(!bOK)
+			return;
+
+		cPicture*	lpPicture	= new cPicture;
+
+		lpPicture->setEXIF(fileList[iIndex], exif);
+		pictureList[iIndex]	= lpPicture;
+	});
+
+	return(pictureList);
+}
+
+void cPicture::setEXIF(const QString& szFileName, cEXIF& exif)
+{
+	QFileInfo	fileInfo(szFileName);
+
 	m_szFileName			= fileInfo.fileName();
 	m_szFilePath			= fileInfo.absolutePath();
 	m_iFileSize				= fileInfo.size();
@@ -58,6 +125,7 @@ bool cPicture::fromFile(const QString& szFileName)
 	m_focalLength			= exif.focalLength();
 	m_lensMake				= exif.lensMake();
 	m_lensModel				= exif.lensModel();
+	m_shutterCount			= exif.shutterCount();
 	m_exposureTime			= exif.exposureTime();
 	m_exposureBias			= exif.exposureBias();
 	m_exifVersion			= exif.exifVersion();
@@ -66,8 +134,46 @@ bool cPicture::fromFile(const QString& szFileName)
 	m_whiteBalance			= exif.whiteBalance();
 	m_focalLength35			= exif.focalLength35();
 	m_gps					= exif.gps();
-
-	return(true);
+	m_bGPSPosition			= exif.hasGPS();
+	m_latitude				= exif.gpsLatitude();
+	m_longitude				= exif.gpsLongitude();
+	m_bAltitude				= exif.hasGPSAltitude();
+	m_altitude				= exif.gpsAltitude();
+	m_bTimestamp			= exif.hasTimestamp();
+	m_timestamp				= exif.timestamp();
+	m_bUTCOffset			= exif.hasUTCOffset();
+	m_utcOffset				= exif.utcOffset();
+	m_bGPSTimestamp			= exif.hasGPSTimestamp();
+	m_gpsTimestamp			= exif.gpsTimestamp();
+	m_preview				= exif.previewData();
+	m_previewWidth			= exif.previewWidth();
+	m_previewHeight			= exif.previewHeight();
+	m_xmpValues				= exif.xmpValues();
+	m_iptcValues			= exif.iptcValues();
+}
+
+void cPicture::save(QDataStream& stream)
+{
+	stream << m_szFileName << m_szFilePath << m_iFileSize << m_imageWidth << m_imageHeight << m_imageOrientation;
+	stream << m_cameraMake << m_cameraModel << m_dateTime << m_fNumber << m_iso << m_flash << m_flashID << m_focalLength;
+	stream << m_lensMake << m_lensModel << m_shutterCount << m_exposureTime << m_exposureBias << m_exifVersion;
+	stream << m_dateTimeOriginal << m_dateTimeDigitized << m_whiteBalance << m_focalLength35 << m_gps;
+	stream << m_bGPSPosition << m_latitude << m_longitude << m_bAltitude << m_altitude;
+	stream << m_bTimestamp << m_timestamp << m_bUTCOffset << m_utcOffset << m_bGPSTimestamp << m_gpsTimestamp;
+	stream << m_preview << m_previewWidth << m_previewHeight << m_xmpValues << m_iptcValues;
+}
+
+bool cPicture::load(QDataStream& stream)
+{
+	stream >> m_szFileName >> m_szFilePath >> m_iFileSize >> m_imageWidth >> m_imageHeight >> m_imageOrientation;
+	stream >> m_cameraMake >> m_cameraModel >> m_dateTime >> m_fNumber >> m_iso >> m_flash >> m_flashID >> m_focalLength;
+	stream >> m_lensMake >> m_lensModel >> m_shutterCount >> m_exposureTime >> m_exposureBias >> m_exifVersion;
+	stream >> m_dateTimeOriginal >> m_dateTimeDigitized >> m_whiteBalance >> m_focalLength35 >> m_gps;
+	stream >> m_bGPSPosition >> m_latitude >> m_longitude >> m_bAltitude >> m_altitude;
+	stream >> m_bTimestamp >> m_timestamp >> m_bUTCOffset >> m_utcOffset >> m_bGPSTimestamp >> m_gpsTimestamp;
+	stream >> m_preview >> m_previewWidth >> m_previewHeight >> m_xmpValues >> m_iptcValues;
+
+	return(stream.status() == QDataStream::Ok);
 }
 
 void cPicture::setImageWidth(const qint32& imageWidth)
@@ -200,6 +306,16 @@ QString cPicture::lensModel()
 	return(m_lensModel);
 }
 
+void cPicture::setShutterCount(const qint32& shutterCount)
+{
+	m_shutterCount	= shutterCount;
+}
+
+qint32 cPicture::shutterCount()
+{
+	return(m_shutterCount);
+}
+
 void cPicture::setExposureTime(const QString& exposureTime)
 {
 	m_exposureTime	= exposureTime;
@@ -280,6 +396,92 @@ QString cPicture::gps()
 	return(m_gps);
 }
 
+void cPicture::setGPSPosition(const double& latitude, const double& longitude)
+{
+	m_latitude		= latitude;
+	m_longitude		= longitude;
+	m_bGPSPosition	= true;
+}
+
+bool cPicture::hasGPSPosition()
+{
+	return(m_bGPSPosition);
+}
+
+double cPicture::latitude()
+{
+	return(m_latitude);
+}
+
+double cPicture::longitude()
+{
+	return(m_longitude);
+}
+
+void cPicture::setAltitude(const double& altitude)
+{
+	m_altitude	= altitude;
+	m_bAltitude	= true;
+}
+
+bool cPicture::hasAltitude()
+{
+	return(m_bAltitude);
+}
+
+double cPicture::altitude()
+{
+	return(m_altitude);
+}
+
+void cPicture::setTimestamp(const qint64& timestamp)
+{
+	m_timestamp	= timestamp;
+	m_bTimestamp	= true;
+}
+
+bool cPicture::hasTimestamp()
+{
+	return(m_bTimestamp);
+}
+
+qint64 cPicture::timestamp()
+{
+	return(m_timestamp);
+}
+
+void cPicture::setUTCOffset(const qint32& utcOffset)
+{
+	m_utcOffset	= utcOffset;
+	m_bUTCOffset	= true;
+}
+
+bool cPicture::hasUTCOffset()
+{
+	return(m_bUTCOffset);
+}
+
+qint32 cPicture::utcOffset()
+{
+	return(m_utcOffset);
+}
+
+void cPicture::setGPSTimestamp(const qint64& gpsTimestamp)
+{
+	m_gpsTimestamp	= gpsTimestamp;
+	m_bGPSTimestamp	= true;
+}
+
+bool cPicture::hasGPSTimestamp()
+{
+	return(m_bGPSTimestamp);
+}
+
+qint64 cPicture::gpsTimestamp()
+{
+	return(m_gpsTimestamp);
+}
+
 void cPicture::setFileName(const QString& fileName)
 {
 	m_szFileName	= fileName;
@@ -309,3 +511,76 @@ qint64 cPicture::fileSize()
 {
 	return(m_iFileSize);
 }
+
+void cPicture::setReadPreview(bool bReadPreview)
+{
+	m_bReadPreview	= bReadPreview;
+}
+
+void cPicture::setPreview(const QByteArray& preview, const qint32& previewWidth, const qint32& previewHeight)
+{
+	m_preview		= preview;
+	m_previewWidth	= previewWidth;
+	m_previewHeight	= previewHeight;
+}
+
+QByteArray cPicture::preview()
+{
+	return(m_preview);
+}
+
+qint32 cPicture::previewWidth()
+{
+	return(m_previewWidth);
+}
+
+qint32 cPicture::previewHeight()
+{
+	return(m_previewHeight);
+}
+
+QStringList cPicture::xmpValues()
+{
+	return(m_xmpValues);
+}
+
+QStringList cPicture::iptcValues()
+{
+	return(m_iptcValues);
+}
+
+void cPicture::setThumbnailID(const quint64& thumbnailID)
+{
+	m_thumbnailID	= thumbnailID;
+}
+
+quint64 cPicture::thumbnailID()
+{
+	return(m_thumbnailID);
+}
+
+void cPicture::setContentHash(const QString& contentHash)
+{
+	m_contentHash	= contentHash;
+}
+
+QString cPicture::contentHash()
+{
+	return(m_contentHash);
+}
+
+void cPicture::setPerceptualHash(const quint64& perceptualHash)
+{
+	m_perceptualHash	= perceptualHash;
+	m_bPerceptualHash	= true;
+}
+
+quint64 cPicture::perceptualHash()
+{
+	return(m_perceptualHash);
+}
+
+bool cPicture::hasPerceptualHash()
+{
+	return(m_bPerceptualHash);
+}
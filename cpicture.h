@@ -9,11 +9,16 @@
 
 #include <QObject>
 #include <QList>
+#include <QStringList>
 #include <QDateTime>
+#include <QByteArray>
 
 #include <QMetaType>
 
 
+class cEXIF;
+class QDataStream;
+
 /*!
  \brief
 
@@ -39,6 +44,58 @@ public:
 	 \return bool
 	*/
 	bool					fromFile(const QString& szFileName);
+	/*!
+	 \brief Reads the picture with a cEXIF configured by the caller.
+
+	 \fn fromFile
+	 \param szFileName
+	 \param exif
+	 \return bool
+	*/
+	bool					fromFile(const QString& szFileName, cEXIF& exif);
+	/*!
+	 \brief Reads the picture from a prefix of the file read by the caller, see cEXIF::fromBuffer().
+
+	 \fn fromBuffer
+	 \param szFileName
+	 \param buffer
+	 \param iFileSize
+	 \param exif
+	 \return bool
+	*/
+	bool					fromBuffer(const QString& szFileName, const QByteArray& buffer, qint64 iFileSize, cEXIF& exif);
+	/*!
+	 \brief Takes the values of the file exif has just read, e.g. in a cEXIF::fromFiles() callback.
+
+	 \fn fromEXIF
+	 \param szFileName
+	 \param exif
+	*/
+	void					fromEXIF(const QString& szFileName, cEXIF& exif);
+	/*!
+	 \brief Reads a batch of pictures with one cEXIF, see cEXIF::fromFiles().
+
+	 \fn fromFiles
+	 \param fileList
+	 \param exif
+	 \return QList<cPicture *> one entry per file, nullptr if the file could not be read. The caller deletes the pictures.
+	*/
+	static QList<cPicture*>	fromFiles(const QStringList& fileList, cEXIF& exif);
+	/*!
+	 \brief Writes the values read from the file, e.g. to pass a picture read by another process.
+
+	 \fn save
+	 \param stream
+	*/
+	void					save(QDataStream& stream);
+	/*!
+	 \brief Reads the values written by save().
+
+	 \fn load
+	 \param stream
+	 \return bool false if the stream is incomplete
+	*/
+	bool					load(QDataStream& stream);
 
 	/*!
 	 \brief
@@ -235,6 +292,21 @@ public:
 	*/
 	QString					lensModel();
 
+	/*!
+	 \brief
+
+	 \fn setShutterCount
+	 \param shutterCount
+	*/
+	void					setShutterCount(const qint32& shutterCount);
+	/*!
+	 \brief Shutter releases from the maker note, see cEXIF::shutterCount().
+
+	 \fn shutterCount
+	 \return qint32
+	*/
+	qint32					shutterCount();
+
 	/*!
 	 \brief
 
@@ -354,6 +426,119 @@ public:
 	 \return QString
 	*/
 	QString					gps();
+	/*!
+	 \brief
+
+	 \fn setGPSPosition
+	 \param latitude decimal degrees
+	 \param longitude decimal degrees
+	*/
+	void					setGPSPosition(const double& latitude, const double& longitude);
+	/*!
+	 \brief
+
+	 \fn hasGPSPosition
+	 \return bool
+	*/
+	bool					hasGPSPosition();
+	/*!
+	 \brief
+
+	 \fn latitude
+	 \return double
+	*/
+	double					latitude();
+	/*!
+	 \brief
+
+	 \fn longitude
+	 \return double
+	*/
+	double					longitude();
+	/*!
+	 \brief
+
+	 \fn setAltitude
+	 \param altitude meters
+	*/
+	void					setAltitude(const double& altitude);
+	/*!
+	 \brief
+
+	 \fn hasAltitude
+	 \return bool
+	*/
+	bool					hasAltitude();
+	/*!
+	 \brief
+
+	 \fn altitude
+	 \return double
+	*/
+	double					altitude();
+	/*!
+	 \brief
+
+	 \fn setTimestamp
+	 \param timestamp UTC nanoseconds since the epoch
+	*/
+	void					setTimestamp(const qint64& timestamp);
+	/*!
+	 \brief
+
+	 \fn hasTimestamp
+	 \return bool
+	*/
+	bool					hasTimestamp();
+	/*!
+	 \brief
+
+	 \fn timestamp
+	 \return qint64
+	*/
+	qint64					timestamp();
+	/*!
+	 \brief
+
+	 \fn setUTCOffset
+	 \param utcOffset seconds east of UTC
+	*/
+	void					setUTCOffset(const qint32& utcOffset);
+	/*!
+	 \brief
+
+	 \fn hasUTCOffset
+	 \return bool
+	*/
+	bool					hasUTCOffset();
+	/*!
+	 \brief
+
+	 \fn utcOffset
+	 \return qint32
+	*/
+	qint32					utcOffset();
+	/*!
+	 \brief
+
+	 \fn setGPSTimestamp
+	 \param gpsTimestamp UTC nanoseconds since the epoch
+	*/
+	void					setGPSTimestamp(const qint64& gpsTimestamp);
+	/*!
+	 \brief
+
+	 \fn hasGPSTimestamp
+	 \return bool
+	*/
+	bool					hasGPSTimestamp();
+	/*!
+	 \brief
+
+	 \fn gpsTimestamp
+	 \return qint64
+	*/
+	qint64					gpsTimestamp();
 
 	/*!
 	 \brief
@@ -415,6 +600,112 @@ public:
 	*/
 	QImage					thumbnail();
 
+	/*!
+	 \brief Makes fromFile() keep the smallest embedded preview image.
+
+	 \fn setReadPreview
+	 \param bReadPreview
+	*/
+	void					setReadPreview(bool bReadPreview);
+
+	/*!
+	 \brief
+
+	 \fn setPreview
+	 \param preview
+	 \param previewWidth
+	 \param previewHeight
+	*/
+	void					setPreview(const QByteArray& preview, const qint32& previewWidth, const qint32& previewHeight);
+	/*!
+	 \brief Encoded bytes of the embedded preview image, empty if none was read.
+
+	 \fn preview
+	 \return QByteArray
+	*/
+	QByteArray				preview();
+	/*!
+	 \brief
+
+	 \fn previewWidth
+	 \return qint32
+	*/
+	qint32					previewWidth();
+	/*!
+	 \brief
+
+	 \fn previewHeight
+	 \return qint32
+	*/
+	qint32					previewHeight();
+
+	/*!
+	 \brief Values of the XMP properties, see cEXIF::xmpValues().
+
+	 \fn xmpValues
+	 \return QStringList
+	*/
+	QStringList				xmpValues();
+	/*!
+	 \brief Values of the IPTC datasets, see cEXIF::iptcValues().
+
+	 \fn iptcValues
+	 \return QStringList
+	*/
+	QStringList				iptcValues();
+
+	/*!
+	 \brief
+
+	 \fn setThumbnailID
+	 \param thumbnailID
+	*/
+	void					setThumbnailID(const quint64& thumbnailID);
+	/*!
+	 \brief Key of the preview in the thumbnail pack, 0 if it was not packed.
+
+	 \fn thumbnailID
+	 \return quint64
+	*/
+	quint64					thumbnailID();
+
+	/*!
+	 \brief
+
+	 \fn setContentHash
+	 \param contentHash
+	*/
+	void					setContentHash(const QString& contentHash);
+	/*!
+	 \brief Hash of the file content, empty if the file was not hashed.
+
+	 \fn contentHash
+	 \return QString
+	*/
+	QString					contentHash();
+
+	/*!
+	 \brief
+
+	 \fn setPerceptualHash
+	 \param perceptualHash
+	*/
+	void					setPerceptualHash(const quint64& perceptualHash);
+	/*!
+	 \brief dHash of the embedded preview.
+
+	 \fn perceptualHash
+	 \return quint64
+	*/
+	quint64					perceptualHash();
+	/*!
+	 \brief
+
+	 \fn hasPerceptualHash
+	 \return bool
+	*/
+	bool					hasPerceptualHash();
+
 signals:
 
 public slots:
@@ -436,6 +727,7 @@ private:
 	qreal					m_focalLength;			/*!< TODO: describe */
 	QString					m_lensMake;				/*!< TODO: describe */
 	QString					m_lensModel;			/*!< TODO: describe */
+	qint32					m_shutterCount;			/*!< shutter releases, 0 if not known */
 	QString					m_exposureTime;			/*!< TODO: describe */
 	qint32					m_exposureBias;			/*!< TODO: describe */
 	QString					m_exifVersion;			/*!< TODO: describe */
@@ -444,6 +736,36 @@ private:
 	qint32					m_whiteBalance;			/*!< TODO: describe */
 	qreal					m_focalLength35;		/*!< TODO: describe */
 	QString					m_gps;					/*!< TODO: describe */
+	bool					m_bGPSPosition;			/*!< m_latitude and m_longitude are valid */
+	double					m_latitude;				/*!< latitude in decimal degrees */
+	double					m_longitude;			/*!< longitude in decimal degrees */
+	bool					m_bAltitude;			/*!< m_altitude is valid */
+	double					m_altitude;				/*!< altitude in meters */
+	bool					m_bTimestamp;			/*!< m_timestamp is valid */
+	qint64					m_timestamp;			/*!< capture time in UTC nanoseconds */
+	bool					m_bUTCOffset;			/*!< m_utcOffset is valid */
+	qint32					m_utcOffset;			/*!< offset of the camera clock in seconds */
+	bool					m_bGPSTimestamp;		/*!< m_gpsTimestamp is valid */
+	qint64					m_gpsTimestamp;			/*!< GPS time in UTC nanoseconds */
+	bool					m_bReadPreview;			/*!< extract the embedded preview in fromFile() */
+	QByteArray				m_preview;				/*!< encoded embedded preview image */
+	qint32					m_previewWidth;			/*!< width of the preview image */
+	qint32					m_previewHeight;		/*!< height of the preview image */
+	QStringList				m_xmpValues;			/*!< values of the configured XMP properties */
+	QStringList				m_iptcValues;			/*!< values of the configured IPTC datasets */
+	quint64					m_thumbnailID;			/*!< key of the preview in the thumbnail pack */
+	QString					m_contentHash;			/*!< hash of the file content */
+	quint64					m_perceptualHash;		/*!< dHash of the embedded preview */
+	bool					m_bPerceptualHash;		/*!< m_perceptualHash is valid */
+
+	/*!
+	 \brief Copies the values read by exif.
+
+	 \fn setEXIF
+	 \param szFileName
+	 \param exif
+	*/
+	void					setEXIF(const QString& szFileName, cEXIF& exif);
 };
 
 Q_DECLARE_METATYPE(cPicture*)
@@ -0,0 +1,363 @@
+/*!
+ \file cprefetcher.cpp
+
+*/
+
+#include "cprefetcher.h"
+#include "cstatistics.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QVector>
+#include <QRunnable>
+#include <QElapsedTimer>
+
+#if defined(HAVE_LIBURING)
+#include <liburing.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+#define OP_OPEN		0
+#define OP_READ		1
+
+#define MAX_DEPTH_FACTOR	4
+
+
+/*!
+ \brief Prefix of one file read by the fallback threads.
+
+ \class cPrefetchResult cprefetcher.cpp
+*/
+class cPrefetchResult
+{
+public:
+	qint32			m_iIndex;					/*!< index in the file list */
+	QByteArray		m_buffer;					/*!< first bytes of the file */
+	qint64			m_iFileSize;				/*!< size of the file, -1 on error */
+};
+
+/*!
+ \brief Completed reads of the fallback threads.
+
+ \class cPrefetchQueue cprefetcher.cpp
+*/
+class cPrefetchQueue
+{
+public:
+	QMutex						m_mutex;				/*!< protects m_resultList */
+	QWaitCondition				m_wait;					/*!< signalled when a result was added */
+	QQueue<cPrefetchResult>		m_resultList;			/*!< results not handed to the callback yet */
+};
+
+/*!
+ \brief Reads the prefix of one file with blocking I/O.
+
+ \class cPrefetchTask cprefetcher.cpp
+*/
+class cPrefetchTask : public QRunnable
+{
+public:
+	cPrefetchTask(cPrefetchQueue* lpQueue, qint32 iIndex, const QString& szFileName, qint64 iPrefixSize) :
+		m_lpQueue(lpQueue),
+		m_iIndex(iIndex),
+		m_szFileName(szFileName),
+		m_iPrefixSize(iPrefixSize)
+	{
+	}
+
+	void run()
+	{
+		cPrefetchResult	result;
+		QFile			file(m_szFileName);
+
+		result.m_iIndex		= m_iIndex;
+		result.m_iFileSize	= -1;
+
+		if(file.open(QFile::ReadOnly | QFile::Unbuffered))
+		{
+			result.m_iFileSize	= file.size();
+			result.m_buffer		= file.read(m_iPrefixSize);
+		}
+
+		QMutexLocker	locker(&m_lpQueue->m_mutex);
+
+		m_lpQueue->m_resultList.enqueue(result);
+		m_lpQueue->m_wait.wakeOne();
+	}
+
+	cPrefetchQueue*	m_lpQueue;					/*!< receives the result */
+	qint32			m_iIndex;					/*!< index in the file list */
+	QString			m_szFileName;				/*!< file to read */
+	qint64			m_iPrefixSize;				/*!< bytes to read */
+};
+
+#if defined(HAVE_LIBURING)
+/*!
+ \brief One file being read through the ring.
+
+ \class cRingSlot cprefetcher.cpp
+*/
+class cRingSlot
+{
+public:
+	qint32			m_iIndex;					/*!< index in the file list */
+	QByteArray		m_path;						/*!< encoded file name, must live until openat() completes */
+	int				m_iFD;						/*!< file descriptor after openat() */
+	qint64			m_iFileSize;				/*!< size of the file */
+	QByteArray		m_buffer;					/*!< receives the prefix */
+	qint64			m_iDone;					/*!< bytes read so far */
+};
+#endif
+
+cPrefetcher::cPrefetcher(qint32 iQueueDepth, qint64 iPrefixSize) :
+	m_iQueueDepth(iQueueDepth > 0 ? iQueueDepth : 1),
+	m_iMaxQueueDepth((iQueueDepth > 0 ? iQueueDepth : 1) * MAX_DEPTH_FACTOR),
+	m_iPrefixSize(iPrefixSize),
+	m_lpRing(nullptr),
+	m_lpStatistics(nullptr)
+{
+#if defined(HAVE_LIBURING)
+	m_lpRing	= new struct io_uring;
+
+	if(io_uring_queue_init(static_cast<unsigned>(m_iMaxQueueDepth * 2), m_lpRing, 0) < 0)
+	{
+		delete m_lpRing;
+		m_lpRing	= nullptr;
+	}
+	else
+	{
+		// IORING_OP_OPENAT and IORING_OP_READ need Linux 5.6
+		struct io_uring_probe*	lpProbe		= io_uring_get_probe_ring(m_lpRing);
+		bool					bSupported	= lpProbe && io_uring_opcode_supported(lpProbe, IORING_OP_OPENAT) && io_uring_opcode_supported(lpProbe, IORING_OP_READ);
+
+		if(lpProbe)
+			io_uring_free_probe(lpProbe);
+
+		if(!bSupported)
+		{
+			io_uring_queue_exit(m_lpRing);
+			delete m_lpRing;
+			m_lpRing	= nullptr;
+		}
+	}
+#endif
+
+	// threads are only started for the files in flight
+	if(!m_lpRing)
+		m_threadPool.setMaxThreadCount(m_iMaxQueueDepth);
+}
+
+cPrefetcher::~cPrefetcher()
+{
+	m_threadPool.waitForDone();
+
+#if defined(HAVE_LIBURING)
+	if(m_lpRing)
+	{
+		io_uring_queue_exit(m_lpRing);
+		delete m_lpRing;
+	}
+#endif
+}
+
+void cPrefetcher::setStatistics(cStatistics* lpStatistics)
+{
+	m_lpStatistics	= lpStatistics;
+}
+
+qint32 cPrefetcher::queueDepth()
+{
+	return(m_iQueueDepth.loadAcquire());
+}
+
+void cPrefetcher::setQueueDepth(qint32 iQueueDepth)
+{
+	m_iQueueDepth.storeRelease(qBound(1, iQueueDepth, m_iMaxQueueDepth));
+}
+
+qint32 cPrefetcher::maxQueueDepth()
+{
+	return(m_iMaxQueueDepth);
+}
+
+bool cPrefetcher::isAsync()
+{
+	return(m_lpRing != nullptr);
+}
+
+void cPrefetcher::read(const QFileInfoList& fileList, const cCallback& callback)
+{
+	QElapsedTimer	timer;
+
+	timer.start();
+
+	if(m_lpRing)
+		readRing(fileList, callback);
+	else
+		readThreads(fileList, callback);
+
+	if(m_lpStatistics)
+	{
+		m_lpStatistics->addTime(m_lpRing ? "prefetch/io_uring" : "prefetch/threads", timer.nsecsElapsed());
+		m_lpStatistics->addCount("prefetch/files", fileList.count());
+	}
+}
+
+void cPrefetcher::readRing(const QFileInfoList& fileList, const cCallback& callback)
+{
+#if defined(HAVE_LIBURING)
+	QVector<cRingSlot>	slotList(m_iMaxQueueDepth);
+	QVector<qint32>		freeList;
+	qint32				iNext		= 0;
+	qint32				iInFlight	= 0;
+
+	for(int x = m_iMaxQueueDepth - 1;x >= 0;x--)
+		freeList.append(x);
+
+	auto	submitRead	= [this](cRingSlot& slot, qint32 iSlot) {
+		struct io_uring_sqe*	lpSQE	= io_uring_get_sqe(m_lpRing);
+
+		io_uring_prep_read(lpSQE, slot.m_iFD, slot.m_buffer.data() + slot.m_iDone, static_cast<unsigned>(slot.m_buffer.size() - slot.m_iDone), static_cast<quint64>(slot.m_iDone));
+		io_uring_sqe_set_data(lpSQE, reinterpret_cast<void*>(static_cast<quintptr>(iSlot * 2 + OP_READ)));
+	};
+
+	while(iNext < fileList.count() || iInFlight)
+	{
+		// keep the queue full, a lowered depth takes effect as the reads complete
+		while(iNext < fileList.count() && !freeList.isEmpty() && iInFlight < m_iQueueDepth.loadAcquire())
+		{
+			qint32					iSlot	= freeList.takeLast();
+			cRingSlot&				slot	= slotList[iSlot];
+			struct io_uring_sqe*	lpSQE	= io_uring_get_sqe(m_lpRing);
+
+			slot.m_iIndex		= iNext;
+			slot.m_path			= QFile::encodeName(fileList[iNext].filePath());
+			slot.m_iFD			= -1;
+			slot.m_iFileSize	= fileList[iNext].size();
+			slot.m_iDone		= 0;
+
+			io_uring_prep_openat(lpSQE, AT_FDCWD, slot.m_path.constData(), O_RDONLY | O_CLOEXEC, 0);
+			io_uring_sqe_set_data(lpSQE, reinterpret_cast<void*>(static_cast<quintptr>(iSlot * 2 + OP_OPEN)));
+
+			iNext++;
+			iInFlight++;
+		}
+
+		io_uring_submit(m_lpRing);
+
+		struct io_uring_cqe*	lpCQE;
+
+		if(io_uring_wait_cqe(m_lpRing, &lpCQE) < 0)
+			continue;
+
+		do
+		{
+			quint64		iData	= static_cast<quint64>(reinterpret_cast<quintptr>(io_uring_cqe_get_data(lpCQE)));
+			qint32		iSlot	= static_cast<qint32>(iData / 2);
+			qint32		iResult	= lpCQE->res;
+			cRingSlot&	slot	= slotList[iSlot];
+			bool		bDone	= false;
+			bool		bOK		= false;
+
+			io_uring_cqe_seen(m_lpRing, lpCQE);
+
+			if(iData % 2 == OP_OPEN)
+			{
+				if(iResult < 0)
+					bDone	= true;
+				else
+				{
+					slot.m_iFD	= iResult;
+					slot.m_buffer.resize(static_cast<int>(qMin(m_iPrefixSize, slot.m_iFileSize)));
+
+					if(slot.m_buffer.isEmpty())
+						bDone	= bOK	= true;
+					else
+						submitRead(slot, iSlot);
+				}
+			}
+			else
+			{
+				if(iResult < 0)
+					bDone	= true;
+				else
+				{
+					slot.m_iDone	+= iResult;
+
+					// short read: continue where it stopped until EOF
+					if(iResult > 0 && slot.m_iDone < slot.m_buffer.size())
+						submitRead(slot, iSlot);
+					else
+						bDone	= bOK	= true;
+				}
+			}
+
+			if(bDone)
+			{
+				if(slot.m_iFD >= 0)
+					::close(slot.m_iFD);
+
+				QByteArray	buffer;
+
+				if(bOK)
+				{
+					slot.m_buffer.resize(static_cast<int>(slot.m_iDone));
+					buffer	= slot.m_buffer;
+					if(m_lpStatistics)
+						m_lpStatistics->addCount("prefetch/bytes", slot.m_iDone);
+				}
+
+				slot.m_buffer	= QByteArray();
+				freeList.append(iSlot);
+				iInFlight--;
+
+				callback(slot.m_iIndex, buffer, bOK ? slot.m_iFileSize : -1);
+			}
+		}
+		while(io_uring_peek_cqe(m_lpRing, &lpCQE) == 0);
+	}
+#else
+	readThreads(fileList, callback);
+#endif
+}
+
+void cPrefetcher::readThreads(const QFileInfoList& fileList, const cCallback& callback)
+{
+	cPrefetchQueue	queue;
+	qint32			iNext		= 0;
+	qint32			iPending	= 0;
+
+	while(iNext < fileList.count() || iPending)
+	{
+		while(iNext < fileList.count() && iPending < m_iQueueDepth.loadAcquire())
+		{
+			m_threadPool.start(new cPrefetchTask(&queue, iNext, fileList[iNext].filePath(), m_iPrefixSize));
+			iNext++;
+			iPending++;
+		}
+
+		QQueue<cPrefetchResult>	resultList;
+
+		queue.m_mutex.lock();
+		while(queue.m_resultList.isEmpty())
+			queue.m_wait.wait(&queue.m_mutex);
+		resultList.swap(queue.m_resultList);
+		queue.m_mutex.unlock();
+
+		while(!resultList.isEmpty())
+		{
+			cPrefetchResult	result	= resultList.dequeue();
+
+			iPending--;
+			if(m_lpStatistics)
+				m_lpStatistics->addCount("prefetch/bytes", result.m_buffer.size());
+
+			callback(result.m_iIndex, result.m_buffer, result.m_iFileSize);
+		}
+	}
+}
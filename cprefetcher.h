@@ -0,0 +1,126 @@
+/*!
+ \file cprefetcher.h
+
+*/
+
+#ifndef CPREFETCHER_H
+#define CPREFETCHER_H
+
+
+#include <QString>
+#include <QByteArray>
+#include <QFileInfo>
+#include <QList>
+#include <QThreadPool>
+#include <QAtomicInteger>
+
+#include <functional>
+
+
+struct io_uring;
+class cStatistics;
+
+/*!
+ \brief Reads the metadata prefix of many files with a fixed number of I/Os in flight.
+
+ With io_uring (HAVE_LIBURING) the openat() and read() of up to
+ queueDepth() files are submitted from the calling thread without blocking.
+ Without io_uring, or if the kernel refuses to set up a ring, the same is
+ done with a thread pool of queueDepth() threads.
+
+ The queue depth can be changed with setQueueDepth() while read() runs,
+ up to maxQueueDepth(), the size the ring and the pool were set up with.
+
+ \class cPrefetcher cprefetcher.h "cprefetcher.h"
+*/
+class cPrefetcher
+{
+public:
+	/*!
+	 \brief Called on the thread calling read() for every file in the order the reads complete.
+	 buffer is empty and iFileSize is -1 if the file could not be read.
+	*/
+	typedef std::function<void(qint32 iIndex, const QByteArray& buffer, qint64 iFileSize)>	cCallback;
+
+	/*!
+	 \brief
+
+	 \fn cPrefetcher
+	 \param iQueueDepth number of files read at the same time, setQueueDepth() may raise it up to four times this value
+	 \param iPrefixSize number of bytes read from the start of every file
+	*/
+	cPrefetcher(qint32 iQueueDepth, qint64 iPrefixSize);
+	~cPrefetcher();
+
+	/*!
+	 \brief
+
+	 \fn setStatistics
+	 \param lpStatistics
+	*/
+	void					setStatistics(cStatistics* lpStatistics);
+	/*!
+	 \brief
+
+	 \fn queueDepth
+	 \return qint32
+	*/
+	qint32					queueDepth();
+	/*!
+	 \brief Changes the number of files read at the same time, may be called from any thread.
+
+	 \fn setQueueDepth
+	 \param iQueueDepth clamped to 1 ... maxQueueDepth()
+	*/
+	void					setQueueDepth(qint32 iQueueDepth);
+	/*!
+	 \brief
+
+	 \fn maxQueueDepth
+	 \return qint32
+	*/
+	qint32					maxQueueDepth();
+	/*!
+	 \brief true if io_uring is used.
+
+	 \fn isAsync
+	 \return bool
+	*/
+	bool					isAsync();
+
+	/*!
+	 \brief Reads the prefix of all files and returns when callback was called for each of them.
+
+	 \fn read
+	 \param fileList
+	 \param callback
+	*/
+	void					read(const QFileInfoList& fileList, const cCallback& callback);
+
+private:
+	QAtomicInteger<qint32>	m_iQueueDepth;					/*!< number of files read at the same time */
+	qint32					m_iMaxQueueDepth;				/*!< size of the ring and the pool */
+	qint64					m_iPrefixSize;					/*!< bytes read from every file */
+	struct io_uring*		m_lpRing;						/*!< ring, or nullptr if the thread pool is used */
+	QThreadPool				m_threadPool;					/*!< fallback without io_uring */
+	cStatistics*			m_lpStatistics;					/*!< timing statistics, or nullptr */
+
+	/*!
+	 \brief
+
+	 \fn readRing
+	 \param fileList
+	 \param callback
+	*/
+	void					readRing(const QFileInfoList& fileList, const cCallback& callback);
+	/*!
+	 \brief
+
+	 \fn readThreads
+	 \param fileList
+	 \param callback
+	*/
+	void					readThreads(const QFileInfoList& fileList, const cCallback& callback);
+};
+
+#endif // CPREFETCHER_H
@@ -0,0 +1,844 @@
+/*!
+ \file cscanner.cpp
+
+*/
+
+#include "cscanner.h"
+#include "cthumbnailpack.h"
+#include "cstatistics.h"
+#include "cexif.h"
+#include "ccontenthash.h"
+#include "cduplicatefinder.h"
+#include "cperceptualhash.h"
+#include "cexternalsort.h"
+#include "cprefetcher.h"
+#include "cconcurrencycontroller.h"
+#include "cguard.h"
+#include "cgeoindex.h"
+#include "cfilter.h"
+#include "caggregator.h"
+
+#include <QDir>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QMutexLocker>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QSet>
+
+#include <exiv2/exiv2.hpp>
+
+#include <limits>
+
+
+#define SEPARATOR			"\t"
+#define PROGRESS_INTERVAL	5000
+
+
+/*!
+ \brief One file of a directory and its result.
+
+ \class cScanTask cscanner.cpp
+*/
+class cScanTask
+{
+public:
+	cScanTask(const QFileInfo& fileInfo) :
+		m_fileInfo(fileInfo),
+		m_iFileSize(-1),
+		m_lpSlots(nullptr),
+		m_bOK(false)
+	{
+	}
+
+	QFileInfo		m_fileInfo;					/*!< file to read */
+	QByteArray		m_buffer;					/*!< prefix read by the prefetcher, or empty */
+	qint64			m_iFileSize;				/*!< size of the file if m_buffer is set */
+	QSemaphore*		m_lpSlots;					/*!< released when the task is done, or nullptr */
+	cPicture		m_picture;					/*!< result */
+	bool			m_bOK;						/*!< the file could be read */
+};
+
+/*!
+ \brief Reads a batch of files on a worker thread of the scanner.
+
+ \class cScanBatch cscanner.cpp
+*/
+class cScanBatch : public QRunnable
+{
+public:
+	cScanBatch(cScanner* lpScanner) :
+		m_lpScanner(lpScanner)
+	{
+		setAutoDelete(true);
+	}
+
+	void run()
+	{
+		m_lpScanner->processBatch(m_taskList);
+	}
+
+	cScanner*			m_lpScanner;			/*!< scanner owning the batch */
+	QList<cScanTask*>	m_taskList;				/*!< files of the batch, owned by the scanner */
+};
+
+/*!
+ \brief Decides by the suffix if a file is an image, so the MIME database is only needed for unusual files.
+
+ \fn isImageSuffix
+ \param szSuffix lower case suffix
+ \param bKnown set to false if the suffix says nothing
+ \return bool
+*/
+static bool isImageSuffix(const QString& szSuffix, bool& bKnown)
+{
+	static const QSet<QString>	imageList	= { "jpg", "jpeg", "jpe", "jfif", "tif", "tiff", "png", "gif", "bmp", "webp", "heic", "heif", "hif", "avif", "jp2", "psd" };
+	static const QSet<QString>	otherList	= { "txt", "xmp", "xml", "json", "csv", "pdf", "html", "ini", "log", "db", "zip", "mov", "mp4", "m4v", "avi", "mts", "wav", "mp3", "pp3", "dop" };
+
+	bKnown	= true;
+
+	if(imageList.contains(szSuffix) || cEXIF::isRAW("x." + szSuffix))
+		return(true);
+	if(otherList.contains(szSuffix))
+		return(false);
+
+	bKnown	= false;
+	return(false);
+}
+
+cScanner::cScanner() :
+	m_lpThumbnailPack(nullptr),
+	m_bLibRaw(false),
+	m_bImageFactory(false),
+	m_ioMode(cFileInput::IOModeRead),
+	m_iPrefixSize(256 * 1024),
+	m_bDropCache(false),
+	m_iBatchSize(16),
+	m_lpPrefetcher(nullptr),
+	m_bAdaptive(false),
+	m_lpController(nullptr),
+	m_lpGuard(nullptr),
+	m_order(cDiskOrder::OrderName),
+	m_lpStatistics(nullptr),
+	m_lpStartTimer(nullptr),
+	m_bHash(false),
+	m_lpDuplicateFinder(nullptr),
+	m_bPerceptualHash(false),
+	m_lpSimilarityIndex(nullptr),
+	m_bGPS(false),
+	m_bTimestamps(false),
+	m_bLens(false),
+	m_lpGeoIndex(nullptr),
+	m_lpFilter(nullptr),
+	m_lpAggregator(nullptr),
+	m_lpExternalSort(nullptr),
+	m_textOut(stdout)
+{
+	// the XMP toolkit is not thread safe during initialization
+	Exiv2::XmpParser::initialize();
+}
+
+cScanner::~cScanner()
+{
+	m_threadPool.waitForDone();
+	delete m_lpController;
+	delete m_lpPrefetcher;
+	qDeleteAll(m_exifList);
+}
+
+void cScanner::setJobs(qint32 iJobs)
+{
+	if(iJobs <= 0)
+		iJobs	= QThread::idealThreadCount();
+
+	m_threadPool.setMaxThreadCount(iJobs);
+}
+
+qint32 cScanner::jobs()
+{
+	return(m_threadPool.maxThreadCount());
+}
+
+void cScanner::setThumbnailPack(cThumbnailPack* lpThumbnailPack)
+{
+	m_lpThumbnailPack	= lpThumbnailPack;
+}
+
+void cScanner::setLibRaw(bool bLibRaw)
+{
+	m_bLibRaw	= bLibRaw;
+}
+
+void cScanner::setImageFactory(bool bImageFactory)
+{
+	m_bImageFactory	= bImageFactory;
+}
+
+void cScanner::setIOMode(cFileInput::IOMode ioMode, qint64 iPrefixSize)
+{
+	m_ioMode		= ioMode;
+	m_iPrefixSize	= iPrefixSize;
+}
+
+void cScanner::setStartTimer(const QElapsedTimer* lpStartTimer)
+{
+	m_lpStartTimer	= lpStartTimer;
+}
+
+void cScanner::setDropCache(bool bDropCache)
+{
+	m_bDropCache	= bDropCache;
+}
+
+void cScanner::setBatchSize(qint32 iBatchSize)
+{
+	m_iBatchSize	= qMax(1, iBatchSize);
+}
+
+void cScanner::setQueueDepth(qint32 iQueueDepth, qint64 iPrefixSize)
+{
+	delete m_lpPrefetcher;
+	m_lpPrefetcher	= nullptr;
+
+	if(iQueueDepth > 0)
+	{
+		m_lpPrefetcher	= new cPrefetcher(iQueueDepth, iPrefixSize);
+		m_lpPrefetcher->setStatistics(m_lpStatistics);
+	}
+}
+
+void cScanner::setAdaptive(bool bAdaptive)
+{
+	m_bAdaptive	= bAdaptive;
+}
+
+void cScanner::setGuard(cGuard* lpGuard)
+{
+	m_lpGuard	= lpGuard;
+}
+
+void cScanner::setProgress(cProgress progress)
+{
+	m_progress	= progress;
+	m_progressTimer.start();
+}
+
+void cScanner::setOrder(cDiskOrder::Order order)
+{
+	m_order	= order;
+}
+
+void cScanner::setStatistics(cStatistics* lpStatistics)
+{
+	m_lpStatistics	= lpStatistics;
+
+	if(m_lpPrefetcher)
+		m_lpPrefetcher->setStatistics(lpStatistics);
+}
+
+void cScanner::setHash(bool bHash)
+{
+	m_bHash	= bHash;
+}
+
+void cScanner::setDuplicateFinder(cDuplicateFinder* lpDuplicateFinder)
+{
+	m_lpDuplicateFinder	= lpDuplicateFinder;
+}
+
+void cScanner::setPerceptualHash(bool bPerceptualHash)
+{
+	m_bPerceptualHash	= bPerceptualHash;
+}
+
+void cScanner::setSimilarityIndex(cSimilarityIndex* lpSimilarityIndex)
+{
+	m_lpSimilarityIndex	= lpSimilarityIndex;
+	if(m_lpSimilarityIndex)
+		m_bPerceptualHash	= true;
+}
+
+void cScanner::setGPS(bool bGPS)
+{
+	m_bGPS	= bGPS;
+}
+
+void cScanner::setTimestamps(bool bTimestamps)
+{
+	m_bTimestamps	= bTimestamps;
+}
+
+void cScanner::setLens(bool bLens)
+{
+	m_bLens	= bLens;
+}
+
+void cScanner::setXMP(const QStringList& szPropertyList)
+{
+	m_szXMPList	= szPropertyList;
+}
+
+QStringList cScanner::xmpProperties()
+{
+	return(m_szXMPList);
+}
+
+void cScanner::setIPTC(const QStringList& szDatasetList)
+{
+	m_szIPTCList	= szDatasetList;
+}
+
+QStringList cScanner::iptcDatasets()
+{
+	return(m_szIPTCList);
+}
+
+void cScanner::setGeoIndex(cGeoIndex* lpGeoIndex)
+{
+	m_lpGeoIndex	= lpGeoIndex;
+}
+
+void cScanner::setFilter(cFilter* lpFilter)
+{
+	m_lpFilter	= lpFilter;
+}
+
+void cScanner::setAggregator(cAggregator* lpAggregator)
+{
+	m_lpAggregator	= lpAggregator;
+}
+
+void cScanner::setExternalSort(cExternalSort* lpExternalSort, const QString& szSortBy)
+{
+	m_lpExternalSort	= lpExternalSort;
+	m_szSortBy			= szSortBy;
+}
+
+void cScanner::setupEXIF(cEXIF& exif)
+{
+	exif.setReadPreview(m_lpThumbnailPack != nullptr || m_bPerceptualHash);
+	exif.setLibRaw(m_bLibRaw);
+	exif.setImageFactory(m_bImageFactory);
+	exif.setMakerNote(m_bLens);
+	exif.setXMPProperties(m_szXMPList);
+	exif.setIPTCDatasets(m_szIPTCList);
+	exif.setIOMode(m_ioMode, m_iPrefixSize);
+	exif.setStatistics(m_lpStatistics);
+}
+
+cEXIF* cScanner::acquireEXIF()
+{
+	QMutexLocker	locker(&m_exifMutex);
+
+	if(!m_exifList.isEmpty())
+		return(m_exifList.takeLast());
+
+	locker.unlock();
+
+	cEXIF*	lpEXIF	= new cEXIF;
+
+	setupEXIF(*lpEXIF);
+	return(lpEXIF);
+}
+
+void cScanner::releaseEXIF(cEXIF* lpEXIF)
+{
+	QMutexLocker	locker(&m_exifMutex);
+
+	m_exifList.append(lpEXIF);
+}
+
+void cScanner::writeHeader(QTextStream& out)
+{
+	out << "directory" << SEPARATOR << "name" << SEPARATOR << "size" << SEPARATOR << "date" << SEPARATOR << "width" << SEPARATOR << "height" << SEPARATOR << "camera";
+
+	if(m_lpThumbnailPack)
+		out << SEPARATOR << "thumbnail";
+	if(m_bHash)
+		out << SEPARATOR << "hash";
+	if(m_bPerceptualHash)
+		out << SEPARATOR << "phash";
+	if(m_bGPS)
+		out << SEPARATOR << "latitude" << SEPARATOR << "longitude" << SEPARATOR << "altitude";
+	if(m_bTimestamps)
+		out << SEPARATOR << "timestamp" << SEPARATOR << "utcOffset" << SEPARATOR << "gpsTimestamp";
+	if(m_bLens)
+		out << SEPARATOR << "lens" << SEPARATOR << "shutterCount";
+	for(int x = 0;x < m_szXMPList.count();x++)
+		out << SEPARATOR << m_szXMPList[x];
+	for(int x = 0;x < m_szIPTCList.count();x++)
+		out << SEPARATOR << "iptc:" << m_szIPTCList[x];
+
+	out << "\n";
+}
+
+void cScanner::readDirectory(const QString& szPath, QTextStream& out, bool bRecursive)
+{
+	m_textOut << "*** DIRECTORY ***: " << szPath << "\n";
+
+	QDir				dir(szPath);
+	QStringList			szDirs	= dir.entryList(QDir::Dirs);
+	QFileInfoList		szFiles	= dir.entryInfoList(QDir::Files);
+	QList<cScanTask*>	taskList;
+
+	szDirs.removeAll(".");
+	szDirs.removeAll("..");
+
+	if(bRecursive)
+	{
+		for(int x = 0;x < szDirs.count();x++)
+			readDirectory(szPath + QDir::separator() + szDirs[x], out);
+	}
+
+	for(int x = 0;x < szFiles.count();x++)
+	{
+		// fields known from the directory listing are checked before the file is even opened
+		if(m_lpFilter && m_lpFilter->evaluate(cFilterRecord(szFiles[x])) == cFilter::ResultFalse)
+		{
+			if(m_lpStatistics)
+				m_lpStatistics->addCount("filter/skipped");
+			continue;
+		}
+
+		bool	bKnown;
+		bool	bImage	= isImageSuffix(szFiles[x].suffix().toLower(), bKnown);
+
+		// loading the MIME database costs more than a small scan, so it is only asked about unknown suffixes
+		if(!bKnown)
+		{
+			bImage	= m_mimeDB.mimeTypeForFile(szFiles[x]).name().startsWith("image");
+
+			if(m_lpStatistics)
+				m_lpStatistics->addCount("mime/lookup");
+		}
+
+		if(!bImage)
+			continue;
+
+		// files that hung or crashed a child before are not touched again
+		if(m_lpGuard && m_lpGuard->isQuarantined(szFiles[x].absoluteFilePath()))
+		{
+			if(m_lpStatistics)
+				m_lpStatistics->addCount("guard/quarantine skipped");
+			continue;
+		}
+
+		taskList.append(new cScanTask(szFiles[x]));
+	}
+
+	// the files are read in disk order, the rows are still written in taskList (name) order
+	QList<qint32>		orderList;
+
+	if(m_order != cDiskOrder::OrderName)
+	{
+		QFileInfoList	fileList;
+		QElapsedTimer	timer;
+
+		timer.start();
+
+		for(int x = 0;x < taskList.count();x++)
+			fileList.append(taskList[x]->m_fileInfo);
+		orderList	= cDiskOrder::order(fileList, m_order);
+
+		if(m_lpStatistics)
+			m_lpStatistics->addTime("order/" + cDiskOrder::orders().value(m_order), timer.nsecsElapsed());
+	}
+	else
+	{
+		for(int x = 0;x < taskList.count();x++)
+			orderList.append(x);
+	}
+
+	// the children of a guarded scan read the files themselves
+	bool	bPrefetch	= (m_lpPrefetcher && !m_lpGuard);
+
+	// the settings of the first directory are the start values
+	if(m_bAdaptive && !m_lpController)
+	{
+		qint32	iJobs	= m_threadPool.maxThreadCount();
+
+		m_lpController	= new cConcurrencyController(iJobs, iJobs * 4, bPrefetch ? m_lpPrefetcher->queueDepth() : 0, bPrefetch ? m_lpPrefetcher->maxQueueDepth() : 0, [this](qint32 iJobs, qint32 iQueueDepth) {
+			m_threadPool.setMaxThreadCount(iJobs);
+			if(m_lpPrefetcher)
+				m_lpPrefetcher->setQueueDepth(iQueueDepth);
+		});
+		m_lpController->setStatistics(m_lpStatistics);
+	}
+
+	if(m_lpController)
+		m_lpController->start();
+
+	if(bPrefetch)
+	{
+		QFileInfoList	fileList;
+		QSemaphore		decodeSlots((m_lpController ? m_lpController->maxJobs() : m_threadPool.maxThreadCount()) * 2);
+
+		for(int x = 0;x < orderList.count();x++)
+		{
+			fileList.append(taskList[orderList[x]]->m_fileInfo);
+			if(m_bDropCache)
+				cFileInput::dropCache(taskList[orderList[x]]->m_fileInfo.filePath());
+		}
+
+		// the decoders start as soon as a prefix arrives, the semaphore bounds the buffers waiting for a thread
+		m_lpPrefetcher->read(fileList, [&](qint32 iIndex, const QByteArray& buffer, qint64 iFileSize) {
+			cScanTask*	lpTask	= taskList[orderList[iIndex]];
+
+			lpTask->m_buffer	= buffer;
+			lpTask->m_iFileSize	= iFileSize;
+			lpTask->m_lpSlots	= &decodeSlots;
+
+			// prefixes are not batched, a batch would hold several of them until its last file is read
+			cScanBatch*	lpBatch	= new cScanBatch(this);
+
+			lpBatch->m_taskList.append(lpTask);
+
+			while(!decodeSlots.tryAcquire(1, PROGRESS_INTERVAL))
+				progress();
+			progress();
+			m_threadPool.start(lpBatch);
+		});
+	}
+	else
+	{
+		// small directories are still spread over all workers
+		qint32	iThreads	= m_threadPool.maxThreadCount();
+		qint32	iBatchSize	= qMax(1, qMin(m_iBatchSize, (orderList.count() + iThreads - 1) / iThreads));
+
+		for(int x = 0;x < orderList.count();x += iBatchSize)
+		{
+			cScanBatch*	lpBatch	= new cScanBatch(this);
+
+			for(int y = x;y < qMin(x + iBatchSize, orderList.count());y++)
+				lpBatch->m_taskList.append(taskList[orderList[y]]);
+
+			m_threadPool.start(lpBatch);
+		}
+	}
+
+	while(!m_threadPool.waitForDone(PROGRESS_INTERVAL))
+		progress();
+
+	if(m_lpController)
+		m_lpController->stop();
+
+	for(int x = 0;x < taskList.count();x++)
+	{
+		cScanTask*	lpTask	= taskList[x];
+
+		m_textOut << "--- File: " << lpTask->m_fileInfo.fileName() << "\n";
+
+		if(lpTask->m_bOK)
+		{
+			if(!m_lpAggregator)
+				writePicture(&lpTask->m_picture, out);
+
+			if(m_lpDuplicateFinder)
+				m_lpDuplicateFinder->add(&lpTask->m_picture);
+			if(m_lpSimilarityIndex && lpTask->m_picture.hasPerceptualHash())
+				m_lpSimilarityIndex->add(lpTask->m_picture.perceptualHash(), lpTask->m_fileInfo.absoluteFilePath());
+			if(m_lpGeoIndex && lpTask->m_picture.hasGPSPosition())
+				m_lpGeoIndex->add(lpTask->m_picture.latitude(), lpTask->m_picture.longitude(), lpTask->m_fileInfo.absoluteFilePath());
+		}
+
+		delete lpTask;
+	}
+}
+
+void cScanner::processBatch(const QList<cScanTask*>& taskList)
+{
+	QElapsedTimer		timer;
+
+	// a file that hangs or crashes the child of this thread only costs that file
+	if(m_lpGuard)
+	{
+		for(int x = 0;x < taskList.count();x++)
+		{
+			cScanTask*	lpTask	= taskList[x];
+
+			if(m_bDropCache)
+				cFileInput::dropCache(lpTask->m_fileInfo.filePath());
+
+			timer.start();
+
+			bool	bOK	= (m_lpGuard->read(lpTask->m_fileInfo.absoluteFilePath(), &lpTask->m_picture) == cGuard::ResultOK);
+
+			if(m_lpStatistics)
+			{
+				m_lpStatistics->addTime("file/total", timer.nsecsElapsed());
+				m_lpStatistics->addCount(bOK ? "file/read" : "file/failed");
+			}
+
+			if(bOK)
+				lpTask->m_bOK	= processPicture(lpTask->m_fileInfo, &lpTask->m_picture);
+
+			if(m_lpController)
+				m_lpController->fileDone();
+		}
+		return;
+	}
+
+	cEXIF*				lpEXIF	= acquireEXIF();
+	QStringList			fileList;
+	QList<QByteArray>	bufferList;
+	QList<qint64>		fileSizeList;
+
+	for(int x = 0;x < taskList.count();x++)
+	{
+		cScanTask*	lpTask	= taskList[x];
+
+		fileList.append(lpTask->m_fileInfo.filePath());
+		bufferList.append(lpTask->m_buffer);
+		fileSizeList.append(lpTask->m_iFileSize);
+		lpTask->m_buffer.clear();
+
+		if(m_bDropCache && !m_lpPrefetcher)
+			cFileInput::dropCache(lpTask->m_fileInfo.filePath());
+	}
+
+	cEXIF::cBatchCallback	callback	= [&](qint32 iIndex, bool bOK, cEXIF& exif) {
+		cScanTask*	lpTask	= taskList[iIndex];
+
+		if(m_lpStatistics)
+		{
+			m_lpStatistics->addTime("file/total", timer.nsecsElapsed());
+			m_lpStatistics->addCount(bOK ? "file/read" : "file/failed");
+		}
+
+		if(bOK)
+		{
+			lpTask->m_picture.fromEXIF(lpTask->m_fileInfo.filePath(), exif);
+			lpTask->m_bOK	= processPicture(lpTask->m_fileInfo, &lpTask->m_picture);
+		}
+
+		if(lpTask->m_lpSlots)
+			lpTask->m_lpSlots->release();
+
+		if(m_lpController)
+			m_lpController->fileDone();
+
+		timer.restart();
+	};
+
+	timer.start();
+
+	if(m_lpPrefetcher)
+		lpEXIF->fromBuffers(fileList, bufferList, fileSizeList, callback);
+	else
+		lpEXIF->fromFiles(fileList, callback);
+
+	releaseEXIF(lpEXIF);
+}
+
+bool cScanner::readPicture(const QFileInfo& fileInfo, cPicture* lpPicture)
+{
+	QElapsedTimer	timer;
+
+	// a single file has not been through the directory listing check of readDirectory()
+	if(m_lpFilter && m_lpFilter->evaluate(cFilterRecord(fileInfo)) == cFilter::ResultFalse)
+	{
+		if(m_lpStatistics)
+			m_lpStatistics->addCount("filter/skipped");
+		return(false);
+	}
+
+	timer.start();
+
+	bool	bOK	= decodePicture(fileInfo.filePath(), lpPicture);
+
+	if(m_lpStatistics)
+	{
+		m_lpStatistics->addTime("file/total", timer.nsecsElapsed());
+		m_lpStatistics->addCount(bOK ? "file/read" : "file/failed");
+	}
+
+	if(!bOK)
+		return(false);
+
+	return(processPicture(fileInfo, lpPicture));
+}
+
+bool cScanner::decodePicture(const QString& szFileName, cPicture* lpPicture)
+{
+	cEXIF*	lpEXIF	= acquireEXIF();
+	bool	bOK		= lpPicture->fromFile(szFileName, *lpEXIF);
+
+	releaseEXIF(lpEXIF);
+	return(bOK);
+}
+
+bool cScanner::processPicture(const QFileInfo& fileInfo, cPicture* lpPicture)
+{
+	QElapsedTimer	timer;
+
+	if(m_lpFilter && m_lpFilter->evaluate(cFilterRecord(fileInfo, lpPicture)) != cFilter::ResultTrue)
+	{
+		if(m_lpStatistics)
+			m_lpStatistics->addCount("filter/rejected");
+		return(false);
+	}
+
+	// aggregated on the decoder thread, the rows are never built
+	if(m_lpAggregator)
+		m_lpAggregator->add(cFilterRecord(fileInfo, lpPicture));
+
+	if(m_lpThumbnailPack && !lpPicture->preview().isEmpty())
+	{
+		quint64	iFileID	= cThumbnailPack::fileID(fileInfo.absoluteFilePath());
+
+		if(m_lpThumbnailPack->append(iFileID, lpPicture->preview(), lpPicture->previewWidth(), lpPicture->previewHeight()))
+			lpPicture->setThumbnailID(iFileID);
+	}
+
+	if(m_bPerceptualHash && !lpPicture->preview().isEmpty())
+	{
+		bool	bHashOK	= false;
+
+		timer.start();
+
+		quint64	iHash	= cPerceptualHash::dHash(lpPicture->preview(), &bHashOK);
+
+		if(bHashOK)
+			lpPicture->setPerceptualHash(iHash);
+
+		if(m_lpStatistics)
+			m_lpStatistics->addTime(bHashOK ? "phash/preview" : "phash/failed", timer.nsecsElapsed());
+	}
+
+	// the preview is consumed now, don't keep it until the row is written
+	lpPicture->setPreview(QByteArray(), lpPicture->previewWidth(), lpPicture->previewHeight());
+
+	if(m_bHash)
+	{
+		timer.start();
+		lpPicture->setContentHash(cContentHash::local()->hashFile(fileInfo.filePath()));
+
+		if(m_lpStatistics)
+			m_lpStatistics->addTime("hash/file", timer.nsecsElapsed());
+	}
+
+	return(true);
+}
+
+void cScanner::writePicture(cPicture* lpPicture, QTextStream& out)
+{
+	QString		szRow;
+	QTextStream	rowOut(&szRow);
+
+	rowOut << lpPicture->filePath() << SEPARATOR << lpPicture->fileName() << SEPARATOR << lpPicture->fileSize() << SEPARATOR << lpPicture->dateTime().toString("yyyy-MM-dd hh:mm:ss") << SEPARATOR << lpPicture->imageWidth() << SEPARATOR << lpPicture->imageHeight() << SEPARATOR << lpPicture->cameraModel();
+
+	if(m_lpThumbnailPack)
+	{
+		rowOut << SEPARATOR;
+		if(lpPicture->thumbnailID())
+			rowOut << QString::number(lpPicture->thumbnailID(), 16);
+	}
+	if(m_bHash)
+		rowOut << SEPARATOR << lpPicture->contentHash();
+	if(m_bPerceptualHash)
+	{
+		rowOut << SEPARATOR;
+		if(lpPicture->hasPerceptualHash())
+			rowOut << QString("%1").arg(lpPicture->perceptualHash(), 16, 16, QChar('0'));
+	}
+	if(m_bGPS)
+	{
+		rowOut << SEPARATOR;
+		if(lpPicture->hasGPSPosition())
+			rowOut << QString::number(lpPicture->latitude(), 'f', 7) << SEPARATOR << QString::number(lpPicture->longitude(), 'f', 7);
+		else
+			rowOut << SEPARATOR;
+		rowOut << SEPARATOR;
+		if(lpPicture->hasAltitude())
+			rowOut << QString::number(lpPicture->altitude(), 'f', 1);
+	}
+	if(m_bTimestamps)
+	{
+		rowOut << SEPARATOR;
+		if(lpPicture->hasTimestamp())
+			rowOut << lpPicture->timestamp();
+		rowOut << SEPARATOR;
+		if(lpPicture->hasUTCOffset())
+		{
+			qint32	iOffset	= qAbs(lpPicture->utcOffset()) / 60;
+
+			rowOut << (lpPicture->utcOffset() < 0 ? "-" : "+") << QString("%1:%2").arg(iOffset / 60, 2, 10, QChar('0')).arg(iOffset % 60, 2, 10, QChar('0'));
+		}
+		rowOut << SEPARATOR;
+		if(lpPicture->hasGPSTimestamp())
+			rowOut << lpPicture->gpsTimestamp();
+	}
+	if(m_bLens)
+	{
+		rowOut << SEPARATOR << lpPicture->lensModel().trimmed() << SEPARATOR;
+		if(lpPicture->shutterCount() > 0)
+			rowOut << lpPicture->shutterCount();
+	}
+	if(!m_szXMPList.isEmpty())
+	{
+		QStringList	valueList	= lpPicture->xmpValues();
+
+		for(int x = 0;x < m_szXMPList.count();x++)
+			rowOut << SEPARATOR << valueList.value(x);
+	}
+	if(!m_szIPTCList.isEmpty())
+	{
+		QStringList	valueList	= lpPicture->iptcValues();
+
+		for(int x = 0;x < m_szIPTCList.count();x++)
+			rowOut << SEPARATOR << valueList.value(x);
+	}
+
+	rowOut << "\n";
+	rowOut.flush();
+
+	if(m_lpExternalSort)
+	{
+		if(!m_lpExternalSort->add(sortKey(lpPicture), szRow) && m_lpStatistics)
+			m_lpStatistics->addCount("sort/rows lost");
+	}
+	else
+		out << szRow;
+
+	if(m_lpStartTimer && m_lpStatistics)
+	{
+		m_lpStatistics->addTime("startup/first-row", m_lpStartTimer->nsecsElapsed());
+		m_lpStartTimer	= nullptr;
+	}
+}
+
+qint64 cScanner::sortKey(cPicture* lpPicture)
+{
+	QDateTime	dateTime;
+
+	if(m_szSortBy == "size")
+		return(lpPicture->fileSize());
+	else if(m_szSortBy == "timestamp")
+		return(lpPicture->hasTimestamp() ? lpPicture->timestamp() : std::numeric_limits<qint64>::max());
+	else if(m_szSortBy == "date")
+		dateTime	= lpPicture->dateTime();
+	else if(m_szSortBy == "dateTimeDigitized")
+		dateTime	= lpPicture->dateTimeDigitized();
+	else
+		dateTime	= lpPicture->dateTimeOriginal();
+
+	// pictures without a date go to the end
+	if(!dateTime.isValid())
+		return(std::numeric_limits<qint64>::max());
+
+	return(dateTime.toMSecsSinceEpoch());
+}
+
+void cScanner::progress()
+{
+	if(!m_progress || m_progressTimer.elapsed() < PROGRESS_INTERVAL)
+		return;
+
+	m_progress();
+	m_progressTimer.restart();
+}
+
+QStringList cScanner::sortKeys()
+{
+	return(QStringList() << "dateTimeOriginal" << "date" << "dateTimeDigitized" << "timestamp" << "size");
+}
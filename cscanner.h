@@ -0,0 +1,417 @@
+/*!
+ \file cscanner.h
+
+*/
+
+#ifndef CSCANNER_H
+#define CSCANNER_H
+
+
+#include "cpicture.h"
+#include "cfileinput.h"
+#include "cdiskorder.h"
+
+#include <QString>
+#include <QFileInfo>
+#include <QList>
+#include <QStringList>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QMimeDatabase>
+#include <QMutex>
+#include <QElapsedTimer>
+
+#include <functional>
+
+
+class cThumbnailPack;
+class cStatistics;
+class cEXIF;
+class cDuplicateFinder;
+class cSimilarityIndex;
+class cExternalSort;
+class cPrefetcher;
+class cConcurrencyController;
+class cGuard;
+class cGeoIndex;
+class cFilter;
+class cAggregator;
+class cScanTask;
+
+/*!
+ \brief Walks a directory tree and writes one row per picture.
+
+ The files of a directory are read in parallel on the scanner's own thread
+ pool, the rows are written in directory order afterwards.
+
+ \class cScanner cscanner.h "cscanner.h"
+*/
+class cScanner
+{
+public:
+	/*!
+	 \brief Called by readDirectory() on its own thread.
+	*/
+	typedef std::function<void()>	cProgress;
+
+	cScanner();
+	~cScanner();
+
+	/*!
+	 \brief Number of files read in parallel, 0 uses the number of CPU cores.
+
+	 \fn setJobs
+	 \param iJobs
+	*/
+	void					setJobs(qint32 iJobs);
+	/*!
+	 \brief
+
+	 \fn jobs
+	 \return qint32
+	*/
+	qint32					jobs();
+
+	/*!
+	 \brief Stores the embedded previews in the given pack.
+
+	 \fn setThumbnailPack
+	 \param lpThumbnailPack
+	*/
+	void					setThumbnailPack(cThumbnailPack* lpThumbnailPack);
+	/*!
+	 \brief Reads the size of RAW files with LibRaw, see cEXIF::setLibRaw().
+
+	 \fn setLibRaw
+	 \param bLibRaw
+	*/
+	void					setLibRaw(bool bLibRaw);
+	/*!
+	 \brief Opens every file through the Exiv2 image factory, see cEXIF::setImageFactory().
+
+	 \fn setImageFactory
+	 \param bImageFactory
+	*/
+	void					setImageFactory(bool bImageFactory);
+	/*!
+	 \brief Selects how the metadata is read, see cEXIF::setIOMode().
+
+	 \fn setIOMode
+	 \param ioMode
+	 \param iPrefixSize
+	*/
+	void					setIOMode(cFileInput::IOMode ioMode, qint64 iPrefixSize);
+	/*!
+	 \brief Reads the first iPrefixSize bytes of up to iQueueDepth files at the same time before they are decoded, 0 disables the prefetch.
+
+	 \fn setQueueDepth
+	 \param iQueueDepth
+	 \param iPrefixSize
+	*/
+	void					setQueueDepth(qint32 iQueueDepth, qint64 iPrefixSize);
+	/*!
+	 \brief Lets a cConcurrencyController tune the number of workers and the queue depth while scanning, starting from setJobs() and setQueueDepth() and up to four times them.
+
+	 \fn setAdaptive
+	 \param bAdaptive
+	*/
+	void					setAdaptive(bool bAdaptive);
+	/*!
+	 \brief Reads every file in a child process of lpGuard and skips the quarantined files. The prefetch is not used.
+
+	 \fn setGuard
+	 \param lpGuard
+	*/
+	void					setGuard(cGuard* lpGuard);
+	/*!
+	 \brief Called every few seconds while readDirectory() waits for the files of a directory, e.g. to tell a coordinator that the worker is alive before the first row of a large directory.
+
+	 \fn setProgress
+	 \param progress
+	*/
+	void					setProgress(cProgress progress);
+	/*!
+	 \brief Order the files of a directory are read in. The output keeps the name order.
+
+	 \fn setOrder
+	 \param order
+	*/
+	void					setOrder(cDiskOrder::Order order);
+	/*!
+	 \brief Evicts every file from the page cache before it is read to measure cold cache performance.
+
+	 \fn setDropCache
+	 \param bDropCache
+	*/
+	void					setDropCache(bool bDropCache);
+	/*!
+	 \brief Maximum number of files a worker reads in one go with one cEXIF, see cEXIF::fromFiles().
+
+	 \fn setBatchSize
+	 \param iBatchSize
+	*/
+	void					setBatchSize(qint32 iBatchSize);
+	/*!
+	 \brief Collects timing statistics for the --stats report.
+
+	 \fn setStatistics
+	 \param lpStatistics
+	*/
+	void					setStatistics(cStatistics* lpStatistics);
+	/*!
+	 \brief Adds the time from the start of lpStartTimer to the first written row to the statistics.
+
+	 \fn setStartTimer
+	 \param lpStartTimer
+	*/
+	void					setStartTimer(const QElapsedTimer* lpStartTimer);
+	/*!
+	 \brief Adds a content hash column.
+
+	 \fn setHash
+	 \param bHash
+	*/
+	void					setHash(bool bHash);
+	/*!
+	 \brief Passes every written picture to the duplicate finder.
+
+	 \fn setDuplicateFinder
+	 \param lpDuplicateFinder
+	*/
+	void					setDuplicateFinder(cDuplicateFinder* lpDuplicateFinder);
+	/*!
+	 \brief Adds a perceptual hash column computed from the embedded preview.
+
+	 \fn setPerceptualHash
+	 \param bPerceptualHash
+	*/
+	void					setPerceptualHash(bool bPerceptualHash);
+	/*!
+	 \brief Passes every perceptual hash to the similarity index. Enables the perceptual hash.
+
+	 \fn setSimilarityIndex
+	 \param lpSimilarityIndex
+	*/
+	void					setSimilarityIndex(cSimilarityIndex* lpSimilarityIndex);
+	/*!
+	 \brief Adds latitude, longitude and altitude columns in decimal degrees and meters.
+
+	 \fn setGPS
+	 \param bGPS
+	*/
+	void					setGPS(bool bGPS);
+	/*!
+	 \brief Adds the columns timestamp (UTC nanoseconds since the epoch), utcOffset (+hh:mm) and gpsTimestamp.
+
+	 \fn setTimestamps
+	 \param bTimestamps
+	*/
+	void					setTimestamps(bool bTimestamps);
+	/*!
+	 \brief Adds the columns lens and shutterCount, read from the maker note if the Exif IFD has no lens, see cEXIF::setMakerNote().
+
+	 \fn setLens
+	 \param bLens
+	*/
+	void					setLens(bool bLens);
+	/*!
+	 \brief Adds one column per XMP property (prefix:name), see cEXIF::setXMPProperties().
+
+	 \fn setXMP
+	 \param szPropertyList
+	*/
+	void					setXMP(const QStringList& szPropertyList);
+	/*!
+	 \brief
+
+	 \fn xmpProperties
+	 \return QStringList
+	*/
+	QStringList				xmpProperties();
+	/*!
+	 \brief Adds one column per IPTC dataset, see cEXIF::setIPTCDatasets().
+
+	 \fn setIPTC
+	 \param szDatasetList
+	*/
+	void					setIPTC(const QStringList& szDatasetList);
+	/*!
+	 \brief
+
+	 \fn iptcDatasets
+	 \return QStringList
+	*/
+	QStringList				iptcDatasets();
+	/*!
+	 \brief Passes the position of every picture to the spatial index.
+
+	 \fn setGeoIndex
+	 \param lpGeoIndex
+	*/
+	void					setGeoIndex(cGeoIndex* lpGeoIndex);
+	/*!
+	 \brief Only pictures matching the filter are written. Files are skipped before decoding if the directory listing is enough to reject them.
+
+	 \fn setFilter
+	 \param lpFilter
+	*/
+	void					setFilter(cFilter* lpFilter);
+	/*!
+	 \brief Adds the pictures to the aggregator instead of writing rows.
+
+	 \fn setAggregator
+	 \param lpAggregator
+	*/
+	void					setAggregator(cAggregator* lpAggregator);
+	/*!
+	 \brief Passes the rows to the external sort instead of writing them.
+
+	 \fn setExternalSort
+	 \param lpExternalSort
+	 \param szSortBy one of sortKeys()
+	*/
+	void					setExternalSort(cExternalSort* lpExternalSort, const QString& szSortBy);
+	/*!
+	 \brief Values accepted by setExternalSort().
+
+	 \fn sortKeys
+	 \return QStringList
+	*/
+	static QStringList		sortKeys();
+
+	/*!
+	 \brief
+
+	 \fn writeHeader
+	 \param out
+	*/
+	void					writeHeader(QTextStream& out);
+	/*!
+	 \brief
+
+	 \fn readDirectory
+	 \param szPath
+	 \param out
+	 \param bRecursive read the sub directories too
+	*/
+	void					readDirectory(const QString& szPath, QTextStream& out, bool bRecursive = true);
+
+	/*!
+	 \brief Reads a batch of files. Called from the worker threads.
+
+	 \fn processBatch
+	 \param taskList
+	*/
+	void					processBatch(const QList<cScanTask*>& taskList);
+	/*!
+	 \brief Reads one file outside of a directory scan, with the settings and the cEXIF pool of the scanner. Thread safe.
+
+	 \fn readPicture
+	 \param fileInfo
+	 \param lpPicture
+	 \return bool false if the file can't be read or is rejected by the filter
+	*/
+	bool					readPicture(const QFileInfo& fileInfo, cPicture* lpPicture);
+	/*!
+	 \brief Only reads the metadata of one file, without filter and hashes. Used by the --guard-child processes. Thread safe.
+
+	 \fn decodePicture
+	 \param szFileName
+	 \param lpPicture
+	 \return bool
+	*/
+	bool					decodePicture(const QString& szFileName, cPicture* lpPicture);
+
+private:
+	/*!
+	 \brief Applies the scanner settings to a cEXIF.
+
+	 \fn setupEXIF
+	 \param exif
+	*/
+	void					setupEXIF(cEXIF& exif);
+	/*!
+	 \brief Takes an idle cEXIF from the pool or creates a new one.
+
+	 \fn acquireEXIF
+	 \return cEXIF
+	*/
+	cEXIF*					acquireEXIF();
+	/*!
+	 \brief Returns a cEXIF to the pool.
+
+	 \fn releaseEXIF
+	 \param lpEXIF
+	*/
+	void					releaseEXIF(cEXIF* lpEXIF);
+	/*!
+	 \brief Filters, aggregates and hashes a picture after it was read.
+
+	 \fn processPicture
+	 \param fileInfo
+	 \param lpPicture
+	 \return bool false if the picture is not written
+	*/
+	bool					processPicture(const QFileInfo& fileInfo, cPicture* lpPicture);
+
+	QThreadPool				m_threadPool;					/*!< workers reading the files */
+	QMimeDatabase			m_mimeDB;						/*!< used to detect image files */
+	cThumbnailPack*			m_lpThumbnailPack;				/*!< pack receiving the previews, or nullptr */
+	bool					m_bLibRaw;						/*!< read the size of RAW files with LibRaw */
+	bool					m_bImageFactory;				/*!< open the files through the Exiv2 image factory */
+	cFileInput::IOMode		m_ioMode;						/*!< how the metadata is read */
+	qint64					m_iPrefixSize;					/*!< size of the metadata region */
+	bool					m_bDropCache;					/*!< evict the files from the page cache before reading */
+	qint32					m_iBatchSize;					/*!< maximum number of files per worker task */
+	QMutex					m_exifMutex;					/*!< guards m_exifList */
+	QList<cEXIF*>			m_exifList;						/*!< idle cEXIF objects, reused by the workers */
+	cPrefetcher*			m_lpPrefetcher;					/*!< reads the file prefixes ahead of the decoders, or nullptr */
+	bool					m_bAdaptive;					/*!< tune the workers and the queue depth */
+	cConcurrencyController*	m_lpController;					/*!< created by the first readDirectory() if m_bAdaptive */
+	cGuard*					m_lpGuard;						/*!< reads the files in child processes, or nullptr */
+	cProgress				m_progress;						/*!< progress callback, or empty */
+	QElapsedTimer			m_progressTimer;				/*!< time since m_progress was called */
+	cDiskOrder::Order		m_order;						/*!< order the files of a directory are read in */
+	cStatistics*			m_lpStatistics;					/*!< timing statistics, or nullptr */
+	const QElapsedTimer*	m_lpStartTimer;					/*!< process start for startup/first-row, nullptr once measured */
+	bool					m_bHash;						/*!< hash the content of every file */
+	cDuplicateFinder*		m_lpDuplicateFinder;			/*!< collects the pictures for the duplicate report, or nullptr */
+	bool					m_bPerceptualHash;				/*!< compute the perceptual hash of the preview */
+	cSimilarityIndex*		m_lpSimilarityIndex;			/*!< collects the perceptual hashes, or nullptr */
+	bool					m_bGPS;							/*!< write the position columns */
+	bool					m_bTimestamps;					/*!< write the UTC timestamp columns */
+	bool					m_bLens;						/*!< write the lens columns and read the maker notes */
+	QStringList				m_szXMPList;					/*!< XMP properties written as columns */
+	QStringList				m_szIPTCList;					/*!< IPTC datasets written as columns */
+	cGeoIndex*				m_lpGeoIndex;					/*!< collects the positions, or nullptr */
+	cFilter*				m_lpFilter;						/*!< --where expression, or nullptr */
+	cAggregator*			m_lpAggregator;					/*!< --group-by aggregation, or nullptr */
+	cExternalSort*			m_lpExternalSort;				/*!< receives the rows if the output is sorted, or nullptr */
+	QString					m_szSortBy;						/*!< field the output is sorted by */
+	QTextStream				m_textOut;						/*!< progress output */
+
+	/*!
+	 \brief
+
+	 \fn writePicture
+	 \param lpPicture
+	 \param out
+	*/
+	void					writePicture(cPicture* lpPicture, QTextStream& out);
+	/*!
+	 \brief
+
+	 \fn sortKey
+	 \param lpPicture
+	 \return qint64
+	*/
+	qint64					sortKey(cPicture* lpPicture);
+	/*!
+	 \brief Calls m_progress if the interval has passed.
+
+	 \fn progress
+	*/
+	void					progress();
+};
+
+#endif // CSCANNER_H
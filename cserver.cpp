@@ -0,0 +1,604 @@
+/*!
+ \file cserver.cpp
+
+*/
+
+#include "cserver.h"
+#include "cscanner.h"
+#include "cpicture.h"
+#include "cstatistics.h"
+
+#include <QSocketNotifier>
+#include <QFileInfo>
+#include <QFile>
+#include <QRunnable>
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <QDebug>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <errno.h>
+#include <cstring>
+
+
+#define MAX_PIPELINE		64					/*!< requests of one connection read in parallel */
+#define MAX_OUTPUT			(1024 * 1024)		/*!< unsent responses of one connection before new requests wait */
+#define MAX_LINE			(64 * 1024)			/*!< longest accepted request line */
+#define MAX_FDS				64					/*!< descriptors accepted with one message */
+#define READ_SIZE			(64 * 1024)
+
+
+/*!
+ \brief Reads the file of one request on a worker thread of the server.
+
+ \class cServerTask cserver.cpp
+*/
+class cServerTask : public QRunnable
+{
+public:
+	cServerTask(cServer* lpServer, quint64 iConnection, const QJsonValue& id, const QString& szFileName, int iFD) :
+		m_lpServer(lpServer),
+		m_iConnection(iConnection),
+		m_id(id),
+		m_szFileName(szFileName),
+		m_iFD(iFD)
+	{
+		setAutoDelete(true);
+	}
+
+	void run()
+	{
+		m_lpServer->processRequest(m_iConnection, m_id, m_szFileName, m_iFD);
+	}
+
+	cServer*		m_lpServer;					/*!< server owning the task */
+	quint64			m_iConnection;				/*!< connection of the request */
+	QJsonValue		m_id;						/*!< id of the request */
+	QString			m_szFileName;				/*!< file to read */
+	int				m_iFD;						/*!< descriptor of the request, or -1 */
+};
+
+/*!
+ \brief
+
+ \fn setNonBlocking
+ \param iSocket
+ \return bool
+*/
+static bool setNonBlocking(int iSocket)
+{
+	int	iFlags	= fcntl(iSocket, F_GETFL);
+
+	if(iFlags < 0 || fcntl(iSocket, F_SETFL, iFlags | O_NONBLOCK) < 0)
+		return(false);
+
+	fcntl(iSocket, F_SETFD, FD_CLOEXEC);
+	return(true);
+}
+
+cServerConnection::cServerConnection(quint64 iID, int iSocket) :
+	m_iID(iID),
+	m_iSocket(iSocket),
+	m_lpReadNotifier(nullptr),
+	m_lpWriteNotifier(nullptr),
+	m_iPending(0),
+	m_bClosed(false),
+	m_bBroken(false)
+{
+}
+
+cServerConnection::~cServerConnection()
+{
+	// the connection may be closed from a signal of its own notifiers
+	m_lpReadNotifier->setEnabled(false);
+	m_lpReadNotifier->deleteLater();
+	m_lpWriteNotifier->setEnabled(false);
+	m_lpWriteNotifier->deleteLater();
+
+	// descriptors sent without a request
+	while(!m_fdList.isEmpty())
+		::close(m_fdList.dequeue());
+
+	::close(m_iSocket);
+}
+
+cServer::cServer(cScanner* lpScanner, QObject* parent) :
+	QObject(parent),
+	m_lpScanner(lpScanner),
+	m_lpStatistics(nullptr),
+	m_iSocket(-1),
+	m_lpAcceptNotifier(nullptr),
+	m_iNextID(1)
+{
+	// the field list of cFilter is built here, before the workers use it
+	QStringList	szFields	= cFilter::fields();
+
+	for(int x = 0;x < szFields.count();x++)
+	{
+		cFilter::cNumberGetter	number	= cFilter::numberGetter(szFields[x]);
+
+		if(number && !cFilter::isDateField(szFields[x]))
+		{
+			m_szNumberList.append(szFields[x]);
+			m_numberList.append(number);
+		}
+		else
+		{
+			m_szTextList.append(szFields[x]);
+			m_textList.append(cFilter::textGetter(szFields[x]));
+		}
+	}
+}
+
+cServer::~cServer()
+{
+	m_threadPool.waitForDone();
+
+	qDeleteAll(m_connectionList);
+
+	for(int x = 0;x < m_responseList.count();x++)
+	{
+		if(m_responseList[x].m_iFD >= 0)
+			::close(m_responseList[x].m_iFD);
+	}
+
+	delete m_lpAcceptNotifier;
+
+	if(m_iSocket >= 0)
+	{
+		::close(m_iSocket);
+		QFile::remove(m_szPath);
+	}
+}
+
+bool cServer::listen(const QString& szPath)
+{
+	QByteArray			path	= QFile::encodeName(szPath);
+	struct sockaddr_un	address;
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family	= AF_UNIX;
+
+	if(path.size() >= static_cast<int>(sizeof(address.sun_path)))
+	{
+		qDebug() << "socket path too long:" << szPath;
+		return(false);
+	}
+	memcpy(address.sun_path, path.constData(), static_cast<size_t>(path.size()));
+
+	m_iSocket	= socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if(m_iSocket < 0)
+		return(false);
+
+	// a socket file left behind by a previous server
+	::unlink(path.constData());
+
+	if(bind(m_iSocket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0 || ::listen(m_iSocket, SOMAXCONN) < 0 || !setNonBlocking(m_iSocket))
+	{
+		qDebug() << "can't listen on" << szPath << strerror(errno);
+		::close(m_iSocket);
+		m_iSocket	= -1;
+		return(false);
+	}
+
+	// a client closing its connection early must not end the server
+	signal(SIGPIPE, SIG_IGN);
+
+	m_szPath			= szPath;
+	m_lpAcceptNotifier	= new QSocketNotifier(m_iSocket, QSocketNotifier::Read, this);
+	connect(m_lpAcceptNotifier, &QSocketNotifier::activated, this, &cServer::onNewConnection);
+
+	return(true);
+}
+
+void cServer::setJobs(qint32 iJobs)
+{
+	if(iJobs > 0)
+		m_threadPool.setMaxThreadCount(iJobs);
+}
+
+void cServer::setStatistics(cStatistics* lpStatistics)
+{
+	m_lpStatistics	= lpStatistics;
+}
+
+void cServer::onNewConnection()
+{
+	for(;;)
+	{
+		int	iSocket	= accept(m_iSocket, nullptr, nullptr);
+
+		if(iSocket < 0)
+		{
+			if(errno == EINTR)
+				continue;
+			return;
+		}
+
+		if(!setNonBlocking(iSocket))
+		{
+			::close(iSocket);
+			continue;
+		}
+
+		quint64				iID			= m_iNextID++;
+		cServerConnection*	lpConnection	= new cServerConnection(iID, iSocket);
+
+		lpConnection->m_lpReadNotifier	= new QSocketNotifier(iSocket, QSocketNotifier::Read, this);
+		lpConnection->m_lpWriteNotifier	= new QSocketNotifier(iSocket, QSocketNotifier::Write, this);
+		lpConnection->m_lpWriteNotifier->setEnabled(false);
+
+		connect(lpConnection->m_lpReadNotifier, &QSocketNotifier::activated, this, [this, iID]() { onReadable(iID); });
+		connect(lpConnection->m_lpWriteNotifier, &QSocketNotifier::activated, this, [this, iID]() {
+			cServerConnection*	lpConnection	= m_connectionList.value(iID);
+
+			if(lpConnection)
+			{
+				flush(lpConnection);
+				handleRequests(lpConnection);
+				checkClosed(lpConnection);
+			}
+		});
+
+		m_connectionList.insert(iID, lpConnection);
+
+		if(m_lpStatistics)
+			m_lpStatistics->addCount("serve/connections");
+	}
+}
+
+void cServer::onReadable(quint64 iConnection)
+{
+	cServerConnection*	lpConnection	= m_connectionList.value(iConnection);
+
+	if(!lpConnection)
+		return;
+
+	char	buffer[READ_SIZE];
+	char	control[CMSG_SPACE(sizeof(int) * MAX_FDS)];
+
+	// only read what can be handled, the rest waits in the socket
+	while(!lpConnection->m_bClosed && lpConnection->m_input.size() < MAX_LINE)
+	{
+		struct iovec	iov;
+		struct msghdr	message;
+		int				iFlags	= MSG_DONTWAIT;
+
+#ifdef MSG_CMSG_CLOEXEC
+		iFlags	|= MSG_CMSG_CLOEXEC;
+#endif
+
+		iov.iov_base			= buffer;
+		iov.iov_len				= sizeof(buffer);
+		memset(&message, 0, sizeof(message));
+		message.msg_iov			= &iov;
+		message.msg_iovlen		= 1;
+		message.msg_control		= control;
+		message.msg_controllen	= sizeof(control);
+
+		ssize_t	iRead	= recvmsg(lpConnection->m_iSocket, &message, iFlags);
+
+		if(iRead < 0)
+		{
+			if(errno == EINTR)
+				continue;
+			if(errno != EAGAIN && errno != EWOULDBLOCK)
+			{
+				lpConnection->m_bClosed	= true;
+				lpConnection->m_bBroken	= true;
+			}
+			break;
+		}
+
+		for(struct cmsghdr* lpHeader = CMSG_FIRSTHDR(&message);lpHeader;lpHeader = CMSG_NXTHDR(&message, lpHeader))
+		{
+			if(lpHeader->cmsg_level != SOL_SOCKET || lpHeader->cmsg_type != SCM_RIGHTS)
+				continue;
+
+			qint32	iCount	= static_cast<qint32>((lpHeader->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+			int		iFD;
+
+			for(qint32 x = 0;x < iCount;x++)
+			{
+				memcpy(&iFD, CMSG_DATA(lpHeader) + x * sizeof(int), sizeof(int));
+				fcntl(iFD, F_SETFD, FD_CLOEXEC);
+				lpConnection->m_fdList.enqueue(iFD);
+			}
+		}
+
+		if(message.msg_flags & MSG_CTRUNC)
+			qDebug() << "descriptors of a request were dropped, more than" << MAX_FDS << "in one message";
+
+		if(!iRead)
+		{
+			lpConnection->m_bClosed	= true;
+			break;
+		}
+
+		lpConnection->m_input.append(buffer, static_cast<int>(iRead));
+	}
+
+	if(lpConnection->m_bClosed)
+		lpConnection->m_lpReadNotifier->setEnabled(false);
+
+	handleRequests(lpConnection);
+	flush(lpConnection);
+	checkClosed(lpConnection);
+}
+
+void cServer::handleRequests(cServerConnection* lpConnection)
+{
+	qint32	iStart	= 0;
+	qint32	iEnd;
+
+	while(lpConnection->m_iPending < MAX_PIPELINE && lpConnection->m_output.size() < MAX_OUTPUT && (iEnd = lpConnection->m_input.indexOf('\n', iStart)) >= 0)
+	{
+		QByteArray	line	= lpConnection->m_input.mid(iStart, iEnd - iStart).trimmed();
+
+		iStart	= iEnd + 1;
+
+		if(!line.isEmpty())
+			handleRequest(lpConnection, line);
+	}
+	lpConnection->m_input.remove(0, iStart);
+
+	// a line that does not end can't be a request
+	if(lpConnection->m_input.size() >= MAX_LINE && lpConnection->m_input.indexOf('\n') < 0)
+	{
+		lpConnection->m_output.append(errorResponse(QJsonValue(), "request line too long"));
+		lpConnection->m_input.clear();
+		lpConnection->m_bClosed	= true;
+	}
+
+	// stop reading while the connection is at its limits
+	bool	bFull	= lpConnection->m_iPending >= MAX_PIPELINE || lpConnection->m_output.size() >= MAX_OUTPUT || lpConnection->m_input.size() >= MAX_LINE;
+
+	lpConnection->m_lpReadNotifier->setEnabled(!lpConnection->m_bClosed && !bFull);
+}
+
+void cServer::handleRequest(cServerConnection* lpConnection, const QByteArray& line)
+{
+	QJsonParseError	error;
+	QJsonDocument	document	= QJsonDocument::fromJson(line, &error);
+
+	if(!document.isObject())
+	{
+		lpConnection->m_output.append(errorResponse(QJsonValue(), "invalid request: " + error.errorString()));
+		return;
+	}
+
+	QJsonObject	request	= document.object();
+	QJsonValue	id		= request.value("id");
+
+	if(request.contains("command"))
+	{
+		if(request.value("command").toString() != "stats")
+			lpConnection->m_output.append(errorResponse(id, "unknown command"));
+		else if(!m_lpStatistics)
+			lpConnection->m_output.append(errorResponse(id, "statistics are disabled, start the server with --stats"));
+		else
+		{
+			QString		szReport;
+			QTextStream	reportOut(&szReport);
+			QJsonObject	response;
+
+			m_lpStatistics->report(reportOut);
+			reportOut.flush();
+
+			response.insert("id", id);
+			response.insert("ok", true);
+			response.insert("report", szReport);
+			lpConnection->m_output.append(QJsonDocument(response).toJson(QJsonDocument::Compact) + "\n");
+		}
+		return;
+	}
+
+	QString	szFileName;
+	int		iFD	= -1;
+
+	if(request.value("fd").toBool())
+	{
+		if(lpConnection->m_fdList.isEmpty())
+		{
+			lpConnection->m_output.append(errorResponse(id, "no descriptor received for the request"));
+			return;
+		}
+
+		// the file is opened again through the descriptor, so every IO mode works
+		iFD			= lpConnection->m_fdList.dequeue();
+		szFileName	= QString("/dev/fd/%1").arg(iFD);
+	}
+	else if(request.value("path").isString())
+		szFileName	= request.value("path").toString();
+	else
+	{
+		lpConnection->m_output.append(errorResponse(id, "request needs \"path\" or \"fd\""));
+		return;
+	}
+
+	lpConnection->m_iPending++;
+	m_threadPool.start(new cServerTask(this, lpConnection->m_iID, id, szFileName, iFD));
+}
+
+void cServer::processRequest(quint64 iConnection, const QJsonValue& id, const QString& szFileName, int iFD)
+{
+	QElapsedTimer	timer;
+	QFileInfo		fileInfo(szFileName);
+	cPicture		picture;
+	cServerResponse	response;
+
+	timer.start();
+
+	response.m_iConnection	= iConnection;
+	response.m_iFD			= iFD;
+
+	if(m_lpScanner->readPicture(fileInfo, &picture))
+		response.m_line	= record(fileInfo, &picture, id);
+	else
+		response.m_line	= errorResponse(id, "can't read the file or rejected by --where");
+
+	if(m_lpStatistics)
+		m_lpStatistics->addTime("serve/request", timer.nsecsElapsed());
+
+	QMutexLocker	locker(&m_responseMutex);
+
+	m_responseList.append(response);
+
+	// one wake up for all responses finished until the server thread gets to them
+	if(m_responseList.count() == 1)
+		QMetaObject::invokeMethod(this, "onResponses", Qt::QueuedConnection);
+}
+
+void cServer::onResponses()
+{
+	QList<cServerResponse>	responseList;
+
+	{
+		QMutexLocker	locker(&m_responseMutex);
+
+		responseList.swap(m_responseList);
+	}
+
+	QList<cServerConnection*>	touchedList;
+
+	for(int x = 0;x < responseList.count();x++)
+	{
+		const cServerResponse&	response		= responseList.at(x);
+		cServerConnection*		lpConnection	= m_connectionList.value(response.m_iConnection);
+
+		if(response.m_iFD >= 0)
+			::close(response.m_iFD);
+
+		if(!lpConnection)
+			continue;
+
+		lpConnection->m_iPending--;
+		if(!lpConnection->m_bBroken)
+			lpConnection->m_output.append(response.m_line);
+
+		if(!touchedList.contains(lpConnection))
+			touchedList.append(lpConnection);
+	}
+
+	for(int x = 0;x < touchedList.count();x++)
+	{
+		flush(touchedList[x]);
+		handleRequests(touchedList[x]);
+		flush(touchedList[x]);
+		checkClosed(touchedList[x]);
+	}
+}
+
+void cServer::flush(cServerConnection* lpConnection)
+{
+	if(lpConnection->m_bBroken)
+		lpConnection->m_output.clear();
+
+	qint32	iWritten	= 0;
+
+	while(iWritten < lpConnection->m_output.size())
+	{
+		ssize_t	iSent	= send(lpConnection->m_iSocket, lpConnection->m_output.constData() + iWritten, static_cast<size_t>(lpConnection->m_output.size() - iWritten), MSG_DONTWAIT);
+
+		if(iSent < 0)
+		{
+			if(errno == EINTR)
+				continue;
+			if(errno == EAGAIN || errno == EWOULDBLOCK)
+				break;
+
+			// nobody reads the responses any more, the pending requests still have to finish
+			lpConnection->m_bBroken	= true;
+			lpConnection->m_bClosed	= true;
+			lpConnection->m_lpReadNotifier->setEnabled(false);
+			iWritten	= lpConnection->m_output.size();
+			break;
+		}
+
+		iWritten	+= static_cast<qint32>(iSent);
+	}
+
+	lpConnection->m_output.remove(0, iWritten);
+	lpConnection->m_lpWriteNotifier->setEnabled(!lpConnection->m_output.isEmpty());
+}
+
+bool cServer::checkClosed(cServerConnection* lpConnection)
+{
+	if(!lpConnection->m_bClosed || lpConnection->m_iPending || !lpConnection->m_output.isEmpty())
+		return(false);
+
+	// requests received after the last complete line are ignored
+	m_connectionList.remove(lpConnection->m_iID);
+	delete lpConnection;
+	return(true);
+}
+
+QByteArray cServer::errorResponse(const QJsonValue& id, const QString& szError)
+{
+	QJsonObject	response;
+
+	response.insert("id", id);
+	response.insert("ok", false);
+	response.insert("error", szError);
+
+	return(QJsonDocument(response).toJson(QJsonDocument::Compact) + "\n");
+}
+
+QByteArray cServer::record(const QFileInfo& fileInfo, cPicture* lpPicture, const QJsonValue& id)
+{
+	QJsonObject		response;
+	cFilterRecord	filterRecord(fileInfo, lpPicture);
+
+	response.insert("id", id);
+	response.insert("ok", true);
+
+	for(int x = 0;x < m_numberList.count();x++)
+	{
+		double	d;
+
+		if(m_numberList[x](filterRecord, d))
+			response.insert(m_szNumberList[x], d);
+	}
+
+	for(int x = 0;x < m_textList.count();x++)
+	{
+		QString	szValue;
+
+		if(m_textList[x](filterRecord, szValue))
+			response.insert(m_szTextList[x], szValue);
+	}
+
+	if(!lpPicture->contentHash().isEmpty())
+		response.insert("hash", lpPicture->contentHash());
+	if(lpPicture->hasPerceptualHash())
+		response.insert("phash", QString("%1").arg(lpPicture->perceptualHash(), 16, 16, QChar('0')));
+
+	QStringList	szXMPList	= m_lpScanner->xmpProperties();
+	QStringList	xmpValues	= lpPicture->xmpValues();
+
+	for(int x = 0;x < szXMPList.count();x++)
+	{
+		if(!xmpValues.value(x).isEmpty())
+			response.insert(szXMPList[x], xmpValues.value(x));
+	}
+
+	QStringList	szIPTCList	= m_lpScanner->iptcDatasets();
+	QStringList	iptcValues	= lpPicture->iptcValues();
+
+	for(int x = 0;x < szIPTCList.count();x++)
+	{
+		if(!iptcValues.value(x).isEmpty())
+			response.insert("iptc:" + szIPTCList[x], iptcValues.value(x));
+	}
+
+	return(QJsonDocument(response).toJson(QJsonDocument::Compact) + "\n");
+}
@@ -0,0 +1,213 @@
+/*!
+ \file cserver.h
+
+*/
+
+#ifndef CSERVER_H
+#define CSERVER_H
+
+
+#include "cfilter.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QList>
+#include <QHash>
+#include <QQueue>
+#include <QMutex>
+#include <QThreadPool>
+#include <QJsonValue>
+
+
+class QSocketNotifier;
+class QFileInfo;
+class cScanner;
+class cStatistics;
+class cPicture;
+
+/*!
+ \brief State of one client of the server.
+
+ \class cServerConnection cserver.h "cserver.h"
+*/
+class cServerConnection
+{
+public:
+	cServerConnection(quint64 iID, int iSocket);
+	~cServerConnection();
+
+	quint64				m_iID;					/*!< never reused, identifies the connection in finished requests */
+	int					m_iSocket;				/*!< connected socket */
+	QSocketNotifier*	m_lpReadNotifier;		/*!< signals new requests */
+	QSocketNotifier*	m_lpWriteNotifier;		/*!< signals room for more responses */
+	QByteArray			m_input;				/*!< request lines not handled yet */
+	QQueue<int>			m_fdList;				/*!< received descriptors not claimed by a request yet */
+	QByteArray			m_output;				/*!< responses not written yet */
+	qint32				m_iPending;				/*!< requests being read by the workers */
+	bool				m_bClosed;				/*!< the client sent all its requests */
+	bool				m_bBroken;				/*!< the client can't receive any more responses */
+};
+
+/*!
+ \brief Response of a request, handed from a worker thread to the server.
+
+ \class cServerResponse cserver.h "cserver.h"
+*/
+class cServerResponse
+{
+public:
+	quint64				m_iConnection;			/*!< cServerConnection::m_iID */
+	int					m_iFD;					/*!< descriptor of the request to close, or -1 */
+	QByteArray			m_line;					/*!< JSON line */
+};
+
+/*!
+ \brief Long running extraction server on a Unix domain socket.
+
+ The scanner, its cEXIF pool with the tag tables and the thread pool stay
+ alive between requests. Requests and responses are JSON lines:
+
+ {"id":1,"path":"/photos/a.jpg"} reads a file by name.
+ {"id":2,"fd":true} reads a descriptor sent with SCM_RIGHTS in the same
+ message as the request or before it. Descriptors are claimed in the order
+ they are received.
+ {"id":3,"command":"stats"} returns the --stats report.
+
+ The answer is {"id":1,"ok":true,...} with the fields of cFilter (plus
+ hash and phash if enabled) or {"id":1,"ok":false,"error":"..."}.
+
+ Clients may pipeline requests. Up to MAX_PIPELINE requests of a
+ connection are read in parallel and answered as soon as they are done,
+ so responses can come back out of order and are matched by "id".
+
+ \class cServer cserver.h "cserver.h"
+*/
+class cServer : public QObject
+{
+	Q_OBJECT
+public:
+	/*!
+	 \brief
+
+	 \fn cServer
+	 \param lpScanner reads the files
+	 \param parent
+	*/
+	cServer(cScanner* lpScanner, QObject* parent = nullptr);
+	~cServer();
+
+	/*!
+	 \brief Listens on the socket file szPath. An existing socket file is replaced.
+
+	 \fn listen
+	 \param szPath
+	 \return bool
+	*/
+	bool								listen(const QString& szPath);
+	/*!
+	 \brief Number of requests read in parallel, 0 uses the number of CPU cores.
+
+	 \fn setJobs
+	 \param iJobs
+	*/
+	void								setJobs(qint32 iJobs);
+	/*!
+	 \brief Enables the stats command and the serve/ timers.
+
+	 \fn setStatistics
+	 \param lpStatistics
+	*/
+	void								setStatistics(cStatistics* lpStatistics);
+
+	/*!
+	 \brief Reads the file of a request and queues the response. Called from the worker threads.
+
+	 \fn processRequest
+	 \param iConnection
+	 \param id
+	 \param szFileName
+	 \param iFD descriptor closed after the response, or -1
+	*/
+	void								processRequest(quint64 iConnection, const QJsonValue& id, const QString& szFileName, int iFD);
+
+private slots:
+	void								onNewConnection();
+	void								onResponses();
+
+private:
+	cScanner*							m_lpScanner;			/*!< reads the files */
+	cStatistics*						m_lpStatistics;			/*!< statistics, or nullptr */
+	QThreadPool							m_threadPool;			/*!< workers reading the requests */
+	QString								m_szPath;				/*!< socket file */
+	int									m_iSocket;				/*!< listening socket, -1 if not listening */
+	QSocketNotifier*					m_lpAcceptNotifier;		/*!< signals new connections */
+	quint64								m_iNextID;				/*!< id of the next connection */
+	QHash<quint64, cServerConnection*>	m_connectionList;		/*!< connected clients */
+	QMutex								m_responseMutex;		/*!< guards m_responseList */
+	QList<cServerResponse>				m_responseList;			/*!< finished requests not sent yet */
+	QStringList							m_szNumberList;			/*!< number fields of the response */
+	QList<cFilter::cNumberGetter>		m_numberList;			/*!< getters of m_szNumberList */
+	QStringList							m_szTextList;			/*!< text and date fields of the response */
+	QList<cFilter::cTextGetter>			m_textList;				/*!< getters of m_szTextList */
+
+	/*!
+	 \brief Receives request lines and descriptors.
+
+	 \fn onReadable
+	 \param iConnection
+	*/
+	void								onReadable(quint64 iConnection);
+	/*!
+	 \brief Starts the requests received so far, as long as the connection is below its limits.
+
+	 \fn handleRequests
+	 \param lpConnection
+	*/
+	void								handleRequests(cServerConnection* lpConnection);
+	/*!
+	 \brief
+
+	 \fn handleRequest
+	 \param lpConnection
+	 \param line
+	*/
+	void								handleRequest(cServerConnection* lpConnection, const QByteArray& line);
+	/*!
+	 \brief Writes as much of the pending responses as the socket takes.
+
+	 \fn flush
+	 \param lpConnection
+	*/
+	void								flush(cServerConnection* lpConnection);
+	/*!
+	 \brief Deletes the connection once it is closed and all its requests are answered.
+
+	 \fn checkClosed
+	 \param lpConnection
+	 \return bool true if the connection was deleted
+	*/
+	bool								checkClosed(cServerConnection* lpConnection);
+	/*!
+	 \brief
+
+	 \fn errorResponse
+	 \param id
+	 \param szError
+	 \return QByteArray
+	*/
+	static QByteArray					errorResponse(const QJsonValue& id, const QString& szError);
+	/*!
+	 \brief
+
+	 \fn record
+	 \param fileInfo
+	 \param lpPicture
+	 \param id
+	 \return QByteArray
+	*/
+	QByteArray							record(const QFileInfo& fileInfo, cPicture* lpPicture, const QJsonValue& id);
+};
+
+#endif // CSERVER_H
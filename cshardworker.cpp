@@ -0,0 +1,204 @@
+/*!
+ \file cshardworker.cpp
+
+*/
+
+#include "cshardworker.h"
+#include "cscanner.h"
+
+#include <QCoreApplication>
+#include <QLocalSocket>
+#include <QTcpSocket>
+#include <QHostInfo>
+#include <QTextStream>
+#include <QStringList>
+#include <QThread>
+
+#include <QDebug>
+
+
+#define SOCKET_TIMEOUT		30000
+#define WAIT_INTERVAL		1000
+#define MAX_PENDING_WRITE	(1024 * 1024)
+
+
+cShardRowDevice::cShardRowDevice(QIODevice* lpSocket, qint32 iShard) :
+	m_lpSocket(lpSocket),
+	m_prefix(QString("ROW %1\t").arg(iShard).toUtf8())
+{
+}
+
+qint64 cShardRowDevice::readData(char* /*lpData*/, qint64 /*iMaxSize*/)
+{
+	return(-1);
+}
+
+qint64 cShardRowDevice::writeData(const char* lpData, qint64 iSize)
+{
+	m_buffer.append(lpData, static_cast<int>(iSize));
+
+	qint32	iStart	= 0;
+	qint32	iEnd;
+
+	while((iEnd = m_buffer.indexOf('\n', iStart)) >= 0)
+	{
+		m_lpSocket->write(m_prefix);
+		m_lpSocket->write(m_buffer.constData() + iStart, iEnd - iStart + 1);
+		iStart	= iEnd + 1;
+	}
+	m_buffer.remove(0, iStart);
+
+	// don't let the socket buffer grow while the coordinator is slow
+	while(m_lpSocket->bytesToWrite() > MAX_PENDING_WRITE)
+	{
+		if(!m_lpSocket->waitForBytesWritten(SOCKET_TIMEOUT))
+			return(-1);
+	}
+
+	return(iSize);
+}
+
+cShardWorker::cShardWorker(cScanner* lpScanner) :
+	m_lpScanner(lpScanner),
+	m_lpSocket(nullptr)
+{
+}
+
+cShardWorker::~cShardWorker()
+{
+	m_lpScanner->setProgress(cScanner::cProgress());
+	delete m_lpSocket;
+}
+
+bool cShardWorker::run(const QString& szAddress)
+{
+	if(!connectTo(szAddress))
+	{
+		qDebug() << "can't connect to coordinator" << szAddress;
+		return(false);
+	}
+
+	QString		szHeader;
+	QTextStream	headerOut(&szHeader);
+
+	m_lpScanner->writeHeader(headerOut);
+	headerOut.flush();
+	szHeader.chop(1);
+
+	send(QString("HELLO %1:%2\t%3").arg(QHostInfo::localHostName()).arg(QCoreApplication::applicationPid()).arg(szHeader));
+
+	// the rows of a directory are only written when all of its files are read, --worker-timeout must not expire meanwhile
+	m_lpScanner->setProgress([this]() { send("ALIVE"); });
+
+	for(;;)
+	{
+		QString	szLine;
+
+		if(!send("CLAIM") || !readLine(szLine))
+			return(false);
+
+		if(szLine == "DONE")
+			return(true);
+
+		if(szLine == "WAIT")
+		{
+			QThread::msleep(WAIT_INTERVAL);
+			continue;
+		}
+
+		if(szLine.startsWith("REJECT "))
+		{
+			qDebug() << "coordinator rejected the worker:" << szLine.mid(7);
+			return(false);
+		}
+
+		if(!szLine.startsWith("SHARD "))
+			return(false);
+
+		qint32		iShard	= szLine.mid(6).toInt();
+		QStringList	itemList;
+
+		for(;;)
+		{
+			if(!readLine(szLine))
+				return(false);
+			if(szLine == "END")
+				break;
+			if(szLine.startsWith("ITEM "))
+				itemList.append(szLine.mid(5));
+		}
+
+		cShardRowDevice	device(m_lpSocket, iShard);
+		device.open(QIODevice::WriteOnly);
+
+		QTextStream		out(&device);
+
+		for(int x = 0;x < itemList.count();x++)
+		{
+			QString	szItem	= itemList[x];
+
+			m_lpScanner->readDirectory(szItem.mid(2), out, szItem.startsWith("r\t"));
+			out.flush();
+		}
+
+		if(!send(QString("FINISHED %1").arg(iShard)))
+			return(false);
+	}
+}
+
+bool cShardWorker::connectTo(const QString& szAddress)
+{
+	if(szAddress.startsWith("local:"))
+	{
+		QLocalSocket*	lpSocket	= new QLocalSocket;
+
+		m_lpSocket	= lpSocket;
+		lpSocket->connectToServer(szAddress.mid(6));
+		return(lpSocket->waitForConnected(SOCKET_TIMEOUT));
+	}
+
+	if(szAddress.startsWith("tcp:"))
+	{
+		QString		szHostPort	= szAddress.mid(4);
+		qint32		iColon		= szHostPort.lastIndexOf(':');
+
+		if(iColon < 0)
+			return(false);
+
+		QTcpSocket*	lpSocket	= new QTcpSocket;
+
+		m_lpSocket	= lpSocket;
+		lpSocket->connectToHost(szHostPort.left(iColon), static_cast<quint16>(szHostPort.mid(iColon + 1).toUInt()));
+		return(lpSocket->waitForConnected(SOCKET_TIMEOUT));
+	}
+
+	return(false);
+}
+
+bool cShardWorker::readLine(QString& szLine)
+{
+	while(!m_lpSocket->canReadLine())
+	{
+		// the coordinator may take a while to hand out a shard, only a closed connection ends the wait
+		if(!m_lpSocket->waitForReadyRead(SOCKET_TIMEOUT))
+		{
+			QLocalSocket*	lpLocal	= qobject_cast<QLocalSocket*>(m_lpSocket);
+			QTcpSocket*		lpTcp	= qobject_cast<QTcpSocket*>(m_lpSocket);
+
+			if((lpLocal && lpLocal->state() != QLocalSocket::ConnectedState) || (lpTcp && lpTcp->state() != QAbstractSocket::ConnectedState))
+				return(false);
+		}
+	}
+
+	szLine	= QString::fromUtf8(m_lpSocket->readLine());
+	szLine.chop(1);
+	return(true);
+}
+
+bool cShardWorker::send(const QString& szLine)
+{
+	m_lpSocket->write(szLine.toUtf8());
+	m_lpSocket->write("\n");
+
+	return(m_lpSocket->waitForBytesWritten(SOCKET_TIMEOUT) || !m_lpSocket->bytesToWrite());
+}
@@ -0,0 +1,104 @@
+/*!
+ \file cshardworker.h
+
+*/
+
+#ifndef CSHARDWORKER_H
+#define CSHARDWORKER_H
+
+
+#include <QIODevice>
+#include <QString>
+#include <QByteArray>
+
+
+class cScanner;
+
+/*!
+ \brief Output device of a worker forwarding every written row to the coordinator as "ROW id\<tab\>row".
+
+ \class cShardRowDevice cshardworker.h "cshardworker.h"
+*/
+class cShardRowDevice : public QIODevice
+{
+public:
+	/*!
+	 \brief
+
+	 \fn cShardRowDevice
+	 \param lpSocket
+	 \param iShard
+	*/
+	cShardRowDevice(QIODevice* lpSocket, qint32 iShard);
+
+protected:
+	qint64				readData(char* lpData, qint64 iMaxSize);
+	qint64				writeData(const char* lpData, qint64 iSize);
+
+private:
+	QIODevice*			m_lpSocket;					/*!< connection to the coordinator */
+	QByteArray			m_prefix;					/*!< "ROW id\t" */
+	QByteArray			m_buffer;					/*!< incomplete row */
+};
+
+/*!
+ \brief Worker side of the sharded scan.
+
+ Connects to a coordinator, claims shards until the coordinator answers
+ DONE and reads them with the given scanner. Uses blocking socket calls, no
+ event loop is needed.
+
+ \class cShardWorker cshardworker.h "cshardworker.h"
+*/
+class cShardWorker
+{
+public:
+	/*!
+	 \brief
+
+	 \fn cShardWorker
+	 \param lpScanner
+	*/
+	cShardWorker(cScanner* lpScanner);
+	~cShardWorker();
+
+	/*!
+	 \brief Runs until the coordinator has no more shards. szAddress is "local:name" or "tcp:host:port".
+
+	 \fn run
+	 \param szAddress
+	 \return bool
+	*/
+	bool				run(const QString& szAddress);
+
+private:
+	cScanner*			m_lpScanner;				/*!< scanner reading the shards */
+	QIODevice*			m_lpSocket;					/*!< connection to the coordinator */
+
+	/*!
+	 \brief
+
+	 \fn connectTo
+	 \param szAddress
+	 \return bool
+	*/
+	bool				connectTo(const QString& szAddress);
+	/*!
+	 \brief
+
+	 \fn readLine
+	 \param szLine
+	 \return bool
+	*/
+	bool				readLine(QString& szLine);
+	/*!
+	 \brief
+
+	 \fn send
+	 \param szLine
+	 \return bool
+	*/
+	bool				send(const QString& szLine);
+};
+
+#endif // CSHARDWORKER_H
@@ -0,0 +1,80 @@
+/*!
+ \file cstatistics.cpp
+
+*/
+
+#include "cstatistics.h"
+
+#include <QMutexLocker>
+#include <QStringList>
+
+
+cStatisticsValue::cStatisticsValue() :
+	m_iCount(0),
+	m_iTotal(0),
+	m_iMin(0),
+	m_iMax(0)
+{
+}
+
+cStatistics::cStatistics()
+{
+}
+
+void cStatistics::addTime(const QString& szName, qint64 iNanoSeconds)
+{
+	QMutexLocker		locker(&m_mutex);
+	cStatisticsValue&	value	= m_timerList[szName];
+
+	if(!value.m_iCount || iNanoSeconds < value.m_iMin)
+		value.m_iMin	= iNanoSeconds;
+	if(iNanoSeconds > value.m_iMax)
+		value.m_iMax	= iNanoSeconds;
+
+	value.m_iCount++;
+	value.m_iTotal	+= iNanoSeconds;
+}
+
+void cStatistics::addCount(const QString& szName, qint64 iCount)
+{
+	QMutexLocker	locker(&m_mutex);
+
+	m_counterList[szName]	+= iCount;
+}
+
+void cStatistics::log(const QString& szMessage)
+{
+	QMutexLocker	locker(&m_mutex);
+
+	m_logList.append(szMessage);
+}
+
+void cStatistics::report(QTextStream& out)
+{
+	QMutexLocker	locker(&m_mutex);
+
+	out << "timer" << "\t" << "count" << "\t" << "total ms" << "\t" << "avg us" << "\t" << "min us" << "\t" << "max us" << "\n";
+
+	for(QMap<QString, cStatisticsValue>::const_iterator i = m_timerList.constBegin();i != m_timerList.constEnd();++i)
+	{
+		const cStatisticsValue&	value	= i.value();
+
+		out << i.key() << "\t" << value.m_iCount << "\t" << QString::number(value.m_iTotal / 1000000.0, 'f', 3) << "\t" << QString::number(value.m_iTotal / 1000.0 / value.m_iCount, 'f', 1) << "\t" << QString::number(value.m_iMin / 1000.0, 'f', 1) << "\t" << QString::number(value.m_iMax / 1000.0, 'f', 1) << "\n";
+	}
+
+	if(!m_counterList.isEmpty())
+	{
+		out << "\n" << "counter" << "\t" << "value" << "\n";
+
+		for(QMap<QString, qint64>::const_iterator i = m_counterList.constBegin();i != m_counterList.constEnd();++i)
+			out << i.key() << "\t" << i.value() << "\n";
+	}
+
+	if(!m_logList.isEmpty())
+	{
+		out << "\n" << "log" << "\n";
+
+		for(int x = 0;x < m_logList.count();x++)
+			out << m_logList[x] << "\n";
+	}
+}
@@ -0,0 +1,85 @@
+/*!
+ \file cstatistics.h
+
+*/
+
+#ifndef CSTATISTICS_H
+#define CSTATISTICS_H
+
+
+#include <QString>
+#include <QMap>
+#include <QStringList>
+#include <QMutex>
+#include <QTextStream>
+
+
+/*!
+ \brief Accumulated counter or timer.
+
+ \class cStatisticsValue cstatistics.h "cstatistics.h"
+*/
+class cStatisticsValue
+{
+public:
+	cStatisticsValue();
+
+	qint64		m_iCount;					/*!< number of samples */
+	qint64		m_iTotal;					/*!< sum of the samples (nanoseconds for timers) */
+	qint64		m_iMin;						/*!< smallest sample */
+	qint64		m_iMax;						/*!< largest sample */
+};
+
+/*!
+ \brief Thread safe collection of named timers and counters for the --stats report.
+
+ Names are grouped by the part before the first '/', e.g. "exiv2/cr2" and
+ "libraw/cr2" can be compared directly in the report.
+
+ \class cStatistics cstatistics.h "cstatistics.h"
+*/
+class cStatistics
+{
+public:
+	cStatistics();
+
+	/*!
+	 \brief Adds a timer sample.
+
+	 \fn addTime
+	 \param szName
+	 \param iNanoSeconds
+	*/
+	void							addTime(const QString& szName, qint64 iNanoSeconds);
+	/*!
+	 \brief Adds to a counter.
+
+	 \fn addCount
+	 \param szName
+	 \param iCount
+	*/
+	void							addCount(const QString& szName, qint64 iCount = 1);
+	/*!
+	 \brief Adds a line to the log section of the report.
+
+	 \fn log
+	 \param szMessage
+	*/
+	void							log(const QString& szMessage);
+
+	/*!
+	 \brief
+
+	 \fn report
+	 \param out
+	*/
+	void							report(QTextStream& out);
+
+private:
+	QMutex							m_mutex;				/*!< guards all members */
+	QMap<QString, cStatisticsValue>	m_timerList;			/*!< timers by name */
+	QMap<QString, qint64>			m_counterList;			/*!< counters by name */
+	QStringList						m_logList;				/*!< log lines */
+};
+
+#endif // CSTATISTICS_H
@@ -0,0 +1,327 @@
+/*!
+ \file cthumbnailpack.cpp
+
+*/
+
+#include "cthumbnailpack.h"
+
+#include <QMutexLocker>
+#include <QtEndian>
+
+#include <algorithm>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+
+#define PACK_MAGIC			0x4b504551		// "QEPK"
+#define PACK_VERSION		1
+#define PACK_HEADER_SIZE	24
+#define PACK_ENTRY_SIZE		32
+
+
+static bool entryLessThan(const cThumbnailPackEntry& e1, const cThumbnailPackEntry& e2)
+{
+	return(e1.m_iFileID < e2.m_iFileID);
+}
+
+cThumbnailPack::cThumbnailPack(const QString& szBaseName, qint64 iSegmentSize) :
+	m_szBaseName(szBaseName),
+	m_iSegmentSize(iSegmentSize),
+	m_iNextOffset(0),
+	m_bOpen(false)
+{
+}
+
+cThumbnailPack::~cThumbnailPack()
+{
+	if(m_bOpen)
+		close();
+}
+
+bool cThumbnailPack::open()
+{
+	m_iNextOffset.storeRelease(0);
+	m_indexList.clear();
+
+	QFile*	lpFile	= segment(0);
+	if(!lpFile)
+		return(false);
+
+	m_bOpen	= true;
+	return(true);
+}
+
+bool cThumbnailPack::append(quint64 iFileID, const QByteArray& data, qint32 iWidth, qint32 iHeight)
+{
+	if(!m_bOpen || data.isEmpty() || data.size() > m_iSegmentSize)
+		return(false);
+
+	qint64	iOffset		= reserve(data.size());
+	QFile*	lpFile		= segment(static_cast<qint32>(iOffset / m_iSegmentSize));
+
+	if(!lpFile)
+		return(false);
+
+	if(!writeAt(lpFile, iOffset % m_iSegmentSize, data))
+		return(false);
+
+	cThumbnailPackEntry	entry;
+
+	entry.m_iFileID	= iFileID;
+	entry.m_iOffset	= static_cast<quint64>(iOffset);
+	entry.m_iLength	= static_cast<quint32>(data.size());
+	entry.m_iWidth	= static_cast<quint32>(iWidth);
+	entry.m_iHeight	= static_cast<quint32>(iHeight);
+
+	QMutexLocker	locker(&m_indexMutex);
+	m_indexList.append(entry);
+
+	return(true);
+}
+
+bool cThumbnailPack::close()
+{
+	if(!m_bOpen)
+		return(false);
+
+	m_bOpen	= false;
+
+	for(int x = 0;x < m_segmentList.count();x++)
+	{
+		m_segmentList[x]->close();
+		delete m_segmentList[x];
+	}
+	m_segmentList.clear();
+
+	std::sort(m_indexList.begin(), m_indexList.end(), entryLessThan);
+
+	QFile	indexFile(indexName(m_szBaseName));
+	if(!indexFile.open(QFile::WriteOnly | QFile::Truncate))
+		return(false);
+
+	QByteArray	buffer(PACK_HEADER_SIZE + m_indexList.count() * PACK_ENTRY_SIZE, 0);
+	uchar*		lpData	= reinterpret_cast<uchar*>(buffer.data());
+
+	qToLittleEndian<quint32>(PACK_MAGIC, lpData);
+	qToLittleEndian<quint32>(PACK_VERSION, lpData + 4);
+	qToLittleEndian<quint64>(static_cast<quint64>(m_indexList.count()), lpData + 8);
+	qToLittleEndian<quint64>(static_cast<quint64>(m_iSegmentSize), lpData + 16);
+
+	lpData	+= PACK_HEADER_SIZE;
+
+	for(int x = 0;x < m_indexList.count();x++, lpData += PACK_ENTRY_SIZE)
+	{
+		const cThumbnailPackEntry&	entry	= m_indexList.at(x);
+
+		qToLittleEndian<quint64>(entry.m_iFileID, lpData);
+		qToLittleEndian<quint64>(entry.m_iOffset, lpData + 8);
+		qToLittleEndian<quint32>(entry.m_iLength, lpData + 16);
+		qToLittleEndian<quint32>(entry.m_iWidth, lpData + 20);
+		qToLittleEndian<quint32>(entry.m_iHeight, lpData + 24);
+	}
+
+	bool	bOK	= (indexFile.write(buffer) == buffer.size());
+	indexFile.close();
+
+	m_indexList.clear();
+	return(bOK);
+}
+
+quint64 cThumbnailPack::fileID(const QString& szFilePath)
+{
+	QByteArray	path	= szFilePath.toUtf8();
+	quint64		iHash	= Q_UINT64_C(14695981039346656037);
+
+	for(int x = 0;x < path.size();x++)
+	{
+		iHash	^= static_cast<uchar>(path.at(x));
+		iHash	*= Q_UINT64_C(1099511628211);
+	}
+	return(iHash);
+}
+
+QString cThumbnailPack::segmentName(const QString& szBaseName, qint32 iSegment)
+{
+	return(QString("%1.%2.pack").arg(szBaseName).arg(iSegment, 4, 10, QChar('0')));
+}
+
+QString cThumbnailPack::indexName(const QString& szBaseName)
+{
+	return(szBaseName + ".idx");
+}
+
+qint64 cThumbnailPack::reserve(qint64 iLength)
+{
+	for(;;)
+	{
+		qint64	iCurrent	= m_iNextOffset.loadAcquire();
+		qint64	iOffset		= iCurrent;
+
+		if(iOffset % m_iSegmentSize + iLength > m_iSegmentSize)
+			iOffset	= (iOffset / m_iSegmentSize + 1) * m_iSegmentSize;
+
+		if(m_iNextOffset.testAndSetOrdered(iCurrent, iOffset + iLength))
+			return(iOffset);
+	}
+}
+
+QFile* cThumbnailPack::segment(qint32 iSegment)
+{
+	QMutexLocker	locker(&m_segmentMutex);
+
+	while(m_segmentList.count() <= iSegment)
+	{
+		QFile*	lpFile	= new QFile(segmentName(m_szBaseName, m_segmentList.count()));
+
+		if(!lpFile->open(QFile::ReadWrite | QFile::Truncate))
+		{
+			delete lpFile;
+			return(nullptr);
+		}
+		m_segmentList.append(lpFile);
+	}
+	return(m_segmentList[iSegment]);
+}
+
+bool cThumbnailPack::writeAt(QFile* lpFile, qint64 iOffset, const QByteArray& data)
+{
+#ifdef Q_OS_UNIX
+	const char*	lpData	= data.constData();
+	qint64		iLeft	= data.size();
+
+	while(iLeft > 0)
+	{
+		ssize_t	iWritten	= ::pwrite(lpFile->handle(), lpData, static_cast<size_t>(iLeft), static_cast<off_t>(iOffset));
+
+		if(iWritten <= 0)
+			return(false);
+
+		lpData	+= iWritten;
+		iOffset	+= iWritten;
+		iLeft	-= iWritten;
+	}
+	return(true);
+#else
+	QMutexLocker	locker(&m_segmentMutex);
+
+	if(!lpFile->seek(iOffset))
+		return(false);
+	return(lpFile->write(data) == data.size());
+#endif
+}
+
+cThumbnailPackReader::cThumbnailPackReader(const QString& szBaseName) :
+	m_szBaseName(szBaseName),
+	m_indexFile(cThumbnailPack::indexName(szBaseName)),
+	m_lpIndex(nullptr),
+	m_iCount(0),
+	m_iSegmentSize(0)
+{
+}
+
+cThumbnailPackReader::~cThumbnailPackReader()
+{
+	for(int x = 0;x < m_segmentList.count();x++)
+		delete m_segmentList[x];
+}
+
+bool cThumbnailPackReader::open()
+{
+	if(!m_indexFile.open(QFile::ReadOnly))
+		return(false);
+
+	if(m_indexFile.size() < PACK_HEADER_SIZE)
+		return(false);
+
+	m_lpIndex	= m_indexFile.map(0, m_indexFile.size());
+	if(!m_lpIndex)
+		return(false);
+
+	if(qFromLittleEndian<quint32>(m_lpIndex) != PACK_MAGIC || qFromLittleEndian<quint32>(m_lpIndex + 4) != PACK_VERSION)
+		return(false);
+
+	m_iCount		= static_cast<qint64>(qFromLittleEndian<quint64>(m_lpIndex + 8));
+	m_iSegmentSize	= static_cast<qint64>(qFromLittleEndian<quint64>(m_lpIndex + 16));
+
+	if(m_iSegmentSize <= 0 || PACK_HEADER_SIZE + m_iCount * PACK_ENTRY_SIZE > m_indexFile.size())
+		return(false);
+
+	return(true);
+}
+
+qint64 cThumbnailPackReader::count()
+{
+	return(m_iCount);
+}
+
+QByteArray cThumbnailPackReader::find(quint64 iFileID, cThumbnailPackEntry* lpEntry)
+{
+	qint64	iLow	= 0;
+	qint64	iHigh	= m_iCount;
+
+	while(iLow < iHigh)
+	{
+		qint64	iMid	= iLow + (iHigh - iLow) / 2;
+
+		if(qFromLittleEndian<quint64>(m_lpIndex + PACK_HEADER_SIZE + iMid * PACK_ENTRY_SIZE) < iFileID)
+			iLow	= iMid + 1;
+		else
+			iHigh	= iMid;
+	}
+
+	if(iLow >= m_iCount)
+		return(QByteArray());
+
+	cThumbnailPackEntry	found	= entry(iLow);
+	if(found.m_iFileID != iFileID)
+		return(QByteArray());
+
+	qint64			iSegmentSize	= 0;
+	const uchar*	lpSegment		= segment(static_cast<qint32>(found.m_iOffset / m_iSegmentSize), &iSegmentSize);
+	if(!lpSegment)
+		return(QByteArray());
+
+	if(static_cast<qint64>(found.m_iOffset % m_iSegmentSize) + found.m_iLength > iSegmentSize)
+		return(QByteArray());
+
+	if(lpEntry)
+		*lpEntry	= found;
+
+	return(QByteArray::fromRawData(reinterpret_cast<const char*>(lpSegment + found.m_iOffset % m_iSegmentSize), static_cast<int>(found.m_iLength)));
+}
+
+cThumbnailPackEntry cThumbnailPackReader::entry(qint64 iIndex)
+{
+	const uchar*		lpData	= m_lpIndex + PACK_HEADER_SIZE + iIndex * PACK_ENTRY_SIZE;
+	cThumbnailPackEntry	entry;
+
+	entry.m_iFileID	= qFromLittleEndian<quint64>(lpData);
+	entry.m_iOffset	= qFromLittleEndian<quint64>(lpData + 8);
+	entry.m_iLength	= qFromLittleEndian<quint32>(lpData + 16);
+	entry.m_iWidth	= qFromLittleEndian<quint32>(lpData + 20);
+	entry.m_iHeight	= qFromLittleEndian<quint32>(lpData + 24);
+
+	return(entry);
+}
+
+const uchar* cThumbnailPackReader::segment(qint32 iSegment, qint64* lpSize)
+{
+	QMutexLocker	locker(&m_segmentMutex);
+
+	while(m_segmentList.count() <= iSegment)
+	{
+		QFile*			lpFile	= new QFile(cThumbnailPack::segmentName(m_szBaseName, m_segmentList.count()));
+		const uchar*	lpMap	= nullptr;
+
+		if(lpFile->open(QFile::ReadOnly) && lpFile->size() > 0)
+			lpMap	= lpFile->map(0, lpFile->size());
+
+		m_segmentList.append(lpFile);
+		m_segmentMapList.append(lpMap);
+	}
+
+	*lpSize	= m_segmentList[iSegment]->size();
+	return(m_segmentMapList[iSegment]);
+}
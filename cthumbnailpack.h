@@ -0,0 +1,220 @@
+/*!
+ \file cthumbnailpack.h
+
+*/
+
+#ifndef CTHUMBNAILPACK_H
+#define CTHUMBNAILPACK_H
+
+
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QList>
+#include <QFile>
+#include <QMutex>
+#include <QAtomicInteger>
+
+
+/*!
+ \brief One entry of the thumbnail pack index.
+
+ All entries have a fixed size of 32 bytes on disk (little endian) and are
+ sorted by m_iFileID, so the index can be mapped and binary searched directly.
+
+ \class cThumbnailPackEntry cthumbnailpack.h "cthumbnailpack.h"
+*/
+class cThumbnailPackEntry
+{
+public:
+	quint64		m_iFileID;					/*!< key of the picture, see cThumbnailPack::fileID() */
+	quint64		m_iOffset;					/*!< offset over all segments */
+	quint32		m_iLength;					/*!< length of the encoded preview */
+	quint32		m_iWidth;					/*!< width of the preview */
+	quint32		m_iHeight;					/*!< height of the preview */
+};
+
+/*!
+ \brief Appends encoded previews into large segment files and writes a sorted offset index.
+
+ The pack consists of \<base\>.idx and the segments \<base\>.0000.pack,
+ \<base\>.0001.pack, ... Space is reserved with a single atomic operation, so
+ any number of scanner threads can call append() at the same time. A preview
+ never crosses a segment boundary.
+
+ \class cThumbnailPack cthumbnailpack.h "cthumbnailpack.h"
+*/
+class cThumbnailPack
+{
+public:
+	/*!
+	 \brief
+
+	 \fn cThumbnailPack
+	 \param szBaseName
+	 \param iSegmentSize
+	*/
+	cThumbnailPack(const QString& szBaseName, qint64 iSegmentSize = Q_INT64_C(1073741824));
+	~cThumbnailPack();
+
+	/*!
+	 \brief
+
+	 \fn open
+	 \return bool
+	*/
+	bool						open();
+	/*!
+	 \brief Stores the preview. Thread safe.
+
+	 \fn append
+	 \param iFileID
+	 \param data
+	 \param iWidth
+	 \param iHeight
+	 \return bool
+	*/
+	bool						append(quint64 iFileID, const QByteArray& data, qint32 iWidth, qint32 iHeight);
+	/*!
+	 \brief Closes the segments and writes the sorted index.
+
+	 \fn close
+	 \return bool
+	*/
+	bool						close();
+
+	/*!
+	 \brief Stable 64 bit key of a file (FNV-1a of the UTF-8 encoded path).
+
+	 \fn fileID
+	 \param szFilePath
+	 \return quint64
+	*/
+	static quint64				fileID(const QString& szFilePath);
+	/*!
+	 \brief
+
+	 \fn segmentName
+	 \param szBaseName
+	 \param iSegment
+	 \return QString
+	*/
+	static QString				segmentName(const QString& szBaseName, qint32 iSegment);
+	/*!
+	 \brief
+
+	 \fn indexName
+	 \param szBaseName
+	 \return QString
+	*/
+	static QString				indexName(const QString& szBaseName);
+
+private:
+	QString						m_szBaseName;					/*!< path and name of the pack without extension */
+	qint64						m_iSegmentSize;					/*!< maximum size of one segment file */
+	QAtomicInteger<qint64>		m_iNextOffset;					/*!< next free offset over all segments */
+	QMutex						m_segmentMutex;					/*!< guards m_segmentList */
+	QList<QFile*>				m_segmentList;					/*!< opened segment files */
+	QMutex						m_indexMutex;					/*!< guards m_indexList */
+	QVector<cThumbnailPackEntry>	m_indexList;				/*!< collected index entries */
+	bool						m_bOpen;						/*!< open() succeeded and close() was not called yet */
+
+	/*!
+	 \brief
+
+	 \fn reserve
+	 \param iLength
+	 \return qint64
+	*/
+	qint64						reserve(qint64 iLength);
+	/*!
+	 \brief
+
+	 \fn segment
+	 \param iSegment
+	 \return QFile
+	*/
+	QFile*						segment(qint32 iSegment);
+	/*!
+	 \brief
+
+	 \fn writeAt
+	 \param lpFile
+	 \param iOffset
+	 \param data
+	 \return bool
+	*/
+	bool						writeAt(QFile* lpFile, qint64 iOffset, const QByteArray& data);
+};
+
+/*!
+ \brief Read access to a thumbnail pack over memory mapped files.
+
+ \class cThumbnailPackReader cthumbnailpack.h "cthumbnailpack.h"
+*/
+class cThumbnailPackReader
+{
+public:
+	/*!
+	 \brief
+
+	 \fn cThumbnailPackReader
+	 \param szBaseName
+	*/
+	cThumbnailPackReader(const QString& szBaseName);
+	~cThumbnailPackReader();
+
+	/*!
+	 \brief
+
+	 \fn open
+	 \return bool
+	*/
+	bool						open();
+	/*!
+	 \brief
+
+	 \fn count
+	 \return qint64
+	*/
+	qint64						count();
+	/*!
+	 \brief Looks up a preview. The returned array references the mapped segment and does not copy.
+
+	 \fn find
+	 \param iFileID
+	 \param lpEntry
+	 \return QByteArray
+	*/
+	QByteArray					find(quint64 iFileID, cThumbnailPackEntry* lpEntry = nullptr);
+
+private:
+	QString						m_szBaseName;					/*!< path and name of the pack without extension */
+	QFile						m_indexFile;					/*!< the index file */
+	const uchar*				m_lpIndex;						/*!< mapped index */
+	qint64						m_iCount;						/*!< number of index entries */
+	qint64						m_iSegmentSize;					/*!< segment size stored in the index */
+	QMutex						m_segmentMutex;					/*!< guards the segment lists */
+	QList<QFile*>				m_segmentList;					/*!< opened segment files */
+	QList<const uchar*>			m_segmentMapList;				/*!< mapped segments */
+
+	/*!
+	 \brief
+
+	 \fn entry
+	 \param iIndex
+	 \return cThumbnailPackEntry
+	*/
+	cThumbnailPackEntry			entry(qint64 iIndex);
+	/*!
+	 \brief
+
+	 \fn segment
+	 \param iSegment
+	 \param lpSize
+	 \return const uchar
+	*/
+	const uchar*				segment(qint32 iSegment, qint64* lpSize);
+};
+
+#endif // CTHUMBNAILPACK_H
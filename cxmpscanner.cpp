@@ -0,0 +1,487 @@
+/*!
+ \file cxmpscanner.cpp
+
+*/
+
+#include "cxmpscanner.h"
+
+#include <cstring>
+
+
+#define RDF_NAMESPACE	"http://www.w3.org/1999/02/22-rdf-syntax-ns#"
+#define MAX_ATTRIBUTES	64
+
+
+/*!
+ \brief Position of an attribute inside the packet.
+
+ \class cXMPAttribute
+*/
+class cXMPAttribute
+{
+public:
+	const char*	m_lpName;					/*!< qualified name */
+	qint32		m_iNameLength;				/*!< length of m_lpName */
+	const char*	m_lpValue;					/*!< value without the quotes, not decoded */
+	qint32		m_iValueLength;				/*!< length of m_lpValue */
+};
+
+/*!
+ \brief Returns the first occurrence of szPattern in [lpData, lpEnd), or lpEnd.
+
+ \fn findString
+ \param lpData
+ \param lpEnd
+ \param szPattern
+ \return const char
+*/
+static const char* findString(const char* lpData, const char* lpEnd, const char* szPattern)
+{
+	size_t	iLength	= strlen(szPattern);
+
+	while(lpData + iLength <= lpEnd)
+	{
+		const char*	lpFirst	= static_cast<const char*>(memchr(lpData, szPattern[0], static_cast<size_t>(lpEnd - lpData)));
+
+		if(!lpFirst || lpFirst + iLength > lpEnd)
+			break;
+		if(!memcmp(lpFirst, szPattern, iLength))
+			return(lpFirst);
+		lpData	= lpFirst + 1;
+	}
+	return(lpEnd);
+}
+
+/*!
+ \brief
+
+ \fn isSpace
+ \param c
+ \return bool
+*/
+static inline bool isSpace(char c)
+{
+	return(c == ' ' || c == '\t' || c == '\r' || c == '\n');
+}
+
+cXMPScanner::cXMPScanner()
+{
+}
+
+bool cXMPScanner::setProperties(const QStringList& szPropertyList)
+{
+	m_propertyList.clear();
+
+	for(int x = 0;x < szPropertyList.count();x++)
+	{
+		QByteArray	name	= szPropertyList[x].trimmed().toUtf8();
+		qint32		iColon	= name.indexOf(':');
+
+		if(iColon <= 0 || iColon == name.size() - 1)
+		{
+			m_propertyList.clear();
+			return(false);
+		}
+
+		cXMPProperty	property;
+
+		property.m_prefix		= name.left(iColon);
+		property.m_namespace	= standardNamespace(property.m_prefix);
+		property.m_name			= name.mid(iColon + 1);
+		m_propertyList.append(property);
+	}
+	return(true);
+}
+
+qint32 cXMPScanner::propertyCount()
+{
+	return(m_propertyList.count());
+}
+
+const QList<cXMPProperty>& cXMPScanner::propertyList()
+{
+	return(m_propertyList);
+}
+
+qint32 cXMPScanner::scan(const char* lpData, qint64 iSize, QStringList& valueList)
+{
+	valueList.clear();
+	for(int x = 0;x < m_propertyList.count();x++)
+		valueList.append(QString());
+
+	if(!lpData || iSize <= 0 || m_propertyList.isEmpty())
+		return(0);
+
+	m_namespaceList.clear();
+
+	const char*		lpEnd			= lpData + iSize;
+	const char*		lpPos			= lpData;
+	qint32			iFound			= 0;
+	qint32			iDepth			= 0;
+	qint32			iProperty		= -1;			// property whose element is open
+	qint32			iPropertyDepth	= 0;
+	bool			bAlt			= false;
+	bool			bDefault		= false;		// the open rdf:li is the x-default item
+	bool			bAltDefault		= false;		// szAlt is the x-default item
+	QString			szText;
+	QString			szAlt;
+	QStringList		itemList;
+	cXMPAttribute	attributeList[MAX_ATTRIBUTES];
+
+	auto	finish	= [&]() {
+		QString	szValue;
+
+		if(bAlt)
+			szValue	= szAlt;
+		else if(!itemList.isEmpty())
+			szValue	= itemList.join("; ");
+		else
+			szValue	= szText;
+
+		// the value has to fit into one tab separated column
+		szValue	= szValue.simplified();
+		if(!szValue.isEmpty() && valueList[iProperty].isEmpty())
+		{
+			valueList[iProperty]	= szValue;
+			iFound++;
+		}
+		iProperty	= -1;
+	};
+
+	while(lpPos < lpEnd && iFound < m_propertyList.count())
+	{
+		const char*	lpTag	= static_cast<const char*>(memchr(lpPos, '<', static_cast<size_t>(lpEnd - lpPos)));
+
+		if(!lpTag)
+			break;
+
+		// text of the open property or of its current item
+		if(iProperty >= 0 && lpTag > lpPos)
+			szText	+= decode(lpPos, lpTag - lpPos);
+
+		lpPos	= lpTag + 1;
+		if(lpPos >= lpEnd)
+			break;
+
+		if(*lpPos == '?')
+		{
+			lpPos	= findString(lpPos, lpEnd, "?>") + 2;
+			continue;
+		}
+
+		if(*lpPos == '!')
+		{
+			if(lpEnd - lpPos >= 8 && !memcmp(lpPos, "![CDATA[", 8))
+			{
+				const char*	lpCDATA	= findString(lpPos + 8, lpEnd, "]]>");
+
+				if(iProperty >= 0)
+					szText	+= QString::fromUtf8(lpPos + 8, static_cast<int>(lpCDATA - lpPos - 8));
+				lpPos	= lpCDATA + 3;
+			}
+			else if(lpEnd - lpPos >= 3 && !memcmp(lpPos, "!--", 3))
+				lpPos	= findString(lpPos + 3, lpEnd, "-->") + 3;
+			else
+				lpPos	= findString(lpPos, lpEnd, ">") + 1;
+			continue;
+		}
+
+		bool		bClose	= (*lpPos == '/');
+		const char*	lpName	= bClose ? lpPos + 1 : lpPos;
+		const char*	lpCur	= lpName;
+
+		while(lpCur < lpEnd && !isSpace(*lpCur) && *lpCur != '>' && *lpCur != '/')
+			lpCur++;
+
+		qint32	iNameLength	= static_cast<qint32>(lpCur - lpName);
+
+		if(bClose)
+		{
+			lpPos	= findString(lpCur, lpEnd, ">") + 1;
+			iDepth--;
+
+			if(iProperty < 0)
+				continue;
+
+			if(iDepth == iPropertyDepth)
+				finish();
+			else if(isRDF(lpName, iNameLength, "li"))
+			{
+				QString	szItem	= szText.trimmed();
+
+				if(bAlt)
+				{
+					if(bDefault || (!bAltDefault && szAlt.isEmpty()))
+					{
+						szAlt		= szItem;
+						bAltDefault	= bDefault;
+					}
+				}
+				else if(!szItem.isEmpty())
+					itemList.append(szItem);
+				szText.clear();
+			}
+			continue;
+		}
+
+		// attributes
+		qint32	iAttributes	= 0;
+		bool	bEmpty		= false;
+
+		while(lpCur < lpEnd)
+		{
+			while(lpCur < lpEnd && isSpace(*lpCur))
+				lpCur++;
+			if(lpCur >= lpEnd)
+				break;
+
+			if(*lpCur == '>')
+			{
+				lpCur++;
+				break;
+			}
+			if(*lpCur == '/')
+			{
+				bEmpty	= true;
+				lpCur++;
+				continue;
+			}
+
+			const char*	lpAttribute	= lpCur;
+
+			while(lpCur < lpEnd && *lpCur != '=' && !isSpace(*lpCur) && *lpCur != '>')
+				lpCur++;
+
+			qint32	iAttributeLength	= static_cast<qint32>(lpCur - lpAttribute);
+
+			while(lpCur < lpEnd && (isSpace(*lpCur) || *lpCur == '='))
+				lpCur++;
+			if(lpCur >= lpEnd || (*lpCur != '"' && *lpCur != '\''))
+				continue;
+
+			char		cQuote	= *lpCur++;
+			const char*	lpValue	= lpCur;
+			const char*	lpQuote	= static_cast<const char*>(memchr(lpCur, cQuote, static_cast<size_t>(lpEnd - lpCur)));
+
+			if(!lpQuote)
+			{
+				lpCur	= lpEnd;
+				break;
+			}
+			lpCur	= lpQuote + 1;
+
+			if(iAttributes < MAX_ATTRIBUTES)
+			{
+				cXMPAttribute&	attribute	= attributeList[iAttributes++];
+
+				attribute.m_lpName			= lpAttribute;
+				attribute.m_iNameLength		= iAttributeLength;
+				attribute.m_lpValue			= lpValue;
+				attribute.m_iValueLength	= static_cast<qint32>(lpQuote - lpValue);
+			}
+		}
+		lpPos	= lpCur;
+
+		// namespaces first, the element may use them itself
+		for(int x = 0;x < iAttributes;x++)
+		{
+			const cXMPAttribute&	attribute	= attributeList[x];
+
+			if(attribute.m_iNameLength > 6 && !memcmp(attribute.m_lpName, "xmlns:", 6))
+				m_namespaceList.insert(QByteArray(attribute.m_lpName + 6, attribute.m_iNameLength - 6), QByteArray(attribute.m_lpValue, attribute.m_iValueLength));
+		}
+
+		if(iProperty < 0)
+		{
+			// simple properties in the attribute form, usually of rdf:Description
+			for(int x = 0;x < iAttributes;x++)
+			{
+				const cXMPAttribute&	attribute	= attributeList[x];
+				qint32					iIndex		= findProperty(attribute.m_lpName, attribute.m_iNameLength);
+
+				if(iIndex >= 0 && valueList[iIndex].isEmpty())
+				{
+					valueList[iIndex]	= decode(attribute.m_lpValue, attribute.m_iValueLength).simplified();
+					if(!valueList[iIndex].isEmpty())
+						iFound++;
+				}
+			}
+
+			qint32	iIndex	= findProperty(lpName, iNameLength);
+
+			if(iIndex >= 0)
+			{
+				iProperty		= iIndex;
+				iPropertyDepth	= iDepth;
+				bAlt			= false;
+				bAltDefault		= false;
+				szText.clear();
+				szAlt.clear();
+				itemList.clear();
+
+				// a URI value
+				for(int x = 0;x < iAttributes;x++)
+				{
+					if(isRDF(attributeList[x].m_lpName, attributeList[x].m_iNameLength, "resource"))
+						szText	= decode(attributeList[x].m_lpValue, attributeList[x].m_iValueLength);
+				}
+			}
+		}
+		else if(isRDF(lpName, iNameLength, "Alt"))
+			bAlt	= true;
+		else if(isRDF(lpName, iNameLength, "li"))
+		{
+			szText.clear();
+			bDefault	= false;
+
+			for(int x = 0;x < iAttributes;x++)
+			{
+				const cXMPAttribute&	attribute	= attributeList[x];
+
+				if(attribute.m_iNameLength == 8 && !memcmp(attribute.m_lpName, "xml:lang", 8) && attribute.m_iValueLength == 9 && !memcmp(attribute.m_lpValue, "x-default", 9))
+					bDefault	= true;
+			}
+		}
+
+		if(!bEmpty)
+			iDepth++;
+		else if(iProperty >= 0 && iDepth == iPropertyDepth)
+			finish();
+	}
+
+	return(iFound);
+}
+
+QByteArray cXMPScanner::standardNamespace(const QByteArray& prefix)
+{
+	static const QHash<QByteArray, QByteArray>	namespaceList	= {
+		{ "dc", "http://purl.org/dc/elements/1.1/" },
+		{ "xmp", "http://ns.adobe.com/xap/1.0/" },
+		{ "xmpRights", "http://ns.adobe.com/xap/1.0/rights/" },
+		{ "xmpMM", "http://ns.adobe.com/xap/1.0/mm/" },
+		{ "photoshop", "http://ns.adobe.com/photoshop/1.0/" },
+		{ "Iptc4xmpCore", "http://iptc.org/std/Iptc4xmpCore/1.0/xmlns/" },
+		{ "Iptc4xmpExt", "http://iptc.org/std/Iptc4xmpExt/2008-02-29/" },
+		{ "lr", "http://ns.adobe.com/lightroom/1.0/" },
+		{ "exif", "http://ns.adobe.com/exif/1.0/" },
+		{ "tiff", "http://ns.adobe.com/tiff/1.0/" },
+		{ "aux", "http://ns.adobe.com/exif/1.0/aux/" },
+		{ "crs", "http://ns.adobe.com/camera-raw-settings/1.0/" },
+		{ "MicrosoftPhoto", "http://ns.microsoft.com/photo/1.0/" },
+		{ "rdf", RDF_NAMESPACE },
+	};
+
+	return(namespaceList.value(prefix));
+}
+
+qint32 cXMPScanner::findProperty(const char* lpName, qint32 iLength)
+{
+	const char*	lpColon	= static_cast<const char*>(memchr(lpName, ':', static_cast<size_t>(iLength)));
+
+	if(!lpColon)
+		return(-1);
+
+	QByteArray	prefix		= QByteArray::fromRawData(lpName, static_cast<int>(lpColon - lpName));
+	QByteArray	name		= QByteArray::fromRawData(lpColon + 1, static_cast<int>(lpName + iLength - lpColon - 1));
+	QByteArray	namespaceURI;
+	bool		bResolved	= false;
+
+	for(int x = 0;x < m_propertyList.count();x++)
+	{
+		const cXMPProperty&	property	= m_propertyList.at(x);
+
+		if(property.m_name != name)
+			continue;
+
+		// resolved only for a matching local name, most elements don't get here
+		if(!bResolved)
+		{
+			namespaceURI	= m_namespaceList.value(prefix);
+			bResolved		= true;
+		}
+
+		if(!property.m_namespace.isEmpty() && !namespaceURI.isEmpty())
+		{
+			if(property.m_namespace == namespaceURI)
+				return(x);
+		}
+		else if(property.m_prefix == prefix)
+			return(x);
+	}
+	return(-1);
+}
+
+bool cXMPScanner::isRDF(const char* lpName, qint32 iLength, const char* szName)
+{
+	qint32	iNameLength	= static_cast<qint32>(strlen(szName));
+
+	if(iLength <= iNameLength || lpName[iLength - iNameLength - 1] != ':' || memcmp(lpName + iLength - iNameLength, szName, static_cast<size_t>(iNameLength)))
+		return(false);
+
+	QByteArray	prefix	= QByteArray::fromRawData(lpName, iLength - iNameLength - 1);
+
+	if(prefix == "rdf")
+		return(true);
+	return(m_namespaceList.value(prefix) == RDF_NAMESPACE);
+}
+
+QString cXMPScanner::decode(const char* lpData, qint64 iLength)
+{
+	const char*	lpEnd	= lpData + iLength;
+
+	// most values have no references at all
+	if(!memchr(lpData, '&', static_cast<size_t>(iLength)))
+		return(QString::fromUtf8(lpData, static_cast<int>(iLength)));
+
+	QByteArray	utf8;
+
+	utf8.reserve(static_cast<int>(iLength));
+
+	while(lpData < lpEnd)
+	{
+		if(*lpData != '&')
+		{
+			utf8.append(*lpData++);
+			continue;
+		}
+
+		const char*	lpSemicolon	= static_cast<const char*>(memchr(lpData, ';', static_cast<size_t>(qMin<qint64>(lpEnd - lpData, 12))));
+
+		if(!lpSemicolon)
+		{
+			utf8.append(*lpData++);
+			continue;
+		}
+
+		QByteArray	entity	= QByteArray::fromRawData(lpData + 1, static_cast<int>(lpSemicolon - lpData - 1));
+		bool		bOK		= true;
+
+		if(entity == "amp")
+			utf8.append('&');
+		else if(entity == "lt")
+			utf8.append('<');
+		else if(entity == "gt")
+			utf8.append('>');
+		else if(entity == "quot")
+			utf8.append('"');
+		else if(entity == "apos")
+			utf8.append('\'');
+		else if(entity.startsWith('#'))
+		{
+			uint	iCode	= entity.startsWith("#x") ? entity.mid(2).toUInt(&bOK, 16) : entity.mid(1).toUInt(&bOK, 10);
+
+			bOK	= bOK && iCode && iCode <= 0x10ffff;
+			if(bOK)
+				utf8.append(QString::fromUcs4(&iCode, 1).toUtf8());
+		}
+		else
+			bOK	= false;
+
+		// unknown references are kept as they are
+		if(!bOK)
+			utf8.append(lpData, static_cast<int>(lpSemicolon - lpData + 1));
+		lpData	= lpSemicolon + 1;
+	}
+
+	return(QString::fromUtf8(utf8));
+}
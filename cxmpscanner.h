@@ -0,0 +1,127 @@
+/*!
+ \file cxmpscanner.h
+
+*/
+
+#ifndef CXMPSCANNER_H
+#define CXMPSCANNER_H
+
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QList>
+#include <QHash>
+
+
+/*!
+ \brief One property searched by cXMPScanner.
+
+ \class cXMPProperty cxmpscanner.h "cxmpscanner.h"
+*/
+class cXMPProperty
+{
+public:
+	QByteArray	m_prefix;					/*!< prefix as configured, e.g. dc */
+	QByteArray	m_namespace;				/*!< namespace URI of the prefix, empty if the prefix is not a standard one */
+	QByteArray	m_name;						/*!< local name, e.g. subject */
+};
+
+/*!
+ \brief Extracts a configured set of properties from an XMP packet without building a DOM.
+
+ The packet is tokenized in one pass. Properties are found both in the
+ attribute form (<rdf:Description xmp:Rating="5"/>) and in the element
+ form (<xmp:Rating>5</xmp:Rating>). The items of arrays (rdf:Bag, rdf:Seq)
+ are joined with "; ", of language alternatives (rdf:Alt) the x-default
+ item is used.
+
+ Prefixes are resolved through the xmlns declarations of the packet, so
+ "dc:subject" also matches a packet using another prefix for the Dublin
+ Core namespace. Prefixes which are not standard XMP prefixes are compared
+ literally. Structures (rdf:parseType="Resource") are not supported.
+
+ \class cXMPScanner cxmpscanner.h "cxmpscanner.h"
+*/
+class cXMPScanner
+{
+public:
+	cXMPScanner();
+
+	/*!
+	 \brief Sets the properties to search for, as prefix:name.
+
+	 \fn setProperties
+	 \param szPropertyList
+	 \return bool false if a property has no prefix
+	*/
+	bool					setProperties(const QStringList& szPropertyList);
+	/*!
+	 \brief
+
+	 \fn propertyCount
+	 \return qint32
+	*/
+	qint32					propertyCount();
+	/*!
+	 \brief
+
+	 \fn propertyList
+	 \return const QList<cXMPProperty>
+	*/
+	const QList<cXMPProperty>&	propertyList();
+	/*!
+	 \brief Scans a packet.
+
+	 \fn scan
+	 \param lpData
+	 \param iSize
+	 \param valueList receives one value per property, empty if the property is not set
+	 \return qint32 number of properties found
+	*/
+	qint32					scan(const char* lpData, qint64 iSize, QStringList& valueList);
+
+	/*!
+	 \brief Namespace URI of a standard XMP prefix, empty if the prefix is not known.
+
+	 \fn standardNamespace
+	 \param prefix
+	 \return QByteArray
+	*/
+	static QByteArray		standardNamespace(const QByteArray& prefix);
+
+private:
+	QList<cXMPProperty>				m_propertyList;			/*!< properties to search for */
+	QHash<QByteArray, QByteArray>	m_namespaceList;		/*!< prefixes declared in the packet */
+
+	/*!
+	 \brief Returns the index of the property with the qualified name at lpName, -1 if it is not searched for.
+
+	 \fn findProperty
+	 \param lpName
+	 \param iLength length of the name
+	 \return qint32
+	*/
+	qint32					findProperty(const char* lpName, qint32 iLength);
+	/*!
+	 \brief Returns true if the qualified name at lpName is the RDF element szName, e.g. li.
+
+	 \fn isRDF
+	 \param lpName
+	 \param iLength
+	 \param szName
+	 \return bool
+	*/
+	bool					isRDF(const char* lpName, qint32 iLength, const char* szName);
+	/*!
+	 \brief Decodes the character and entity references of XML text.
+
+	 \fn decode
+	 \param lpData
+	 \param iLength
+	 \return QString
+	*/
+	static QString			decode(const char* lpData, qint64 iLength);
+};
+
+#endif // CXMPSCANNER_H
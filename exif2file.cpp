@@ -0,0 +1,183 @@
+/*!
+ \file exif2file.cpp
+
+*/
+
+#include "exif2file.h"
+#include "cexif.h"
+
+#include <QByteArray>
+#include <QDateTime>
+
+#include <exiv2/exiv2.hpp>
+
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+
+/*!
+ \brief Reader handle of the C interface.
+*/
+struct exif2file_reader
+{
+	cEXIF	exif;								/*!< reused for every buffer */
+};
+
+/*!
+ \brief Initializes Exiv2 once per process.
+
+ \fn initialize
+*/
+static void initialize()
+{
+	static std::once_flag	once;
+
+	// the XMP toolkit is not thread safe during initialization
+	std::call_once(once, []() { Exiv2::XmpParser::initialize(); });
+}
+
+/*!
+ \brief Copies a string into a fixed size field, truncated at a character boundary.
+
+ \fn copyString
+ \param szDest
+ \param iSize size of szDest including the terminating 0
+ \param szValue
+*/
+static void copyString(char* szDest, size_t iSize, const QString& szValue)
+{
+	QByteArray	utf8	= szValue.toUtf8();
+	size_t		iLength	= static_cast<size_t>(utf8.size());
+
+	if(iLength >= iSize)
+	{
+		iLength	= iSize - 1;
+
+		// don't cut a multi byte sequence
+		while(iLength && (static_cast<uchar>(utf8.at(static_cast<int>(iLength))) & 0xc0) == 0x80)
+			iLength--;
+	}
+
+	memcpy(szDest, utf8.constData(), iLength);
+	szDest[iLength]	= 0;
+}
+
+/*!
+ \brief
+
+ \fn copyDateTime
+ \param szDest
+ \param iSize
+ \param dateTime
+*/
+static void copyDateTime(char* szDest, size_t iSize, const QDateTime& dateTime)
+{
+	if(dateTime.isValid())
+		copyString(szDest, iSize, dateTime.toString("yyyy-MM-dd hh:mm:ss"));
+}
+
+exif2file_reader* exif2file_reader_new(void)
+{
+	initialize();
+
+	try
+	{
+		return(new exif2file_reader);
+	}
+	catch(...)
+	{
+		return(nullptr);
+	}
+}
+
+void exif2file_reader_free(exif2file_reader* lpReader)
+{
+	delete lpReader;
+}
+
+int exif2file_read(exif2file_reader* lpReader, const void* lpData, size_t iSize, exif2file_info* lpInfo)
+{
+	if(!lpInfo)
+		return(EXIF2FILE_ERROR_ARGUMENT);
+
+	memset(lpInfo, 0, sizeof(*lpInfo));
+
+	// QByteArray is limited to int
+	if(!lpReader || !lpData || !iSize || iSize > static_cast<size_t>(INT_MAX))
+		return(EXIF2FILE_ERROR_ARGUMENT);
+
+	initialize();
+
+	// no exception may cross the C interface
+	try
+	{
+		cEXIF&		exif	= lpReader->exif;
+		QByteArray	buffer	= QByteArray::fromRawData(static_cast<const char*>(lpData), static_cast<int>(iSize));
+
+		// the buffer is the whole file, so cEXIF never falls back to reading a file by name
+		if(!exif.fromBuffer(QString(), buffer, static_cast<qint64>(iSize)))
+			return(EXIF2FILE_ERROR_FORMAT);
+
+		lpInfo->width			= exif.imageWidth();
+		lpInfo->height			= exif.imageHeight();
+		lpInfo->orientation		= exif.imageOrientation();
+		copyString(lpInfo->camera_make, sizeof(lpInfo->camera_make), exif.cameraMake());
+		copyString(lpInfo->camera_model, sizeof(lpInfo->camera_model), exif.cameraModel());
+		copyString(lpInfo->lens_model, sizeof(lpInfo->lens_model), exif.lensModel());
+		copyDateTime(lpInfo->date_time, sizeof(lpInfo->date_time), exif.dateTime());
+		copyDateTime(lpInfo->date_time_original, sizeof(lpInfo->date_time_original), exif.dateTimeOriginal());
+		lpInfo->iso				= exif.iso();
+		lpInfo->focal_length	= exif.focalLength();
+		copyString(lpInfo->f_number, sizeof(lpInfo->f_number), exif.fNumber());
+		copyString(lpInfo->exposure_time, sizeof(lpInfo->exposure_time), exif.exposureTime());
+
+		if(exif.hasTimestamp())
+		{
+			lpInfo->has_timestamp	= 1;
+			lpInfo->timestamp		= exif.timestamp();
+		}
+		if(exif.hasUTCOffset())
+		{
+			lpInfo->has_utc_offset	= 1;
+			lpInfo->utc_offset		= exif.utcOffset();
+		}
+		if(exif.hasGPS())
+		{
+			lpInfo->has_gps			= 1;
+			lpInfo->latitude		= exif.gpsLatitude();
+			lpInfo->longitude		= exif.gpsLongitude();
+		}
+		if(exif.hasGPSAltitude())
+		{
+			lpInfo->has_altitude	= 1;
+			lpInfo->altitude		= exif.gpsAltitude();
+		}
+	}
+	catch(...)
+	{
+		memset(lpInfo, 0, sizeof(*lpInfo));
+		return(EXIF2FILE_ERROR_INTERNAL);
+	}
+
+	return(EXIF2FILE_OK);
+}
+
+int exif2file_extract(const void* lpData, size_t iSize, exif2file_info* lpInfo)
+{
+	static thread_local std::unique_ptr<exif2file_reader>	reader;
+
+	// created on first use and destroyed when the thread exits
+	if(!reader)
+		reader.reset(exif2file_reader_new());
+
+	if(!reader)
+	{
+		if(lpInfo)
+			memset(lpInfo, 0, sizeof(*lpInfo));
+		return(EXIF2FILE_ERROR_INTERNAL);
+	}
+
+	return(exif2file_read(reader.get(), lpData, iSize, lpInfo));
+}
@@ -0,0 +1,113 @@
+/*!
+ \file exif2file.h
+
+ C interface of the qtEXIF2File library.
+
+ A reader keeps the tag tables and buffers of one cEXIF and reuses them
+ for every call. A reader must not be used by two threads at the same
+ time, different readers can be used in parallel. No Qt event loop and
+ no QCoreApplication are needed.
+*/
+
+#ifndef EXIF2FILE_H
+#define EXIF2FILE_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+#if defined(_WIN32) && defined(EXIF2FILE_LIBRARY)
+#define EXIF2FILE_EXPORT __declspec(dllexport)
+#elif defined(_WIN32) && !defined(EXIF2FILE_STATIC)
+#define EXIF2FILE_EXPORT __declspec(dllimport)
+#elif defined(__GNUC__)
+#define EXIF2FILE_EXPORT __attribute__((visibility("default")))
+#else
+#define EXIF2FILE_EXPORT
+#endif
+
+#define EXIF2FILE_OK				0		/*!< the metadata was read */
+#define EXIF2FILE_ERROR_ARGUMENT	-1		/*!< a pointer is null or the buffer is empty or too large */
+#define EXIF2FILE_ERROR_FORMAT		-2		/*!< the buffer is no image Exiv2 can read */
+#define EXIF2FILE_ERROR_INTERNAL	-3		/*!< out of memory or another unexpected error */
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ \brief Opaque reader handle.
+*/
+typedef struct exif2file_reader exif2file_reader;
+
+/*!
+ \brief Metadata of one image. Strings are UTF-8, null terminated and empty if the tag is missing.
+*/
+typedef struct exif2file_info
+{
+	int32_t		width;						/*!< image width in pixels */
+	int32_t		height;						/*!< image height in pixels */
+	int32_t		orientation;				/*!< EXIF orientation, 0 if unknown */
+	char		camera_make[64];			/*!< camera make */
+	char		camera_model[64];			/*!< camera model */
+	char		lens_model[64];				/*!< lens model */
+	char		date_time[20];				/*!< DateTime as yyyy-MM-dd hh:mm:ss in the camera's local time */
+	char		date_time_original[20];		/*!< DateTimeOriginal as yyyy-MM-dd hh:mm:ss in the camera's local time */
+	int32_t		iso;						/*!< ISO speed, 0 if unknown */
+	double		focal_length;				/*!< focal length in mm, 0 if unknown */
+	char		f_number[16];				/*!< f-number */
+	char		exposure_time[16];			/*!< exposure time */
+	int32_t		has_timestamp;				/*!< timestamp is set */
+	int64_t		timestamp;					/*!< capture time in UTC nanoseconds since the epoch */
+	int32_t		has_utc_offset;				/*!< utc_offset is set */
+	int32_t		utc_offset;					/*!< offset of the camera's local time to UTC in seconds */
+	int32_t		has_gps;					/*!< latitude and longitude are set */
+	double		latitude;					/*!< decimal degrees, south is negative */
+	double		longitude;					/*!< decimal degrees, west is negative */
+	int32_t		has_altitude;				/*!< altitude is set */
+	double		altitude;					/*!< meters above sea level */
+} exif2file_info;
+
+/*!
+ \brief Creates a reader.
+
+ \fn exif2file_reader_new
+ \return exif2file_reader nullptr if there is not enough memory
+*/
+EXIF2FILE_EXPORT exif2file_reader*	exif2file_reader_new(void);
+/*!
+ \brief Destroys a reader. Accepts nullptr.
+
+ \fn exif2file_reader_free
+ \param lpReader
+*/
+EXIF2FILE_EXPORT void				exif2file_reader_free(exif2file_reader* lpReader);
+/*!
+ \brief Reads the metadata of an image held in memory. The buffer is not copied and not kept after the call.
+
+ \fn exif2file_read
+ \param lpReader
+ \param lpData complete image file
+ \param iSize
+ \param lpInfo filled on success, cleared otherwise
+ \return int EXIF2FILE_OK or one of the EXIF2FILE_ERROR codes
+*/
+EXIF2FILE_EXPORT int				exif2file_read(exif2file_reader* lpReader, const void* lpData, size_t iSize, exif2file_info* lpInfo);
+/*!
+ \brief exif2file_read() with a reader owned by the calling thread.
+
+ \fn exif2file_extract
+ \param lpData complete image file
+ \param iSize
+ \param lpInfo filled on success, cleared otherwise
+ \return int EXIF2FILE_OK or one of the EXIF2FILE_ERROR codes
+*/
+EXIF2FILE_EXPORT int				exif2file_extract(const void* lpData, size_t iSize, exif2file_info* lpInfo);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EXIF2FILE_H
@@ -1,59 +1,79 @@
 #include <QCoreApplication>
 
-#include "cpicture.h"
+#include "cscanner.h"
+#include "cexif.h"
+#include "cthumbnailpack.h"
+#include "cstatistics.h"
+#include "cduplicatefinder.h"
+#include "cperceptualhash.h"
+#include "cexternalsort.h"
+#include "ccoordinator.h"
+#include "cshardworker.h"
+#include "cgeoindex.h"
+#include "cfilter.h"
+#include "caggregator.h"
+#include "cguard.h"
+
+#ifdef Q_OS_UNIX
+#include "cserver.h"
+#include "cloadtest.h"
+#endif
 
 #include <QCommandLineParser>
 #include <QFile>
 #include <QTextStream>
 #include <QDir>
-#include <QMimeDatabase>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QScopedPointer>
 
 #include <QDebug>
 
 #include <iostream>
 #include <cstdlib>
 
-#define SEPARATOR	"\t"
-
 
-void readDirectory(const QString& szPath, QTextStream& out)
+void writeStatistics(cStatistics& statistics, const QString& szFileName)
 {
-	QTextStream textOut(stdout);
-
-	textOut << "*** DIRECTORY ***: " << szPath << "\n";
-
-	QMimeDatabase	mimeDB;
-	QDir			dir(szPath);
-	QStringList		szDirs	= dir.entryList(QDir::Dirs);
-	QFileInfoList	szFiles	= dir.entryInfoList(QDir::Files);
-	QDateTime		oldDateTime;
-
-	szDirs.removeAll(".");
-	szDirs.removeAll("..");
-
-	for(int x = 0;x < szDirs.count();x++)
-		readDirectory(szPath + QDir::separator() + szDirs[x], out);
-
-	for(int x = 0;x < szFiles.count();x++)
+	if(szFileName == "-")
 	{
-		QFileInfo	fileInfo	= szFiles[x];
-		QMimeType	mimeType	= mimeDB.mimeTypeForFile(szFiles[x]);
+		QTextStream	textOut(stdout);
+		statistics.report(textOut);
+		return;
+	}
 
-		if(mimeType.name().startsWith("image"))
-		{
-			textOut << "--- File: " << fileInfo.fileName() << "\n";
+	QFile	file(szFileName);
 
-			cPicture		picture;
-			if(picture.fromFile(fileInfo.filePath()))
-				out << fileInfo.absolutePath() << SEPARATOR << fileInfo.fileName() << SEPARATOR << fileInfo.size() << SEPARATOR << picture.dateTime().toString("yyyy-MM-dd hh:mm:ss") << SEPARATOR << picture.imageWidth() << SEPARATOR << picture.imageHeight() << SEPARATOR << picture.cameraModel() << "\n";
-		}
+	if(!file.open(QFile::WriteOnly | QFile::Truncate))
+	{
+		qDebug() << "can't write statistics to" << szFileName;
+		return;
 	}
+
+	QTextStream	out(&file);
+	statistics.report(out);
 }
 
 int main(int argc, char *argv[])
 {
-	QCoreApplication	a(argc, argv);
-	QCommandLineParser	parser;
+	QElapsedTimer						startTimer;
+	QScopedPointer<QCoreApplication>	lpApp;
+	QStringList							arguments;
+	QCommandLineParser					parser;
+
+	startTimer.start();
+
+	// the application object is only needed by the modes with an event loop
+	QCoreApplication::setApplicationName("qtEXIF2File");
+#ifdef Q_OS_WIN
+	// argv is not Unicode on Windows, QCoreApplication reads the real command line
+	lpApp.reset(new QCoreApplication(argc, argv));
+	arguments	= QCoreApplication::arguments();
+#else
+	for(int x = 0;x < argc;x++)
+		arguments.append(QString::fromLocal8Bit(argv[x]));
+#endif
 
 	parser.setApplicationDescription("qtEXIF2File help");
 	parser.addHelpOption();
@@ -61,24 +81,663 @@ int main(int argc, char *argv[])
 	parser.addPositionalArgument("source", QCoreApplication::translate("main", "directory to parse"));
 	parser.addPositionalArgument("destination", QCoreApplication::translate("main", "output file name"));
 
-	parser.process(a);
+	QCommandLineOption	jobsOption(QStringList() << "j" << "jobs", QCoreApplication::translate("main", "number of files read in parallel (default: number of CPU cores)"), "count", "0");
+	QCommandLineOption	thumbnailPackOption("thumbnail-pack", QCoreApplication::translate("main", "append the embedded previews to the pack <base>.NNNN.pack with the index <base>.idx"), "base");
+	QCommandLineOption	packSegmentOption("pack-segment-size", QCoreApplication::translate("main", "maximum size of one pack segment in MB (default: 1024)"), "MB", "1024");
+	QCommandLineOption	libRawOption("libraw", QCoreApplication::translate("main", "read the image size of RAW files with LibRaw"));
+	QCommandLineOption	imageFactoryOption("exiv2-factory", QCoreApplication::translate("main", "open every file through the Exiv2 image factory, which probes all formats, instead of the image class of its format (compare exiv2-open/ in --stats)"));
+	QCommandLineOption	hashOption("hash", QCoreApplication::translate("main", "add a content hash (XXH3-128) column"));
+	QCommandLineOption	duplicatesOption("duplicates", QCoreApplication::translate("main", "write groups of identical files to <file>"), "file");
+	QCommandLineOption	phashOption("phash", QCoreApplication::translate("main", "add a perceptual hash (dHash of the embedded preview) column"));
+	QCommandLineOption	similarOption("similar", QCoreApplication::translate("main", "write clusters of similar images to <file>"), "file");
+	QCommandLineOption	similarDistanceOption("similar-distance", QCoreApplication::translate("main", "maximum number of differing perceptual hash bits (default: 6)"), "bits", "6");
+	QCommandLineOption	whereOption("where", QCoreApplication::translate("main", "only write pictures matching <expression>, e.g. \"camera ~ 'EOS R5' AND date >= 2023-01-01 AND iso > 3200\", fields: %1").arg(cFilter::fields().join(", ")), "expression");
+	QCommandLineOption	groupByOption("group-by", QCoreApplication::translate("main", "write one row per group instead of one per picture, <fields> are --where fields or year, month, day"), "fields");
+	QCommandLineOption	aggOption("agg", QCoreApplication::translate("main", "aggregates of --group-by: count, bytes, min(field), max(field), sum(field), avg(field) (default: count,bytes)"), "list", "count,bytes");
+	QCommandLineOption	gpsOption("gps", QCoreApplication::translate("main", "add latitude, longitude (decimal degrees) and altitude (meters) columns"));
+	QCommandLineOption	timestampsOption("timestamps", QCoreApplication::translate("main", "add capture time and GPS time columns in UTC nanoseconds since the epoch and the UTC offset of the camera clock"));
+	QCommandLineOption	lensOption("lens", QCoreApplication::translate("main", "add lens and shutterCount columns, the lens falls back to the Canon, Nikon, Sony and Fujifilm maker notes if the Exif lens tag is empty (also for the lens and shutterCount fields of --where)"));
+	QCommandLineOption	xmpOption("xmp", QCoreApplication::translate("main", "add one column per XMP property, e.g. dc:subject,xmp:Rating,photoshop:City"), "list");
+	QCommandLineOption	iptcOption("iptc", QCoreApplication::translate("main", "add one column per IPTC dataset of record 2, e.g. Keywords,City,Byline"), "list");
+	QCommandLineOption	geoIndexOption("geo-index", QCoreApplication::translate("main", "write a spatial index of all pictures with a position to <file>"), "file");
+	QCommandLineOption	geoQueryOption("geo-query", QCoreApplication::translate("main", "print the pictures of the spatial index <file> inside --bbox and exit"), "file");
+	QCommandLineOption	bboxOption("bbox", QCoreApplication::translate("main", "bounding box for --geo-query"), "minLat,minLon,maxLat,maxLon");
+	QCommandLineOption	sortByOption("sort-by", QCoreApplication::translate("main", "sort the output by <field>: %1").arg(cScanner::sortKeys().join(", ")), "field");
+	QCommandLineOption	sortMemoryOption("sort-memory", QCoreApplication::translate("main", "memory used for sorting before rows are spilled to disk in MB (default: 512)"), "MB", "512");
+	QCommandLineOption	sortTempOption("sort-temp", QCoreApplication::translate("main", "directory for the sort run files and the --similar file list (default: system temp directory)"), "directory");
+	QCommandLineOption	ioOption("io", QCoreApplication::translate("main", "how the metadata is read: %1 (default: read)").arg(cFileInput::ioModes().join(", ")), "mode", "read");
+	QCommandLineOption	ioPrefixOption("io-prefix", QCoreApplication::translate("main", "size of the metadata region read by --io prefix and prefetched by --io mmap in KB (default: 256)"), "KB", "256");
+	QCommandLineOption	queueDepthOption("queue-depth", QCoreApplication::translate("main", "prefetch the metadata region of up to <count> files at the same time (io_uring if available), 0 disables the prefetch (default: 0)"), "count", "0");
+	QCommandLineOption	orderOption("order", QCoreApplication::translate("main", "order the files of a directory are read in: %1 (default: name), the output is always in name order").arg(cDiskOrder::orders().join(", ")), "order", "name");
+	QCommandLineOption	dropCacheOption("drop-cache", QCoreApplication::translate("main", "evict every file from the page cache before reading it (cold cache measurements, Linux only)"));
+	QCommandLineOption	adaptiveOption("adaptive", QCoreApplication::translate("main", "tune the number of workers and the queue depth while scanning from the throughput, CPU utilization and I/O wait, starting at --jobs and --queue-depth and up to four times them (the decisions are logged in --stats)"));
+	QCommandLineOption	guardedOption("guarded", QCoreApplication::translate("main", "read every file in a child process with a time and memory budget, files exceeding it are skipped, written to --error-report and added to --quarantine"));
+	QCommandLineOption	fileTimeoutOption("file-timeout", QCoreApplication::translate("main", "seconds a --guarded child may spend on one file (default: 30, 0 = no limit)"), "seconds", "30");
+	QCommandLineOption	memoryLimitOption("memory-limit", QCoreApplication::translate("main", "address space limit of a --guarded child in MB (default: 4096, 0 = no limit, Unix only)"), "MB", "4096");
+	QCommandLineOption	errorReportOption("error-report", QCoreApplication::translate("main", "write the files a --guarded scan could not read and the reason to <file>"), "file");
+	QCommandLineOption	quarantineOption("quarantine", QCoreApplication::translate("main", "skip the files listed in <file> and append the files that timed out, crashed or ran out of memory in a --guarded scan"), "file");
+	QCommandLineOption	guardChildOption("guard-child", QCoreApplication::translate("main", "read the files a --guarded scan sends on stdin with an address space limit of <MB>"), "MB");
+	QCommandLineOption	batchSizeOption("batch-size", QCoreApplication::translate("main", "maximum number of files a thread reads in one batch (default: 16)"), "count", "16");
+	QCommandLineOption	statsOption("stats", QCoreApplication::translate("main", "write timing statistics to <file> (- for stdout)"), "file");
+	QCommandLineOption	coordinatorOption("coordinator", QCoreApplication::translate("main", "split the source into shards and let worker processes read them"));
+	QCommandLineOption	listenOption("listen", QCoreApplication::translate("main", "accept workers on <address> (local:name or tcp:host:port), may be given more than once"), "address");
+	QCommandLineOption	spawnOption("spawn", QCoreApplication::translate("main", "start <count> local worker processes"), "count", "0");
+	QCommandLineOption	shardsOption("shards", QCoreApplication::translate("main", "number of shards (default: 16)"), "count", "16");
+	QCommandLineOption	workerTimeoutOption("worker-timeout", QCoreApplication::translate("main", "hand a shard out again if its worker sent nothing for <seconds> (default: 300, 0 = never)"), "seconds", "300");
+	QCommandLineOption	workerOption("worker", QCoreApplication::translate("main", "read shards for the coordinator at <address>"), "address");
+	QCommandLineOption	serveOption("serve", QCoreApplication::translate("main", "answer JSON line requests on the Unix domain socket <path> until killed (Unix only)"), "path");
+	QCommandLineOption	loadTestOption("load-test", QCoreApplication::translate("main", "send requests for the files of the source directories to the server at <path> and print the latency percentiles (Unix only)"), "path");
+	QCommandLineOption	connectionsOption("connections", QCoreApplication::translate("main", "parallel connections of --load-test (default: 4)"), "count", "4");
+	QCommandLineOption	requestsOption("requests", QCoreApplication::translate("main", "number of requests of --load-test (default: 10000)"), "count", "10000");
+	QCommandLineOption	pipelineOption("pipeline", QCoreApplication::translate("main", "requests in flight per connection of --load-test (default: 16)"), "count", "16");
+	QCommandLineOption	passFDsOption("pass-fds", QCoreApplication::translate("main", "--load-test sends open file descriptors instead of paths"));
+
+	parser.addOption(jobsOption);
+	parser.addOption(thumbnailPackOption);
+	parser.addOption(packSegmentOption);
+	parser.addOption(libRawOption);
+	parser.addOption(imageFactoryOption);
+	parser.addOption(hashOption);
+	parser.addOption(duplicatesOption);
+	parser.addOption(phashOption);
+	parser.addOption(similarOption);
+	parser.addOption(similarDistanceOption);
+	parser.addOption(whereOption);
+	parser.addOption(groupByOption);
+	parser.addOption(aggOption);
+	parser.addOption(gpsOption);
+	parser.addOption(timestampsOption);
+	parser.addOption(lensOption);
+	parser.addOption(xmpOption);
+	parser.addOption(iptcOption);
+	parser.addOption(geoIndexOption);
+	parser.addOption(geoQueryOption);
+	parser.addOption(bboxOption);
+	parser.addOption(sortByOption);
+	parser.addOption(sortMemoryOption);
+	parser.addOption(sortTempOption);
+	parser.addOption(ioOption);
+	parser.addOption(ioPrefixOption);
+	parser.addOption(queueDepthOption);
+	parser.addOption(orderOption);
+	parser.addOption(dropCacheOption);
+	parser.addOption(adaptiveOption);
+	parser.addOption(guardedOption);
+	parser.addOption(fileTimeoutOption);
+	parser.addOption(memoryLimitOption);
+	parser.addOption(errorReportOption);
+	parser.addOption(quarantineOption);
+	parser.addOption(guardChildOption);
+	parser.addOption(batchSizeOption);
+	parser.addOption(statsOption);
+	parser.addOption(coordinatorOption);
+	parser.addOption(listenOption);
+	parser.addOption(spawnOption);
+	parser.addOption(shardsOption);
+	parser.addOption(workerTimeoutOption);
+	parser.addOption(workerOption);
+	parser.addOption(serveOption);
+	parser.addOption(loadTestOption);
+	parser.addOption(connectionsOption);
+	parser.addOption(requestsOption);
+	parser.addOption(pipelineOption);
+	parser.addOption(passFDsOption);
+
+	parser.process(arguments);
+
+	// --guarded starts its children with QCoreApplication::applicationFilePath()
+	if(!lpApp && (parser.isSet(coordinatorOption) || parser.isSet(workerOption) || parser.isSet(serveOption) || parser.isSet(guardedOption)))
+		lpApp.reset(new QCoreApplication(argc, argv));
+
+	bool				bIOMode;
+	cFileInput::IOMode	ioMode	= cFileInput::ioMode(parser.value(ioOption), &bIOMode);
+	qint64				iPrefixSize	= parser.value(ioPrefixOption).toLongLong() * 1024;
+
+	if(!bIOMode)
+	{
+		qDebug() << "unknown io mode" << parser.value(ioOption);
+		return(1);
+	}
+
+	bool				bOrder;
+	cDiskOrder::Order	order	= cDiskOrder::fromName(parser.value(orderOption), &bOrder);
+
+	if(!bOrder)
+	{
+		qDebug() << "unknown order" << parser.value(orderOption);
+		return(1);
+	}
+
+	cFilter				filter;
+
+	if(parser.isSet(whereOption) && !filter.compile(parser.value(whereOption)))
+	{
+		qDebug() << "invalid --where expression:" << filter.error();
+		return(1);
+	}
+
+	cAggregator			aggregator;
+
+	if(parser.isSet(groupByOption) && !aggregator.compile(parser.value(groupByOption), parser.value(aggOption)))
+	{
+		qDebug() << "invalid --group-by or --agg:" << aggregator.error();
+		return(1);
+	}
+
+	QStringList			xmpList;
+	QStringList			iptcList;
+
+	// QString::SkipEmptyParts is deprecated since Qt 5.14, drop the empty parts by hand
+	if(parser.isSet(xmpOption))
+	{
+		xmpList	= parser.value(xmpOption).split(",");
+		xmpList.removeAll(QString());
+	}
+	if(parser.isSet(iptcOption))
+	{
+		iptcList	= parser.value(iptcOption).split(",");
+		iptcList.removeAll(QString());
+	}
+
+	{
+		cEXIF	exif;
+
+		if(!exif.setXMPProperties(xmpList))
+		{
+			qDebug() << "invalid --xmp list, properties are prefix:name" << parser.value(xmpOption);
+			return(1);
+		}
+
+		if(!exif.setIPTCDatasets(iptcList))
+		{
+			qDebug() << "unknown dataset in --iptc" << parser.value(iptcOption);
+			return(1);
+		}
+	}
+
+	// the options a --guarded child needs to decode the files, the parent does everything else
+	QStringList			guardArgs;
+
+	if(parser.isSet(libRawOption))
+		guardArgs << "--libraw";
+	if(parser.isSet(imageFactoryOption))
+		guardArgs << "--exiv2-factory";
+	guardArgs << "--io" << parser.value(ioOption) << "--io-prefix" << parser.value(ioPrefixOption);
+	// --phash only makes the child read the previews
+	if(parser.isSet(phashOption) || parser.isSet(similarOption) || parser.isSet(thumbnailPackOption))
+		guardArgs << "--phash";
+	if(parser.isSet(lensOption))
+		guardArgs << "--lens";
+	if(!xmpList.isEmpty())
+		guardArgs << "--xmp" << xmpList.join(",");
+	if(!iptcList.isEmpty())
+		guardArgs << "--iptc" << iptcList.join(",");
+
+	if(parser.isSet(guardChildOption))
+	{
+		cScanner		scanner;
+
+		scanner.setLibRaw(parser.isSet(libRawOption));
+		scanner.setImageFactory(parser.isSet(imageFactoryOption));
+		scanner.setIOMode(ioMode, iPrefixSize);
+		scanner.setPerceptualHash(parser.isSet(phashOption));
+		scanner.setLens(parser.isSet(lensOption));
+		scanner.setXMP(xmpList);
+		scanner.setIPTC(iptcList);
+
+		return(cGuard::runChild(&scanner, parser.value(guardChildOption).toInt()));
+	}
+
+	if(parser.isSet(geoQueryOption))
+	{
+		QStringList		bboxList	= parser.value(bboxOption).split(",");
+		cGeoIndexReader	reader(parser.value(geoQueryOption));
+
+		if(bboxList.count() != 4)
+		{
+			qDebug() << "--geo-query needs --bbox minLat,minLon,maxLat,maxLon";
+			return(1);
+		}
+
+		if(!reader.open())
+		{
+			qDebug() << "can't read spatial index" << parser.value(geoQueryOption);
+			return(1);
+		}
+
+		QList<cGeoIndexEntry>	resultList	= reader.query(bboxList[0].toDouble(), bboxList[1].toDouble(), bboxList[2].toDouble(), bboxList[3].toDouble());
+		QTextStream				textOut(stdout);
+
+		for(int x = 0;x < resultList.count();x++)
+			textOut << QString::number(resultList[x].m_dLatitude, 'f', 7) << "\t" << QString::number(resultList[x].m_dLongitude, 'f', 7) << "\t" << resultList[x].m_szFileName << "\n";
+		return(0);
+	}
+
+	if(parser.isSet(loadTestOption))
+	{
+#ifdef Q_OS_UNIX
+		QStringList	fileList;
+		QStringList	sourceList	= parser.positionalArguments();
+
+		for(int x = 0;x < sourceList.count();x++)
+		{
+			if(QFileInfo(sourceList[x]).isFile())
+			{
+				fileList.append(QFileInfo(sourceList[x]).absoluteFilePath());
+				continue;
+			}
+
+			QDirIterator	iterator(sourceList[x], QDir::Files, QDirIterator::Subdirectories);
+
+			while(iterator.hasNext())
+				fileList.append(QFileInfo(iterator.next()).absoluteFilePath());
+		}
+
+		if(fileList.isEmpty())
+		{
+			qDebug() << "--load-test needs files or directories to request";
+			return(1);
+		}
+
+		cLoadTest	loadTest;
+		QTextStream	textOut(stdout);
+
+		loadTest.setConnections(parser.value(connectionsOption).toInt());
+		loadTest.setRequests(parser.value(requestsOption).toInt());
+		loadTest.setPipeline(parser.value(pipelineOption).toInt());
+		loadTest.setPassFDs(parser.isSet(passFDsOption));
+
+		return(loadTest.run(parser.value(loadTestOption), fileList, textOut) ? 0 : 1);
+#else
+		qDebug() << "--load-test needs Unix domain sockets";
+		return(1);
+#endif
+	}
+
+	if(parser.isSet(serveOption))
+	{
+#ifdef Q_OS_UNIX
+		cScanner		scanner;
+		cStatistics		statistics;
+		cServer			server(&scanner);
+
+		// the scanner only reads single files for the server, its own threads stay idle
+		scanner.setLibRaw(parser.isSet(libRawOption));
+		scanner.setImageFactory(parser.isSet(imageFactoryOption));
+		scanner.setIOMode(ioMode, iPrefixSize);
+		scanner.setHash(parser.isSet(hashOption));
+		scanner.setPerceptualHash(parser.isSet(phashOption));
+		scanner.setLens(parser.isSet(lensOption));
+		scanner.setXMP(xmpList);
+		scanner.setIPTC(iptcList);
+		if(parser.isSet(whereOption))
+			scanner.setFilter(&filter);
+
+		server.setJobs(parser.value(jobsOption).toInt());
+
+		if(parser.isSet(statsOption))
+		{
+			scanner.setStatistics(&statistics);
+			server.setStatistics(&statistics);
+		}
+
+		if(!server.listen(parser.value(serveOption)))
+			return(1);
+
+		return(lpApp->exec());
+#else
+		qDebug() << "--serve needs Unix domain sockets";
+		return(1);
+#endif
+	}
+
+	if(parser.isSet(workerOption))
+	{
+		cScanner		scanner;
+		cShardWorker	worker(&scanner);
+		cGuard			guard(guardArgs);
+
+		scanner.setJobs(parser.value(jobsOption).toInt());
+		scanner.setLibRaw(parser.isSet(libRawOption));
+		scanner.setImageFactory(parser.isSet(imageFactoryOption));
+		scanner.setIOMode(ioMode, iPrefixSize);
+		scanner.setQueueDepth(parser.value(queueDepthOption).toInt(), iPrefixSize);
+		scanner.setAdaptive(parser.isSet(adaptiveOption));
+		scanner.setOrder(order);
+		scanner.setDropCache(parser.isSet(dropCacheOption));
+		scanner.setBatchSize(parser.value(batchSizeOption).toInt());
+		scanner.setHash(parser.isSet(hashOption));
+		scanner.setPerceptualHash(parser.isSet(phashOption));
+		scanner.setGPS(parser.isSet(gpsOption));
+		scanner.setTimestamps(parser.isSet(timestampsOption));
+		scanner.setLens(parser.isSet(lensOption));
+		scanner.setXMP(xmpList);
+		scanner.setIPTC(iptcList);
+		if(parser.isSet(whereOption))
+			scanner.setFilter(&filter);
+
+		if(parser.isSet(guardedOption))
+		{
+			guard.setTimeout(parser.value(fileTimeoutOption).toInt());
+			guard.setMemoryLimit(parser.value(memoryLimitOption).toInt());
+			scanner.setGuard(&guard);
+		}
+
+		return(worker.run(parser.value(workerOption)) ? 0 : 1);
+	}
 
 	const QStringList	args	= parser.positionalArguments();
+
+	if(args.count() < 2)
+		parser.showHelp(1);
+
+	if(parser.isSet(sortByOption) && !cScanner::sortKeys().contains(parser.value(sortByOption)))
+	{
+		qDebug() << "unknown sort field" << parser.value(sortByOption);
+		return(1);
+	}
+
+	if(parser.isSet(sortByOption) && parser.isSet(groupByOption))
+	{
+		qDebug() << "--sort-by can't be used with --group-by, the groups are always sorted";
+		return(1);
+	}
+
+	if((parser.isSet(errorReportOption) || parser.isSet(quarantineOption)) && !parser.isSet(guardedOption))
+	{
+		qDebug() << "--error-report and --quarantine need --guarded";
+		return(1);
+	}
+
 	QFile				file(args[1]);
 	QDir				dir(args[0]);
 
+	if(parser.isSet(coordinatorOption))
+	{
+		if(parser.isSet(sortByOption) || parser.isSet(thumbnailPackOption) || parser.isSet(duplicatesOption) || parser.isSet(similarOption) || parser.isSet(geoIndexOption) || parser.isSet(groupByOption))
+		{
+			qDebug() << "--sort-by, --thumbnail-pack, --duplicates, --similar, --geo-index and --group-by are not supported with --coordinator";
+			return(1);
+		}
+
+		if(!dir.exists() || !file.open(QFile::WriteOnly | QFile::Truncate))
+			return(1);
+
+		QTextStream		out(&file);
+		cScanner		scanner;
+		cStatistics		statistics;
+		QString			szHeader;
+		QTextStream		headerOut(&szHeader);
+		QStringList		listenList	= parser.values(listenOption);
+		QStringList		workerArgs;
+
+		scanner.setHash(parser.isSet(hashOption));
+		scanner.setPerceptualHash(parser.isSet(phashOption));
+		scanner.setGPS(parser.isSet(gpsOption));
+		scanner.setTimestamps(parser.isSet(timestampsOption));
+		scanner.setLens(parser.isSet(lensOption));
+		scanner.setXMP(xmpList);
+		scanner.setIPTC(iptcList);
+		scanner.writeHeader(headerOut);
+		headerOut.flush();
+		out << szHeader;
+		szHeader.chop(1);
+
+		cCoordinator	coordinator(szHeader, out);
+
+		if(parser.isSet(statsOption))
+			coordinator.setStatistics(&statistics);
+		coordinator.setWorkerTimeout(parser.value(workerTimeoutOption).toInt());
+
+		qint32			iShards		= coordinator.plan(dir.absolutePath(), parser.value(shardsOption).toInt());
+		qint32			iSpawn		= parser.value(spawnOption).toInt();
+		QString			szSpawnAddress;
+
+		if(iSpawn > 0)
+		{
+			szSpawnAddress	= QString("local:qtEXIF2File-%1").arg(QCoreApplication::applicationPid());
+			listenList.append(szSpawnAddress);
+		}
+
+		if(listenList.isEmpty())
+		{
+			qDebug() << "--coordinator needs --listen or --spawn";
+			return(1);
+		}
+
+		for(int x = 0;x < listenList.count();x++)
+		{
+			if(!coordinator.listen(listenList[x]))
+			{
+				qDebug() << "can't listen on" << listenList[x];
+				return(1);
+			}
+		}
+
+		workerArgs << "--jobs" << parser.value(jobsOption);
+		if(parser.isSet(libRawOption))
+			workerArgs << "--libraw";
+		if(parser.isSet(imageFactoryOption))
+			workerArgs << "--exiv2-factory";
+		workerArgs << "--io" << parser.value(ioOption) << "--io-prefix" << parser.value(ioPrefixOption) << "--queue-depth" << parser.value(queueDepthOption) << "--order" << parser.value(orderOption) << "--batch-size" << parser.value(batchSizeOption);
+		if(parser.isSet(dropCacheOption))
+			workerArgs << "--drop-cache";
+		if(parser.isSet(hashOption))
+			workerArgs << "--hash";
+		if(parser.isSet(phashOption))
+			workerArgs << "--phash";
+		if(parser.isSet(gpsOption))
+			workerArgs << "--gps";
+		if(parser.isSet(timestampsOption))
+			workerArgs << "--timestamps";
+		if(parser.isSet(adaptiveOption))
+			workerArgs << "--adaptive";
+		if(parser.isSet(lensOption))
+			workerArgs << "--lens";
+		if(parser.isSet(guardedOption))
+			workerArgs << "--guarded" << "--file-timeout" << parser.value(fileTimeoutOption) << "--memory-limit" << parser.value(memoryLimitOption);
+		if(!xmpList.isEmpty())
+			workerArgs << "--xmp" << xmpList.join(",");
+		if(!iptcList.isEmpty())
+			workerArgs << "--iptc" << iptcList.join(",");
+		if(parser.isSet(whereOption))
+			workerArgs << "--where" << parser.value(whereOption);
+
+		if(iSpawn > 0)
+			coordinator.spawn(iSpawn, szSpawnAddress, workerArgs);
+
+		if(parser.isSet(statsOption))
+			statistics.addCount("coordinator/shards", iShards);
+
+		if(!coordinator.isFinished())
+		{
+			QObject::connect(&coordinator, &cCoordinator::finished, lpApp.data(), &QCoreApplication::quit);
+			lpApp->exec();
+		}
+
+		out.flush();
+		file.close();
+
+		if(parser.isSet(statsOption))
+			writeStatistics(statistics, parser.value(statsOption));
+		return(0);
+	}
+
+	int	iExitCode	= 0;
+
 	if(dir.exists())
 	{
 		if(file.open(QFile::WriteOnly | QFile::Truncate))
 		{
-			QTextStream	out(&file);
+			QTextStream		out(&file);
+			cScanner		scanner;
+			cThumbnailPack*	lpThumbnailPack	= nullptr;
+			cStatistics		statistics;
+			cDuplicateFinder	duplicateFinder;
+			cSimilarityIndex	similarityIndex(parser.value(sortTempOption));
+			cExternalSort*		lpExternalSort	= nullptr;
+			cGeoIndex			geoIndex;
+			cGuard				guard(guardArgs);
+
+			scanner.setJobs(parser.value(jobsOption).toInt());
+			scanner.setLibRaw(parser.isSet(libRawOption));
+			scanner.setImageFactory(parser.isSet(imageFactoryOption));
+			scanner.setIOMode(ioMode, iPrefixSize);
+			scanner.setQueueDepth(parser.value(queueDepthOption).toInt(), iPrefixSize);
+			scanner.setAdaptive(parser.isSet(adaptiveOption));
+			scanner.setOrder(order);
+			scanner.setDropCache(parser.isSet(dropCacheOption));
+			scanner.setBatchSize(parser.value(batchSizeOption).toInt());
+			scanner.setHash(parser.isSet(hashOption));
+
+			scanner.setPerceptualHash(parser.isSet(phashOption));
+			scanner.setGPS(parser.isSet(gpsOption));
+			scanner.setTimestamps(parser.isSet(timestampsOption));
+			scanner.setLens(parser.isSet(lensOption));
+			scanner.setXMP(xmpList);
+			scanner.setIPTC(iptcList);
+
+			if(parser.isSet(whereOption))
+				scanner.setFilter(&filter);
+			if(parser.isSet(geoIndexOption))
+				scanner.setGeoIndex(&geoIndex);
+			if(parser.isSet(groupByOption))
+				scanner.setAggregator(&aggregator);
+
+			if(parser.isSet(duplicatesOption))
+				scanner.setDuplicateFinder(&duplicateFinder);
+			if(parser.isSet(similarOption))
+				scanner.setSimilarityIndex(&similarityIndex);
+
+			if(parser.isSet(statsOption))
+			{
+				scanner.setStatistics(&statistics);
+				scanner.setStartTimer(&startTimer);
+				guard.setStatistics(&statistics);
+			}
+
+			if(parser.isSet(guardedOption))
+			{
+				guard.setTimeout(parser.value(fileTimeoutOption).toInt());
+				guard.setMemoryLimit(parser.value(memoryLimitOption).toInt());
+
+				if(parser.isSet(quarantineOption) && !guard.setQuarantine(parser.value(quarantineOption)))
+				{
+					qDebug() << "can't open quarantine file" << parser.value(quarantineOption);
+					return(1);
+				}
+
+				if(parser.isSet(errorReportOption) && !guard.setErrorReport(parser.value(errorReportOption)))
+				{
+					qDebug() << "can't write error report to" << parser.value(errorReportOption);
+					return(1);
+				}
+
+				scanner.setGuard(&guard);
+			}
+
+			if(parser.isSet(thumbnailPackOption))
+			{
+				bool	bOK;
+				qint64	iSegmentSize	= parser.value(packSegmentOption).toLongLong(&bOK);
+
+				// up to 1 PB so the size in bytes can't overflow
+				if(!bOK || iSegmentSize <= 0 || iSegmentSize > Q_INT64_C(1024) * 1024 * 1024)
+				{
+					qDebug() << "invalid --pack-segment-size" << parser.value(packSegmentOption);
+					return(1);
+				}
+
+				lpThumbnailPack	= new cThumbnailPack(parser.value(thumbnailPackOption), iSegmentSize * 1024 * 1024);
+				if(!lpThumbnailPack->open())
+				{
+					qDebug() << "can't create thumbnail pack" << parser.value(thumbnailPackOption);
+					delete lpThumbnailPack;
+					return(1);
+				}
+				scanner.setThumbnailPack(lpThumbnailPack);
+			}
+
+			if(parser.isSet(sortByOption))
+			{
+				lpExternalSort	= new cExternalSort(parser.value(sortMemoryOption).toLongLong() * 1024 * 1024, scanner.jobs(), parser.value(sortTempOption));
+				scanner.setExternalSort(lpExternalSort, parser.value(sortByOption));
+			}
+
+			if(parser.isSet(statsOption))
+				statistics.addTime("startup/init", startTimer.nsecsElapsed());
+
+			if(!parser.isSet(groupByOption))
+				scanner.writeHeader(out);
+			scanner.readDirectory(args[0], out);
+
+			if(parser.isSet(groupByOption))
+			{
+				QElapsedTimer	timer;
+
+				timer.start();
+
+				qint32	iGroups	= aggregator.write(out);
+
+				if(parser.isSet(statsOption))
+				{
+					statistics.addTime("agg/merge", timer.nsecsElapsed());
+					statistics.addCount("agg/groups", iGroups);
+				}
+			}
+
+			if(lpExternalSort)
+			{
+				if(!lpExternalSort->finish(out))
+				{
+					qDebug() << "sorting the output failed, the output is incomplete (is the --sort-temp directory full?)";
+					iExitCode	= 1;
+				}
+
+				if(parser.isSet(statsOption))
+					statistics.addCount("sort/runs", lpExternalSort->runCount());
+				delete lpExternalSort;
+			}
+
+			if(lpThumbnailPack)
+			{
+				lpThumbnailPack->close();
+				delete lpThumbnailPack;
+			}
+
+			if(parser.isSet(duplicatesOption))
+			{
+				duplicateFinder.find(scanner.jobs(), parser.isSet(statsOption) ? &statistics : nullptr);
+				if(!duplicateFinder.writeReport(parser.value(duplicatesOption)))
+					qDebug() << "can't write duplicate report to" << parser.value(duplicatesOption);
+			}
+
+			if(parser.isSet(similarOption))
+			{
+				qint32	iClusters	= similarityIndex.cluster(parser.value(similarDistanceOption).toInt());
+
+				if(parser.isSet(statsOption))
+					statistics.addCount("similar/clusters", iClusters);
+				if(!similarityIndex.writeReport(parser.value(similarOption)))
+					qDebug() << "can't write similarity report to" << parser.value(similarOption);
+			}
 
-			out << "directory" << SEPARATOR << "name" << SEPARATOR << "size" << SEPARATOR << "date" << SEPARATOR << "width" << SEPARATOR << "height" << SEPARATOR << "camera\n";
+			if(parser.isSet(geoIndexOption))
+			{
+				if(parser.isSet(statsOption))
+					statistics.addCount("geo/pictures", geoIndex.count());
+				if(!geoIndex.write(parser.value(geoIndexOption)))
+					qDebug() << "can't write spatial index to" << parser.value(geoIndexOption);
+			}
 
-			readDirectory(args[0], out);
+			if(parser.isSet(statsOption))
+			{
+				statistics.addTime("startup/total", startTimer.nsecsElapsed());
+				writeStatistics(statistics, parser.value(statsOption));
+			}
 		}
 		file.close();
 	}
-	return(0);
+	return(iExitCode);
 //	return a.exec();
 }
@@ -0,0 +1,39 @@
+# Core of qtEXIF2File: reads the metadata of one file or buffer.
+# Included by the command line tool (qtEXIF2File.pro) and the library (qtEXIF2FileLib.pro).
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+win32-g++ {
+    INCLUDEPATH += C:\dev\3rdParty\exiv2\include C:\dev\3rdParty\libraw
+    # Exiv2 and LibRaw use Winsock, the library needs it as well as the tool
+    LIBS += -LC:\dev\3rdParty\exiv2\lib -lexiv2.dll -LC:\dev\3rdParty\libraw\lib -lraw -lws2_32
+}
+
+unix {
+    LIBS += -lraw_r -lexiv2
+}
+
+# qmake CONFIG+=no_translation builds the tag tables from literals instead of QObject::tr()
+no_translation: DEFINES += EXIF2FILE_NO_TRANSLATION
+
+# LibRaw runs on the scanner threads, so the thread safe build (libraw_r) is needed
+QMAKE_CXXFLAGS += -DLIBRAW_NODLL
+
+SOURCES += \
+    $$PWD/cexif.cpp \
+    $$PWD/cpicture.cpp \
+    $$PWD/cfileinput.cpp \
+    $$PWD/cifdview.cpp \
+    $$PWD/cbmffreader.cpp \
+    $$PWD/cxmpscanner.cpp \
+    $$PWD/cstatistics.cpp
+
+HEADERS += \
+    $$PWD/cexif.h \
+    $$PWD/cpicture.h \
+    $$PWD/cfileinput.h \
+    $$PWD/cifdview.h \
+    $$PWD/cbmffreader.h \
+    $$PWD/cxmpscanner.h \
+    $$PWD/cstatistics.h
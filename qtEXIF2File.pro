@@ -1,4 +1,5 @@
 QT -= gui
+QT += network
 
 win32-msvc* {
     contains(QT_ARCH, i386) {
@@ -10,16 +11,24 @@ win32-msvc* {
 
 win32-g++ {
     message("mingw")
-    INCLUDEPATH += C:\dev\3rdParty\exiv2\include C:\dev\3rdParty\libraw
-    LIBS += -LC:\dev\3rdParty\exiv2\lib -lexiv2.dll -LC:\dev\3rdParty\libraw\lib -lraw -lws2_32
+    INCLUDEPATH += C:\dev\3rdParty\xxhash\include C:\dev\3rdParty\libjpeg-turbo\include
+    LIBS += -LC:\dev\3rdParty\xxhash\lib -lxxhash -LC:\dev\3rdParty\libjpeg-turbo\lib -ljpeg
 }
 
 unix {
     message("*nix")
-    LIBS += -lraw -lexiv2
-}
+    LIBS += -lxxhash -ljpeg
 
-QMAKE_CXXFLAGS += -DLIBRAW_NODLL -DLIBRAW_NOTHREADS
+    packagesExist(liburing) {
+        message("io_uring prefetch enabled")
+        DEFINES += HAVE_LIBURING
+        LIBS += -luring
+    }
+
+    # --serve and --load-test use Unix domain sockets
+    SOURCES += cloadtest.cpp cserver.cpp
+    HEADERS += cloadtest.h cserver.h
+}
 
 CONFIG += c++11 console
 CONFIG -= app_bundle
@@ -35,10 +44,26 @@ DEFINES += QT_DEPRECATED_WARNINGS
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# cEXIF, cPicture and their helpers, shared with the library
+include(qtEXIF2File.pri)
+
 SOURCES += \
         main.cpp \
-    cexif.cpp \
-    cpicture.cpp
+    caggregator.cpp \
+    cconcurrencycontroller.cpp \
+    ccontenthash.cpp \
+    ccoordinator.cpp \
+    cdiskorder.cpp \
+    cduplicatefinder.cpp \
+    cexternalsort.cpp \
+    cfilter.cpp \
+    cgeoindex.cpp \
+    cguard.cpp \
+    cperceptualhash.cpp \
+    cprefetcher.cpp \
+    cscanner.cpp \
+    cshardworker.cpp \
+    cthumbnailpack.cpp
 
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
@@ -49,5 +74,18 @@ DISTFILES += \
     README.md
 
 HEADERS += \
-    cexif.h \
-    cpicture.h
+    caggregator.h \
+    cconcurrencycontroller.h \
+    ccontenthash.h \
+    ccoordinator.h \
+    cdiskorder.h \
+    cduplicatefinder.h \
+    cexternalsort.h \
+    cfilter.h \
+    cgeoindex.h \
+    cguard.h \
+    cperceptualhash.h \
+    cprefetcher.h \
+    cscanner.h \
+    cshardworker.h \
+    cthumbnailpack.h
@@ -0,0 +1,30 @@
+# qtEXIF2File core as a library with a C interface (exif2file.h).
+# Builds a shared library, run qmake with CONFIG+=staticlib for a static one
+# and define EXIF2FILE_STATIC in the applications linking it on Windows.
+
+TEMPLATE = lib
+TARGET = exif2file
+
+QT -= gui
+
+CONFIG += c++11 hide_symbols
+CONFIG -= app_bundle
+
+DEFINES += EXIF2FILE_LIBRARY
+DEFINES += QT_DEPRECATED_WARNINGS
+
+include(qtEXIF2File.pri)
+
+SOURCES += \
+    exif2file.cpp
+
+HEADERS += \
+    exif2file.h
+
+# Default rules for deployment.
+unix:!android {
+    target.path = /usr/local/lib
+    headers.path = /usr/local/include
+    headers.files = exif2file.h
+    INSTALLS += target headers
+}